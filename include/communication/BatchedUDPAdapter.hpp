@@ -0,0 +1,90 @@
+#pragma once
+#include "communication/SocketBackend.hpp"
+#include "interfaces/ICommunicationAdapter.hpp"
+#include <yaml-cpp/yaml.h>
+#include <memory>
+
+namespace radar_tracking {
+
+/**
+ * @brief UDP ingestion adapter on the shared SocketBackend
+ *
+ * Receives on one bound socket and, when a remote endpoint is configured,
+ * sends on a second, connected one; both run on the backend's single loop
+ * thread (io_uring where available, recvmmsg/sendmmsg otherwise). Consumers
+ * that can take a whole batch register it with registerBatchCallback() and
+ * read the datagrams in place. The per-packet callback of
+ * ICommunicationAdapter is still served, through one reused buffer, for
+ * consumers that need a vector. Callbacks run on the loop thread and must be
+ * registered before start().
+ */
+class BatchedUDPAdapter : public ICommunicationAdapter {
+public:
+    /**
+     * @brief Configuration (communication.primary section)
+     */
+    struct Config {
+        std::string host = "0.0.0.0";             ///< Bind address
+        uint16_t port = 8080;
+        std::string remote_host;                    ///< sendData() destination; empty disables sending
+        uint16_t remote_port = 0;
+        uint32_t socket_buffer_kb = 4096;           ///< SO_RCVBUF request, absorbs bursts between loop iterations
+        SocketBackend::Config backend;
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+private:
+    Config config_;
+    std::unique_ptr<SocketBackend> backend_;
+    int receive_id_ = -1;
+    int send_id_ = -1;
+    std::function<void(const std::vector<uint8_t>&)> callback_;
+    SocketBackend::BatchHandler batch_callback_;
+    std::vector<uint8_t> scratch_;                  ///< Loop thread: per-packet callback copy
+
+public:
+    BatchedUDPAdapter() = default;
+    ~BatchedUDPAdapter() override;
+
+    BatchedUDPAdapter(const BatchedUDPAdapter&) = delete;
+    BatchedUDPAdapter& operator=(const BatchedUDPAdapter&) = delete;
+
+    // ICommunicationAdapter interface implementation
+    bool initialize(const std::string& config_file) override;
+    void start() override;
+    void stop() override;
+    void registerCallback(std::function<void(const std::vector<uint8_t>&)> callback) override;
+    bool isConnected() const override;
+    std::string getConnectionStats() const override;
+    bool sendData(const std::vector<uint8_t>& data) override;
+    std::string getAdapterType() const override { return "UDP"; }
+
+    /**
+     * @brief Create the sockets and the backend
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Receive whole batches in place instead of one vector per datagram
+     */
+    void registerBatchCallback(SocketBackend::BatchHandler callback);
+
+    /**
+     * @brief Backend counters (syscalls, batches, drops)
+     */
+    SocketBackend::Stats getStats() const;
+
+private:
+    void onBatch(const PacketView* packets, size_t count);
+};
+
+}  // namespace radar_tracking
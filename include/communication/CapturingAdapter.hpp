@@ -0,0 +1,45 @@
+#pragma once
+#include "interfaces/ICommunicationAdapter.hpp"
+#include "utils/DataRecorder.hpp"
+#include <memory>
+
+namespace radar_tracking {
+
+/**
+ * @brief Capture mode for live communication adapters
+ *
+ * Wraps a live adapter (UDP, TCP, ...) and hands every received buffer to a
+ * DataRecorder as a RAW frame before forwarding it to the registered
+ * callback. The resulting session can be played back with ReplayAdapter.
+ */
+class CapturingAdapter : public ICommunicationAdapter {
+private:
+    std::unique_ptr<ICommunicationAdapter> inner_;
+    std::shared_ptr<DataRecorder> recorder_;
+    std::function<void(const std::vector<uint8_t>&)> callback_;
+
+public:
+    /**
+     * @brief Wrap a live adapter
+     * @param inner Adapter that receives the live data
+     * @param recorder Running recorder with record_raw enabled
+     */
+    CapturingAdapter(std::unique_ptr<ICommunicationAdapter> inner,
+                     std::shared_ptr<DataRecorder> recorder);
+    ~CapturingAdapter() override = default;
+
+    // ICommunicationAdapter interface implementation
+    bool initialize(const std::string& config) override;
+    void start() override;
+    void stop() override;
+    void registerCallback(std::function<void(const std::vector<uint8_t>&)> callback) override;
+    bool isConnected() const override;
+    std::string getConnectionStats() const override;
+    bool sendData(const std::vector<uint8_t>& data) override;
+    std::string getAdapterType() const override;
+
+private:
+    void onDataReceived(const std::vector<uint8_t>& data);
+};
+
+}  // namespace radar_tracking
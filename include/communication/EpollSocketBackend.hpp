@@ -0,0 +1,54 @@
+#pragma once
+#include "communication/SocketBackend.hpp"
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Classic socket backend: epoll with recvmmsg/sendmmsg batching
+ *
+ * Fallback for kernels without the io_uring features IoUringBackend needs.
+ * Sockets are switched to non-blocking mode. A readable datagram socket is
+ * drained with recvmmsg, batch_size datagrams per call, and each call's
+ * datagrams go to the handler together; stream sockets are read in
+ * receive_buffer_size chunks. Queued datagrams leave through sendmmsg and
+ * stream data through gathered sendmsg; both resume on EPOLLOUT when the socket
+ * buffer is full.
+ */
+class EpollSocketBackend : public SocketBackend {
+private:
+    struct ReceiveState {
+        std::vector<uint8_t> buffers;          ///< batch_size * receive_buffer_size
+        std::vector<mmsghdr> messages;
+        std::vector<iovec> iov;
+        std::vector<PacketView> views;
+        std::vector<mmsghdr> send_messages;
+        std::vector<iovec> send_iov;
+        bool want_write = false;
+    };
+
+    int epoll_fd_ = -1;
+    std::vector<ReceiveState> state_;
+
+public:
+    explicit EpollSocketBackend(const Config& config) : SocketBackend(config) {}
+    ~EpollSocketBackend() override { stop(); }
+
+    std::string getName() const override { return "socket"; }
+
+protected:
+    bool setup() override;
+    void run() override;
+    void teardown() override;
+
+private:
+    void receiveDatagrams(size_t index);
+    void receiveStream(size_t index);
+    void flushDatagrams(size_t index);
+    void flushStream(size_t index);
+    void updateInterest(size_t index, bool want_write);
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,102 @@
+#pragma once
+#include "communication/SocketBackend.hpp"
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+
+namespace radar_tracking {
+
+/**
+ * @brief io_uring socket backend (Linux 6.0+, built with ENABLE_IO_URING)
+ *
+ * Every receiving socket has one multishot receive armed for its lifetime.
+ * The kernel picks a buffer from a ring of receive_buffers provided buffers
+ * and posts one completion per datagram (or stream chunk). The loop thread
+ * reaps every completion available, calls each socket's handler once with
+ * all of its packets, then hands the buffers back to the ring with a single
+ * tail update. Sends are written from a send slab registered with the ring;
+ * datagrams of zerocopy_min_bytes or more go out as zero-copy sends from the
+ * registered buffer. Stream sockets have one gathered send in flight at a
+ * time, which keeps their bytes in order.
+ *
+ * Submissions and waiting share one io_uring_enter call per loop iteration,
+ * so a busy link costs a fraction of a syscall per packet. Wake-ups for
+ * queued sends arrive as a completed read of the backend's eventfd. The ring
+ * is created disabled and enabled by the loop thread, so it can run with
+ * single-issuer, deferred task work on kernels that offer it.
+ */
+class IoUringBackend : public SocketBackend {
+private:
+    struct SocketState {
+        bool receive_armed = false;
+        bool send_inflight = false;            ///< Stream: a gathered send is in the kernel
+        std::vector<iovec> iov;                ///< Stream send, stable while in flight
+        msghdr message{};
+        std::vector<PacketView> views;         ///< This iteration's received packets
+    };
+
+    int ring_fd_ = -1;
+    void* sq_map_ = nullptr;
+    size_t sq_map_size_ = 0;
+    void* cq_map_ = nullptr;
+    size_t cq_map_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned sq_pending_ = 0;                  ///< Prepared, not yet submitted
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+    io_uring_buf_ring* buf_ring_ = nullptr;
+    size_t buf_ring_size_ = 0;
+    std::unique_ptr<uint8_t[]> receive_slab_;
+    uint16_t buf_tail_ = 0;
+    std::vector<uint16_t> returned_buffers_;   ///< Given back after this iteration's handlers
+    bool fixed_send_buffers_ = false;
+    uint64_t wake_value_ = 0;
+
+    std::vector<SocketState> state_;
+    std::vector<size_t> ready_;                ///< Sockets with packets this iteration
+
+public:
+    explicit IoUringBackend(const Config& config) : SocketBackend(config) {}
+    ~IoUringBackend() override { stop(); }
+
+    /**
+     * @brief Whether the running kernel provides everything this backend uses
+     */
+    static bool isSupported();
+
+    std::string getName() const override { return "io_uring"; }
+
+protected:
+    bool setup() override;
+    void run() override;
+    void teardown() override;
+
+private:
+    bool mapRings(unsigned flags);
+    io_uring_sqe* nextSqe();
+    int enter(unsigned to_submit, unsigned min_complete, unsigned flags);
+
+    void armReceive(size_t index);
+    void armWake();
+    void submitSends();
+    void submitStream(size_t index);
+    void reap();
+    void handleReceive(const io_uring_cqe& cqe, size_t index);
+    void handleStreamSent(const io_uring_cqe& cqe, size_t index);
+    void returnBuffers();
+};
+
+}  // namespace radar_tracking
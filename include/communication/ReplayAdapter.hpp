@@ -0,0 +1,124 @@
+#pragma once
+#include "interfaces/ICommunicationAdapter.hpp"
+#include "utils/RecordingReader.hpp"
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace radar_tracking {
+
+/**
+ * @brief Communication adapter that replays captured raw frames
+ *
+ * Streams RAW frames from a DataRecorder session (produced by a
+ * CapturingAdapter on a live link) into the registered callback. Playback
+ * can follow the original inter-arrival timing, a scaled rate, or run as
+ * fast as possible while the consumer keeps up.
+ */
+class ReplayAdapter : public ICommunicationAdapter {
+public:
+    enum class ReplayMode {
+        ORIGINAL_TIMING,       ///< Reproduce recorded inter-arrival times
+        SCALED,                ///< Recorded timing divided by rate_scale
+        AS_FAST_AS_POSSIBLE    ///< No pacing, throttled only by backpressure
+    };
+
+    /**
+     * @brief Replay configuration (communication.primary.replay section)
+     */
+    struct Config {
+        std::string session_path;          ///< Session base path or any .rec segment
+        ReplayMode mode = ReplayMode::ORIGINAL_TIMING;
+        std::string mode_name;             ///< mode as configured (checked by validate); empty: mode set directly
+        double rate_scale = 1.0;           ///< Speed-up factor for SCALED mode
+        double start_offset_sec = 0.0;     ///< Seek this far into the session before playing
+        bool loop = false;                 ///< Restart at the end of the session (not after a pass without RAW frames)
+        size_t max_pending_frames = 64;    ///< Backpressure high-water mark
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+private:
+    Config config_;
+    RecordingReader reader_;
+    mutable std::mutex reader_mutex_;
+
+    std::function<void(const std::vector<uint8_t>&)> callback_;
+    std::function<size_t()> backpressure_probe_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> finished_{false};
+    std::atomic<int64_t> pending_seek_ns_{-1};
+    std::thread replay_thread_;
+    std::mutex wake_mutex_;                ///< Pairs with wake_cv_; stop() and seek() cut pacing waits short
+    std::condition_variable wake_cv_;
+
+    // Statistics
+    std::atomic<uint64_t> frames_replayed_{0};
+    std::atomic<uint64_t> bytes_replayed_{0};
+    std::atomic<uint64_t> backpressure_waits_{0};
+    std::atomic<int64_t> session_time_ns_{0};
+    std::atomic<int64_t> wall_start_ns_{0};  ///< steady_clock ticks when replay started; 0: not started
+    int64_t session_start_ns_ = 0;
+
+public:
+    ReplayAdapter() = default;
+    ~ReplayAdapter() override;
+
+    // ICommunicationAdapter interface implementation
+    bool initialize(const std::string& config_file) override;
+    void start() override;
+    void stop() override;
+    void registerCallback(std::function<void(const std::vector<uint8_t>&)> callback) override;
+    bool isConnected() const override;
+    std::string getConnectionStats() const override;
+    bool sendData(const std::vector<uint8_t>& data) override;
+    std::string getAdapterType() const override { return "REPLAY"; }
+
+    /**
+     * @brief Initialize from an already parsed configuration
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Install a probe reporting the consumer's queue depth
+     *
+     * In AS_FAST_AS_POSSIBLE and SCALED modes the replay thread waits while
+     * the probe reports more than max_pending_frames.
+     */
+    void setBackpressureProbe(std::function<size_t()> probe);
+
+    /**
+     * @brief Jump to a position in the session (thread safe, applied by the replay thread)
+     * @param seconds_from_start Offset from the first recorded frame
+     */
+    void seek(double seconds_from_start);
+
+    /**
+     * @brief Check whether the whole session has been replayed
+     */
+    bool isFinished() const { return finished_; }
+
+private:
+    void replayLoop();
+    void waitForConsumer();
+    void wake();
+};
+
+/**
+ * @brief Parse replay mode name (original, scaled, afap); unknown names give ORIGINAL_TIMING
+ */
+ReplayAdapter::ReplayMode parseReplayMode(const std::string& mode);
+
+}  // namespace radar_tracking
@@ -0,0 +1,191 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "utils/RecordingFormat.hpp"
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace radar_tracking {
+
+/**
+ * @brief Horizontal partition of the site owned by one shard
+ *
+ * An unbounded region (the default) owns everything: used when shards are
+ * split by radar rather than by geography, in which case every track is a
+ * boundary track and goes through cross-shard association.
+ */
+struct ShardRegion {
+    bool bounded = false;
+    double x_min = -std::numeric_limits<double>::infinity();
+    double x_max = std::numeric_limits<double>::infinity();
+    double y_min = -std::numeric_limits<double>::infinity();
+    double y_max = std::numeric_limits<double>::infinity();
+
+    bool contains(const Point3D& p) const {
+        return p.x >= x_min && p.x < x_max && p.y >= y_min && p.y < y_max;
+    }
+
+    /**
+     * @brief Distance to the nearest edge (positive inside, negative outside)
+     */
+    double edgeDistance(const Point3D& p) const {
+        if (!bounded) {
+            return std::numeric_limits<double>::infinity();
+        }
+        const double inside = std::min(std::min(p.x - x_min, x_max - p.x), std::min(p.y - y_min, y_max - p.y));
+        if (inside >= 0.0) {
+            return inside;
+        }
+        const double dx = std::max(std::max(x_min - p.x, p.x - x_max), 0.0);
+        const double dy = std::max(std::max(y_min - p.y, p.y - y_max), 0.0);
+        return -std::sqrt(dx * dx + dy * dy);
+    }
+
+    /**
+     * @brief Load from a [x_min, y_min, x_max, y_max] sequence; absent means unbounded
+     */
+    void loadFromYaml(const YAML::Node& node) {
+        if (!node || !node.IsSequence() || node.size() != 4) {
+            return;
+        }
+        bounded = true;
+        x_min = node[0].as<double>();
+        y_min = node[1].as<double>();
+        x_max = node[2].as<double>();
+        y_max = node[3].as<double>();
+    }
+};
+
+/**
+ * @brief One entry of sharding.shards: identity, owned region and frame origin
+ */
+struct ShardSpec {
+    uint32_t id = 0;
+    ShardRegion region;
+    Point3D origin;              ///< Worker frame origin in the site frame
+    YAML::Node overrides;        ///< Merged into the worker's configuration by the supervisor
+
+    void loadFromYaml(const YAML::Node& node) {
+        if (!node) {
+            return;
+        }
+        id = node["id"].as<uint32_t>(id);
+        region.loadFromYaml(node["region"]);
+        const YAML::Node o = node["origin"];
+        if (o && o.IsSequence() && o.size() == 3) {
+            origin = Point3D(o[0].as<double>(), o[1].as<double>(), o[2].as<double>());
+        }
+        overrides = node["overrides"];
+    }
+};
+
+namespace shard_wire {
+
+/**
+ * @brief Messages between shard workers and the merge stage
+ *
+ * Sent over a local SOCK_SEQPACKET Unix socket, so every message arrives
+ * whole or not at all. A worker's track picture is one frame split into
+ * chunk_count messages of at most MAX_MESSAGE_BYTES; the merge stage only
+ * applies a frame once all of its chunks have arrived and drops frames
+ * superseded before completing. HANDOVER messages go the other way and
+ * carry tracks entering the receiving shard's region, with their global
+ * ids. Positions are in the common site frame. Little-endian.
+ */
+constexpr uint32_t MAGIC = 0x44485352;  // "RSHD"
+constexpr uint16_t VERSION = 1;
+constexpr size_t MAX_MESSAGE_BYTES = 65536;
+
+inline std::string socketPath(const std::string& socket_dir) {
+    return socket_dir + "/merge.sock";
+}
+
+enum MessageType : uint16_t {
+    MSG_HELLO = 1,       ///< Worker to merge stage on connect; no records
+    MSG_TRACKS = 2,      ///< Worker track picture (one chunk)
+    MSG_HANDOVER = 3     ///< Merge stage to worker: tracks entering its region
+};
+
+enum TrackFlags : uint8_t {
+    TRACK_BOUNDARY = 1 << 0,   ///< Within boundary_margin_m of the region edge
+    TRACK_FOREIGN = 1 << 1     ///< Outside the sending shard's region
+};
+
+#pragma pack(push, 1)
+
+struct MessageHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t type;
+    uint32_t shard_id;
+    uint64_t frame_seq;
+    int64_t timestamp_ns;
+    uint16_t chunk_index;
+    uint16_t chunk_count;
+    uint32_t record_count;
+};
+
+struct TrackRecord {
+    uint32_t track_id;               ///< Worker-local id
+    uint32_t global_id;              ///< HANDOVER only; 0 otherwise
+    uint8_t state;                   ///< TrackState
+    uint8_t flags;                   ///< TrackFlags
+    uint16_t reserved;
+    float confidence;
+    int64_t valid_time_ns;
+    double position[3];
+    double velocity[3];
+    double position_covariance[6];   ///< xx, xy, xz, yy, yz, zz
+};
+
+#pragma pack(pop)
+
+constexpr size_t RECORDS_PER_MESSAGE = (MAX_MESSAGE_BYTES - sizeof(MessageHeader)) / sizeof(TrackRecord);
+
+inline TrackRecord toRecord(const Track& track, const Point3D& origin, uint8_t flags) {
+    TrackRecord record{};
+    record.track_id = track.track_id;
+    record.state = static_cast<uint8_t>(track.state);
+    record.flags = flags;
+    record.confidence = static_cast<float>(track.confidence);
+    record.valid_time_ns = recording::toNanoseconds(track.valid_time);
+    const Point3D position = track.position + origin;
+    record.position[0] = position.x;
+    record.position[1] = position.y;
+    record.position[2] = position.z;
+    record.velocity[0] = track.velocity.x;
+    record.velocity[1] = track.velocity.y;
+    record.velocity[2] = track.velocity.z;
+    int k = 0;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = i; j < 3; ++j) {
+            record.position_covariance[k++] = track.covariance[i][j];
+        }
+    }
+    return record;
+}
+
+inline Track fromRecord(const TrackRecord& record, const Point3D& origin = Point3D()) {
+    Track track;
+    track.track_id = record.track_id;
+    track.state = static_cast<TrackState>(record.state);
+    track.confidence = record.confidence;
+    track.valid_time = recording::fromNanoseconds(record.valid_time_ns);
+    track.last_update = track.valid_time;
+    track.position = Point3D(record.position[0], record.position[1], record.position[2]) - origin;
+    track.velocity = Point3D(record.velocity[0], record.velocity[1], record.velocity[2]);
+    int k = 0;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = i; j < 3; ++j) {
+            track.covariance[i][j] = track.covariance[j][i] = record.position_covariance[k++];
+        }
+    }
+    return track;
+}
+
+}  // namespace shard_wire
+
+}  // namespace radar_tracking
@@ -0,0 +1,193 @@
+#pragma once
+#include "utils/LockFreeQueue.hpp"
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Received bytes owned by the backend; valid only during the handler call
+ */
+struct PacketView {
+    const uint8_t* data;
+    size_t size;
+};
+
+/**
+ * @brief Single-threaded socket I/O engine shared by the UDP/TCP adapters
+ *
+ * One loop thread owns every registered socket. Received datagrams (or stream
+ * chunks) are handed to the socket's handler in batches, one call per socket
+ * per loop iteration, straight from the backend's receive buffers. Sends may
+ * be issued from any thread: the payload is copied into a preallocated slot,
+ * queued through a lock-free hand-off and written by the loop thread together
+ * with everything else queued since its last iteration. send() never blocks
+ * and never allocates; when no slot is free the packet is dropped and counted.
+ *
+ * create() picks IoUringBackend when the kernel supports it (multishot
+ * receive, provided buffer rings, registered send buffers; Linux 6.0+) and
+ * EpollSocketBackend (recvmmsg/sendmmsg) otherwise. Sockets must be connected
+ * (or bound, for receive-only UDP) and registered before start().
+ */
+class SocketBackend {
+public:
+    using BatchHandler = std::function<void(const PacketView* packets, size_t count)>;
+
+    enum class Kind {
+        AUTO,       ///< io_uring when available, otherwise classic sockets
+        IO_URING,
+        SOCKET
+    };
+
+    /**
+     * @brief Configuration (keys of the adapter's section)
+     */
+    struct Config {
+        Kind kind = Kind::AUTO;                    ///< io_backend: auto, io_uring or socket
+        uint32_t ring_entries = 256;               ///< io_uring submission queue size
+        uint32_t receive_buffers = 256;            ///< Power of two
+        uint32_t receive_buffer_size = 65536;      ///< Largest datagram accepted
+        uint32_t send_buffers = 256;               ///< Power of two
+        uint32_t send_buffer_size = 65536;         ///< Largest packet accepted by send()
+        uint32_t batch_size = 64;                  ///< Datagrams per recvmmsg/sendmmsg, iovecs per stream send
+        uint32_t zerocopy_min_bytes = 16384;       ///< io_uring: zero-copy sends from registered buffers
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    struct Stats {
+        uint64_t packets_received = 0;
+        uint64_t bytes_received = 0;
+        uint64_t receive_batches = 0;         ///< Handler calls
+        uint64_t packets_sent = 0;
+        uint64_t bytes_sent = 0;
+        uint64_t send_dropped = 0;            ///< No free slot, oversized or failed
+        uint64_t receive_starved = 0;         ///< Receive paused because every buffer was in use
+        uint64_t syscalls = 0;                ///< Made by the loop thread
+    };
+
+protected:
+    struct SendRequest {
+        uint32_t socket;
+        uint32_t slot;
+        uint32_t size;
+    };
+
+    struct Socket {
+        int fd = -1;
+        bool stream = false;
+        std::atomic<bool> open{true};
+        BatchHandler handler;                  ///< Empty for send-only sockets
+        std::deque<SendRequest> pending;       ///< Queued, not yet handed to the kernel
+        size_t offset = 0;                     ///< Stream: bytes of pending.front() already sent
+    };
+
+    Config config_;
+    std::deque<Socket> sockets_;               ///< Fixed once started (deque: elements never move)
+    std::unique_ptr<uint8_t[]> send_slab_;     ///< send_buffers slots of send_buffer_size bytes
+    std::unique_ptr<LockFreeQueue<uint32_t>> free_slots_;
+    std::unique_ptr<LockFreeQueue<SendRequest>> submit_queue_;
+    int wake_fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> wake_pending_{false};
+    std::thread loop_thread_;
+
+    std::atomic<uint64_t> packets_received_{0};
+    std::atomic<uint64_t> bytes_received_{0};
+    std::atomic<uint64_t> receive_batches_{0};
+    std::atomic<uint64_t> packets_sent_{0};
+    std::atomic<uint64_t> bytes_sent_{0};
+    std::atomic<uint64_t> send_dropped_{0};
+    std::atomic<uint64_t> receive_starved_{0};
+    std::atomic<uint64_t> syscalls_{0};
+
+public:
+    explicit SocketBackend(const Config& config);
+    virtual ~SocketBackend();
+
+    SocketBackend(const SocketBackend&) = delete;
+    SocketBackend& operator=(const SocketBackend&) = delete;
+
+    /**
+     * @brief Choose and construct the best available backend
+     * @return nullptr if the configuration is invalid
+     */
+    static std::unique_ptr<SocketBackend> create(const Config& config);
+
+    /**
+     * @brief Register a socket; the backend owns and closes it from now on
+     * @param handler Receive handler, or empty for a send-only socket
+     * @return Socket id for send(), or -1 (after start() or on error)
+     */
+    int addSocket(int fd, BatchHandler handler);
+
+    /**
+     * @brief Start the loop thread
+     */
+    bool start();
+
+    /**
+     * @brief Stop the loop thread and close every socket (final)
+     */
+    void stop();
+
+    /**
+     * @brief Queue a packet for sending; callable from any thread
+     * @return false if the packet was dropped
+     */
+    bool send(int socket_id, const uint8_t* data, size_t size);
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+    bool isOpen(int socket_id) const;
+    const Config& getConfig() const { return config_; }
+    Stats getStats() const;
+
+    virtual std::string getName() const = 0;
+
+protected:
+    /**
+     * @brief Backend resources for the registered sockets (caller thread)
+     */
+    virtual bool setup() = 0;
+
+    /**
+     * @brief Loop body; returns when running_ is cleared
+     */
+    virtual void run() = 0;
+
+    /**
+     * @brief Release backend resources after the loop has exited
+     */
+    virtual void teardown() = 0;
+
+    uint8_t* slotData(uint32_t slot) const {
+        return send_slab_.get() + static_cast<size_t>(slot) * config_.send_buffer_size;
+    }
+
+    void releaseSlot(uint32_t slot) { free_slots_->tryPush(slot); }
+
+    /**
+     * @brief Move queued sends onto their sockets' pending lists
+     * @return true if anything was queued
+     */
+    bool collectSubmissions();
+
+    void closeSocket(Socket& socket, const char* reason);
+};
+
+}  // namespace radar_tracking
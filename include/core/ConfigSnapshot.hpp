@@ -0,0 +1,170 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "management/BeamScheduler.hpp"
+#include "processing/DBSCANClustering.hpp"
+#include "processing/LazyPrediction.hpp"
+#include "processing/SectorStreamProcessor.hpp"
+#include "processing/TrackSpatialIndex.hpp"
+#include "tracking/FilterKernels.hpp"
+#include "tracking/IMMBatchEngine.hpp"
+#include "tracking/OOSMHandler.hpp"
+#include "tracking/ParticleFilter.hpp"
+#include "tracking/SquareRootKalmanFilter.hpp"
+#include <yaml-cpp/yaml.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Typed, validated and immutable view of the system configuration
+ *
+ * compile() resolves every key once, loads the algorithm configuration
+ * files referenced from the algorithms section, and validates each
+ * component's parameter object. Consumers read plain struct members instead
+ * of dotted-path lookups through YAML nodes; a snapshot never changes after
+ * it is published, so it can be read from any thread without locking.
+ */
+struct ConfigSnapshot {
+    struct System {
+        TrackingMode tracking_mode = TrackingMode::TWS;
+        uint32_t max_tracks = 1000;
+        double update_rate_hz = 50.0;
+    };
+
+    struct Processing {
+        uint32_t thread_pool_size = 8;
+        uint32_t queue_size_limit = 1000;
+        double processing_timeout_ms = 100.0;
+        TrackSpatialIndex::Config spatial_index;
+        LazyPredictionPlanner::Config lazy_prediction;  ///< Effective: forced by streaming/OOSM, TWS only
+        SectorStreamProcessor::Config streaming;
+        OOSMConfig oosm;                                ///< Effective: disabled without lazy prediction
+    };
+
+    struct Association {
+        double gating_threshold = 9.21;
+        double max_association_distance = 500.0;
+    };
+
+    /**
+     * @brief Algorithm selection and the parameters of the selected algorithms
+     *
+     * Only the parameter objects of the configured types are loaded and
+     * validated; the others keep their defaults.
+     */
+    struct Algorithms {
+        std::string pipeline = "static";
+        std::string clustering_type;
+        std::string association_type;
+        std::string tracking_type;
+        std::string clustering_config_file;
+        std::string association_config_file;
+        std::string tracking_config_file;
+
+        DBSCANClustering::Config dbscan;
+        Association gnn;
+        KalmanCVKernel::Params kalman;
+        IMMKernel::Params imm;
+        bool imm_batched = false;                       ///< performance.enable_parallel_models
+        IMMBatchEngine::BatchConfig imm_batch;
+        ParticleFilter::Config particle;
+        SquareRootKalmanFilter::Config srkf;
+    };
+
+    struct Logging {
+        std::string level = "INFO";
+        std::string file_path = "logs/radar_tracking.log";
+    };
+
+    System system;
+    TrackManagementConfig track_management;
+    Processing processing;
+    BeamScheduler::Config beam_scheduler;
+    Algorithms algorithms;
+    Logging logging;
+
+    std::string source_file;
+    uint64_t generation = 0;                            ///< Set when published
+
+    ConfigSnapshot() : track_management{3, 5, 10.0, 0.7, 1000} {}
+
+    /**
+     * @brief Compile a snapshot from a system configuration document
+     * @param root Parsed system configuration
+     * @param source_file Path of the document (for diagnostics)
+     * @return The snapshot, or nullptr if any section is invalid (errors are logged)
+     */
+    static std::shared_ptr<ConfigSnapshot> compile(const YAML::Node& root, const std::string& source_file = "");
+
+    /**
+     * @brief Load and compile a system configuration file
+     */
+    static std::shared_ptr<ConfigSnapshot> compileFile(const std::string& config_file);
+};
+
+/**
+ * @brief Publishes configuration snapshots with read-copy-update semantics
+ *
+ * current() is a lock-free atomic load of the published pointer; readers
+ * keep the snapshot they loaded alive for as long as they use it. reload()
+ * compiles the file off to the side and, only if it is valid, swaps the
+ * pointer and notifies subscribers from the reloading thread, so a reload
+ * never pauses the pipeline and a bad file leaves the running configuration
+ * in place. Reloads are serialized with each other, not with readers.
+ */
+class ConfigPublisher {
+public:
+    using SnapshotPtr = std::shared_ptr<const ConfigSnapshot>;
+    using Listener = std::function<void(const SnapshotPtr&)>;
+
+private:
+    SnapshotPtr current_;                 ///< Accessed only through std::atomic_load/store
+    std::string config_file_;
+    std::vector<Listener> listeners_;
+    mutable std::mutex reload_mutex_;     ///< Serializes load/reload and listener changes
+    uint64_t generation_ = 0;
+
+public:
+    ConfigPublisher() = default;
+    ConfigPublisher(const ConfigPublisher&) = delete;
+    ConfigPublisher& operator=(const ConfigPublisher&) = delete;
+
+    /**
+     * @brief Compile and publish a configuration file
+     * @return false if the file is invalid (the published snapshot is unchanged)
+     */
+    bool load(const std::string& config_file);
+
+    /**
+     * @brief Recompile the last loaded file and publish it if valid
+     */
+    bool reload();
+
+    /**
+     * @brief Publish an already compiled snapshot
+     */
+    void publish(std::shared_ptr<ConfigSnapshot> snapshot);
+
+    /**
+     * @brief The published snapshot (nullptr before the first successful load)
+     */
+    SnapshotPtr current() const { return std::atomic_load(&current_); }
+
+    /**
+     * @brief Call listener with every newly published snapshot
+     *
+     * If a snapshot is already published the listener is called with it
+     * immediately. Listeners run on the publishing thread and should only
+     * hand the snapshot over (e.g. store it for the next scan).
+     */
+    void subscribe(Listener listener);
+
+private:
+    void publishLocked(std::shared_ptr<ConfigSnapshot> snapshot);
+};
+
+}  // namespace radar_tracking
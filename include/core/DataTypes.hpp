@@ -74,6 +74,7 @@ struct Track {
     double quality_score;
     TrackState state;
     std::chrono::high_resolution_clock::time_point last_update;
+    std::chrono::high_resolution_clock::time_point valid_time;  // Time the state estimate refers to
     std::chrono::high_resolution_clock::time_point creation_time;
     std::vector<RadarDetection> associated_detections;
     std::vector<Point3D> trajectory;
@@ -84,6 +85,7 @@ struct Track {
               state(TrackState::TENTATIVE), consecutive_misses(0), hit_count(0) {
         creation_time = std::chrono::high_resolution_clock::now();
         last_update = creation_time;
+        valid_time = creation_time;
         
         // Initialize covariance matrix to zeros
         for (int i = 0; i < 9; ++i) {
@@ -0,0 +1,137 @@
+#pragma once
+#include "communication/ShardProtocol.hpp"
+#include "interfaces/IOutputAdapter.hpp"
+#include "management/TrackMerger.hpp"
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Merge stage of a sharded deployment
+ *
+ * Listens on a SOCK_SEQPACKET Unix socket in socket_dir for the shard
+ * workers' ShardLinkAdapters. One event-loop thread reassembles each
+ * worker's frames, hands complete ones to a TrackMerger, and at
+ * publish_rate_hz publishes the merged picture to the registered output
+ * adapters and callback. Handovers produced by a merge are sent back to the
+ * shard that now owns the track. A worker that disconnects (crash, restart)
+ * has its picture withdrawn immediately rather than after shard_timeout_s.
+ */
+class MergeStage {
+public:
+    using PublishCallback = std::function<void(const std::vector<Track>&)>;
+
+    /**
+     * @brief Configuration (sharding section)
+     */
+    struct Config {
+        std::string socket_dir = "/tmp/radar_shards";
+        double publish_rate_hz = 20.0;
+        std::vector<ShardSpec> shards;
+        TrackMerger::Config merge;
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    struct Stats {
+        uint64_t frames_received = 0;         ///< Complete worker frames applied
+        uint64_t frames_incomplete = 0;       ///< Superseded before all chunks arrived
+        uint64_t messages_rejected = 0;       ///< Bad magic, version, size or shard id
+        uint64_t publishes = 0;
+        uint64_t handovers_sent = 0;
+        uint32_t connected_shards = 0;
+        double last_merge_ms = 0.0;
+        TrackMerger::Stats merger;
+    };
+
+private:
+    struct Peer {
+        int fd = -1;
+        int shard = -1;                       ///< Set by HELLO
+        uint64_t frame_seq = 0;
+        uint16_t chunks_received = 0;
+        std::vector<shard_wire::TrackRecord> assembling;
+    };
+
+    Config config_;
+    TrackMerger merger_;
+    int listen_fd_ = -1;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::vector<std::unique_ptr<Peer>> peers_;
+    std::vector<std::unique_ptr<IOutputAdapter>> outputs_;
+    PublishCallback callback_;
+    std::vector<uint8_t> buffer_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> frames_received_{0};
+    std::atomic<uint64_t> frames_incomplete_{0};
+    std::atomic<uint64_t> messages_rejected_{0};
+    std::atomic<uint64_t> publishes_{0};
+    std::atomic<uint64_t> handovers_sent_{0};
+    std::atomic<uint32_t> connected_shards_{0};
+    std::atomic<double> last_merge_ms_{0.0};
+    TrackMerger::Stats merger_stats_;         ///< Copied by the loop thread under stats_mutex_
+    mutable std::mutex stats_mutex_;
+
+public:
+    MergeStage() = default;
+    ~MergeStage();
+
+    MergeStage(const MergeStage&) = delete;
+    MergeStage& operator=(const MergeStage&) = delete;
+
+    /**
+     * @brief Load the sharding section of a configuration file
+     */
+    bool initialize(const std::string& config_file);
+
+    /**
+     * @brief Create the listening socket; an existing socket file is replaced
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Publish merged pictures to an adapter; call before start()
+     */
+    void addOutputAdapter(std::unique_ptr<IOutputAdapter> adapter);
+
+    /**
+     * @brief Receive merged pictures on the loop thread; call before start()
+     */
+    void setPublishCallback(PublishCallback callback) { callback_ = std::move(callback); }
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    const Config& getConfig() const { return config_; }
+    Stats getStats() const;
+
+private:
+    void run();
+    void accept();
+    void readPeer(Peer& peer);
+    void applyMessage(Peer& peer, const shard_wire::MessageHeader& header, const uint8_t* records);
+    void dropPeer(Peer& peer);
+    void publish();
+    void closeAll();
+};
+
+}  // namespace radar_tracking
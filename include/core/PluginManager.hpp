@@ -0,0 +1,250 @@
+#pragma once
+#include "interfaces/AlgorithmPlugin.hpp"
+#include "interfaces/IAssociationAlgorithm.hpp"
+#include "interfaces/IClusteringAlgorithm.hpp"
+#include "interfaces/ITracker.hpp"
+#include "processing/ScanPipeline.hpp"
+#include "utils/CheckpointSection.hpp"
+#include <yaml-cpp/yaml.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Loads algorithm plugins and swaps them in between scans
+ *
+ * Each of the clustering, association and tracker slots can name a plugin
+ * library (AlgorithmPlugin.hpp ABI) and the configuration file its instance
+ * is initialized with. A watcher thread checks every poll_interval_s whether
+ * a library, an algorithm configuration file or the plugins section of the
+ * system configuration changed; it then loads and initializes a new
+ * instance off to the side. The library is copied to staging_directory
+ * first, so a rebuilt library installed under the same name is loaded as new
+ * code, and plugins built for another ABI version or data layout are
+ * refused. A plugin that fails to load or initialize leaves the running
+ * instance in place.
+ *
+ * The tracking thread calls applyPending() between scans. Without a staged
+ * instance that is one atomic load; otherwise the new instances replace the
+ * running ones at once: the outgoing tracker's per-track state
+ * (ITracker::exportState) is imported into the incoming one, and the scan
+ * pipeline is rebound to the new instances. Replaced instances are destroyed
+ * and their libraries closed later on the watcher thread.
+ *
+ * Slots without a plugin keep the built-in instances given to
+ * setDefaults(). Only the runtime scan pipeline runs plugin algorithms;
+ * StaticPipeline specializations hold their own.
+ */
+class PluginManager {
+public:
+    static constexpr size_t KIND_COUNT = 3;
+
+    /**
+     * @brief Plugin of one slot
+     */
+    struct PluginSpec {
+        std::string library;               ///< File in directory (or absolute path); empty: built-in
+        std::string config_file;           ///< Passed to the instance's initialize()
+
+        bool operator==(const PluginSpec& other) const {
+            return library == other.library && config_file == other.config_file;
+        }
+    };
+
+    /**
+     * @brief Configuration (plugins section)
+     */
+    struct Config {
+        bool enabled = false;
+        std::string directory = "/usr/local/lib/radar_tracking/plugins";
+        std::string staging_directory = "/tmp/radar_tracking_plugins";  ///< Private copies that are loaded
+        double poll_interval_s = 1.0;      ///< Change check period; 0: only on refresh()
+        bool migrate_tracker_state = true; ///< Carry per-track filter state across tracker swaps
+        PluginSpec clustering;
+        PluginSpec association;
+        PluginSpec tracking;
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+
+        const PluginSpec& spec(PluginKind kind) const;
+        std::string libraryPath(const PluginSpec& spec) const;
+    };
+
+    struct Stats {
+        uint64_t loads = 0;                ///< Instances loaded and initialized
+        uint64_t load_failures = 0;        ///< Missing library, entry point or failed initialize()
+        uint64_t abi_rejections = 0;       ///< Built for another ABI version or layout
+        uint64_t swaps = 0;                ///< applyPending() calls that swapped instances
+        uint64_t migrated_tracks = 0;      ///< Tracks whose filter state was carried over
+        uint64_t migration_failures = 0;   ///< Tracker swaps that restarted from Track estimates
+        double last_load_ms = 0.0;
+        double last_swap_ms = 0.0;         ///< Tracking thread time of the last swap
+    };
+
+private:
+    struct Library;
+
+    /**
+     * @brief Modification stamp of a file, to detect replacements
+     */
+    struct FileStamp {
+        int64_t mtime_ns = -1;
+        uint64_t size = 0;
+
+        bool operator==(const FileStamp& other) const { return mtime_ns == other.mtime_ns && size == other.size; }
+        bool operator!=(const FileStamp& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @brief One algorithm object created by a plugin
+     */
+    struct Instance {
+        std::shared_ptr<Library> library;  ///< Closed after the last instance from it is destroyed
+        void* object = nullptr;            ///< Interface pointer of kind
+        PluginKind kind = PluginKind::CLUSTERING;
+        std::string name;
+        std::string version;
+
+        Instance() = default;
+        Instance(const Instance&) = delete;
+        Instance& operator=(const Instance&) = delete;
+        ~Instance();
+    };
+
+    using InstancePtr = std::unique_ptr<Instance>;
+
+    /**
+     * @brief What the running (or staged) instance of a slot was loaded from
+     */
+    struct Source {
+        PluginSpec spec;
+        FileStamp library;
+        FileStamp config;
+    };
+
+    Config config_;                        ///< Watcher thread only once started (plugins changes)
+    bool enabled_ = false;
+    std::atomic<bool> migrate_tracker_state_{true};
+    std::string config_file_;              ///< System configuration re-read for plugins changes
+    FileStamp config_file_stamp_;
+    std::array<Source, KIND_COUNT> sources_;
+    uint64_t load_sequence_ = 0;
+
+    std::thread watcher_;
+    std::mutex refresh_mutex_;             ///< Serializes refresh()
+    std::mutex mutex_;                     ///< Guards staged_, retired_ and stopping_
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::array<InstancePtr, KIND_COUNT> staged_;
+    std::vector<InstancePtr> retired_;
+    std::atomic<bool> pending_{false};
+
+    // Tracking thread only
+    std::array<InstancePtr, KIND_COUNT> active_;
+    IClusteringAlgorithm* default_clustering_ = nullptr;
+    IAssociationAlgorithm* default_association_ = nullptr;
+    ITracker* default_tracker_ = nullptr;
+    CheckpointSection migration_;
+    bool warned_static_pipeline_ = false;
+
+    std::atomic<uint64_t> loads_{0};
+    std::atomic<uint64_t> load_failures_{0};
+    std::atomic<uint64_t> abi_rejections_{0};
+    std::atomic<uint64_t> swaps_{0};
+    std::atomic<uint64_t> migrated_tracks_{0};
+    std::atomic<uint64_t> migration_failures_{0};
+    std::atomic<double> last_load_ms_{0.0};
+    std::atomic<double> last_swap_ms_{0.0};
+
+public:
+    PluginManager() = default;
+    ~PluginManager();
+
+    PluginManager(const PluginManager&) = delete;
+    PluginManager& operator=(const PluginManager&) = delete;
+
+    /**
+     * @brief Load the plugins section of a system configuration file
+     *
+     * The file is watched: a changed plugins section selects other plugins
+     * or configuration files without a restart.
+     */
+    bool initialize(const std::string& config_file);
+
+    /**
+     * @brief Apply a configuration, load its plugins and start the watcher
+     *
+     * The configured plugins are staged before this returns, so the first
+     * applyPending() swaps them in.
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Stop the watcher and release staged and replaced instances
+     *
+     * Active instances stay usable until the manager is destroyed.
+     */
+    void shutdown();
+
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * @brief Built-in instances used by slots without a plugin (owned by the caller)
+     */
+    void setDefaults(IClusteringAlgorithm* clustering, IAssociationAlgorithm* association, ITracker* tracker);
+
+    /**
+     * @brief Load changed plugins now instead of waiting for the watcher
+     * @return Number of instances staged
+     */
+    size_t refresh();
+
+    /**
+     * @brief Whether staged instances wait for applyPending()
+     */
+    bool hasPending() const { return pending_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Swap staged instances in; call on the tracking thread between scans
+     * @param tracks Current tracks, for tracker state migration
+     * @param pipeline Scan pipeline to rebind (may be nullptr)
+     * @return true if any instance was swapped
+     */
+    bool applyPending(const std::vector<Track>& tracks, ScanPipeline* pipeline);
+
+    // Running instances (plugin or default); tracking thread, valid until the next applyPending()
+    IClusteringAlgorithm* clustering() const;
+    IAssociationAlgorithm* association() const;
+    ITracker* tracker() const;
+
+    Stats getStats() const;
+
+    static const char* kindName(PluginKind kind);
+
+private:
+    static size_t slot(PluginKind kind) { return static_cast<size_t>(kind) - 1; }
+    static FileStamp stamp(const std::string& path);
+
+    bool start(const Config& config);
+    InstancePtr load(PluginKind kind, const PluginSpec& spec);
+    bool reloadConfig();
+    void releaseRetired();
+    void watcherLoop();
+};
+
+}  // namespace radar_tracking
@@ -1,5 +1,6 @@
 #pragma once
 #include "core/DataTypes.hpp"
+#include "core/PluginManager.hpp"
 #include "core/ThreadPool.hpp"
 #include "interfaces/ICommunicationAdapter.hpp"
 #include "interfaces/IDataProcessor.hpp"
@@ -7,7 +8,11 @@
 #include "interfaces/IAssociationAlgorithm.hpp"
 #include "interfaces/ITracker.hpp"
 #include "interfaces/IOutputAdapter.hpp"
+#include "management/TrackCheckpointer.hpp"
 #include "management/TrackManager.hpp"
+#include "processing/ScanPipeline.hpp"
+#include "processing/ShadowExecutor.hpp"
+#include "utils/DataRecorder.hpp"
 #include <thread>
 #include <queue>
 #include <mutex>
@@ -54,7 +59,12 @@ private:
     std::unique_ptr<IAssociationAlgorithm> association_algo_;
     std::unique_ptr<ITracker> tracker_;
     std::unique_ptr<TrackManager> track_manager_;
+    std::unique_ptr<ScanPipeline> scan_pipeline_;  // Static specialization or runtime fallback
+    std::unique_ptr<TrackCheckpointer> checkpointer_;  // Periodic state capture, warm start in initialize()
+    std::unique_ptr<PluginManager> plugin_manager_;  // Plugin algorithms, swapped in by the tracking thread between scans
+    std::unique_ptr<ShadowExecutor> shadow_executor_;  // Secondary chain on shared scans, compared off the tracking thread
     std::vector<std::unique_ptr<IOutputAdapter>> output_adapters_;
+    std::shared_ptr<DataRecorder> data_recorder_;
     
     // Configuration
     TrackingMode tracking_mode_;
@@ -0,0 +1,112 @@
+#pragma once
+#include "communication/ShardProtocol.hpp"
+#include <yaml-cpp/yaml.h>
+#include <sys/types.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Starts and watches the worker processes of a sharded deployment
+ *
+ * For every entry of sharding.shards the supervisor writes a worker
+ * configuration into socket_dir: the base configuration with every output
+ * disabled except output.shard (the link to the merge stage), the entry's
+ * overrides deep-merged in (typically the radar input port, recording
+ * paths) and sharding.shard_id set. Unless the overrides name one, each
+ * worker checkpoints into checkpoint.directory/shard_<id>, so shards
+ * neither contend for one primary lock nor warm-start from each other's
+ * tracks. It then runs one process per shard, the same executable with
+ * --config <worker config> --shard-id <id>, so each worker is a complete
+ * RadarSystem on its own cores and address space.
+ * A worker that exits is restarted after restart_delay_s; one that keeps
+ * failing is given up on after max_restarts, leaving the rest running.
+ */
+class ShardSupervisor {
+public:
+    /**
+     * @brief Configuration (sharding section)
+     */
+    struct Config {
+        std::string socket_dir = "/tmp/radar_shards";
+        std::string executable;              ///< Empty: this process's own executable
+        double restart_delay_s = 1.0;
+        uint32_t max_restarts = 10;          ///< Per worker; 0 never restarts
+        std::vector<ShardSpec> shards;
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    struct WorkerStatus {
+        uint32_t shard_id;
+        pid_t pid;                           ///< 0 while not running
+        uint32_t restarts;
+        bool failed;                         ///< Restart budget exhausted
+    };
+
+private:
+    struct Worker {
+        uint32_t shard_id = 0;
+        std::string config_path;
+        pid_t pid = 0;
+        uint32_t restarts = 0;
+        bool failed = false;
+        std::chrono::steady_clock::time_point restart_at{};
+    };
+
+    Config config_;
+    std::vector<Worker> workers_;
+    std::string log_level_ = "INFO";
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    mutable std::mutex mutex_;
+
+public:
+    ShardSupervisor() = default;
+    ~ShardSupervisor();
+
+    ShardSupervisor(const ShardSupervisor&) = delete;
+    ShardSupervisor& operator=(const ShardSupervisor&) = delete;
+
+    /**
+     * @brief Read the sharding section and write every worker's configuration
+     */
+    bool initialize(const std::string& config_file, const std::string& log_level = "INFO");
+
+    /**
+     * @brief Launch all workers and the watch thread
+     */
+    bool start();
+
+    /**
+     * @brief SIGTERM all workers, SIGKILL those still alive after timeout_s
+     */
+    void stop(double timeout_s = 10.0);
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+    std::vector<WorkerStatus> getStatus() const;
+
+    /**
+     * @brief Recursively merge overrides into base (maps merge, other nodes replace)
+     */
+    static void mergeOverrides(YAML::Node base, const YAML::Node& overrides);
+
+private:
+    bool launch(Worker& worker);
+    void watch();
+};
+
+}  // namespace radar_tracking
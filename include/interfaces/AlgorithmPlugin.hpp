@@ -0,0 +1,113 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "interfaces/IAssociationAlgorithm.hpp"
+#include "interfaces/IClusteringAlgorithm.hpp"
+#include "interfaces/ITracker.hpp"
+#include "utils/CheckpointSection.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Binary interface between the tracker and algorithm plugins
+ *
+ * A plugin is a shared library exporting one C function,
+ * radar_tracking_plugin(), that returns a static PluginDescriptor (see
+ * RADAR_TRACKING_PLUGIN). Algorithm objects cross the boundary as C++
+ * interface pointers, so the descriptor carries the plugin ABI version and a
+ * fingerprint of the layouts both sides must agree on; PluginManager refuses
+ * a plugin whose values differ from its own instead of calling through a
+ * mismatched vtable. Bump PLUGIN_ABI_VERSION whenever an algorithm interface
+ * or a type in DataTypes.hpp changes.
+ *
+ * Instances are created and destroyed by the plugin, so each side frees
+ * only what its own allocator returned.
+ */
+constexpr uint32_t PLUGIN_ABI_VERSION = 2;
+constexpr const char* PLUGIN_ENTRY_POINT = "radar_tracking_plugin";
+
+enum class PluginKind : uint32_t {
+    CLUSTERING = 1,
+    ASSOCIATION = 2,
+    TRACKER = 3
+};
+
+/**
+ * @brief Layout fingerprint of the types passed between core and plugins
+ *
+ * Covers the algorithm data types, the standard library containers they
+ * hold (catches a libstdc++ dual-ABI mismatch) and the compiler's C++ ABI.
+ */
+constexpr uint64_t pluginLayoutFingerprint() {
+#if defined(__GXX_ABI_VERSION)
+    constexpr uint64_t compiler_abi = __GXX_ABI_VERSION;
+#elif defined(_MSC_VER)
+    constexpr uint64_t compiler_abi = _MSC_VER / 100;  // Toolsets within a major version are compatible
+#else
+    constexpr uint64_t compiler_abi = 0;
+#endif
+    const uint64_t values[] = {
+        sizeof(RadarDetection), sizeof(Cluster), sizeof(Track), alignof(Track), sizeof(SystemStats),
+        sizeof(CheckpointSection), sizeof(std::string), sizeof(std::vector<uint8_t>),
+        sizeof(void*), compiler_abi
+    };
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const uint64_t value : values) {
+        hash = (hash ^ value) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief What radar_tracking_plugin() returns; plain data, stable layout
+ */
+struct PluginDescriptor {
+    uint32_t abi_version;            ///< PLUGIN_ABI_VERSION the plugin was built with
+    uint32_t kind;                   ///< PluginKind
+    uint64_t layout;                 ///< pluginLayoutFingerprint() of the plugin build
+    const char* name;                ///< Algorithm name (for logs and state migration tags)
+    const char* version;             ///< Build or tuning version (for logs)
+    void* (*create)();               ///< New instance, as a pointer to the kind's interface
+    void (*destroy)(void* instance);
+};
+
+using PluginEntryPoint = const PluginDescriptor* (*)();
+
+/**
+ * @brief Interface type of each plugin kind
+ */
+template<PluginKind Kind> struct PluginInterface;
+template<> struct PluginInterface<PluginKind::CLUSTERING> { using type = IClusteringAlgorithm; };
+template<> struct PluginInterface<PluginKind::ASSOCIATION> { using type = IAssociationAlgorithm; };
+template<> struct PluginInterface<PluginKind::TRACKER> { using type = ITracker; };
+
+}  // namespace radar_tracking
+
+#ifdef _WIN32
+    #define RADAR_TRACKING_PLUGIN_EXPORT __declspec(dllexport)
+#else
+    #define RADAR_TRACKING_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief Define the entry point of a plugin providing CLASS as KIND
+ *
+ * Use once per plugin library, at global scope, e.g.
+ * RADAR_TRACKING_PLUGIN(CLUSTERING, DBSCANClustering, "dbscan", "1.0").
+ */
+#define RADAR_TRACKING_PLUGIN(KIND, CLASS, NAME, VERSION)                                              \
+    extern "C" RADAR_TRACKING_PLUGIN_EXPORT const ::radar_tracking::PluginDescriptor*                 \
+    radar_tracking_plugin() {                                                                         \
+        using Interface = ::radar_tracking::PluginInterface<::radar_tracking::PluginKind::KIND>::type; \
+        static const ::radar_tracking::PluginDescriptor descriptor{                                    \
+            ::radar_tracking::PLUGIN_ABI_VERSION,                                                      \
+            static_cast<uint32_t>(::radar_tracking::PluginKind::KIND),                                 \
+            ::radar_tracking::pluginLayoutFingerprint(),                                               \
+            NAME,                                                                                      \
+            VERSION,                                                                                   \
+            []() -> void* { return static_cast<Interface*>(new CLASS()); },                            \
+            [](void* instance) { delete static_cast<Interface*>(instance); }};                         \
+        return &descriptor;                                                                            \
+    }
@@ -30,6 +30,24 @@ public:
         const std::vector<Track>& tracks,
         const std::vector<Cluster>& clusters) = 0;
     
+    /**
+     * @brief Associate clusters with tracks using precomputed candidate pairs
+     * @param tracks Vector of existing tracks
+     * @param clusters Vector of new clusters to associate
+     * @param candidates (track_index, cluster_index) pairs whose gates overlap, sorted by track
+     * @return Vector of pairs (track_index, cluster_index) representing associations
+     *
+     * Candidates come from a TrackSpatialIndex; pairs not listed are outside
+     * the gate. The default ignores them and evaluates all pairs.
+     */
+    virtual std::vector<std::pair<uint32_t, uint32_t>> associateCandidates(
+        const std::vector<Track>& tracks,
+        const std::vector<Cluster>& clusters,
+        const std::vector<std::pair<uint32_t, uint32_t>>& candidates) {
+        (void)candidates;
+        return associate(tracks, clusters);
+    }
+    
     /**
      * @brief Calculate association probability between track and cluster
      * @param track Track to test association with
@@ -1,6 +1,8 @@
 #pragma once
 #include "core/DataTypes.hpp"
+#include "utils/CheckpointSection.hpp"
 #include <string>
+#include <vector>
 
 namespace radar_tracking {
 
@@ -73,6 +75,42 @@ public:
      * @return true if track should be deleted
      */
     virtual bool shouldDeleteTrack(const Track& track) const = 0;
+    
+    /**
+     * @brief Drop per-track state of tracks that no longer exist
+     * @param tracks All current tracks; called once per scan before prediction
+     *
+     * The default keeps no state beyond Track and does nothing.
+     */
+    virtual void retainTracks(const std::vector<Track>& tracks) {
+        (void)tracks;
+    }
+    
+    /**
+     * @brief Export per-track filter state kept outside Track
+     * @param tracks Tracks whose state to export, in this order
+     * @param section Filled with one element per track; the tag names the producer
+     *
+     * Used to migrate state when the tracker is replaced between scans. The
+     * default keeps no state beyond Track and leaves the section empty.
+     */
+    virtual void exportState(const std::vector<Track>& tracks, CheckpointSection& section) {
+        (void)tracks;
+        section.clear();
+    }
+    
+    /**
+     * @brief Adopt state another instance exported for the same tracks
+     * @param tracks Tracks the section was exported for, in the same order
+     * @param section State from exportState()
+     * @return false if the section is not usable (other producer or layout);
+     *         the tracker then continues from the Track estimates
+     */
+    virtual bool importState(const std::vector<Track>& tracks, const CheckpointSection& section) {
+        (void)tracks;
+        (void)section;
+        return false;
+    }
 };
 
 }  // namespace radar_tracking
\ No newline at end of file
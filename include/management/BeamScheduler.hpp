@@ -0,0 +1,174 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "interfaces/ICommunicationAdapter.hpp"
+#include "utils/IndexedPriorityQueue.hpp"
+#include <yaml-cpp/yaml.h>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace radar_tracking {
+
+namespace beam {
+
+/**
+ * @brief Wire layout of a beam request batch sent through ICommunicationAdapter::sendData
+ *
+ * A RequestBatchHeader followed by request_count RequestRecords, little-endian.
+ */
+constexpr uint32_t REQUEST_MAGIC = 0x51524252;  // "RBRQ"
+constexpr uint16_t REQUEST_VERSION = 1;
+
+#pragma pack(push, 1)
+
+struct RequestBatchHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t request_count;
+    int64_t slot_start_ns;
+};
+
+struct RequestRecord {
+    uint32_t beam_id;
+    uint32_t track_id;
+    double azimuth;          ///< Radians, atan2(y, x)
+    double elevation;        ///< Radians
+    double dwell_time_ms;
+    int64_t request_time_ns; ///< Scheduled dwell start
+};
+
+#pragma pack(pop)
+
+}  // namespace beam
+
+/**
+ * @brief Revisit scheduler for dedicated track beams (BEAM_REQUEST mode)
+ *
+ * Each track gets a revisit deadline: the time at which its predicted
+ * position standard deviation (largest axis, including white-noise
+ * acceleration growth) reaches position_std_m, shortened for low quality
+ * and tentative tracks and clamped to [min_revisit_s, max_revisit_s].
+ * Pending requests live in an indexed priority queue keyed by track id, so
+ * a track update or removal costs O(log n). scheduleSlot() packs the most
+ * urgent due requests (earliest deadline first) back to back into one
+ * timeline slot until the slot's dwell budget is spent; a track that was
+ * looked at is re-queued for a reacquisition look after min_revisit_s,
+ * which its next update replaces.
+ */
+class BeamScheduler {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+
+    /**
+     * @brief Configuration (beam_scheduler section)
+     */
+    struct Config {
+        double slot_ms = 10.0;               ///< Timeline slot length
+        double occupancy = 0.8;              ///< Fraction of a slot available for track dwells
+        double dwell_time_ms = 1.0;          ///< Dwell at reference_range_m
+        double min_dwell_time_ms = 0.25;
+        double max_dwell_time_ms = 4.0;
+        double reference_range_m = 50000.0;  ///< Dwell scales with (range / reference)^4
+        double position_std_m = 150.0;       ///< Revisit when the predicted position std reaches this
+        double process_noise = 1.0;          ///< White-noise acceleration density (m^2/s^3)
+        double min_revisit_s = 0.05;
+        double max_revisit_s = 4.0;
+        double quality_weight = 0.5;         ///< Revisit interval scale at zero quality is 1 - weight
+        double tentative_factor = 0.5;       ///< Revisit interval scale for tentative tracks
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    struct Stats {
+        uint64_t slots = 0;
+        uint64_t requests = 0;
+        uint64_t late_requests = 0;     ///< Dwell started after the track's deadline
+        uint64_t deferred = 0;          ///< Due requests left for a later slot (budget spent)
+        double budget_used_ms = 0.0;
+    };
+
+private:
+    struct TrackEntry {
+        TimePoint valid_time;
+        Point3D position;
+        Point3D velocity;
+        Point3D acceleration;
+        TimePoint last_dwell;
+        bool dwelt = false;
+    };
+
+    Config config_;
+    Stats stats_;
+    IndexedPriorityQueue<TimePoint> queue_;      ///< Revisit deadline per track id
+    std::unordered_map<uint32_t, TrackEntry> tracks_;
+    uint32_t next_beam_id_ = 1;
+
+public:
+    BeamScheduler() = default;
+    explicit BeamScheduler(const Config& config) : config_(config) {}
+
+    const Config& getConfig() const { return config_; }
+    void setConfig(const Config& config) { config_ = config; }
+    const Stats& getStats() const { return stats_; }
+
+    size_t pendingCount() const { return queue_.size(); }
+
+    /**
+     * @brief Add or refresh one track after its state changed, O(log n)
+     *
+     * Terminated tracks are removed.
+     */
+    void updateTrack(const Track& track);
+
+    /**
+     * @brief Drop a track's pending request
+     */
+    void removeTrack(uint32_t track_id);
+
+    /**
+     * @brief Refresh from the full track list, removing tracks not in it
+     */
+    void updateTracks(const std::vector<Track>& tracks);
+
+    /**
+     * @brief Deadline of a track's pending request; the track must be queued
+     */
+    TimePoint getDeadline(uint32_t track_id) const { return queue_.priority(track_id); }
+
+    /**
+     * @brief Pack due requests into the slot starting at slot_start
+     * @return Requests in dwell order, each with its dwell start as request_time
+     */
+    std::vector<BeamRequest> scheduleSlot(TimePoint slot_start);
+
+    /**
+     * @brief Revisit interval of a track from its covariance growth and quality
+     */
+    double revisitInterval(const Track& track) const;
+
+    /**
+     * @brief Serialize a slot's requests (beam::RequestBatchHeader + records)
+     */
+    static std::vector<uint8_t> encode(const std::vector<BeamRequest>& requests, TimePoint slot_start);
+
+    /**
+     * @brief Send a slot's requests to the radar
+     * @return true if sent (or nothing to send)
+     */
+    static bool dispatch(ICommunicationAdapter& adapter, const std::vector<BeamRequest>& requests,
+                         TimePoint slot_start);
+
+private:
+    double dwellTime(double range) const;
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,213 @@
+#pragma once
+#include "management/TrackManager.hpp"
+#include "processing/ScanPipeline.hpp"
+#include "utils/CheckpointFormat.hpp"
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Periodic checkpoints of the tracker state and warm start from them
+ *
+ * Every interval_s the tracking thread calls capture() between scans. That
+ * only copies the tracks, ID counters, the pipeline's per-track filter state
+ * (IMM mode states, square-root factors) and its association context (OOSM
+ * replay windows) into a spare TrackerCheckpoint; the two checkpoint buffers
+ * are then swapped, so the copy is all the tracking thread pays. A writer
+ * thread encodes the checkpoint (checkpoint::FileHeader layout), writes it
+ * to checkpoint.tmp, optionally fsyncs it and renames it over
+ * checkpoint.bin, keeping the previous one as checkpoint.prev. A capture
+ * that comes due while the previous checkpoint is still being written is
+ * skipped, never queued.
+ *
+ * warmStart() loads the newest valid checkpoint (falling back to
+ * checkpoint.prev if the latest is torn) and restores it into the
+ * TrackManager and the scan pipeline, so confirmed tracks keep their IDs and
+ * state instead of re-confirming. Checkpoints older than max_age_s are
+ * ignored.
+ *
+ * Handover mode supports a hot standby on the same host: the primary holds
+ * an exclusive lock on <directory>/primary.lock (PrimaryLock) for its
+ * lifetime and writes a final checkpoint on shutdown (writeFinal()); a
+ * process started with --standby waits for that lock and then warm-starts
+ * from the primary's last checkpoint. With directory on a tmpfs and a short
+ * interval, a crashed primary loses at most interval_s of state.
+ */
+class TrackCheckpointer {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+
+    /**
+     * @brief Configuration (checkpoint section)
+     */
+    struct Config {
+        bool enabled = false;
+        std::string directory = "/var/lib/radar_tracking/checkpoint";
+        double interval_s = 1.0;
+        double max_age_s = 30.0;           ///< Older checkpoints are not restored
+        bool sync = true;                  ///< fsync before the rename (not needed on a tmpfs)
+        bool handover = false;             ///< Hot standby: primary lock and final checkpoint
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+
+        std::string checkpointPath() const { return directory + "/checkpoint.bin"; }
+        std::string previousPath() const { return directory + "/checkpoint.prev"; }
+        std::string lockPath() const { return directory + "/primary.lock"; }
+    };
+
+    struct Stats {
+        uint64_t checkpoints_written = 0;
+        uint64_t captures_skipped = 0;     ///< Writer still busy with the previous checkpoint
+        uint64_t write_failures = 0;
+        uint64_t last_bytes = 0;
+        double last_capture_ms = 0.0;      ///< Tracking thread time of the last capture
+        double last_write_ms = 0.0;        ///< Encode and write time on the writer thread
+        uint64_t restored_tracks = 0;
+        double restore_ms = 0.0;
+    };
+
+private:
+    Config config_;
+    std::thread writer_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    bool pending_ = false;                 ///< write_ is owned by the writer until cleared
+
+    TrackerCheckpoint capture_;            ///< Filled by the tracking thread
+    TrackerCheckpoint write_;              ///< Being written
+    std::vector<uint8_t> buffer_;          ///< Encoded file, writer thread only
+    uint64_t sequence_ = 0;
+    TimePoint next_capture_{};
+
+    std::atomic<uint64_t> checkpoints_written_{0};
+    std::atomic<uint64_t> captures_skipped_{0};
+    std::atomic<uint64_t> write_failures_{0};
+    std::atomic<uint64_t> last_bytes_{0};
+    std::atomic<double> last_capture_ms_{0.0};
+    std::atomic<double> last_write_ms_{0.0};
+    std::atomic<uint64_t> restored_tracks_{0};
+    std::atomic<double> restore_ms_{0.0};
+
+public:
+    TrackCheckpointer() = default;
+    ~TrackCheckpointer();
+
+    TrackCheckpointer(const TrackCheckpointer&) = delete;
+    TrackCheckpointer& operator=(const TrackCheckpointer&) = delete;
+
+    bool initialize(const std::string& config_file);
+
+    /**
+     * @brief Apply a configuration and start the writer thread
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Finish the checkpoint being written and stop the writer
+     */
+    void shutdown();
+
+    bool isEnabled() const { return config_.enabled; }
+
+    /**
+     * @brief Whether interval_s has passed since the last capture
+     */
+    bool isDue(TimePoint now) const { return config_.enabled && now >= next_capture_; }
+
+    /**
+     * @brief Capture the tracker state and hand it to the writer thread
+     *
+     * Call on the tracking thread between scans.
+     *
+     * @param pipeline Scan pipeline whose filter state is captured (may be nullptr)
+     * @return false if skipped because the previous checkpoint is still being written
+     */
+    bool capture(const TrackManager& tracks, ScanPipeline* pipeline, TimePoint now);
+
+    /**
+     * @brief Capture and write a checkpoint synchronously, flagged as a handover
+     *
+     * For a planned shutdown or switchover to the standby; call after the
+     * tracking thread has stopped and before releasing the PrimaryLock.
+     */
+    bool writeFinal(const TrackManager& tracks, ScanPipeline* pipeline);
+
+    /**
+     * @brief Restore the newest valid checkpoint
+     * @return false if there is none (or it is too old): cold start
+     */
+    bool warmStart(TrackManager& tracks, ScanPipeline* pipeline);
+
+    const Config& getConfig() const { return config_; }
+    Stats getStats() const;
+
+    /**
+     * @brief Encode a checkpoint into the file layout
+     */
+    static void encode(const TrackerCheckpoint& checkpoint, std::vector<uint8_t>& out);
+
+    /**
+     * @brief Decode and verify a checkpoint file image
+     * @return false if the image is truncated, corrupt or of another format version
+     */
+    static bool decode(const uint8_t* data, size_t size, TrackerCheckpoint& checkpoint);
+
+    /**
+     * @brief Read and decode a checkpoint file
+     */
+    static bool load(const std::string& path, TrackerCheckpoint& checkpoint);
+
+private:
+    void fill(const TrackManager& tracks, ScanPipeline* pipeline, TimePoint now, TrackerCheckpoint& checkpoint);
+    bool write(const TrackerCheckpoint& checkpoint);
+    void writerLoop();
+};
+
+/**
+ * @brief Exclusive, process-lifetime lock marking the primary instance
+ *
+ * Held with flock(), so the kernel releases it when the primary exits or
+ * crashes and a waiting standby takes over immediately. POSIX only; on
+ * other platforms acquire() always succeeds.
+ */
+class PrimaryLock {
+private:
+    int fd_ = -1;
+
+public:
+    PrimaryLock() = default;
+    ~PrimaryLock();
+
+    PrimaryLock(const PrimaryLock&) = delete;
+    PrimaryLock& operator=(const PrimaryLock&) = delete;
+
+    /**
+     * @brief Take the lock, creating the file if needed
+     * @param keep_waiting Polled while another process holds the lock; empty: try once
+     * @return true once held
+     */
+    bool acquire(const std::string& path, const std::function<bool()>& keep_waiting = {});
+
+    void release();
+
+    bool isHeld() const { return fd_ >= 0; }
+};
+
+}  // namespace radar_tracking
@@ -1,5 +1,7 @@
 #pragma once
 #include "core/DataTypes.hpp"
+#include "utils/CheckpointFormat.hpp"
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <memory>
@@ -113,6 +115,43 @@ public:
      * @return true if track should be deleted
      */
     bool shouldDeleteTrack(const Track& track) const;
+    
+    /**
+     * @brief Copy all tracks and the ID and statistics counters into a checkpoint
+     * @param checkpoint Destination; its track vector is reused
+     */
+    void exportState(TrackerCheckpoint& checkpoint) const {
+        std::lock_guard<std::mutex> lock(tracks_mutex_);
+        checkpoint.tracks.clear();
+        checkpoint.tracks.reserve(tracks_.size());
+        for (const auto& entry : tracks_) {
+            checkpoint.tracks.push_back(entry.second);
+        }
+        checkpoint.next_track_id = next_track_id_.load();
+        checkpoint.total_tracks_created = total_tracks_created_.load();
+        checkpoint.total_tracks_deleted = total_tracks_deleted_.load();
+        checkpoint.tracks_confirmed = tracks_confirmed_.load();
+    }
+    
+    /**
+     * @brief Replace all tracks and counters with a checkpoint's (warm start)
+     *
+     * New track IDs continue after the restored ones, so IDs stay unique
+     * across the restart.
+     */
+    void importState(const TrackerCheckpoint& checkpoint) {
+        std::lock_guard<std::mutex> lock(tracks_mutex_);
+        tracks_.clear();
+        uint32_t next_id = checkpoint.next_track_id;
+        for (const auto& track : checkpoint.tracks) {
+            tracks_[track.track_id] = track;
+            next_id = std::max(next_id, track.track_id + 1);
+        }
+        next_track_id_ = next_id;
+        total_tracks_created_ = checkpoint.total_tracks_created;
+        total_tracks_deleted_ = checkpoint.total_tracks_deleted;
+        tracks_confirmed_ = checkpoint.tracks_confirmed;
+    }
 
 private:
     void updateTrackState(Track& track);
@@ -0,0 +1,185 @@
+#pragma once
+#include "communication/ShardProtocol.hpp"
+#include "core/DataTypes.hpp"
+#include <yaml-cpp/yaml.h>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Track-to-track association across shards into one picture
+ *
+ * Each shard worker reports its whole track picture; the merger keeps the
+ * latest one per shard and, on merge(), extrapolates every track to a common
+ * time at constant velocity. Interior tracks of a geographically bounded
+ * shard are owned by that shard alone and pass straight through. Tracks the
+ * worker flagged as near or beyond its region edge, and all tracks of
+ * unbounded (per-radar) shards, are associated: candidate pairs from
+ * different shards come from a uniform grid of max_gate_distance_m cells,
+ * are gated on the 3D Mahalanobis distance with the summed position
+ * covariances, and are joined greedily, best pair first, into groups holding
+ * at most one track per shard. Pairs already sharing a global id are joined
+ * first so an established correspondence is not re-decided every frame.
+ *
+ * Every group is one output track under a global id that survives worker
+ * id changes and handovers. Its representative is the member reported by
+ * the shard whose region contains the track, or else the most certain one.
+ * When a track's owner region changes, the new owner is sent a handover
+ * (see takeHandovers()) unless it already reports the track itself.
+ *
+ * Not thread-safe; the merge stage drives it from its event loop.
+ */
+class TrackMerger {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+
+    /**
+     * @brief Configuration (sharding.merge section)
+     */
+    struct Config {
+        double gate_chi2 = 11.34;             ///< Chi-square gate, 3 DOF (99%)
+        double max_gate_distance_m = 500.0;   ///< Euclidean pre-gate and grid cell size
+        double min_position_variance = 25.0;  ///< Per-axis floor (m^2) against overconfident workers
+        double velocity_std_mps = 5.0;        ///< Position uncertainty growth while extrapolating
+        double shard_timeout_s = 2.0;         ///< A silent shard's picture is dropped after this
+        bool confirmed_only = true;           ///< Leave tentative tracks out of the picture
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    /**
+     * @brief A track that entered a shard's region, to be seeded there
+     */
+    struct Handover {
+        uint32_t shard_id;
+        shard_wire::TrackRecord record;      ///< Extrapolated state, global_id set
+    };
+
+    struct Stats {
+        uint64_t merges = 0;
+        uint64_t input_tracks = 0;
+        uint64_t output_tracks = 0;
+        uint64_t candidate_pairs = 0;        ///< Pairs inside the Euclidean pre-gate
+        uint64_t associated_pairs = 0;       ///< Pairs joined into a group
+        uint64_t duplicates_removed = 0;
+        uint64_t handovers = 0;              ///< Owner region changes
+        uint64_t global_ids_created = 0;
+        uint64_t global_ids_merged = 0;      ///< Two global ids found to be one target
+    };
+
+    static constexpr uint32_t MAX_SHARDS = 64;
+
+private:
+    struct ShardState {
+        bool connected = false;
+        ShardRegion region;
+        std::vector<shard_wire::TrackRecord> records;
+        TimePoint received{};
+    };
+
+    struct Entry {
+        uint32_t shard;
+        uint32_t record;
+        uint32_t bound_global;               ///< 0 if not seen before
+        bool associable;
+        Point3D position;                    ///< Extrapolated to the merge time
+        double covariance[6];                ///< Extrapolated, xx xy xz yy yz zz
+    };
+
+    struct Pair {
+        uint32_t a;
+        uint32_t b;
+        double distance2;
+        bool same_global;
+    };
+
+    struct Global {
+        uint32_t owner_shard;
+        TimePoint last_seen;
+        uint64_t last_merge;                 ///< Claimed by a group in this merge
+    };
+
+    struct Binding {
+        uint32_t global_id;
+        TimePoint last_seen;
+    };
+
+    Config config_;
+    Stats stats_;
+    std::vector<ShardState> shards_;                    ///< Indexed by shard id
+    std::unordered_map<uint64_t, Binding> bindings_;    ///< (shard << 32 | worker track id) -> global id
+    std::unordered_map<uint32_t, Global> globals_;
+    uint32_t next_global_id_ = 1;
+
+    std::vector<Track> output_;
+    std::vector<Handover> handovers_;
+
+    // Scratch, reused across merges
+    std::vector<Entry> entries_;
+    std::vector<std::pair<uint64_t, uint32_t>> grid_;  ///< (cell key, entry) sorted by cell
+    std::vector<Pair> pairs_;
+    std::vector<uint32_t> parent_;
+    std::vector<uint64_t> shard_mask_;
+    std::vector<uint32_t> roots_;
+    std::vector<uint32_t> group_start_;
+    std::vector<uint32_t> group_members_;
+
+public:
+    TrackMerger() = default;
+    explicit TrackMerger(const Config& config) : config_(config) {}
+
+    const Config& getConfig() const { return config_; }
+    void setConfig(const Config& config) { config_ = config; }
+    const Stats& getStats() const { return stats_; }
+
+    /**
+     * @brief Declare a shard and the region it owns; shard_id < MAX_SHARDS
+     */
+    void setRegion(uint32_t shard_id, const ShardRegion& region);
+
+    /**
+     * @brief Replace a shard's track picture
+     */
+    void updateShard(uint32_t shard_id, std::vector<shard_wire::TrackRecord>&& records, TimePoint received);
+
+    /**
+     * @brief Drop a shard's picture (worker disconnected)
+     */
+    void removeShard(uint32_t shard_id);
+
+    /**
+     * @brief Associate all shard pictures into one, extrapolated to now
+     * @return Merged tracks, valid until the next call
+     */
+    const std::vector<Track>& merge(TimePoint now);
+
+    /**
+     * @brief Handovers produced by the last merge(); clears them
+     */
+    std::vector<Handover> takeHandovers();
+
+    size_t globalCount() const { return globals_.size(); }
+
+private:
+    void collectEntries(TimePoint now);
+    void findPairs();
+    uint32_t find(uint32_t i);
+    void buildGroups();
+    void emitGroup(const uint32_t* members, size_t count, TimePoint now);
+    double gateDistance2(const Entry& a, const Entry& b) const;
+    int ownerShard(const Point3D& position) const;
+    void prune(TimePoint now);
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,127 @@
+#pragma once
+#include "communication/ShardProtocol.hpp"
+#include "interfaces/IOutputAdapter.hpp"
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Worker-side link from a shard's RadarSystem to the merge stage
+ *
+ * Each publishTracks() call sends the worker's whole track picture, moved
+ * into the common site frame by the shard's origin, as one frame of
+ * shard_wire messages over a SOCK_SEQPACKET Unix socket. Tracks within
+ * boundary_margin_m of the region edge, or outside it, are flagged so the
+ * merge stage associates them with the neighbouring shards' tracks; the
+ * rest are passed through unchanged. A send waits at most send_timeout_ms
+ * for socket buffer space; after that the remainder of the frame is
+ * dropped and the next frame replaces it, so a stalled merge stage cannot
+ * hold up the worker's tracking loop. A lost merge stage is reconnected
+ * every reconnect_interval_s.
+ *
+ * Handovers from the merge stage (tracks entering this shard's region) are
+ * read on each publish and delivered, in the shard's local frame and with
+ * track_id set to the global id, to the handover callback.
+ *
+ * Publishing is single-writer; calls must come from one thread at a time.
+ */
+class ShardLinkAdapter : public IOutputAdapter {
+public:
+    using HandoverCallback = std::function<void(std::vector<Track>&&)>;
+
+    /**
+     * @brief Configuration (sharding section; this shard's entry is picked by shard_id)
+     */
+    struct Config {
+        std::string socket_path = "/tmp/radar_shards/merge.sock";
+        uint32_t shard_id = 0;
+        ShardRegion region;
+        Point3D origin;                       ///< Shard frame origin in the site frame
+        double boundary_margin_m = 1000.0;
+        double reconnect_interval_s = 1.0;
+        uint32_t send_timeout_ms = 20;
+        uint32_t send_buffer_kb = 4096;      ///< SO_SNDBUF request; a frame that fits is sent without waiting
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    struct Stats {
+        uint64_t frames_sent = 0;
+        uint64_t frames_dropped = 0;          ///< Send timed out or merge stage unreachable
+        uint64_t tracks_sent = 0;
+        uint64_t boundary_tracks = 0;
+        uint64_t handovers_received = 0;
+        uint64_t connects = 0;
+    };
+
+private:
+    Config config_;
+    int fd_ = -1;
+    uint64_t frame_seq_ = 0;
+    std::chrono::steady_clock::time_point next_connect_{};
+    HandoverCallback handover_callback_;
+    std::vector<uint8_t> buffer_;             ///< One message, reused
+    std::vector<shard_wire::TrackRecord> records_;
+
+    std::atomic<uint64_t> frames_sent_{0};
+    std::atomic<uint64_t> frames_dropped_{0};
+    std::atomic<uint64_t> tracks_sent_{0};
+    std::atomic<uint64_t> boundary_tracks_{0};
+    std::atomic<uint64_t> handovers_received_{0};
+    std::atomic<uint64_t> connects_{0};
+
+public:
+    ShardLinkAdapter() = default;
+    ~ShardLinkAdapter() override;
+
+    ShardLinkAdapter(const ShardLinkAdapter&) = delete;
+    ShardLinkAdapter& operator=(const ShardLinkAdapter&) = delete;
+
+    // IOutputAdapter interface implementation
+    bool initialize(const std::string& config_file) override;
+    void publishTracks(const std::vector<Track>& tracks) override;
+    void publishDetections(const std::vector<RadarDetection>&) override {}
+    void publishClusters(const std::vector<Cluster>&) override {}
+    void publishStats(const SystemStats&) override {}
+    bool isReady() const override { return fd_ >= 0; }
+    std::string getAdapterType() const override { return "SHARD"; }
+    void flush() override {}
+
+    /**
+     * @brief Apply a parsed configuration and try a first connection
+     *
+     * Succeeds even if the merge stage is not listening yet.
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Receive tracks handed over to this shard; called from publishTracks()
+     */
+    void setHandoverCallback(HandoverCallback callback) { handover_callback_ = std::move(callback); }
+
+    void close();
+
+    const Config& getConfig() const { return config_; }
+    Stats getStats() const;
+
+private:
+    bool connect();
+    bool sendMessage(shard_wire::MessageType type, uint16_t chunk_index, uint16_t chunk_count,
+                     const shard_wire::TrackRecord* records, uint32_t count, int64_t timestamp_ns);
+    void receiveHandovers();
+};
+
+}  // namespace radar_tracking
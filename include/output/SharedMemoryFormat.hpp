@@ -0,0 +1,70 @@
+#pragma once
+#include "utils/RecordingFormat.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace radar_tracking {
+namespace shm {
+
+/**
+ * @brief Layout of the shared-memory output segment
+ *
+ * The segment is a SegmentHeader followed by slot_count slots of slot_size
+ * bytes each. A slot is a SlotHeader plus a frame payload encoded exactly
+ * like a recording frame payload (a uint32 record count followed by
+ * recording::*Record structs), so RecordingReader's decoders apply.
+ *
+ * Frame n is written into slot n % slot_count under a per-slot seqlock: its
+ * sequence word is 2n+1 while the writer fills the slot and 2n+2 once the
+ * frame is complete. SegmentHeader::published is advanced to n+1 after that.
+ * A reader copies the slot and accepts it only if the sequence word read
+ * before and after the copy is 2n+2; anything else means the writer lapped
+ * the reader. Values are host-endian (the segment never leaves the box).
+ */
+
+constexpr uint32_t SEGMENT_MAGIC = 0x4D485352;  // "RSHM"
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t CACHE_LINE = 64;
+
+struct alignas(CACHE_LINE) SegmentHeader {
+    std::atomic<uint32_t> magic;             ///< Stored last; the segment is valid once it reads SEGMENT_MAGIC
+    uint32_t version;
+    uint32_t slot_count;                     ///< Power of two
+    uint32_t slot_size;                      ///< Bytes per slot including its SlotHeader
+    int64_t created_ns;                      ///< Writer start (system clock)
+    uint64_t writer_pid;
+    alignas(CACHE_LINE) std::atomic<uint64_t> published;  ///< Frames completed so far
+};
+
+struct alignas(CACHE_LINE) SlotHeader {
+    std::atomic<uint64_t> sequence;          ///< 0 empty, 2n+1 writing frame n, 2n+2 frame n complete
+    recording::RecordType type;
+    uint16_t reserved;
+    uint32_t payload_size;
+    int64_t timestamp_ns;                    ///< Data time (system clock)
+    int64_t publish_ns;                      ///< Steady clock at publication, for latency measurement
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Shared-memory sequence words must be lock-free to work across processes");
+static_assert(std::is_standard_layout<SegmentHeader>::value, "SegmentHeader must be standard layout");
+static_assert(std::is_standard_layout<SlotHeader>::value, "SlotHeader must be standard layout");
+
+/**
+ * @brief Payload capacity of a slot of slot_size bytes
+ */
+inline size_t slotCapacity(uint32_t slot_size) {
+    return slot_size - sizeof(SlotHeader);
+}
+
+/**
+ * @brief Bytes to map for a segment
+ */
+inline size_t segmentSize(uint32_t slot_count, uint32_t slot_size) {
+    return sizeof(SegmentHeader) + static_cast<size_t>(slot_count) * slot_size;
+}
+
+}  // namespace shm
+}  // namespace radar_tracking
@@ -0,0 +1,108 @@
+#pragma once
+#include "interfaces/IOutputAdapter.hpp"
+#include "output/SharedMemoryFormat.hpp"
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <string>
+
+namespace radar_tracking {
+
+/**
+ * @brief Output adapter publishing frames into a POSIX shared-memory ring
+ *
+ * Every publish call encodes its records straight into the next ring slot
+ * under the slot's seqlock (see SharedMemoryFormat.hpp); nothing is queued,
+ * copied twice or sent through the kernel. Consumers on the same host map
+ * the segment with SharedMemoryReader and poll it without system calls. The
+ * writer never waits for readers: a reader that falls more than slot_count
+ * frames behind loses the overwritten frames and is told how many.
+ *
+ * Publishing is single-writer; calls must come from one thread at a time.
+ */
+class SharedMemoryOutputAdapter : public IOutputAdapter {
+public:
+    /**
+     * @brief Configuration (output.shm section)
+     */
+    struct Config {
+        std::string segment_name = "/radar_tracking_output";  ///< shm_open name
+        uint32_t slot_count = 32;            ///< Ring depth (power of two)
+        uint32_t slot_size_kb = 1024;        ///< Per-slot size; bounds the largest frame
+        bool publish_detections = false;
+        bool publish_clusters = false;
+        bool publish_stats = true;
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    struct Stats {
+        uint64_t frames_published = 0;
+        uint64_t frames_dropped = 0;         ///< Larger than a slot
+        uint64_t bytes_published = 0;
+    };
+
+private:
+    Config config_;
+    int fd_ = -1;
+    uint8_t* segment_ = nullptr;
+    size_t segment_size_ = 0;
+    shm::SegmentHeader* header_ = nullptr;
+    uint64_t next_frame_ = 0;
+
+    std::atomic<uint64_t> frames_published_{0};
+    std::atomic<uint64_t> frames_dropped_{0};
+    std::atomic<uint64_t> bytes_published_{0};
+
+public:
+    SharedMemoryOutputAdapter() = default;
+    ~SharedMemoryOutputAdapter() override;
+
+    SharedMemoryOutputAdapter(const SharedMemoryOutputAdapter&) = delete;
+    SharedMemoryOutputAdapter& operator=(const SharedMemoryOutputAdapter&) = delete;
+
+    // IOutputAdapter interface implementation
+    bool initialize(const std::string& config_file) override;
+    void publishTracks(const std::vector<Track>& tracks) override;
+    void publishDetections(const std::vector<RadarDetection>& detections) override;
+    void publishClusters(const std::vector<Cluster>& clusters) override;
+    void publishStats(const SystemStats& stats) override;
+    bool isReady() const override { return header_ != nullptr; }
+    std::string getAdapterType() const override { return "SHM"; }
+    void flush() override {}
+
+    /**
+     * @brief Create (or recreate) the segment from a parsed configuration
+     *
+     * An existing segment of the same name is unlinked first, so readers of
+     * a previous writer keep their old mapping and must reopen.
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Unmap and unlink the segment
+     */
+    void close();
+
+    const Config& getConfig() const { return config_; }
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Start frame next_frame_ in its slot
+     * @return Payload area, or nullptr if payload_size does not fit a slot
+     */
+    uint8_t* beginFrame(recording::RecordType type, size_t payload_size, int64_t timestamp_ns);
+    void commitFrame(size_t payload_size);
+
+    shm::SlotHeader* slot(uint64_t frame) const;
+};
+
+}  // namespace radar_tracking
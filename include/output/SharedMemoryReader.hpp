@@ -0,0 +1,133 @@
+#pragma once
+#include "output/SharedMemoryFormat.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Consumer side of SharedMemoryOutputAdapter
+ *
+ * Maps the writer's segment read-only and polls it; after open() no call
+ * enters the kernel. Each reader keeps its own position, so any number of
+ * processes can attach at any time without the writer knowing about them.
+ * A reader that falls behind by more than the ring depth skips ahead to the
+ * oldest frame still intact and counts what it missed. A restarted writer
+ * creates a new segment; a reader that sees the ring go quiet reopens it.
+ *
+ * Depends only on SharedMemoryFormat.hpp and RecordingFormat.hpp, so
+ * consumers can link the radar_shm_reader library without the tracker core.
+ */
+class SharedMemoryReader {
+public:
+    /**
+     * @brief Where a newly opened reader starts
+     */
+    enum class StartPosition {
+        LATEST,      ///< Most recently completed frame (late joiners get the current picture)
+        NEXT,        ///< First frame published after open()
+        OLDEST       ///< Oldest frame still in the ring
+    };
+
+    enum class PollResult {
+        FRAME,       ///< A frame was copied out
+        EMPTY,       ///< Nothing new since the last frame
+        NOT_OPEN
+    };
+
+    /**
+     * @brief A frame copied out of the ring
+     */
+    struct Frame {
+        recording::RecordType type = recording::RecordType::RAW;
+        uint64_t sequence = 0;              ///< Writer's frame number
+        int64_t timestamp_ns = 0;           ///< Data time (system clock)
+        int64_t publish_ns = 0;             ///< Steady clock at publication
+        std::vector<uint8_t> payload;       ///< Same encoding as a recording frame payload
+
+        /**
+         * @brief Leading record count of a DETECTIONS, CLUSTERS or TRACKS payload
+         */
+        uint32_t count() const {
+            uint32_t value = 0;
+            if (payload.size() >= sizeof(value)) {
+                std::memcpy(&value, payload.data(), sizeof(value));
+            }
+            return value;
+        }
+
+        /**
+         * @brief Copy fixed-size records (TrackRecord, DetectionRecord) following the count
+         */
+        template<typename Record>
+        std::vector<Record> records() const {
+            std::vector<Record> out;
+            if (payload.size() < sizeof(uint32_t)) {
+                return out;
+            }
+            const size_t available = (payload.size() - sizeof(uint32_t)) / sizeof(Record);
+            out.resize(std::min<size_t>(count(), available));
+            std::memcpy(out.data(), payload.data() + sizeof(uint32_t), out.size() * sizeof(Record));
+            return out;
+        }
+    };
+
+private:
+    int fd_ = -1;
+    const uint8_t* segment_ = nullptr;
+    size_t segment_size_ = 0;
+    const shm::SegmentHeader* header_ = nullptr;
+    uint64_t next_frame_ = 0;
+    uint64_t frames_read_ = 0;
+    uint64_t frames_missed_ = 0;
+    std::string error_;
+
+public:
+    SharedMemoryReader() = default;
+    ~SharedMemoryReader();
+
+    SharedMemoryReader(const SharedMemoryReader&) = delete;
+    SharedMemoryReader& operator=(const SharedMemoryReader&) = delete;
+
+    /**
+     * @brief Map a segment published by SharedMemoryOutputAdapter
+     * @param segment_name shm_open name, e.g. "/radar_tracking_output"
+     * @return false if the segment does not exist or is not a valid ring (see getLastError())
+     */
+    bool open(const std::string& segment_name, StartPosition start = StartPosition::LATEST);
+
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+
+    /**
+     * @brief Copy out the next frame, if any; never blocks or enters the kernel
+     */
+    PollResult poll(Frame& frame);
+
+    /**
+     * @brief Skip everything up to the most recently completed frame
+     */
+    void seekLatest();
+
+    /**
+     * @brief Frames published by the writer so far
+     */
+    uint64_t getPublishedCount() const;
+
+    /**
+     * @brief Start time of the writer that created the mapped segment
+     */
+    int64_t getCreatedTime() const { return header_ ? header_->created_ns : 0; }
+
+    uint64_t getFramesRead() const { return frames_read_; }
+    uint64_t getFramesMissed() const { return frames_missed_; }
+    const std::string& getLastError() const { return error_; }
+
+private:
+    const shm::SlotHeader* slot(uint64_t frame) const;
+};
+
+}  // namespace radar_tracking
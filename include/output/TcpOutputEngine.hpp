@@ -0,0 +1,188 @@
+#pragma once
+#include "interfaces/IOutputAdapter.hpp"
+#include "utils/BufferPool.hpp"
+#include "utils/LockFreeQueue.hpp"
+#include "utils/RecordingFormat.hpp"
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Non-blocking TCP output server for the fusion link
+ *
+ * Publishing serializes a frame (recording::FrameHeader plus the recording
+ * payload encoding) into a pooled, reference-counted buffer and hands it to
+ * the engine's epoll thread through a lock-free queue. The call never blocks
+ * and never allocates once the pool has warmed up. If no buffer or queue slot
+ * is free the frame is dropped and counted, so tracking is never stalled by
+ * the network.
+ *
+ * The epoll thread accepts any number of clients up to max_clients. It
+ * queues a reference to each frame in every client's bounded send queue and
+ * sends queued frames with gathered sendmsg calls (writev semantics, one
+ * call per up to 64 frames). MSG_MORE is set while more data is queued, which
+ * corks partial segments, and MSG_ZEROCOPY is used for large batches where
+ * the kernel supports it. Zero-copy buffers stay referenced until the
+ * kernel's completion notification. A client whose queue is full either
+ * loses its oldest unsent frame or is disconnected, per slow_client_policy;
+ * the other clients are unaffected.
+ */
+class TcpOutputEngine : public IOutputAdapter {
+public:
+    enum class SlowClientPolicy {
+        DROP_OLDEST,    ///< Discard the oldest frame not yet started
+        DISCONNECT      ///< Close the connection
+    };
+
+    /**
+     * @brief Configuration (output.fusion section)
+     */
+    struct Config {
+        std::string host = "0.0.0.0";              ///< Listen address
+        uint16_t port = 9091;
+        uint32_t max_clients = 8;
+        uint32_t client_queue_frames = 16;         ///< Per-client send queue bound
+        SlowClientPolicy slow_client_policy = SlowClientPolicy::DROP_OLDEST;
+        uint32_t buffer_count = 64;                ///< Pooled frame buffers
+        uint32_t buffer_size_kb = 256;             ///< Initial capacity of each buffer (grows on demand)
+        uint32_t submit_queue_frames = 32;         ///< Publisher to epoll thread hand-off (power of two)
+        bool zerocopy = true;                      ///< MSG_ZEROCOPY where supported
+        uint32_t zerocopy_min_bytes = 16384;       ///< Smaller batches are copied (cheaper below ~10 KB)
+        bool publish_detections = false;
+        bool publish_clusters = false;
+        bool publish_stats = true;
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    struct Stats {
+        uint64_t frames_submitted = 0;
+        uint64_t frames_dropped_pool = 0;     ///< No free buffer
+        uint64_t frames_dropped_queue = 0;    ///< Hand-off queue full
+        uint64_t frames_dropped_slow = 0;     ///< Discarded from a slow client's queue
+        uint64_t clients_accepted = 0;
+        uint64_t clients_rejected = 0;        ///< Over max_clients
+        uint64_t clients_disconnected_slow = 0;
+        uint64_t send_calls = 0;
+        uint64_t bytes_sent = 0;
+        uint64_t zerocopy_sends = 0;
+        uint64_t zerocopy_copied = 0;         ///< Kernel fell back to copying
+        size_t clients = 0;
+    };
+
+private:
+    struct ZeroCopyBatch {
+        uint32_t id;                          ///< Kernel's per-socket zero-copy send counter
+        std::vector<BufferPool::Ref> buffers;
+    };
+
+    struct Client {
+        int fd = -1;
+        std::string peer;
+        std::deque<BufferPool::Ref> queue;
+        size_t offset = 0;                    ///< Bytes of queue.front() already sent
+        bool want_write = false;              ///< EPOLLOUT registered
+        bool zerocopy = false;
+        uint32_t zerocopy_next = 0;
+        std::deque<ZeroCopyBatch> zerocopy_inflight;
+    };
+
+    Config config_;
+    std::unique_ptr<BufferPool> pool_;
+    std::unique_ptr<LockFreeQueue<BufferPool::Ref>> submit_queue_;
+    int listen_fd_ = -1;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> wake_pending_{false};
+    std::thread loop_thread_;
+    std::unordered_map<int, Client> clients_;        ///< Epoll thread only
+
+    std::atomic<uint64_t> frames_submitted_{0};
+    std::atomic<uint64_t> frames_dropped_pool_{0};
+    std::atomic<uint64_t> frames_dropped_queue_{0};
+    std::atomic<uint64_t> frames_dropped_slow_{0};
+    std::atomic<uint64_t> clients_accepted_{0};
+    std::atomic<uint64_t> clients_rejected_{0};
+    std::atomic<uint64_t> clients_disconnected_slow_{0};
+    std::atomic<uint64_t> send_calls_{0};
+    std::atomic<uint64_t> bytes_sent_{0};
+    std::atomic<uint64_t> zerocopy_sends_{0};
+    std::atomic<uint64_t> zerocopy_copied_{0};
+    std::atomic<size_t> client_count_{0};
+
+public:
+    TcpOutputEngine() = default;
+    ~TcpOutputEngine() override;
+
+    TcpOutputEngine(const TcpOutputEngine&) = delete;
+    TcpOutputEngine& operator=(const TcpOutputEngine&) = delete;
+
+    // IOutputAdapter interface implementation
+    bool initialize(const std::string& config_file) override;
+    void publishTracks(const std::vector<Track>& tracks) override;
+    void publishDetections(const std::vector<RadarDetection>& detections) override;
+    void publishClusters(const std::vector<Cluster>& clusters) override;
+    void publishStats(const SystemStats& stats) override;
+    bool isReady() const override { return running_.load(std::memory_order_acquire); }
+    std::string getAdapterType() const override { return "TCP"; }
+    void flush() override {}
+
+    /**
+     * @brief Listen and start the epoll thread
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Stop the epoll thread and close every connection
+     */
+    void stop();
+
+    /**
+     * @brief Publish an already serialized payload (e.g. a TrackPublisher frame)
+     * @return false if the frame was dropped
+     */
+    bool publishFrame(recording::RecordType type, const uint8_t* payload, size_t size);
+
+    /**
+     * @brief Bound port (useful with port 0)
+     */
+    uint16_t getPort() const;
+
+    const Config& getConfig() const { return config_; }
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Start a frame in a pooled buffer with payload_size bytes after the header
+     * @return Payload area, or nullptr if no buffer is free (frame is counted as dropped)
+     */
+    uint8_t* beginFrame(BufferPool::Ref& buffer, recording::RecordType type, size_t payload_size);
+    bool submit(BufferPool::Ref& buffer);
+
+    void run();
+    void drainSubmissions();
+    void acceptClients();
+    void enqueue(Client& client, const BufferPool::Ref& frame);
+    bool flushClient(Client& client);
+    bool drainZeroCopyCompletions(Client& client);
+    void updateInterest(Client& client, bool want_write);
+    void disconnect(int fd, const char* reason);
+};
+
+}  // namespace radar_tracking
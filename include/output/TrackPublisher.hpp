@@ -0,0 +1,288 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include <yaml-cpp/yaml.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace radar_tracking {
+
+namespace track_delta {
+
+/**
+ * @brief Wire layout of a delta-encoded track frame
+ *
+ * A FrameHeader, then removal_count uint32 track ids, then update_count
+ * track updates. An update is a TrackUpdateHeader followed by the field
+ * groups named in its mask, in mask bit order. Field values are absolute
+ * quantized values, not differences, so a frame built against baseline B
+ * applies to any receiver state at or after B. A keyframe (baseline 0)
+ * carries every field of every live track and no removals. Little-endian.
+ */
+constexpr uint32_t FRAME_MAGIC = 0x4C445452;  // "RTDL"
+constexpr uint16_t FORMAT_VERSION = 1;
+
+enum FrameFlags : uint16_t {
+    FRAME_FLAG_NONE = 0,
+    FRAME_FLAG_KEYFRAME = 1 << 0
+};
+
+enum FieldMask : uint8_t {
+    FIELD_POSITION = 1 << 0,     ///< PositionField
+    FIELD_VELOCITY = 1 << 1,     ///< VelocityField
+    FIELD_STATUS = 1 << 2,       ///< StatusField
+    FIELD_COVARIANCE = 1 << 3,   ///< CovarianceField (formats with include_covariance)
+    FIELD_ALL = 0x0F
+};
+
+constexpr int FIELD_GROUPS = 4;
+
+#pragma pack(push, 1)
+
+struct FrameHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    uint64_t frame_seq;
+    uint64_t baseline_seq;       ///< 0 for keyframes
+    int64_t timestamp_ns;
+    float position_resolution_m;
+    float velocity_resolution_mps;
+    uint32_t removal_count;
+    uint32_t update_count;
+};
+
+struct TrackUpdateHeader {
+    uint32_t track_id;
+    uint8_t fields;              ///< FieldMask bits present
+};
+
+struct PositionField {
+    int32_t position[3];         ///< Units of position_resolution_m
+};
+
+struct VelocityField {
+    int32_t velocity[3];         ///< Units of velocity_resolution_mps
+};
+
+struct StatusField {
+    uint8_t state;               ///< TrackState
+    uint8_t confidence;          ///< [0, 1] in 1/255 steps
+    uint8_t quality;             ///< [0, 1] in 1/255 steps
+};
+
+struct CovarianceField {
+    uint16_t position_std[3];    ///< Units of position_resolution_m, saturating
+};
+
+#pragma pack(pop)
+
+}  // namespace track_delta
+
+/**
+ * @brief Delta-encoding track publication layer with per-subscriber rates
+ *
+ * Subscribers share an encoding state when they ask for the same format
+ * (resolutions and covariance). Each format keeps the quantized value of
+ * every live track together with the frame at which each field group last
+ * changed, and a most-recently-changed list; a track whose quantized values
+ * are unchanged costs one comparison per ingested frame and nothing on the
+ * wire. Encoding a frame against a baseline walks that list only as far as
+ * the baseline, so the work and the bytes follow track churn rather than
+ * the track count.
+ *
+ * A subscriber is sent a frame at most every 1 / update_rate_hz; what
+ * changed in between is coalesced because a delta always carries the
+ * latest values of everything changed since the baseline. The baseline is
+ * the last frame the subscriber acknowledged, or, for subscribers that do
+ * not acknowledge, the last frame handed to their sink. Keyframes are sent
+ * at the first frame, every keyframe_interval_s, and whenever the baseline
+ * is older than the retained removal history. Each distinct (format,
+ * baseline) frame is serialized once and the same buffer is handed to every
+ * subscriber that needs it.
+ *
+ * All methods may be called from any thread; they are serialized internally.
+ */
+class TrackPublisher {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+    using Buffer = std::shared_ptr<const std::vector<uint8_t>>;
+    using Sink = std::function<bool(const Buffer& frame)>;
+
+    /**
+     * @brief Per-subscriber settings (an output.<name> section)
+     */
+    struct SubscriberConfig {
+        std::string name;
+        double update_rate_hz = 10.0;              ///< <= 0 sends every published frame
+        double position_resolution_m = 1.0;
+        double velocity_resolution_mps = 0.1;
+        bool include_covariance = false;
+        double keyframe_interval_s = 5.0;
+        bool acknowledged = false;                 ///< Baseline advances only on acknowledge()
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    /**
+     * @brief Publisher settings (output.publisher section)
+     */
+    struct Config {
+        uint32_t removal_history_entries = 1024;   ///< Track removals kept; baselines before the oldest get a keyframe
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+    };
+
+    struct Stats {
+        uint64_t frames = 0;                 ///< publish() calls
+        uint64_t ingests = 0;                ///< Format states brought up to date
+        uint64_t encodes = 0;                ///< Distinct frames serialized
+        uint64_t keyframes_sent = 0;
+        uint64_t deltas_sent = 0;
+        uint64_t bytes_sent = 0;
+        uint64_t send_failures = 0;
+    };
+
+private:
+    struct Quantized {
+        int32_t position[3];
+        int32_t velocity[3];
+        uint8_t state;
+        uint8_t confidence;
+        uint8_t quality;
+        uint16_t position_std[3];
+    };
+
+    struct TrackEntry {
+        Quantized value;
+        uint64_t field_seq[track_delta::FIELD_GROUPS];  ///< Frame of each group's last change
+        uint64_t changed_seq = 0;                        ///< Max of field_seq
+        uint64_t seen_seq = 0;
+        std::list<uint32_t>::iterator recency;
+    };
+
+    struct FormatState {
+        double position_resolution_m;
+        double velocity_resolution_mps;
+        bool include_covariance;
+        uint64_t ingested_seq = 0;
+        std::unordered_map<uint32_t, TrackEntry> tracks;
+        std::list<uint32_t> recency;                     ///< Track ids, most recently changed first
+        std::deque<std::pair<uint64_t, uint32_t>> removals;  ///< (frame, track id), oldest first
+        uint64_t history_start = 0;                      ///< Removals after this frame are retained
+        std::unordered_map<uint64_t, Buffer> encoded;    ///< This frame's buffers by baseline
+    };
+
+    struct Subscriber {
+        uint32_t id;
+        SubscriberConfig config;
+        Sink sink;
+        size_t format;
+        uint64_t baseline_seq = 0;
+        uint64_t acked_seq = 0;
+        bool sent = false;
+        TimePoint last_sent;
+        TimePoint last_keyframe;
+        uint64_t bytes_sent = 0;
+    };
+
+    Config config_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<FormatState>> formats_;
+    std::vector<Subscriber> subscribers_;
+    uint32_t next_subscriber_id_ = 1;
+    uint64_t frame_seq_ = 0;
+    Stats stats_;
+
+public:
+    TrackPublisher() = default;
+    explicit TrackPublisher(const Config& config) : config_(config) {}
+
+    TrackPublisher(const TrackPublisher&) = delete;
+    TrackPublisher& operator=(const TrackPublisher&) = delete;
+
+    /**
+     * @brief Register a subscriber
+     * @return Subscriber id (0 if the configuration is invalid)
+     */
+    uint32_t addSubscriber(const SubscriberConfig& config, Sink sink);
+
+    void removeSubscriber(uint32_t subscriber_id);
+
+    /**
+     * @brief Record that a subscriber holds the state of frame_seq
+     *
+     * Later deltas to this subscriber are built against it. Ignored for
+     * subscribers configured without acknowledgements.
+     */
+    void acknowledge(uint32_t subscriber_id, uint64_t frame_seq);
+
+    /**
+     * @brief Offer the current track picture; sends to every subscriber that is due
+     * @param tracks All live tracks; tracks missing from the list (or TERMINATED) are removed
+     * @return Frame sequence number assigned to this picture
+     */
+    uint64_t publish(const std::vector<Track>& tracks, TimePoint now = std::chrono::high_resolution_clock::now());
+
+    Stats getStats() const;
+    uint64_t getSubscriberBytes(uint32_t subscriber_id) const;
+
+private:
+    size_t formatFor(const SubscriberConfig& config);
+    void ingest(FormatState& format, const std::vector<Track>& tracks, uint64_t seq);
+    Buffer encode(FormatState& format, uint64_t baseline_seq, uint64_t seq, TimePoint now);
+    Quantized quantize(const FormatState& format, const Track& track) const;
+};
+
+/**
+ * @brief Receiver side: rebuilds the quantized track picture from delta frames
+ */
+class TrackDeltaDecoder {
+public:
+    struct DecodedTrack {
+        uint32_t track_id = 0;
+        Point3D position;
+        Point3D velocity;
+        TrackState state = TrackState::TENTATIVE;
+        double confidence = 0.0;
+        double quality_score = 0.0;
+        Point3D position_std;
+    };
+
+private:
+    std::unordered_map<uint32_t, DecodedTrack> tracks_;
+    uint64_t frame_seq_ = 0;
+    bool synchronized_ = false;
+
+public:
+    /**
+     * @brief Apply one frame
+     * @return false if the frame is malformed or its baseline is newer than the
+     *         current state (a keyframe is needed); the state is then unchanged
+     */
+    bool apply(const uint8_t* data, size_t size);
+
+    bool isSynchronized() const { return synchronized_; }
+    uint64_t getFrameSeq() const { return frame_seq_; }
+    const std::unordered_map<uint32_t, DecodedTrack>& getTracks() const { return tracks_; }
+};
+
+}  // namespace radar_tracking
@@ -77,6 +77,9 @@ public:
     // IClusteringAlgorithm interface implementation
     bool initialize(const std::string& config_file) override;
     std::vector<Cluster> cluster(const std::vector<RadarDetection>& detections) override;
+    std::string getParameters() const override;
+    bool updateParameters(const std::string& params) override;
+    SystemStats getPerformanceMetrics() const override;
 
     /**
      * @brief Get current configuration
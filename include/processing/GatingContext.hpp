@@ -0,0 +1,149 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "tracking/MotionModels.hpp"
+#include <cmath>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Per-scan cache of innovation covariances for gating
+ *
+ * For every track the innovation covariance S = HPH^T + R, its Cholesky
+ * factor L and log|S| are computed once per scan. Track/cluster pair tests
+ * then reduce to a 3x3 forward substitution, evaluated in batches over
+ * structure-of-arrays cluster positions so the compiler can vectorize them.
+ */
+class GatingContext {
+private:
+    // Per-track data (structure of arrays)
+    std::vector<double> px_, py_, pz_;             ///< Predicted measurement
+    std::vector<double> s00_, s11_, s22_, s10_, s20_, s21_;  ///< Innovation covariance S
+    std::vector<double> l10_, l20_, l21_;           ///< Off-diagonal Cholesky factors
+    std::vector<double> inv_l00_, inv_l11_, inv_l22_;  ///< Reciprocal Cholesky diagonal
+    std::vector<double> log_det_;                   ///< log|S|
+    std::vector<uint8_t> valid_;                    ///< S was positive definite
+
+    // Per-cluster data (structure of arrays)
+    std::vector<double> cx_, cy_, cz_;
+
+    // Scratch buffers for gathered candidate batches
+    mutable std::vector<double> gx_, gy_, gz_;
+
+    double gate_threshold_ = 9.21;
+
+public:
+    GatingContext() = default;
+
+    /**
+     * @brief Cache innovation covariances using a filter kernel
+     * @param tracks Predicted tracks
+     * @param filter Any type providing innovationCovariance(const Track&)
+     * @param gate_threshold Chi-squared gate on the squared Mahalanobis distance
+     */
+    template<typename Filter>
+    void buildTracks(const std::vector<Track>& tracks, const Filter& filter, double gate_threshold) {
+        reserveTracks(tracks.size(), gate_threshold);
+        for (size_t t = 0; t < tracks.size(); ++t) {
+            setTrack(t, tracks[t], filter.innovationCovariance(tracks[t]));
+        }
+    }
+
+    /**
+     * @brief Cache innovation covariances as P_pos + R with isotropic R
+     * @param tracks Predicted tracks
+     * @param measurement_variance Position measurement variance (m^2)
+     * @param gate_threshold Chi-squared gate on the squared Mahalanobis distance
+     */
+    void buildTracks(const std::vector<Track>& tracks, double measurement_variance, double gate_threshold);
+
+    /**
+     * @brief Load cluster centroids for this scan
+     */
+    void setClusters(const std::vector<Cluster>& clusters);
+
+    size_t getTrackCount() const { return px_.size(); }
+    size_t getClusterCount() const { return cx_.size(); }
+    double getGateThreshold() const { return gate_threshold_; }
+
+    /**
+     * @brief Check that the track's innovation covariance could be factorized
+     */
+    bool isValid(size_t track) const { return valid_[track] != 0; }
+
+    /**
+     * @brief Cached log-determinant of the track's innovation covariance
+     */
+    double getLogDeterminant(size_t track) const { return log_det_[track]; }
+
+    /**
+     * @brief Predicted measurement of a track
+     */
+    Point3D getPredictedPosition(size_t track) const { return Point3D(px_[track], py_[track], pz_[track]); }
+
+    /**
+     * @brief Half extents of the axis-aligned box enclosing the track's gate ellipsoid
+     */
+    Point3D getGateHalfExtents(size_t track) const {
+        return Point3D(std::sqrt(gate_threshold_ * s00_[track]),
+                       std::sqrt(gate_threshold_ * s11_[track]),
+                       std::sqrt(gate_threshold_ * s22_[track]));
+    }
+
+    /**
+     * @brief Squared Mahalanobis distance of one track/cluster pair
+     */
+    double distanceSquared(size_t track, size_t cluster) const {
+        double d2;
+        mahalanobisBatch(track, &cx_[cluster], &cy_[cluster], &cz_[cluster], 1, &d2);
+        return d2;
+    }
+
+    /**
+     * @brief Squared distances from a track to every cluster of the scan
+     * @param track Track index
+     * @param d2_out Output array with getClusterCount() elements
+     */
+    void distancesToAllClusters(size_t track, double* d2_out) const {
+        mahalanobisBatch(track, cx_.data(), cy_.data(), cz_.data(), cx_.size(), d2_out);
+    }
+
+    /**
+     * @brief Squared distances from a track to a candidate subset of clusters
+     * @param track Track index
+     * @param clusters Candidate cluster indices
+     * @param count Number of candidates
+     * @param d2_out Output array with count elements
+     */
+    void distancesToClusters(size_t track, const uint32_t* clusters, size_t count, double* d2_out) const;
+
+    /**
+     * @brief Gaussian log-likelihood of a pair given its squared distance
+     */
+    double logLikelihood(size_t track, double d2) const {
+        return -0.5 * (d2 + log_det_[track] + 3.0 * std::log(2.0 * M_PI));
+    }
+
+private:
+    void reserveTracks(size_t count, double gate_threshold);
+    void setTrack(size_t index, const Track& track, const motion::MeasMatrix& S);
+
+    /**
+     * @brief Forward substitution L w = (z - z_pred) for a batch of positions
+     */
+    void mahalanobisBatch(size_t track, const double* __restrict x, const double* __restrict y,
+                          const double* __restrict z, size_t count, double* __restrict d2_out) const {
+        const double px = px_[track], py = py_[track], pz = pz_[track];
+        const double l10 = l10_[track], l20 = l20_[track], l21 = l21_[track];
+        const double i00 = inv_l00_[track], i11 = inv_l11_[track], i22 = inv_l22_[track];
+
+        for (size_t k = 0; k < count; ++k) {
+            const double w0 = (x[k] - px) * i00;
+            const double w1 = ((y[k] - py) - l10 * w0) * i11;
+            const double w2 = ((z[k] - pz) - l20 * w0 - l21 * w1) * i22;
+            d2_out[k] = w0 * w0 + w1 * w1 + w2 * w2;
+        }
+    }
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "interfaces/IAssociationAlgorithm.hpp"
+#include "core/DataTypes.hpp"
+#include "core/ThreadPool.hpp"
+#include "processing/GatingContext.hpp"
+#include "processing/JPDAEngine.hpp"
+#include "processing/TrackSpatialIndex.hpp"
+#include <yaml-cpp/yaml.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Joint Probabilistic Data Association
+ *
+ * Computes marginal association probabilities with JPDAEngine and exposes
+ * them through getLastResult() for probabilistic track updates. The
+ * associate() interface returns, per track, the most probable cluster when
+ * it outweighs the missed-detection hypothesis, with each cluster used at
+ * most once.
+ */
+class JPDAAssociation : public IAssociationAlgorithm {
+public:
+    /**
+     * @brief Configuration parameters for JPDA
+     */
+    struct Config {
+        JPDAEngine::Config engine;             ///< Gate clustering and hypothesis strategy
+        double measurement_variance = 25.0;    ///< Position measurement variance R (m^2)
+        TrackSpatialIndex::Config spatial_index;  ///< Candidate generation without a caller index
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+private:
+    Config config_;
+    JPDAEngine engine_;
+    GatingContext gating_;
+    TrackSpatialIndex spatial_index_;
+    JPDAResult last_result_;
+
+    // Performance monitoring
+    mutable std::mutex stats_mutex_;
+    size_t total_scans_ = 0;
+    size_t total_associations_ = 0;
+    double total_processing_time_ms_ = 0.0;
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    JPDAAssociation() = default;
+
+    /**
+     * @brief Constructor with configuration
+     */
+    explicit JPDAAssociation(const Config& config);
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~JPDAAssociation() = default;
+
+    // IAssociationAlgorithm interface implementation
+    bool initialize(const std::string& config_file) override;
+    std::vector<std::pair<uint32_t, uint32_t>> associate(
+        const std::vector<Track>& tracks,
+        const std::vector<Cluster>& clusters) override;
+    std::vector<std::pair<uint32_t, uint32_t>> associateCandidates(
+        const std::vector<Track>& tracks,
+        const std::vector<Cluster>& clusters,
+        const std::vector<std::pair<uint32_t, uint32_t>>& candidates) override;
+    double calculateAssociationProbability(const Track& track, const Cluster& cluster) const override;
+    double getGatingThreshold() const override { return config_.engine.gating_threshold; }
+    void setGatingThreshold(double threshold) override;
+    SystemStats getStats() const override;
+
+    /**
+     * @brief Get current configuration
+     */
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Set configuration
+     */
+    void setConfig(const Config& config);
+
+    /**
+     * @brief Distribute gate clusters over a thread pool (nullptr: serial)
+     */
+    void setThreadPool(ThreadPool* pool) { engine_.setThreadPool(pool); }
+
+    /**
+     * @brief Marginal probabilities of the most recent scan
+     */
+    const JPDAResult& getLastResult() const { return last_result_; }
+
+private:
+    /**
+     * @brief Run the engine once gating_ holds this scan's tracks
+     */
+    std::vector<std::pair<uint32_t, uint32_t>> associateGated(
+        const std::vector<Cluster>& clusters,
+        const std::vector<std::pair<uint32_t, uint32_t>>& candidates);
+
+    /**
+     * @brief Hard decisions from marginals: most probable cluster per track, clusters used once
+     */
+    std::vector<std::pair<uint32_t, uint32_t>> selectAssociations(const JPDAResult& result) const;
+};
+
+/**
+ * @brief Factory function for creating JPDA association instances
+ */
+std::unique_ptr<IAssociationAlgorithm> createJPDAAssociation();
+
+} // namespace radar_tracking
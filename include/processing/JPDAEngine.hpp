@@ -0,0 +1,147 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "core/ThreadPool.hpp"
+#include "processing/GatingContext.hpp"
+#include <yaml-cpp/yaml.h>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Marginal probability that a track originated a cluster
+ */
+struct AssociationMarginal {
+    uint32_t track_index;
+    uint32_t cluster_index;
+    double probability;
+};
+
+/**
+ * @brief JPDA output for one scan
+ */
+struct JPDAResult {
+    std::vector<AssociationMarginal> marginals;  ///< Sorted by track, then cluster
+    std::vector<double> miss_probability;        ///< Per track: no cluster is its own
+
+    // Gate cluster statistics
+    size_t gate_clusters = 0;
+    size_t largest_gate_cluster = 0;   ///< Tracks in the largest gate cluster
+    size_t exact_clusters = 0;
+    size_t kbest_clusters = 0;
+    size_t parametric_clusters = 0;
+    bool budget_exceeded = false;
+};
+
+/**
+ * @brief Joint probabilistic data association with bounded cost
+ *
+ * Gated track/cluster pairs are partitioned with union-find into independent
+ * gate clusters. Each gate cluster is solved with the cheapest strategy that
+ * is still accurate: exact enumeration of joint events when small, Murty
+ * k-best joint hypotheses when larger, and the parametric "cheap JPDA"
+ * approximation when the per-scan time budget is spent. Gate clusters are
+ * distributed over the ThreadPool when one is attached.
+ */
+class JPDAEngine {
+public:
+    /**
+     * @brief Engine parameters (jpda_config.yaml)
+     */
+    struct Config {
+        double gating_threshold = 9.21;        ///< Chi-squared gate
+        double detection_probability = 0.9;    ///< P_D
+        double gate_probability = 0.99;        ///< P_G for gating_threshold
+        double clutter_density = 1e-9;         ///< False alarms per m^3
+        size_t exact_max_tracks = 6;           ///< Enumerate exactly up to this many tracks
+        size_t exact_max_events = 20000;       ///< ... and this many joint events (upper bound)
+        size_t k_best = 64;                    ///< Hypotheses for the Murty approximation
+        size_t kbest_max_tracks = 40;          ///< Larger gate clusters go parametric
+        double time_budget_ms = 20.0;          ///< Per-scan budget for the expensive strategies
+        size_t parallel_min_clusters = 4;      ///< Use the pool from this many gate clusters
+
+        /**
+         * @brief Load configuration from a jpda_config.yaml document
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+private:
+    /**
+     * @brief Independent subproblem: tracks sharing at least one gated cluster
+     */
+    struct GateCluster {
+        std::vector<uint32_t> tracks;
+        std::vector<uint32_t> clusters;
+        std::vector<uint32_t> pairs;  ///< Indices into gated_ pairs
+    };
+
+    struct GatedPair {
+        uint32_t track;
+        uint32_t cluster;
+        uint32_t local_track;    ///< Row within its gate cluster
+        uint32_t local_cluster;  ///< Column within its gate cluster
+        double weight;           ///< Likelihood ratio of this pair against a missed detection
+    };
+
+    Config config_;
+    ThreadPool* thread_pool_ = nullptr;
+
+    std::vector<GatedPair> gated_;
+    std::vector<GateCluster> gate_clusters_;
+    std::vector<uint32_t> parent_;
+    std::vector<int32_t> node_slot_;
+    std::vector<uint32_t> candidate_row_;
+    std::vector<double> d2_row_;
+
+public:
+    JPDAEngine() = default;
+    explicit JPDAEngine(const Config& config) : config_(config) {}
+
+    const Config& getConfig() const { return config_; }
+    void setConfig(const Config& config) { config_ = config; }
+
+    /**
+     * @brief Distribute gate clusters over a thread pool (nullptr: serial)
+     */
+    void setThreadPool(ThreadPool* pool) { thread_pool_ = pool; }
+
+    /**
+     * @brief Compute association marginals for one scan
+     * @param gating Innovation covariances for the tracks and this scan's clusters
+     * @param candidates (track_index, cluster_index) pairs to test, sorted by track
+     * @return Marginals and per-track miss probabilities
+     */
+    JPDAResult compute(const GatingContext& gating,
+                       const std::vector<std::pair<uint32_t, uint32_t>>& candidates);
+
+private:
+    void gatePairs(const GatingContext& gating, const std::vector<std::pair<uint32_t, uint32_t>>& candidates);
+    void buildGateClusters(size_t track_count, size_t cluster_count);
+    uint32_t findRoot(uint32_t node);
+
+    enum class Strategy { EXACT, KBEST, PARAMETRIC };
+
+    /**
+     * @brief Solve one gate cluster, writing one probability per pair
+     */
+    Strategy solveGateCluster(const GateCluster& cluster,
+                              std::chrono::steady_clock::time_point deadline,
+                              std::vector<double>& pair_probability) const;
+
+    void solveExact(const GateCluster& cluster, const Eigen::MatrixXd& weights,
+                    std::vector<double>& pair_probability) const;
+    bool solveKBest(const GateCluster& cluster, const Eigen::MatrixXd& weights,
+                    std::chrono::steady_clock::time_point deadline,
+                    std::vector<double>& pair_probability) const;
+    void solveParametric(const GateCluster& cluster, const Eigen::MatrixXd& weights,
+                         std::vector<double>& pair_probability) const;
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,133 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "processing/TrackSpatialIndex.hpp"
+#include <yaml-cpp/yaml.h>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Seconds from one time point to another
+ */
+inline double secondsBetween(std::chrono::high_resolution_clock::time_point from,
+                             std::chrono::high_resolution_clock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+}
+
+/**
+ * @brief Move a track's time of validity forward after predicting it by dt
+ */
+inline void advanceValidTime(Track& track, double dt) {
+    track.valid_time += std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+        std::chrono::duration<double>(dt));
+}
+
+/**
+ * @brief On-demand track prediction for sector scans (TWS)
+ *
+ * In track-while-scan operation a scan usually covers one sector, so most
+ * tracks cannot be gated by any of its detections. Rather than predicting
+ * every track by the scan interval, plan() bounds each track's gate at the
+ * scan's detection times from its current estimate alone: the position
+ * standard deviation grows by at most sigma_v*dt + sigma_a*dt^2/2 under the
+ * CV/CA dynamics, and unmodelled manoeuvres move the mean by at most
+ * max_acceleration*dt^2/2. Only tracks whose bounded gate box contains a
+ * cluster are selected; each is predicted to the time of its earliest such
+ * cluster. The others keep their time of validity (Track::valid_time) and
+ * are predicted when the beam next reaches them.
+ */
+class LazyPredictionPlanner {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+    using Box = TrackSpatialIndex::Box;
+
+    /**
+     * @brief Configuration (processing.lazy_prediction section)
+     */
+    struct Config {
+        bool enabled = false;                ///< Only honoured in TWS mode
+        double max_acceleration = 30.0;      ///< Manoeuvre bound for gate growth (m/s^2)
+        double measurement_variance = 25.0;  ///< R for the bounded gate (m^2)
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+    };
+
+private:
+    Config config_;
+    TrackSpatialIndex index_;
+    std::vector<Box> boxes_;
+    std::vector<uint32_t> selected_;        ///< Selected track indices, ascending
+    std::vector<TimePoint> target_time_;    ///< Prediction time of each selected track
+    std::vector<uint32_t> compact_of_;      ///< Compact index of each track (or NONE)
+
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+public:
+    LazyPredictionPlanner() = default;
+    explicit LazyPredictionPlanner(const Config& config) : config_(config) {}
+
+    const Config& getConfig() const { return config_; }
+    void setConfig(const Config& config) { config_ = config; }
+
+    /**
+     * @brief Index used to match bounded gates to clusters for large track counts
+     */
+    void setIndexConfig(const TrackSpatialIndex::Config& config) { index_.setConfig(config); }
+
+    /**
+     * @brief Select the tracks whose bounded gate reaches a cluster of this scan
+     * @param tracks All tracks, each at its own time of validity
+     * @param clusters Clusters of this scan
+     * @param measurements Measurement of each cluster (clusterMeasurement), for its timestamp
+     * @param gate_threshold Chi-squared gate of the associator
+     * @param max_distance Euclidean pre-gate of the associator (<= 0: none)
+     */
+    void plan(const std::vector<Track>& tracks,
+              const std::vector<Cluster>& clusters,
+              const std::vector<RadarDetection>& measurements,
+              double gate_threshold,
+              double max_distance);
+
+    /**
+     * @brief Indices of the selected tracks, ascending
+     */
+    const std::vector<uint32_t>& getSelected() const { return selected_; }
+
+    /**
+     * @brief Time to predict the k-th selected track to
+     */
+    TimePoint getTargetTime(size_t k) const { return target_time_[k]; }
+
+    /**
+     * @brief Move the selected tracks into a compact vector (in selection order)
+     */
+    void gather(std::vector<Track>& tracks, std::vector<Track>& compact) const;
+
+    /**
+     * @brief Move the compact tracks back to their places
+     */
+    void scatter(std::vector<Track>& compact, std::vector<Track>& tracks) const;
+
+    /**
+     * @brief Translate compact track indices in (track, cluster) pairs to full indices
+     */
+    void remap(std::vector<std::pair<uint32_t, uint32_t>>& associations) const;
+
+    /**
+     * @brief Tracks that were not selected this scan
+     */
+    std::vector<uint32_t> deferredTracks(size_t track_count) const;
+
+    /**
+     * @brief Box enclosing the track's gate at every time in [dt_begin, dt_end] past its validity
+     */
+    static Box boundedGate(const Track& track, double dt_begin, double dt_end, double gate_threshold,
+                           double measurement_variance, double max_acceleration, double max_distance);
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,217 @@
+#pragma once
+
+#include "interfaces/IAssociationAlgorithm.hpp"
+#include "core/DataTypes.hpp"
+#include "utils/MemoryPool.hpp"
+#include <yaml-cpp/yaml.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Track-oriented Multiple Hypothesis Tracking association
+ *
+ * Every track owns a hypothesis tree spanning the last N scans. Each scan,
+ * every leaf branches into a missed-detection child and one child per gated
+ * cluster, scored incrementally with the log-likelihood ratio of its
+ * history. Trees that compete for clusters are grouped, and the k best
+ * global hypotheses of each group are ranked with Murty's algorithm. The
+ * best hypothesis gives this scan's associations; decisions older than N
+ * scans are committed by N-scan-back pruning, and leaf counts adapt to a
+ * per-scan compute budget.
+ *
+ * Leaves carry a compact constant-velocity filter, decoupled per axis, and
+ * all tree nodes live in a pool allocator.
+ */
+class MHTAssociation : public IAssociationAlgorithm {
+public:
+    /**
+     * @brief Configuration parameters for MHT
+     */
+    struct Config {
+        double gating_threshold = 9.21;        ///< Chi-squared gate per leaf
+        double detection_probability = 0.9;    ///< P_D
+        double clutter_density = 1e-9;         ///< False alarms per m^3
+        double measurement_variance = 25.0;    ///< Position measurement variance (m^2)
+        double process_noise = 1.0;            ///< White acceleration noise intensity
+        double scan_period_sec = 1.0;          ///< dt when clusters carry no timestamps
+
+        int n_scan = 3;                        ///< Sliding window depth (N-scan-back)
+        size_t k_best = 10;                    ///< Global hypotheses per tree group
+        size_t max_leaves_per_tree = 16;       ///< Upper bound on retained leaves
+        double prune_log_ratio = 9.2;          ///< Drop leaves this far below the tree's best
+        double min_hypothesis_probability = 1e-3;  ///< Keep leaves with this marginal
+
+        double time_budget_ms = 30.0;          ///< Per-scan compute budget
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    /**
+     * @brief Per-scan hypothesis statistics
+     */
+    struct HypothesisStats {
+        size_t trees = 0;
+        size_t leaves = 0;
+        size_t nodes = 0;
+        size_t groups = 0;
+        size_t global_hypotheses = 0;
+        size_t leaf_limit = 0;         ///< Current budget-adapted leaf cap
+        double processing_time_ms = 0.0;
+    };
+
+private:
+    /**
+     * @brief Constant-velocity state of one axis
+     */
+    struct AxisState {
+        double pos, vel;
+        double p00, p01, p11;  ///< Covariance of (pos, vel)
+    };
+
+    /**
+     * @brief Hypothesis tree node (pool allocated)
+     */
+    struct HypothesisNode {
+        HypothesisNode* parent = nullptr;
+        HypothesisNode* first_child = nullptr;
+        HypothesisNode* next_sibling = nullptr;
+        double score = 0.0;        ///< Cumulative log-likelihood ratio
+        double marginal = 0.0;     ///< Probability mass in the last global hypotheses
+        int32_t cluster = -1;      ///< Cluster index at its scan, -1 for a miss
+        uint32_t scan = 0;
+        AxisState axes[3];
+    };
+
+    /**
+     * @brief Hypothesis tree of one track
+     */
+    struct HypothesisTree {
+        uint32_t track_id = 0;
+        HypothesisNode* root = nullptr;
+        HypothesisNode* selected = nullptr;   ///< Leaf in the best global hypothesis
+        std::vector<HypothesisNode*> leaves;
+        uint32_t last_seen_scan = 0;
+    };
+
+    Config config_;
+    ObjectPool<HypothesisNode> node_pool_;
+    std::unordered_map<uint32_t, HypothesisTree> trees_;
+    uint32_t scan_ = 0;
+    size_t leaf_limit_ = 16;
+    bool has_scan_time_ = false;
+    std::chrono::high_resolution_clock::time_point last_scan_time_;
+
+    // Per-scan scratch
+    std::vector<double> cx_, cy_, cz_;
+    HypothesisStats last_stats_;
+
+    // Performance monitoring
+    mutable std::mutex stats_mutex_;
+    size_t total_scans_ = 0;
+    size_t total_associations_ = 0;
+    double total_processing_time_ms_ = 0.0;
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    MHTAssociation();
+
+    /**
+     * @brief Constructor with configuration
+     */
+    explicit MHTAssociation(const Config& config);
+
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~MHTAssociation();
+
+    // IAssociationAlgorithm interface implementation
+    bool initialize(const std::string& config_file) override;
+    std::vector<std::pair<uint32_t, uint32_t>> associate(
+        const std::vector<Track>& tracks,
+        const std::vector<Cluster>& clusters) override;
+    double calculateAssociationProbability(const Track& track, const Cluster& cluster) const override;
+    double getGatingThreshold() const override { return config_.gating_threshold; }
+    void setGatingThreshold(double threshold) override { config_.gating_threshold = threshold; }
+    SystemStats getStats() const override;
+
+    /**
+     * @brief Get current configuration
+     */
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Set configuration
+     */
+    void setConfig(const Config& config);
+
+    /**
+     * @brief Hypothesis statistics of the most recent scan
+     */
+    HypothesisStats getHypothesisStats() const;
+
+    /**
+     * @brief Filtered state along the track's selected hypothesis
+     *
+     * Lets the caller re-synchronize a track after MHT revised an earlier
+     * decision (for example, undoing a swap between crossing tracks).
+     * @return false if the track has no hypothesis tree
+     */
+    bool getSelectedState(uint32_t track_id, Point3D& position, Point3D& velocity) const;
+
+    /**
+     * @brief Drop all hypothesis trees
+     */
+    void reset();
+
+private:
+    HypothesisTree& treeFor(const Track& track);
+    void retainTrees(const std::vector<Track>& tracks);
+    double scanInterval(const std::vector<Cluster>& clusters);
+
+    /**
+     * @brief Branch every leaf of a tree into miss and gated-cluster children
+     * @param gated Receives the clusters gated by any leaf of the tree
+     */
+    void extendTree(HypothesisTree& tree, double dt, std::vector<uint32_t>& gated);
+
+    /**
+     * @brief Rank global hypotheses for one group of competing trees
+     * @return Number of global hypotheses formed
+     */
+    size_t solveGroup(const std::vector<HypothesisTree*>& group,
+                      const std::vector<std::vector<uint32_t>>& gated,
+                      std::chrono::steady_clock::time_point deadline);
+
+    void pruneTree(HypothesisTree& tree);
+    void nScanPrune(HypothesisTree& tree);
+    void collectLeaves(HypothesisNode* node, std::vector<HypothesisNode*>& leaves) const;
+    void destroySubtree(HypothesisNode* node);
+    void detachChild(HypothesisNode* parent, HypothesisNode* child);
+    HypothesisNode* addChild(HypothesisNode* parent);
+    void adaptLeafLimit(double processing_time_ms);
+
+    static void predictAxis(AxisState& axis, double dt, double q);
+};
+
+/**
+ * @brief Factory function for creating MHT association instances
+ */
+std::unique_ptr<IAssociationAlgorithm> createMHTAssociation();
+
+} // namespace radar_tracking
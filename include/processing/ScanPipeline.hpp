@@ -0,0 +1,508 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "interfaces/IClusteringAlgorithm.hpp"
+#include "interfaces/IAssociationAlgorithm.hpp"
+#include "interfaces/ITracker.hpp"
+#include "processing/DBSCANClustering.hpp"
+#include "processing/GatingContext.hpp"
+#include "processing/LazyPrediction.hpp"
+#include "processing/TrackSpatialIndex.hpp"
+#include "tracking/FilterKernels.hpp"
+#include "tracking/IMMBatchEngine.hpp"
+#include "tracking/OOSMHandler.hpp"
+#include "tracking/ParticleFilter.hpp"
+#include "tracking/SquareRootKalmanFilter.hpp"
+#include "utils/CheckpointFormat.hpp"
+#include "utils/Mathematics.hpp"
+#include <yaml-cpp/yaml.h>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Result of processing one scan
+ */
+struct ScanResult {
+    std::vector<Cluster> clusters;
+    std::vector<std::pair<uint32_t, uint32_t>> associations;  ///< (track_index, cluster_index)
+    std::vector<uint32_t> unassigned_tracks;
+    std::vector<uint32_t> unassigned_clusters;
+    std::vector<uint32_t> deferred_tracks;  ///< Not predicted this scan (lazy prediction); also unassigned
+};
+
+/**
+ * @brief One scan of predict, cluster, associate and update
+ *
+ * RadarSystem calls processScan() once per scan; this is the only virtual
+ * call on the path. Implementations are either the runtime-polymorphic chain
+ * built from plugin interfaces or a compile-time specialized StaticPipeline.
+ */
+class ScanPipeline {
+public:
+    virtual ~ScanPipeline() = default;
+
+    /**
+     * @brief Process one scan of detections against the current tracks
+     * @param detections Detections of this scan
+     * @param tracks Tracks to predict and update in place
+     * @param dt Time since the previous scan (seconds)
+     * @return Clusters and association decisions for track management
+     */
+    virtual ScanResult processScan(const std::vector<RadarDetection>& detections,
+                                   std::vector<Track>& tracks,
+                                   double dt) = 0;
+
+    /**
+     * @brief Human-readable pipeline variant (for logs and stats)
+     */
+    virtual std::string getVariantName() const = 0;
+
+    /**
+     * @brief Add per-track filter and association state to a checkpoint
+     *
+     * Called on the tracking thread between scans, after the tracks were
+     * exported into checkpoint.tracks. The default keeps no state beyond Track.
+     */
+    virtual void saveState(TrackerCheckpoint& /*checkpoint*/) {}
+
+    /**
+     * @brief Restore the state saveState() captured, for checkpoint.tracks
+     * @return false if the checkpoint holds no usable state for this pipeline;
+     *         its filters then restart from the restored Track estimates
+     */
+    virtual bool restoreState(const TrackerCheckpoint& /*checkpoint*/) { return false; }
+
+    /**
+     * @brief Run other plugin algorithm instances from the next scan on
+     *
+     * Called on the tracking thread between scans (PluginManager swap);
+     * nullptr keeps the current instance.
+     * @return false if this pipeline does not run the plugin interfaces
+     *         (compile-time specializations hold their own algorithms)
+     */
+    virtual bool rebindAlgorithms(IClusteringAlgorithm* /*clustering*/,
+                                  IAssociationAlgorithm* /*association*/,
+                                  ITracker* /*tracker*/) {
+        return false;
+    }
+};
+
+/**
+ * @brief Build the measurement used to update a track from a cluster
+ */
+RadarDetection clusterMeasurement(const Cluster& cluster);
+
+/**
+ * @brief Fill unassigned track/cluster lists from the association pairs
+ */
+void completeScanResult(size_t track_count, ScanResult& result);
+
+/**
+ * @brief Fallback pipeline dispatching through the plugin interfaces
+ */
+class RuntimePipeline : public ScanPipeline {
+private:
+    IClusteringAlgorithm* clustering_;
+    IAssociationAlgorithm* association_;
+    ITracker* tracker_;
+
+    TrackSpatialIndex spatial_index_;
+    GatingContext gating_;
+    bool use_spatial_index_ = false;
+
+    LazyPredictionPlanner lazy_;
+    std::vector<RadarDetection> measurements_;
+    std::vector<Track> selected_tracks_;
+
+public:
+    /**
+     * @brief Wrap algorithm instances owned by RadarSystem
+     */
+    RuntimePipeline(IClusteringAlgorithm* clustering,
+                    IAssociationAlgorithm* association,
+                    ITracker* tracker);
+
+    /**
+     * @brief Generate candidate pairs from a track spatial index
+     *
+     * Gate boxes use P_pos + R with the configured measurement variance and
+     * the association algorithm's gating threshold.
+     */
+    void enableSpatialIndex(const TrackSpatialIndex::Config& config);
+
+    /**
+     * @brief Predict only the tracks a scan's detections can reach (TWS)
+     */
+    void enableLazyPrediction(const LazyPredictionPlanner::Config& config,
+                              const TrackSpatialIndex::Config& index_config);
+
+    ScanResult processScan(const std::vector<RadarDetection>& detections,
+                           std::vector<Track>& tracks,
+                           double dt) override;
+
+    std::string getVariantName() const override { return "runtime"; }
+
+    bool rebindAlgorithms(IClusteringAlgorithm* clustering,
+                          IAssociationAlgorithm* association,
+                          ITracker* tracker) override;
+};
+
+/**
+ * @brief Global nearest neighbour association policy for StaticPipeline
+ *
+ * Gating and cost evaluation are templated on the filter so the innovation
+ * covariance is computed inline, once per track per scan, and cached with
+ * its Cholesky factor in a GatingContext.
+ */
+struct GNNPolicy {
+    double gating_threshold = 9.21;            ///< Chi-squared gate on Mahalanobis distance
+    double max_association_distance = 500.0;   ///< Euclidean pre-gate (meters)
+
+    /**
+     * @brief Load parameters from a gnn_config.yaml document
+     */
+    void loadFromYaml(const YAML::Node& node);
+
+    GatingContext gating;          ///< Per-scan innovation covariance cache
+    TrackSpatialIndex spatial_index;  ///< Coarse gate overlap index
+    std::vector<double> d2_row;    ///< Scratch row of squared distances
+    std::vector<uint32_t> candidate_row;  ///< Scratch candidate cluster indices
+
+    template<typename Filter>
+    std::vector<std::pair<uint32_t, uint32_t>> associate(const std::vector<Track>& tracks,
+                                                          const std::vector<Cluster>& clusters,
+                                                          const Filter& filter) {
+        std::vector<std::pair<uint32_t, uint32_t>> associations;
+        if (tracks.empty() || clusters.empty()) {
+            return associations;
+        }
+
+        constexpr double INFEASIBLE_COST = 1e9;
+        const double max_dist2 = max_association_distance * max_association_distance;
+        Eigen::MatrixXd cost = Eigen::MatrixXd::Constant(tracks.size(), clusters.size(), INFEASIBLE_COST);
+
+        // S, its Cholesky factor and log|S| once per track, then batched pair tests
+        gating.buildTracks(tracks, filter, gating_threshold);
+        gating.setClusters(clusters);
+
+        auto accept = [&](size_t t, size_t c, double d2) {
+            if (d2 > gating_threshold) {
+                return;
+            }
+            const Point3D delta = clusters[c].centroid - gating.getPredictedPosition(t);
+            if (delta.x * delta.x + delta.y * delta.y + delta.z * delta.z <= max_dist2) {
+                cost(t, c) = d2;
+            }
+        };
+
+        const auto& index_config = spatial_index.getConfig();
+        if (index_config.enabled && tracks.size() >= index_config.min_tracks) {
+            // Only pairs whose gate boxes overlap reach the Mahalanobis test
+            spatial_index.build(gating);
+            const auto candidates = spatial_index.candidatePairs(clusters);
+
+            for (size_t begin = 0; begin < candidates.size();) {
+                const uint32_t t = candidates[begin].first;
+                size_t end = begin;
+                candidate_row.clear();
+                while (end < candidates.size() && candidates[end].first == t) {
+                    candidate_row.push_back(candidates[end++].second);
+                }
+                d2_row.resize(candidate_row.size());
+                gating.distancesToClusters(t, candidate_row.data(), candidate_row.size(), d2_row.data());
+                for (size_t k = 0; k < candidate_row.size(); ++k) {
+                    accept(t, candidate_row[k], d2_row[k]);
+                }
+                begin = end;
+            }
+        } else {
+            d2_row.resize(clusters.size());
+            for (size_t t = 0; t < tracks.size(); ++t) {
+                if (!gating.isValid(t)) {
+                    continue;
+                }
+                gating.distancesToAllClusters(t, d2_row.data());
+                for (size_t c = 0; c < clusters.size(); ++c) {
+                    accept(t, c, d2_row[c]);
+                }
+            }
+        }
+
+        for (const auto& [t, c] : Mathematics::hungarianAssignment(cost)) {
+            if (t >= 0 && c >= 0 && cost(t, c) < INFEASIBLE_COST) {
+                associations.emplace_back(static_cast<uint32_t>(t), static_cast<uint32_t>(c));
+            }
+        }
+        return associations;
+    }
+};
+
+/**
+ * @brief Detects filters that predict and update all tracks in one call
+ */
+template<typename Filter, typename = void>
+struct HasBatchInterface : std::false_type {};
+
+template<typename Filter>
+struct HasBatchInterface<Filter, std::void_t<decltype(std::declval<Filter&>().predictAll(
+                                     std::declval<std::vector<Track>&>(), 0.0))>> : std::true_type {};
+
+/**
+ * @brief Compile-time specialized scan pipeline
+ *
+ * Clusterer, Associator and Filter are held by value, so every call below
+ * processScan() is statically bound and the gating/update loops can be
+ * inlined and vectorized.
+ */
+template<typename Clusterer, typename Associator, typename Filter>
+class StaticPipeline final : public ScanPipeline {
+private:
+    Clusterer clusterer_;
+    Associator associator_;
+    Filter filter_;
+    std::string variant_name_;
+    std::vector<std::pair<uint32_t, RadarDetection>> measurements_;  ///< Batch update scratch
+
+    LazyPredictionPlanner lazy_;
+    std::vector<RadarDetection> cluster_measurements_;  ///< Lazy path: measurement per cluster
+    std::vector<Track> selected_tracks_;                ///< Lazy path: tracks reached this scan
+
+    struct NoOOSM {};
+    std::conditional_t<HasSnapshotInterface<Filter>::value, OOSMHandler<Filter>, NoOOSM> oosm_;
+
+public:
+    StaticPipeline(Clusterer clusterer, Associator associator, Filter filter, std::string variant_name)
+        : clusterer_(std::move(clusterer)),
+          associator_(std::move(associator)),
+          filter_(std::move(filter)),
+          variant_name_(std::move(variant_name)) {}
+
+    /**
+     * @brief Predict only the tracks a scan's detections can reach (TWS)
+     *
+     * Tracks are then predicted per track to their detections' time, so
+     * filters with a batch interface use their per-track path.
+     */
+    void enableLazyPrediction(const LazyPredictionPlanner::Config& config,
+                              const TrackSpatialIndex::Config& index_config) {
+        lazy_.setConfig(config);
+        lazy_.setIndexConfig(index_config);
+    }
+
+    /**
+     * @brief Fuse late measurements by bounded replay (lazy prediction only)
+     *
+     * @return false if the filter has no snapshot interface (OOSM stays disabled)
+     */
+    bool enableOOSM(const OOSMConfig& config) {
+        if constexpr (HasSnapshotInterface<Filter>::value) {
+            oosm_.setConfig(config);
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    ScanResult processScan(const std::vector<RadarDetection>& detections,
+                           std::vector<Track>& tracks,
+                           double dt) override {
+        if (lazy_.getConfig().enabled) {
+            return processLazy(detections, tracks);
+        }
+
+        ScanResult result;
+
+        if constexpr (HasBatchInterface<Filter>::value) {
+            filter_.predictAll(tracks, dt);
+        } else {
+            filter_.retainTracks(tracks);
+            for (auto& track : tracks) {
+                filter_.predict(track, dt);
+            }
+        }
+        for (auto& track : tracks) {
+            advanceValidTime(track, dt);
+        }
+
+        result.clusters = clusterer_.cluster(detections);
+        result.associations = associator_.associate(tracks, result.clusters, filter_);
+
+        if constexpr (HasBatchInterface<Filter>::value) {
+            measurements_.clear();
+            for (const auto& [track_index, cluster_index] : result.associations) {
+                measurements_.emplace_back(track_index, clusterMeasurement(result.clusters[cluster_index]));
+            }
+            filter_.updateAll(tracks, measurements_);
+        } else {
+            for (const auto& [track_index, cluster_index] : result.associations) {
+                filter_.update(tracks[track_index], clusterMeasurement(result.clusters[cluster_index]));
+            }
+        }
+
+        completeScanResult(tracks.size(), result);
+        return result;
+    }
+
+    std::string getVariantName() const override { return variant_name_; }
+
+    void saveState(TrackerCheckpoint& checkpoint) override {
+        if constexpr (HasSnapshotInterface<Filter>::value) {
+            using Snapshot = typename Filter::Snapshot;
+            if constexpr (!std::is_empty<Snapshot>::value) {
+                checkpoint.filter_state.template begin<Snapshot>(variant_name_);
+                for (const auto& track : checkpoint.tracks) {
+                    checkpoint.filter_state.append(track.track_id, filter_.snapshot(track));
+                }
+            }
+            if (oosm_.getConfig().enabled) {
+                oosm_.exportWindows(checkpoint.tracks, variant_name_, checkpoint.association_state);
+            }
+        }
+    }
+
+    bool restoreState(const TrackerCheckpoint& checkpoint) override {
+        if constexpr (HasSnapshotInterface<Filter>::value) {
+            using Snapshot = typename Filter::Snapshot;
+            if (oosm_.getConfig().enabled) {
+                oosm_.importWindows(checkpoint.association_state, variant_name_);
+            }
+            if constexpr (std::is_empty<Snapshot>::value) {
+                return true;  // The whole estimate lives in Track
+            } else {
+                // Elements follow checkpoint.tracks one to one
+                const auto& section = checkpoint.filter_state;
+                if (!section.template matches<Snapshot>(variant_name_) || section.count != checkpoint.tracks.size()) {
+                    return false;
+                }
+                Snapshot snapshot;
+                uint32_t track_id = 0;
+                for (uint32_t i = 0; i < section.count; ++i) {
+                    section.read(i, track_id, snapshot);
+                    if (track_id == checkpoint.tracks[i].track_id) {
+                        filter_.restore(checkpoint.tracks[i], snapshot);
+                    }
+                }
+                return true;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    Clusterer& getClusterer() { return clusterer_; }
+    Associator& getAssociator() { return associator_; }
+    Filter& getFilter() { return filter_; }
+
+private:
+    void predictTo(Track& track, LazyPredictionPlanner::TimePoint time) {
+        const double dt = secondsBetween(track.valid_time, time);
+        if (dt > 0.0) {
+            filter_.predict(track, dt);
+            track.valid_time = time;
+        }
+    }
+
+    void updateTrack(Track& track, const RadarDetection& measurement) {
+        if constexpr (HasSnapshotInterface<Filter>::value) {
+            if (oosm_.getConfig().enabled) {
+                if (oosm_.isLate(track, measurement)) {
+                    oosm_.retrodict(track, measurement, filter_);
+                } else {
+                    filter_.update(track, measurement);
+                    oosm_.record(track, measurement, filter_);
+                }
+                return;
+            }
+        }
+        filter_.update(track, measurement);
+    }
+
+    ScanResult processLazy(const std::vector<RadarDetection>& detections, std::vector<Track>& tracks) {
+        ScanResult result;
+        filter_.retainTracks(tracks);
+        if constexpr (HasSnapshotInterface<Filter>::value) {
+            oosm_.retainTracks(tracks);
+        }
+
+        result.clusters = clusterer_.cluster(detections);
+        cluster_measurements_.clear();
+        for (const auto& cluster : result.clusters) {
+            cluster_measurements_.push_back(clusterMeasurement(cluster));
+        }
+
+        lazy_.plan(tracks, result.clusters, cluster_measurements_,
+                   associator_.gating_threshold, associator_.max_association_distance);
+        const auto& selected = lazy_.getSelected();
+        for (size_t k = 0; k < selected.size(); ++k) {
+            predictTo(tracks[selected[k]], lazy_.getTargetTime(k));
+        }
+
+        // Associate and update only the reached tracks, then put them back
+        lazy_.gather(tracks, selected_tracks_);
+        result.associations = associator_.associate(selected_tracks_, result.clusters, filter_);
+        for (const auto& [track_index, cluster_index] : result.associations) {
+            Track& track = selected_tracks_[track_index];
+            predictTo(track, cluster_measurements_[cluster_index].timestamp);
+            updateTrack(track, cluster_measurements_[cluster_index]);
+        }
+        lazy_.scatter(selected_tracks_, tracks);
+        lazy_.remap(result.associations);
+
+        completeScanResult(tracks.size(), result);
+        result.deferred_tracks = lazy_.deferredTracks(tracks.size());
+        return result;
+    }
+};
+
+using DBSCANGNNIMMPipeline = StaticPipeline<DBSCANClustering, GNNPolicy, IMMKernel>;
+using DBSCANGNNKalmanPipeline = StaticPipeline<DBSCANClustering, GNNPolicy, KalmanCVKernel>;
+using DBSCANGNNIMMBatchPipeline = StaticPipeline<DBSCANClustering, GNNPolicy, IMMBatchEngine>;
+using DBSCANGNNParticlePipeline = StaticPipeline<DBSCANClustering, GNNPolicy, ParticleFilter>;
+using DBSCANGNNSquareRootKalmanPipeline = StaticPipeline<DBSCANClustering, GNNPolicy, SquareRootKalmanCVKernel>;
+
+extern template class StaticPipeline<DBSCANClustering, GNNPolicy, IMMKernel>;
+extern template class StaticPipeline<DBSCANClustering, GNNPolicy, KalmanCVKernel>;
+extern template class StaticPipeline<DBSCANClustering, GNNPolicy, IMMBatchEngine>;
+extern template class StaticPipeline<DBSCANClustering, GNNPolicy, ParticleFilter>;
+extern template class StaticPipeline<DBSCANClustering, GNNPolicy, SquareRootKalmanCVKernel>;
+
+struct ConfigSnapshot;
+
+/**
+ * @brief Select and build the scan pipeline from configuration
+ *
+ * algorithms.pipeline selects "static" (compile-time specialized when the
+ * configured algorithm combination has a specialization), or "runtime".
+ * Unsupported combinations fall back to the runtime pipeline. IMM uses
+ * the batched engine when imm_config.yaml enables parallel models. Lazy
+ * prediction and OOSM handling follow the snapshot's effective settings.
+ *
+ * @param config Compiled system configuration
+ * @param clustering Runtime clustering algorithm (fallback path)
+ * @param association Runtime association algorithm (fallback path)
+ * @param tracker Runtime tracker (fallback path)
+ * @param thread_pool Pool for batched stages (optional)
+ * @return Pipeline instance, never null
+ */
+std::unique_ptr<ScanPipeline> createScanPipeline(const ConfigSnapshot& config,
+                                                 IClusteringAlgorithm* clustering,
+                                                 IAssociationAlgorithm* association,
+                                                 ITracker* tracker,
+                                                 ThreadPool* thread_pool = nullptr);
+
+/**
+ * @brief Compile a system configuration file and build its scan pipeline
+ *
+ * An invalid configuration yields the runtime pipeline.
+ */
+std::unique_ptr<ScanPipeline> createScanPipeline(const std::string& config_file,
+                                                 IClusteringAlgorithm* clustering,
+                                                 IAssociationAlgorithm* association,
+                                                 ITracker* tracker,
+                                                 ThreadPool* thread_pool = nullptr);
+
+}  // namespace radar_tracking
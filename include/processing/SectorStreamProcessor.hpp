@@ -0,0 +1,149 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "processing/ScanPipeline.hpp"
+#include <yaml-cpp/yaml.h>
+#include <chrono>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Per-sector processing of a rotating scan as detections arrive
+ *
+ * Detections are bucketed by azimuth sector (from azimuth, or from beam_id
+ * when beams map to sectors). When the first detection of a new sector
+ * arrives the open sector is complete and is processed immediately, so
+ * tracks are available one sector after their detections instead of one
+ * revolution.
+ *
+ * Clustering is seam-aware: when the next sector is adjacent, detections
+ * within seam_margin_m of the trailing boundary, and all detections linked
+ * to them by steps of at most seam_margin_m, are held back and clustered
+ * with the next sector, so a target straddling the boundary forms one
+ * cluster. Each sector is associated only against tracks whose position,
+ * extrapolated to the sector time, falls in the sector wedge widened by
+ * track_margin_m. Only tracks in the wedge proper can be missed, where
+ * the wedge moves with the seam bands so that a track is never missed in
+ * the sector that handed its detections on.
+ *
+ * The pipeline must predict per track to detection time (lazy prediction),
+ * since tracks are touched at different sectors; createScanPipeline
+ * enables it when streaming is configured.
+ */
+class SectorStreamProcessor {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+
+    /**
+     * @brief Configuration (processing.streaming section)
+     */
+    struct Config {
+        bool enabled = false;
+        uint32_t num_sectors = 16;
+        double seam_margin_m = 150.0;      ///< Seam band and linkage distance (>= clustering epsilon)
+        double track_margin_m = 2000.0;    ///< Wedge widening for association candidates
+        bool clockwise = false;            ///< Antenna rotation sense (azimuth = atan2(y, x))
+        bool use_beam_id = false;          ///< Take sectors from beam_id instead of azimuth
+        uint32_t beams_per_sector = 1;
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    /**
+     * @brief Outcome of one processed sector
+     *
+     * Track indices in scan refer to the full track vector. unassigned_tracks
+     * only holds tracks of this sector's wedge, so the caller can mark them
+     * missed and publish owned_tracks once track management has run.
+     */
+    struct SectorResult {
+        uint32_t sector = 0;
+        TimePoint sector_time;                ///< Latest detection time of the batch
+        ScanResult scan;
+        std::vector<uint32_t> owned_tracks;   ///< Tracks in the sector wedge proper
+    };
+
+private:
+    Config config_;
+    ScanPipeline* pipeline_;
+    double sector_width_;
+
+    static constexpr uint32_t NO_SECTOR = 0xFFFFFFFFu;
+    uint32_t open_sector_ = NO_SECTOR;
+    std::vector<RadarDetection> pending_;   ///< Detections of the open sector
+    std::vector<RadarDetection> carry_;     ///< Seam detections held for the next sector
+    bool carry_into_open_ = false;          ///< The open sector receives the previous seam band
+    TimePoint last_sector_time_{};
+    bool have_last_time_ = false;
+
+    // Scratch
+    std::vector<RadarDetection> batch_;
+    std::vector<uint32_t> selected_;        ///< Full indices of the sector's candidate tracks
+    std::vector<uint8_t> owned_;            ///< Per selected track: inside the wedge proper
+    std::vector<Track> sector_tracks_;
+
+    size_t sectors_processed_ = 0;
+
+public:
+    /**
+     * @brief Stream into a pipeline (not owned, must outlive the processor)
+     */
+    SectorStreamProcessor(const Config& config, ScanPipeline* pipeline);
+
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Add detections as they arrive, processing every sector they complete
+     * @param detections Newly received detections (any batching)
+     * @param tracks All tracks; sector tracks are predicted and updated in place
+     * @return Results of completed sectors, in processing order
+     */
+    std::vector<SectorResult> push(const std::vector<RadarDetection>& detections, std::vector<Track>& tracks);
+
+    /**
+     * @brief Process the open sector and any held seam detections (end of stream)
+     */
+    std::vector<SectorResult> flush(std::vector<Track>& tracks);
+
+    /**
+     * @brief Sector of a detection
+     */
+    uint32_t sectorOf(const RadarDetection& detection) const;
+
+    size_t getSectorsProcessed() const { return sectors_processed_; }
+
+private:
+    /**
+     * @brief Azimuth (radians, atan2(y, x) convention) in the rotation frame, in [0, 2*pi)
+     */
+    double rotationAngle(double azimuth) const;
+
+    /**
+     * @brief Sectors from 'from' to 'to' in the rotation sense
+     */
+    uint32_t sectorsAhead(uint32_t from, uint32_t to) const {
+        return (to + config_.num_sectors - from) % config_.num_sectors;
+    }
+
+    void closeSector(uint32_t next_sector, std::vector<Track>& tracks, std::vector<SectorResult>& results);
+    void processBatch(uint32_t sector, bool leading_seam, bool trailing_seam,
+                      std::vector<Track>& tracks, std::vector<SectorResult>& results);
+
+    /**
+     * @brief Candidate and owned tracks of a sector
+     * @param leading_seam The batch holds the previous sector's seam band
+     * @param trailing_seam The sector's own seam band was held for the next sector
+     */
+    void selectTracks(uint32_t sector, bool leading_seam, bool trailing_seam,
+                      const std::vector<Track>& tracks, TimePoint time);
+};
+
+}  // namespace radar_tracking
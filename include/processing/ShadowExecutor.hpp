@@ -0,0 +1,235 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "interfaces/IAssociationAlgorithm.hpp"
+#include "interfaces/IClusteringAlgorithm.hpp"
+#include "processing/ScanPipeline.hpp"
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Runs a secondary clustering and association chain beside the primary scan
+ *
+ * For evaluating other algorithm variants on live traffic. The tracking
+ * thread calls beginScan() before the primary processScan() and
+ * completeScan() with its result afterwards. beginScan() takes shared
+ * ownership of the scan's detections (no copy) and, if the shadow thread is
+ * idle, copies the tracks' kinematic state (not their trajectories) into a
+ * reused buffer; if the shadow is still busy with an earlier scan, or the
+ * scan is not sampled, it returns at once and the scan is skipped. Nothing
+ * on the primary path ever waits for the shadow: both calls hand over
+ * through atomics and wake the shadow thread with an eventfd write, never
+ * taking a lock the low-priority thread could hold.
+ *
+ * The shadow thread, optionally pinned to spare cores and at idle or nice
+ * priority, clusters the detections (or reuses the primary's clusters, to
+ * evaluate association alone), extrapolates its track copies over dt with a
+ * constant-velocity model and associates them. Once the primary result has
+ * arrived it records per scan:
+ * - primary latency (the whole processScan()) and shadow clustering and
+ *   association latency;
+ * - cluster count difference and cluster mismatches: clusters without a
+ *   counterpart holding exactly the same detections (matched by
+ *   detection_id, which must be unique within a scan);
+ * - assignment disagreements: tracks the two chains assigned to different
+ *   clusters, or assigned in one chain only; a cluster is identified by its
+ *   lowest detection_id.
+ *
+ * Records are kept in a ring for getRecords(), optionally appended to a CSV
+ * file, and summarized in the log every log_interval_s.
+ */
+class ShadowExecutor {
+public:
+    /**
+     * @brief Algorithm of the shadow chain
+     */
+    struct AlgorithmSpec {
+        std::string type;                  ///< DBSCAN; JPDA or MHT. Clustering "primary": reuse the primary clusters
+        std::string config_file;
+    };
+
+    /**
+     * @brief Configuration (shadow section)
+     */
+    struct Config {
+        bool enabled = false;
+        AlgorithmSpec clustering{"DBSCAN", "config/algorithms/dbscan_config.yaml"};
+        AlgorithmSpec association{"JPDA", "config/algorithms/jpda_config.yaml"};
+        uint32_t sample_interval = 1;      ///< Shadow every Nth scan
+        std::vector<int> cpus;             ///< Pin the shadow thread to these cores; empty: any
+        bool idle_priority = true;         ///< SCHED_IDLE: runs only on otherwise idle cores (Linux)
+        int nice = 10;                     ///< Thread nice value when idle_priority is off
+        size_t history_size = 1024;        ///< Per-scan records kept for getRecords()
+        std::string record_file;           ///< CSV of per-scan records; empty: none
+        double log_interval_s = 10.0;      ///< Summary log period; 0: never
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+
+        bool reusesPrimaryClusters() const { return clustering.type == "primary"; }
+    };
+
+    /**
+     * @brief Comparison of one scan
+     */
+    struct ScanRecord {
+        uint64_t scan = 0;                 ///< Sampled scan number
+        double primary_ms = 0.0;
+        double clustering_ms = 0.0;        ///< 0 when reusing the primary clusters
+        double association_ms = 0.0;
+        uint32_t detections = 0;
+        uint32_t tracks = 0;
+        uint32_t primary_clusters = 0;
+        uint32_t shadow_clusters = 0;
+        uint32_t cluster_mismatches = 0;
+        uint32_t primary_assignments = 0;
+        uint32_t shadow_assignments = 0;
+        uint32_t assignment_disagreements = 0;
+    };
+
+    struct Stats {
+        uint64_t scans_compared = 0;
+        uint64_t scans_skipped = 0;        ///< Shadow still busy with an earlier scan
+        uint64_t scans_failed = 0;         ///< Shadow algorithm threw, or no primary result
+        double mean_primary_ms = 0.0;
+        double mean_shadow_ms = 0.0;       ///< Clustering plus association
+        double max_shadow_ms = 0.0;
+        double mean_cluster_count_diff = 0.0;   ///< Mean |shadow - primary| clusters per scan
+        uint64_t cluster_mismatches = 0;
+        uint64_t assignments_compared = 0; ///< Tracks assigned in either chain
+        uint64_t assignment_disagreements = 0;
+    };
+
+private:
+    struct Job {
+        uint64_t scan = 0;
+        std::shared_ptr<const std::vector<RadarDetection>> detections;
+        std::vector<Track> tracks;         ///< Kinematic copies, reused across scans
+        double dt = 0.0;
+        std::shared_ptr<const ScanResult> primary;  ///< Written by completeScan() before primary_done_
+        double primary_ms = 0.0;
+    };
+
+    Config config_;
+    std::unique_ptr<IClusteringAlgorithm> clustering_;
+    std::unique_ptr<IAssociationAlgorithm> association_;
+
+    std::thread worker_;
+    int wake_fd_ = -1;                     ///< eventfd the shadow thread blocks on (Linux)
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> busy_{false};        ///< job_ belongs to the shadow thread
+    std::atomic<bool> primary_done_{false};///< completeScan() was called (job_.primary may be null)
+    Job job_;
+    mutable std::mutex mutex_;             ///< Guards records_; never taken on the tracking thread
+
+    // Tracking thread only
+    uint64_t scan_counter_ = 0;
+    uint64_t sampled_scans_ = 0;
+    bool awaiting_result_ = false;         ///< beginScan() handed over a job, completeScan() not yet called
+
+    // Shadow thread only
+    std::vector<Cluster> clusters_;
+    std::vector<std::pair<uint32_t, uint32_t>> associations_;
+    std::unordered_map<uint64_t, uint32_t> primary_cluster_of_;  ///< detection_id -> primary cluster
+    std::vector<uint64_t> primary_lead_, shadow_lead_;           ///< Per track: assigned cluster's lowest id
+    std::ofstream record_stream_;
+
+    std::vector<ScanRecord> records_;      ///< Ring of the last history_size records
+    size_t record_next_ = 0;
+
+    std::atomic<uint64_t> scans_compared_{0};
+    std::atomic<uint64_t> scans_skipped_{0};
+    std::atomic<uint64_t> scans_failed_{0};
+    std::atomic<double> primary_ms_total_{0.0};
+    std::atomic<double> shadow_ms_total_{0.0};
+    std::atomic<double> max_shadow_ms_{0.0};
+    std::atomic<uint64_t> cluster_count_diff_total_{0};
+    std::atomic<uint64_t> cluster_mismatches_{0};
+    std::atomic<uint64_t> assignments_compared_{0};
+    std::atomic<uint64_t> assignment_disagreements_{0};
+
+public:
+    ShadowExecutor() = default;
+    ~ShadowExecutor();
+
+    ShadowExecutor(const ShadowExecutor&) = delete;
+    ShadowExecutor& operator=(const ShadowExecutor&) = delete;
+
+    bool initialize(const std::string& config_file);
+
+    /**
+     * @brief Create the configured shadow algorithms and start the shadow thread
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Start the shadow thread with given algorithm instances
+     * @param clustering Shadow clusterer (unused when reusing the primary clusters)
+     * @param association Shadow association algorithm
+     */
+    bool initialize(const Config& config,
+                    std::unique_ptr<IClusteringAlgorithm> clustering,
+                    std::unique_ptr<IAssociationAlgorithm> association);
+
+    void shutdown();
+
+    bool isEnabled() const { return config_.enabled; }
+
+    /**
+     * @brief Hand a scan to the shadow chain; call right before the primary processScan()
+     * @param detections The scan's detections, shared with the primary (not copied)
+     * @param tracks Tracks as the primary receives them
+     * @param dt Time since the previous scan (seconds)
+     * @return false if the scan is skipped (not sampled, or the shadow is busy)
+     */
+    bool beginScan(std::shared_ptr<const std::vector<RadarDetection>> detections,
+                   const std::vector<Track>& tracks, double dt);
+
+    /**
+     * @brief Hand the primary result of the scan to compare with
+     *
+     * Call after processScan() whenever beginScan() returned true; a null
+     * result abandons the comparison.
+     *
+     * @param primary_ms Primary processScan() latency
+     */
+    void completeScan(std::shared_ptr<const ScanResult> primary, double primary_ms);
+
+    Stats getStats() const;
+
+    /**
+     * @brief Per-scan records, oldest first
+     */
+    std::vector<ScanRecord> getRecords() const;
+
+    static std::unique_ptr<IClusteringAlgorithm> createClustering(const std::string& type);
+    static std::unique_ptr<IAssociationAlgorithm> createAssociation(const std::string& type);
+
+private:
+    void workerLoop();
+    void applyThreadPolicy();
+    void wake();
+    void waitForWake();
+    void runScan(Job& job);
+    void predictTracks(std::vector<Track>& tracks, double dt) const;
+    void compare(const ScanResult& primary, const std::vector<Cluster>& shadow_clusters, ScanRecord& record);
+    void addRecord(const ScanRecord& record);
+    void logSummary() const;
+};
+
+}  // namespace radar_tracking
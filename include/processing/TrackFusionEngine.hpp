@@ -0,0 +1,253 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "core/ThreadPool.hpp"
+#include "processing/TrackSpatialIndex.hpp"
+#include "tracking/FusionKernels.hpp"
+#include "utils/RecordingFormat.hpp"
+#include <Eigen/StdVector>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Track-to-track fusion of peer tracker streams into the local picture
+ *
+ * Remote tracks arrive from any number of sources, as the recording frames
+ * the output adapters already emit (ingestBytes(), e.g. from a peer's TCP
+ * or UDP track output) or as Track vectors from in-process sources. Ingestion
+ * only queues a compact copy under a short lock, so it can run on the
+ * communication threads at tens of thousands of tracks per second.
+ *
+ * fuse() applies the queued updates, aligns every local and remote state to
+ * the fusion time with a constant-velocity prediction, and associates remote
+ * tracks to local ones: candidates come from a TrackSpatialIndex over the
+ * local tracks, the gate is a 6-DOF chi-square test on position and
+ * velocity, and the assignment is greedy by distance with existing
+ * associations kept first, one remote track per source per local track.
+ * Associated pairs are fused with covariance intersection or, with the
+ * INFORMATION method, into a fused track the engine keeps per local track:
+ * each fusion adds only the information the local and remote tracks gained
+ * since the last one (their previous estimates are removed), so repeated
+ * fusion does not double count. A new association, or a step that is not
+ * positive definite, falls back to covariance intersection. Prediction, gating and
+ * fusion run as fixed-size 6x6 kernels over contiguous arrays, in chunks
+ * over the ThreadPool for large batches.
+ *
+ * Remote tracks no local track matches are appended to the picture under
+ * stable ids from remote_id_base. ingest*() may be called from any thread;
+ * fuse() from one thread at a time.
+ */
+class TrackFusionEngine {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+    using Vector6 = fusion::Vector<6>;
+    using Matrix6 = fusion::Matrix<6>;
+
+    enum class Method {
+        COVARIANCE_INTERSECTION,
+        INFORMATION              ///< Information-matrix fusion, CI on first contact and as fallback
+    };
+
+    /**
+     * @brief Configuration (track_fusion section)
+     */
+    struct Config {
+        Method method = Method::COVARIANCE_INTERSECTION;
+        double gate_chi2 = 16.81;              ///< Chi-square gate, 6 DOF (99%)
+        double process_noise = 1.0;            ///< CV acceleration density for time alignment (m^2/s^3)
+        double max_age_s = 2.0;                ///< Remote tracks not updated for this long are dropped
+        int ci_iterations = 12;                ///< Golden-section steps for the CI weight
+        bool include_remote_only = true;       ///< Add confirmed remote tracks no local track matches
+        uint32_t remote_id_base = 0x80000000u; ///< Ids of remote-only tracks start here
+        double cell_size_m = 2000.0;           ///< Candidate grid over local tracks
+        size_t chunk_size = 256;               ///< Pairs per ThreadPool task
+        size_t parallel_min_pairs = 1024;
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    struct Stats {
+        uint64_t fusions = 0;                  ///< fuse() calls
+        uint64_t remote_updates = 0;           ///< Remote track records ingested
+        uint64_t rejected_frames = 0;          ///< Undecodable or compressed input frames
+        uint64_t gate_tests = 0;
+        uint64_t associations = 0;             ///< Remote-local pairs fused
+        uint64_t new_associations = 0;         ///< Pairs not associated in the previous fusion
+        uint64_t information_fusions = 0;
+        uint64_t information_fallbacks = 0;    ///< Information fusion not positive definite, CI used
+        uint64_t remote_only = 0;              ///< Remote-only tracks published
+        size_t remote_tracks = 0;              ///< Remote tracks currently held
+        double last_fuse_ms = 0.0;
+    };
+
+private:
+    template<typename T>
+    using AlignedVector = std::vector<T, Eigen::aligned_allocator<T>>;
+
+    struct RemoteUpdate {
+        uint32_t source;
+        uint32_t track_id;
+        uint8_t state;
+        int64_t time_ns;
+        double x[6];
+        double P[21];                         ///< Upper triangle, row-major
+    };
+
+    struct Remote {
+        uint32_t source;
+        uint32_t track_id;
+        TrackState state;
+        int64_t time_ns;
+        uint32_t local_id = 0;                ///< Local track fused with last time, 0 if none
+        uint32_t output_id = 0;               ///< Id when published as remote-only
+        bool has_previous = false;            ///< previous_* hold the last fused remote estimate
+        int64_t previous_time_ns = 0;
+    };
+
+    struct History {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        uint32_t local_id;
+        int64_t time_ns;
+        Vector6 x;                            ///< Fused estimate at time_ns
+        Matrix6 P;
+        Vector6 local_x;                      ///< Local estimate fused into it
+        Matrix6 local_P;
+    };
+
+    struct Pair {
+        uint32_t remote;                      ///< Index into remotes_
+        uint32_t local;                       ///< Index into the local track vector
+        double distance2;
+        bool kept;                            ///< Associated in the previous fusion
+    };
+
+    Config config_;
+    Stats stats_;
+    ThreadPool* thread_pool_ = nullptr;
+
+    std::mutex pending_mutex_;
+    std::vector<RemoteUpdate> pending_;
+    std::unordered_map<uint32_t, std::vector<uint8_t>> partial_;  ///< Per-source stream reassembly
+    uint64_t pending_rejected_ = 0;
+
+    // Remote track table (structure of arrays, one slot per remote track)
+    std::vector<Remote> remotes_;
+    AlignedVector<Vector6> remote_x_;
+    AlignedVector<Matrix6> remote_P_;
+    AlignedVector<Vector6> previous_x_;
+    AlignedVector<Matrix6> previous_P_;
+    std::unordered_map<uint64_t, uint32_t> remote_index_;  ///< (source << 32 | track id) -> slot
+    uint32_t next_output_id_ = 0;
+
+    // Fused tracks kept for information fusion, one per local track fused last time
+    AlignedVector<History> history_, next_history_;
+    std::unordered_map<uint32_t, uint32_t> history_index_;  ///< Local track id -> history_ slot
+
+    // Per-fusion arrays
+    AlignedVector<Vector6> local_x_, aligned_remote_x_, fused_x_;
+    AlignedVector<Matrix6> local_P_, aligned_remote_P_, fused_P_;
+    std::vector<TrackSpatialIndex::Box> boxes_;
+    TrackSpatialIndex index_;
+    std::vector<Pair> pairs_;
+    std::vector<uint32_t> candidates_;
+    std::vector<int32_t> remote_match_;       ///< Local index per remote, -1 if unmatched
+    std::vector<uint8_t> outcome_;            ///< Per remote: how it was fused this time
+    std::unordered_set<uint64_t> local_sources_;  ///< (local << 32 | source) already matched
+    std::vector<uint32_t> matched_locals_;
+    std::vector<uint32_t> local_order_;       ///< Matched remotes grouped by local track
+    std::vector<uint32_t> local_start_;
+    std::vector<Track> output_;
+
+public:
+    TrackFusionEngine() = default;
+    explicit TrackFusionEngine(const Config& config);
+
+    const Config& getConfig() const { return config_; }
+    void setConfig(const Config& config);
+    Stats getStats() const { return stats_; }
+
+    /**
+     * @brief Distribute large batches over a thread pool (nullptr: serial)
+     */
+    void setThreadPool(ThreadPool* pool) { thread_pool_ = pool; }
+
+    /**
+     * @brief Queue remote tracks from an in-process source
+     */
+    void ingest(uint32_t source, const std::vector<Track>& tracks);
+
+    /**
+     * @brief Queue remote tracks from a byte stream of recording frames
+     *
+     * Accepts whole frames (datagrams) as well as arbitrary pieces of a TCP
+     * stream; partial frames are kept per source until completed. Frames
+     * other than uncompressed TRACKS are skipped.
+     *
+     * @return Number of remote track records queued
+     */
+    size_t ingestBytes(uint32_t source, const uint8_t* data, size_t size);
+
+    /**
+     * @brief Forget a source's remote tracks and partial input (peer disconnected)
+     */
+    void removeSource(uint32_t source);
+
+    /**
+     * @brief Fuse all remote tracks into the local picture at time now
+     * @param local Local tracks (not modified)
+     * @return Fused picture: local tracks, fused where associated, then remote-only tracks;
+     *         valid until the next call
+     */
+    const std::vector<Track>& fuse(const std::vector<Track>& local, TimePoint now);
+
+    size_t getRemoteTrackCount() const { return remotes_.size(); }
+
+    static Method parseMethod(const std::string& method);
+
+private:
+    void applyPending(int64_t now_ns);
+    void eraseRemote(uint32_t slot);
+    void alignStates(const std::vector<Track>& local, int64_t now_ns);
+    void findPairs(const std::vector<Track>& local);
+    void assign(const std::vector<Track>& local);
+    void fusePairs(const std::vector<Track>& local, int64_t now_ns);
+    void buildOutput(const std::vector<Track>& local, TimePoint now);
+
+    void predict(Vector6& x, Matrix6& P, double dt) const;
+    static void store(const Vector6& x, const Matrix6& P, Track& track);
+
+    template<typename Fn>
+    void forChunks(size_t count, Fn&& fn) {
+        const size_t chunk = std::max<size_t>(config_.chunk_size, 1);
+        if (!thread_pool_ || thread_pool_->getThreadCount() < 2 || count < config_.parallel_min_pairs) {
+            fn(size_t{0}, count);
+            return;
+        }
+        std::vector<std::future<void>> futures;
+        futures.reserve((count + chunk - 1) / chunk);
+        for (size_t begin = 0; begin < count; begin += chunk) {
+            const size_t end = std::min(count, begin + chunk);
+            futures.push_back(thread_pool_->enqueue([&fn, begin, end]() { fn(begin, end); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,113 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "processing/GatingContext.hpp"
+#include <yaml-cpp/yaml.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Uniform grid over predicted track gates for coarse gating
+ *
+ * Each track is entered into every horizontal grid cell overlapped by the
+ * axis-aligned bounding box of its gate ellipsoid. Entries are kept as a
+ * sorted (cell, track) array, so a rebuild is a single sort with no
+ * per-cell allocations, and a cluster query is a binary search followed by
+ * a box test on a handful of tracks. Track indices follow the scan's
+ * gating context, so the index is rebuilt every scan.
+ */
+class TrackSpatialIndex {
+public:
+    /**
+     * @brief Index configuration (processing.spatial_index section)
+     */
+    struct Config {
+        bool enabled = true;               ///< Use the index for candidate generation
+        double cell_size_m = 2000.0;       ///< Grid cell edge length
+        size_t min_tracks = 64;            ///< Below this, all pairs are cheaper
+        size_t max_cells_per_track = 64;   ///< Larger gates go to the always-checked list
+        double measurement_variance = 25.0;   ///< R for gate boxes when no filter kernel is bound (m^2)
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+    };
+
+    /**
+     * @brief Axis-aligned gate bounding box
+     */
+    struct Box {
+        double min_x, min_y, min_z;
+        double max_x, max_y, max_z;
+
+        bool contains(const Point3D& p) const {
+            return p.x >= min_x && p.x <= max_x && p.y >= min_y && p.y <= max_y &&
+                   p.z >= min_z && p.z <= max_z;
+        }
+    };
+
+private:
+    struct Entry {
+        uint64_t cell;
+        uint32_t track;
+
+        bool operator<(const Entry& other) const {
+            return cell < other.cell || (cell == other.cell && track < other.track);
+        }
+    };
+
+    Config config_;
+    double inv_cell_size_ = 1.0 / 2000.0;
+    std::vector<Box> boxes_;
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> always_check_;   ///< Oversized gates
+
+public:
+    TrackSpatialIndex() = default;
+    explicit TrackSpatialIndex(const Config& config);
+
+    const Config& getConfig() const { return config_; }
+    void setConfig(const Config& config);
+
+    /**
+     * @brief Rebuild from the per-scan gating context (call after predictTracks)
+     */
+    void build(const GatingContext& gating);
+
+    /**
+     * @brief Rebuild from explicit gate boxes
+     */
+    void build(const std::vector<Box>& boxes);
+
+    /**
+     * @brief Tracks whose gate box contains a point
+     * @param point Query position (cluster centroid)
+     * @param tracks Receives candidate track indices (cleared first)
+     */
+    void query(const Point3D& point, std::vector<uint32_t>& tracks) const;
+
+    /**
+     * @brief Candidate (track_index, cluster_index) pairs, sorted by track
+     */
+    std::vector<std::pair<uint32_t, uint32_t>> candidatePairs(const std::vector<Cluster>& clusters) const;
+
+    size_t getTrackCount() const { return boxes_.size(); }
+    size_t getEntryCount() const { return entries_.size(); }
+
+    /**
+     * @brief Gate bounding box of a track from the gating context
+     */
+    static Box gateBox(const GatingContext& gating, size_t track);
+
+private:
+    static uint64_t cellKey(int64_t ix, int64_t iy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(ix)) << 32) | static_cast<uint32_t>(iy);
+    }
+    int64_t cellCoord(double v) const { return static_cast<int64_t>(std::floor(v * inv_cell_size_)); }
+    void insertEntries(uint32_t track, const Box& box);
+};
+
+}  // namespace radar_tracking
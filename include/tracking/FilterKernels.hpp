@@ -0,0 +1,343 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "tracking/MotionModels.hpp"
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Header-only Kalman filter kernel for a fixed motion model
+ *
+ * Provides the same operations as ITracker without virtual dispatch, for
+ * use as the Filter parameter of StaticPipeline.
+ */
+template<typename Model>
+class KalmanKernel {
+public:
+    struct Params {
+        double process_noise = 1.0;          ///< Process noise spectral density
+        double measurement_noise = 25.0;     ///< Position measurement variance (m^2)
+        double initial_uncertainty = 1000.0; ///< Initial position variance (m^2)
+    };
+
+private:
+    Params params_;
+
+public:
+    KalmanKernel() = default;
+    explicit KalmanKernel(const Params& params) : params_(params) {}
+
+    const Params& getParams() const { return params_; }
+    void setParams(const Params& params) { params_ = params; }
+
+    void predict(Track& track, double dt) const {
+        motion::StateVector x;
+        motion::StateMatrix P, F, Q;
+        motion::loadTrackState(track, x, P);
+        Model::transition(x, dt, F);
+        Model::processNoise(dt, params_.process_noise, Q);
+        x = F * x;
+        P = F * P * F.transpose() + Q;
+        motion::storeTrackState(x, P, track);
+    }
+
+    motion::MeasMatrix innovationCovariance(const Track& track) const {
+        motion::MeasMatrix S = motion::ConstTrackCovarianceMap(&track.covariance[0][0]).topLeftCorner<3, 3>();
+        S.diagonal().array() += params_.measurement_noise;
+        return S;
+    }
+
+    void update(Track& track, const RadarDetection& detection) const {
+        motion::StateVector x;
+        motion::StateMatrix P;
+        motion::loadTrackState(track, x, P);
+
+        motion::MeasMatrix S = P.topLeftCorner<3, 3>();
+        S.diagonal().array() += params_.measurement_noise;
+        const motion::MeasVector y = motion::measurementOf(detection) - x.head<3>();
+        const Eigen::LLT<motion::MeasMatrix> llt(S);
+
+        // K = P H^T S^-1, with H selecting the position states
+        const motion::GainMatrix PHt = P.leftCols<3>();
+        const motion::GainMatrix K = llt.solve(PHt.transpose()).transpose();
+        x += K * y;
+        P -= K * PHt.transpose();
+        P = 0.5 * (P + P.transpose());
+
+        motion::storeTrackState(x, P, track);
+        track.last_update = detection.timestamp;
+        track.valid_time = detection.timestamp;
+    }
+
+    Track initializeTrack(const RadarDetection& detection) const {
+        Track track;
+        track.position = detection.position;
+        track.velocity = detection.velocity;
+        track.last_update = detection.timestamp;
+        track.valid_time = detection.timestamp;
+        for (int i = 0; i < 3; ++i) {
+            track.covariance[i][i] = params_.initial_uncertainty;
+            track.covariance[i + 3][i + 3] = params_.initial_uncertainty * 0.01;
+            track.covariance[i + 6][i + 6] = params_.initial_uncertainty * 0.001;
+        }
+        return track;
+    }
+
+    void retainTracks(const std::vector<Track>& /*tracks*/) {}
+
+    /**
+     * @brief Filter state beyond Track (none: the estimate lives in Track)
+     */
+    struct Snapshot {};
+    Snapshot snapshot(const Track& /*track*/) const { return {}; }
+    void restore(const Track& /*track*/, const Snapshot& /*snapshot*/) {}
+};
+
+using KalmanCVKernel = KalmanKernel<motion::ConstantVelocityModel>;
+using KalmanCAKernel = KalmanKernel<motion::ConstantAccelerationModel>;
+
+/**
+ * @brief Header-only Interacting Multiple Model kernel (CV, CA, CT)
+ *
+ * Per-track model-conditioned states and mode probabilities are kept in a
+ * side table keyed by track ID; the combined estimate is written to Track.
+ */
+class IMMKernel {
+public:
+    static constexpr int NUM_MODELS = 3;
+
+    enum ModelType { CV = 0, CA = 1, CT = 2 };
+
+    struct ModelParams {
+        double initial_probability = 1.0 / NUM_MODELS;
+        double process_noise = 1.0;
+        double measurement_noise = 25.0;
+    };
+
+    struct Params {
+        std::array<ModelParams, NUM_MODELS> models;
+        std::array<std::array<double, NUM_MODELS>, NUM_MODELS> transition = {{
+            {{0.95, 0.04, 0.01}},
+            {{0.05, 0.90, 0.05}},
+            {{0.02, 0.08, 0.90}}
+        }};
+        double mixing_threshold = 1e-6;
+        double initial_position_variance = 10000.0;
+        double initial_velocity_variance = 100.0;
+        double initial_acceleration_variance = 10.0;
+
+        /**
+         * @brief Load parameters from an imm_config.yaml document
+         */
+        void loadFromYaml(const YAML::Node& node);
+    };
+
+    struct ModeState {
+        std::array<double, NUM_MODELS> probability;
+        std::array<motion::StateVector, NUM_MODELS> x;
+        std::array<motion::StateMatrix, NUM_MODELS> P;
+    };
+
+private:
+    Params params_;
+    std::unordered_map<uint32_t, ModeState> mode_states_;
+    std::vector<uint32_t> live_ids_;     ///< retainTracks() scratch
+
+public:
+    IMMKernel() = default;
+    explicit IMMKernel(const Params& params) : params_(params) {}
+
+    const Params& getParams() const { return params_; }
+    void setParams(const Params& params) { params_ = params; }
+
+    /**
+     * @brief Mode probabilities of a track (uniform prior if unknown)
+     */
+    std::array<double, NUM_MODELS> getModeProbabilities(uint32_t track_id) const {
+        auto it = mode_states_.find(track_id);
+        if (it != mode_states_.end()) {
+            return it->second.probability;
+        }
+        return {{params_.models[CV].initial_probability, params_.models[CA].initial_probability,
+                 params_.models[CT].initial_probability}};
+    }
+
+    void predict(Track& track, double dt) {
+        ModeState& mode = modeStateFor(track);
+
+        // Mixing: predicted mode probabilities and mixed initial conditions
+        std::array<double, NUM_MODELS> c{};
+        for (int j = 0; j < NUM_MODELS; ++j) {
+            for (int i = 0; i < NUM_MODELS; ++i) {
+                c[j] += params_.transition[i][j] * mode.probability[i];
+            }
+        }
+
+        std::array<motion::StateVector, NUM_MODELS> x0;
+        std::array<motion::StateMatrix, NUM_MODELS> P0;
+        for (int j = 0; j < NUM_MODELS; ++j) {
+            x0[j].setZero();
+            P0[j].setZero();
+            if (c[j] <= 0.0) {
+                x0[j] = mode.x[j];
+                P0[j] = mode.P[j];
+                continue;
+            }
+            for (int i = 0; i < NUM_MODELS; ++i) {
+                x0[j] += (params_.transition[i][j] * mode.probability[i] / c[j]) * mode.x[i];
+            }
+            for (int i = 0; i < NUM_MODELS; ++i) {
+                const double w = params_.transition[i][j] * mode.probability[i] / c[j];
+                const motion::StateVector dx = mode.x[i] - x0[j];
+                P0[j] += w * (mode.P[i] + dx * dx.transpose());
+            }
+        }
+
+        predictModel<motion::ConstantVelocityModel>(x0[CV], P0[CV], dt, params_.models[CV].process_noise);
+        predictModel<motion::ConstantAccelerationModel>(x0[CA], P0[CA], dt, params_.models[CA].process_noise);
+        predictModel<motion::CoordinatedTurnModel>(x0[CT], P0[CT], dt, params_.models[CT].process_noise);
+
+        mode.x = x0;
+        mode.P = P0;
+        mode.probability = c;
+        combine(mode, track);
+    }
+
+    motion::MeasMatrix innovationCovariance(const Track& track) const {
+        motion::MeasMatrix S = motion::ConstTrackCovarianceMap(&track.covariance[0][0]).topLeftCorner<3, 3>();
+        S.diagonal().array() += params_.models[CV].measurement_noise;
+        return S;
+    }
+
+    void update(Track& track, const RadarDetection& detection) {
+        ModeState& mode = modeStateFor(track);
+        const motion::MeasVector z = motion::measurementOf(detection);
+
+        std::array<double, NUM_MODELS> likelihood{};
+        double normalizer = 0.0;
+        for (int j = 0; j < NUM_MODELS; ++j) {
+            motion::MeasMatrix S = mode.P[j].topLeftCorner<3, 3>();
+            S.diagonal().array() += params_.models[j].measurement_noise;
+            const motion::MeasVector y = z - mode.x[j].head<3>();
+            const Eigen::LLT<motion::MeasMatrix> llt(S);
+
+            const motion::GainMatrix PHt = mode.P[j].leftCols<3>();
+            const motion::GainMatrix K = llt.solve(PHt.transpose()).transpose();
+            mode.x[j] += K * y;
+            mode.P[j] -= K * PHt.transpose();
+            mode.P[j] = 0.5 * (mode.P[j] + mode.P[j].transpose());
+
+            // Gaussian likelihood via the Cholesky factor
+            const motion::MeasVector w = llt.matrixL().solve(y);
+            const double log_det = 2.0 * llt.matrixLLT().diagonal().array().log().sum();
+            likelihood[j] = std::exp(-0.5 * (w.squaredNorm() + log_det + 3.0 * std::log(2.0 * M_PI)));
+            normalizer += likelihood[j] * mode.probability[j];
+        }
+
+        if (normalizer > 0.0) {
+            double total = 0.0;
+            for (int j = 0; j < NUM_MODELS; ++j) {
+                mode.probability[j] = std::max(likelihood[j] * mode.probability[j] / normalizer,
+                                               params_.mixing_threshold);
+                total += mode.probability[j];
+            }
+            for (int j = 0; j < NUM_MODELS; ++j) {
+                mode.probability[j] /= total;
+            }
+        }
+
+        combine(mode, track);
+        track.last_update = detection.timestamp;
+        track.valid_time = detection.timestamp;
+    }
+
+    Track initializeTrack(const RadarDetection& detection) {
+        Track track;
+        track.position = detection.position;
+        track.velocity = detection.velocity;
+        track.last_update = detection.timestamp;
+        track.valid_time = detection.timestamp;
+        for (int i = 0; i < 3; ++i) {
+            track.covariance[i][i] = params_.initial_position_variance;
+            track.covariance[i + 3][i + 3] = params_.initial_velocity_variance;
+            track.covariance[i + 6][i + 6] = params_.initial_acceleration_variance;
+        }
+        return track;
+    }
+
+    /**
+     * @brief Drop mode state of tracks that no longer exist
+     *
+     * Checked every scan: a deletion and a creation in the same scan leave
+     * the count unchanged but the deleted track's mode state stale.
+     */
+    void retainTracks(const std::vector<Track>& tracks) {
+        live_ids_.clear();
+        for (const auto& track : tracks) {
+            live_ids_.push_back(track.track_id);
+        }
+        std::sort(live_ids_.begin(), live_ids_.end());
+        for (auto it = mode_states_.begin(); it != mode_states_.end();) {
+            if (std::binary_search(live_ids_.begin(), live_ids_.end(), it->first)) {
+                ++it;
+            } else {
+                it = mode_states_.erase(it);
+            }
+        }
+    }
+
+    /**
+     * @brief Filter state beyond Track: model-conditioned states and probabilities
+     */
+    using Snapshot = ModeState;
+    Snapshot snapshot(const Track& track) { return modeStateFor(track); }
+    void restore(const Track& track, const Snapshot& snapshot) { mode_states_[track.track_id] = snapshot; }
+
+private:
+    template<typename Model>
+    static void predictModel(motion::StateVector& x, motion::StateMatrix& P, double dt, double q) {
+        motion::StateMatrix F, Q;
+        Model::transition(x, dt, F);
+        Model::processNoise(dt, q, Q);
+        x = F * x;
+        P = F * P * F.transpose() + Q;
+    }
+
+    ModeState& modeStateFor(const Track& track) {
+        auto it = mode_states_.find(track.track_id);
+        if (it != mode_states_.end()) {
+            return it->second;
+        }
+        ModeState mode;
+        motion::StateVector x;
+        motion::StateMatrix P;
+        motion::loadTrackState(track, x, P);
+        for (int j = 0; j < NUM_MODELS; ++j) {
+            mode.probability[j] = params_.models[j].initial_probability;
+            mode.x[j] = x;
+            mode.P[j] = P;
+        }
+        return mode_states_.emplace(track.track_id, mode).first->second;
+    }
+
+    static void combine(const ModeState& mode, Track& track) {
+        motion::StateVector x = motion::StateVector::Zero();
+        for (int j = 0; j < NUM_MODELS; ++j) {
+            x += mode.probability[j] * mode.x[j];
+        }
+        motion::StateMatrix P = motion::StateMatrix::Zero();
+        for (int j = 0; j < NUM_MODELS; ++j) {
+            const motion::StateVector dx = mode.x[j] - x;
+            P += mode.probability[j] * (mode.P[j] + dx * dx.transpose());
+        }
+        motion::storeTrackState(x, P, track);
+    }
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,132 @@
+#pragma once
+#include <Eigen/Dense>
+#include <algorithm>
+
+namespace radar_tracking {
+
+/**
+ * @brief Header-only track-to-track fusion kernels on fixed-size states
+ *
+ * Both kernels work on any state dimension N (3 for position, 6 for
+ * position and velocity), so the per-pair work compiles to unrolled,
+ * vectorized fixed-size Eigen code with no allocations.
+ */
+namespace fusion {
+
+template<int N>
+using Vector = Eigen::Matrix<double, N, 1>;
+template<int N>
+using Matrix = Eigen::Matrix<double, N, N>;
+
+/**
+ * @brief Covariance intersection of two estimates with unknown cross-correlation
+ *
+ * P^-1 = w A^-1 + (1 - w) B^-1 and x = P (w A^-1 a + (1 - w) B^-1 b), with
+ * the weight w chosen by golden-section search to minimize trace(P). The
+ * result is consistent whatever the correlation between a and b, which is
+ * what makes it safe for tracks that may share measurements or priors.
+ *
+ * @param iterations Golden-section steps; each narrows w by a factor 0.618
+ * @param omega Receives the chosen weight of a (may be nullptr)
+ * @return false if A or B is not positive definite
+ */
+template<int N>
+bool covarianceIntersection(const Vector<N>& a, const Matrix<N>& A, const Vector<N>& b, const Matrix<N>& B,
+                            int iterations, Vector<N>& x, Matrix<N>& P, double* omega = nullptr) {
+    const Matrix<N> I = Matrix<N>::Identity();
+    const Eigen::LLT<Matrix<N>> llt_a(A);
+    const Eigen::LLT<Matrix<N>> llt_b(B);
+    if (llt_a.info() != Eigen::Success || llt_b.info() != Eigen::Success) {
+        return false;
+    }
+    const Matrix<N> Ai = llt_a.solve(I);
+    const Matrix<N> Bi = llt_b.solve(I);
+
+    auto cost = [&](double w) {
+        const Eigen::LLT<Matrix<N>> llt(w * Ai + (1.0 - w) * Bi);
+        return llt.solve(I).trace();
+    };
+
+    constexpr double ratio = 0.6180339887498949;
+    double lo = 0.0;
+    double hi = 1.0;
+    double c = hi - ratio * (hi - lo);
+    double d = lo + ratio * (hi - lo);
+    double fc = cost(c);
+    double fd = cost(d);
+    for (int i = 0; i < iterations; ++i) {
+        if (fc < fd) {
+            hi = d;
+            d = c;
+            fd = fc;
+            c = hi - ratio * (hi - lo);
+            fc = cost(c);
+        } else {
+            lo = c;
+            c = d;
+            fc = fd;
+            d = lo + ratio * (hi - lo);
+            fd = cost(d);
+        }
+    }
+
+    // The trace is convex in w, but the minimum can sit at an end (one estimate dominates)
+    double w = 0.5 * (lo + hi);
+    double best = cost(w);
+    if (A.trace() < best) {
+        w = 1.0;
+        best = A.trace();
+    }
+    if (B.trace() < best) {
+        w = 0.0;
+    }
+
+    const Matrix<N> Y = w * Ai + (1.0 - w) * Bi;
+    const Eigen::LLT<Matrix<N>> llt(Y);
+    P = llt.solve(I);
+    x = P * (w * (Ai * a) + (1.0 - w) * (Bi * b));
+    if (omega) {
+        *omega = w;
+    }
+    return true;
+}
+
+/**
+ * @brief Information-matrix fusion with removal of previously fused information
+ *
+ * Y = A^-1 + B^-1 - B0^-1, where (a, A) is the fused estimate and (b0, B0)
+ * is the estimate of source b already fused into it, both extrapolated to
+ * the current time: only the information b gained since then is added, so
+ * repeated fusion of the same stream does not double count. Exact when the
+ * source tracker's process noise is small between fusions; the caller
+ * should fall back to covariance intersection when this returns false.
+ *
+ * @return false if any input or the fused information is not positive definite
+ */
+template<int N>
+bool informationFusion(const Vector<N>& a, const Matrix<N>& A, const Vector<N>& b, const Matrix<N>& B,
+                       const Vector<N>& b0, const Matrix<N>& B0, Vector<N>& x, Matrix<N>& P) {
+    const Matrix<N> I = Matrix<N>::Identity();
+    const Eigen::LLT<Matrix<N>> llt_a(A);
+    const Eigen::LLT<Matrix<N>> llt_b(B);
+    const Eigen::LLT<Matrix<N>> llt_b0(B0);
+    if (llt_a.info() != Eigen::Success || llt_b.info() != Eigen::Success || llt_b0.info() != Eigen::Success) {
+        return false;
+    }
+    const Matrix<N> Ai = llt_a.solve(I);
+    const Matrix<N> Bi = llt_b.solve(I);
+    const Matrix<N> B0i = llt_b0.solve(I);
+
+    const Matrix<N> Y = Ai + Bi - B0i;
+    const Eigen::LLT<Matrix<N>> llt(Y);
+    if (llt.info() != Eigen::Success) {
+        return false;
+    }
+    P = llt.solve(I);
+    x = P * (Ai * a + Bi * b - B0i * b0);
+    return true;
+}
+
+}  // namespace fusion
+
+}  // namespace radar_tracking
@@ -0,0 +1,174 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "core/ThreadPool.hpp"
+#include "tracking/FilterKernels.hpp"
+#include "tracking/MotionModels.hpp"
+#include <Eigen/StdVector>
+#include <algorithm>
+#include <array>
+#include <future>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Batched Interacting Multiple Model engine (CV, CA, CT)
+ *
+ * Model-conditioned states live in structure-of-arrays slots with
+ * fixed-size matrices per model dimension (6 for CV, 9 for CA and CT), so
+ * mixing, prediction and update for all tracks run as tight loops over
+ * contiguous storage. Transition and process noise matrices that depend
+ * only on dt are built once per scan. Tracks are processed in chunks,
+ * distributed over the ThreadPool for large track counts.
+ *
+ * Models whose probability is below mixing_threshold are not mixed into
+ * the others, and a model whose predicted probability falls below it is
+ * not propagated for that scan.
+ */
+class IMMBatchEngine {
+public:
+    static constexpr int NUM_MODELS = IMMKernel::NUM_MODELS;
+    using Params = IMMKernel::Params;
+
+    /**
+     * @brief Work distribution (imm_config.yaml performance.batch)
+     */
+    struct BatchConfig {
+        size_t chunk_size = 128;            ///< Tracks per task
+        size_t parallel_min_tracks = 256;   ///< Use the pool from this many tracks
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+    };
+
+private:
+    using CVVector = Eigen::Matrix<double, 6, 1>;
+    using CVMatrix = Eigen::Matrix<double, 6, 6>;
+    template<typename T>
+    using AlignedVector = std::vector<T, Eigen::aligned_allocator<T>>;
+
+    Params params_;
+    BatchConfig batch_;
+    ThreadPool* thread_pool_ = nullptr;
+
+    // Slot storage (structure of arrays, one slot per track)
+    AlignedVector<CVVector> cv_x_;
+    AlignedVector<CVMatrix> cv_P_;
+    AlignedVector<motion::StateVector> ca_x_, ct_x_;
+    AlignedVector<motion::StateMatrix> ca_P_, ct_P_;
+    std::array<std::vector<double>, NUM_MODELS> probability_;
+    std::vector<uint8_t> active_;          ///< Bit j set: model j propagated this scan
+    std::vector<uint32_t> last_seen_;
+
+    std::unordered_map<uint32_t, uint32_t> slot_of_id_;
+    std::vector<uint32_t> free_slots_;
+    std::vector<uint32_t> track_slot_;     ///< Slot of each track index this scan
+    uint32_t scan_ = 0;
+
+    // Shared per-dt matrices
+    double prepared_dt_ = -1.0;
+    CVMatrix F_cv_, Q_cv_;
+    motion::StateMatrix F_ca_, Q_ca_, Q_ct_;
+
+public:
+    IMMBatchEngine() = default;
+    explicit IMMBatchEngine(const Params& params) : params_(params) {}
+    IMMBatchEngine(const Params& params, const BatchConfig& batch) : params_(params), batch_(batch) {}
+
+    const Params& getParams() const { return params_; }
+    void setParams(const Params& params) { params_ = params; prepared_dt_ = -1.0; }
+    const BatchConfig& getBatchConfig() const { return batch_; }
+    void setBatchConfig(const BatchConfig& batch) { batch_ = batch; }
+
+    /**
+     * @brief Distribute track chunks over a thread pool (nullptr: serial)
+     */
+    void setThreadPool(ThreadPool* pool) { thread_pool_ = pool; }
+
+    /**
+     * @brief Mix and predict every track, writing the combined estimates
+     *
+     * Also drops the state of tracks that are no longer present.
+     */
+    void predictAll(std::vector<Track>& tracks, double dt);
+
+    /**
+     * @brief Update tracks with their associated measurements
+     * @param tracks Tracks predicted by predictAll() this scan
+     * @param measurements (track_index, measurement) pairs
+     */
+    void updateAll(std::vector<Track>& tracks,
+                   const std::vector<std::pair<uint32_t, RadarDetection>>& measurements);
+
+    // Per-track filter interface (StaticPipeline / GatingContext)
+    void predict(Track& track, double dt);
+    motion::MeasMatrix innovationCovariance(const Track& track) const;
+    void update(Track& track, const RadarDetection& detection);
+    Track initializeTrack(const RadarDetection& detection) const;
+    void retainTracks(const std::vector<Track>& tracks);
+
+    /**
+     * @brief Filter state beyond Track: mode probabilities and model-conditioned states
+     *
+     * The CV model's state is embedded in the 9-dimensional layout, as in
+     * IMMKernel, so snapshots of both IMM implementations are interchangeable.
+     */
+    using Snapshot = IMMKernel::ModeState;
+    Snapshot snapshot(const Track& track);
+    void restore(const Track& track, const Snapshot& snapshot);
+
+    /**
+     * @brief Mode probabilities of a track (initial probabilities if unknown)
+     */
+    std::array<double, NUM_MODELS> getModeProbabilities(uint32_t track_id) const;
+
+    size_t getTrackCount() const { return slot_of_id_.size(); }
+
+private:
+    uint32_t slotFor(const Track& track);
+    void releaseUnseen();
+    void prepareScan(double dt);
+    void predictSlot(uint32_t slot);
+    void updateSlot(uint32_t slot, const motion::MeasVector& z);
+    void combineSlot(uint32_t slot, Track& track) const;
+
+    /**
+     * @brief Embed a CV state into the 9-dimensional state space
+     */
+    void embedCV(uint32_t slot, motion::StateVector& x, motion::StateMatrix& P) const;
+
+    /**
+     * @brief Mixed initial condition of one target model in its leading Dim states
+     */
+    template<int Dim>
+    static void mixInto(const std::array<double, NUM_MODELS>& w, double w_total, int target,
+                        const motion::StateVector* const* src_x, const motion::StateMatrix* const* src_P,
+                        Eigen::Matrix<double, Dim, 1>& x0, Eigen::Matrix<double, Dim, Dim>& P0);
+
+    /**
+     * @brief Run fn(begin, end) over [0, count) in chunks, in parallel when worthwhile
+     */
+    template<typename Fn>
+    void forChunks(size_t count, Fn&& fn) {
+        const size_t chunk = std::max<size_t>(batch_.chunk_size, 1);
+        if (!thread_pool_ || thread_pool_->getThreadCount() < 2 || count < batch_.parallel_min_tracks) {
+            fn(size_t{0}, count);
+            return;
+        }
+        std::vector<std::future<void>> futures;
+        futures.reserve((count + chunk - 1) / chunk);
+        for (size_t begin = 0; begin < count; begin += chunk) {
+            const size_t end = std::min(count, begin + chunk);
+            futures.push_back(thread_pool_->enqueue([&fn, begin, end]() { fn(begin, end); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+};
+
+}  // namespace radar_tracking
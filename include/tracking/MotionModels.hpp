@@ -0,0 +1,144 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include <Eigen/Dense>
+#include <cmath>
+
+namespace radar_tracking {
+
+/**
+ * @brief Fixed-size state-space motion models
+ *
+ * All models share the 9-element state layout used by Track:
+ * [x y z vx vy vz ax ay az]. Matrices are fixed-size so that filter code
+ * built on them is fully inlinable and vectorizable.
+ */
+namespace motion {
+
+constexpr int STATE_DIM = 9;
+constexpr int MEAS_DIM = 3;
+
+using StateVector = Eigen::Matrix<double, STATE_DIM, 1>;
+using StateMatrix = Eigen::Matrix<double, STATE_DIM, STATE_DIM>;
+using MeasVector = Eigen::Matrix<double, MEAS_DIM, 1>;
+using MeasMatrix = Eigen::Matrix<double, MEAS_DIM, MEAS_DIM>;
+using GainMatrix = Eigen::Matrix<double, STATE_DIM, MEAS_DIM>;
+using TrackCovarianceMap = Eigen::Map<Eigen::Matrix<double, STATE_DIM, STATE_DIM, Eigen::RowMajor>>;
+using ConstTrackCovarianceMap = Eigen::Map<const Eigen::Matrix<double, STATE_DIM, STATE_DIM, Eigen::RowMajor>>;
+
+/**
+ * @brief Copy track kinematics and covariance into filter form
+ */
+inline void loadTrackState(const Track& track, StateVector& x, StateMatrix& P) {
+    x << track.position.x, track.position.y, track.position.z,
+         track.velocity.x, track.velocity.y, track.velocity.z,
+         track.acceleration.x, track.acceleration.y, track.acceleration.z;
+    P = ConstTrackCovarianceMap(&track.covariance[0][0]);
+}
+
+/**
+ * @brief Write filter state back into a track
+ */
+inline void storeTrackState(const StateVector& x, const StateMatrix& P, Track& track) {
+    track.position = Point3D(x(0), x(1), x(2));
+    track.velocity = Point3D(x(3), x(4), x(5));
+    track.acceleration = Point3D(x(6), x(7), x(8));
+    TrackCovarianceMap(&track.covariance[0][0]) = P;
+}
+
+/**
+ * @brief Position measurement of a detection
+ */
+inline MeasVector measurementOf(const RadarDetection& detection) {
+    return MeasVector(detection.position.x, detection.position.y, detection.position.z);
+}
+
+/**
+ * @brief Constant velocity model; acceleration states are driven to zero
+ */
+struct ConstantVelocityModel {
+    static void transition(const StateVector& /*x*/, double dt, StateMatrix& F) {
+        F.setZero();
+        F.topLeftCorner<6, 6>().setIdentity();
+        F.block<3, 3>(0, 3).diagonal().setConstant(dt);
+    }
+
+    static void processNoise(double dt, double q, StateMatrix& Q) {
+        const double dt2 = dt * dt;
+        Q.setZero();
+        for (int i = 0; i < 3; ++i) {
+            Q(i, i) = 0.25 * dt2 * dt2 * q;
+            Q(i, i + 3) = Q(i + 3, i) = 0.5 * dt2 * dt * q;
+            Q(i + 3, i + 3) = dt2 * q;
+        }
+    }
+};
+
+/**
+ * @brief Constant acceleration (Wiener process acceleration) model
+ */
+struct ConstantAccelerationModel {
+    static void transition(const StateVector& /*x*/, double dt, StateMatrix& F) {
+        F.setIdentity();
+        F.block<3, 3>(0, 3).diagonal().setConstant(dt);
+        F.block<3, 3>(0, 6).diagonal().setConstant(0.5 * dt * dt);
+        F.block<3, 3>(3, 6).diagonal().setConstant(dt);
+    }
+
+    static void processNoise(double dt, double q, StateMatrix& Q) {
+        const double dt2 = dt * dt;
+        const double dt3 = dt2 * dt;
+        Q.setZero();
+        for (int i = 0; i < 3; ++i) {
+            Q(i, i) = dt3 * dt2 / 20.0 * q;
+            Q(i, i + 3) = Q(i + 3, i) = dt2 * dt2 / 8.0 * q;
+            Q(i, i + 6) = Q(i + 6, i) = dt3 / 6.0 * q;
+            Q(i + 3, i + 3) = dt3 / 3.0 * q;
+            Q(i + 3, i + 6) = Q(i + 6, i + 3) = dt2 / 2.0 * q;
+            Q(i + 6, i + 6) = dt * q;
+        }
+    }
+};
+
+/**
+ * @brief Horizontal coordinated turn model
+ *
+ * The turn rate is derived from the current velocity and acceleration
+ * (omega = (vx*ay - vy*ax) / |v|^2); vertical motion is constant velocity.
+ */
+struct CoordinatedTurnModel {
+    static double turnRate(const StateVector& x) {
+        const double speed2 = x(3) * x(3) + x(4) * x(4);
+        return speed2 > 1e-6 ? (x(3) * x(7) - x(4) * x(6)) / speed2 : 0.0;
+    }
+
+    static void transition(const StateVector& x, double dt, StateMatrix& F) {
+        const double omega = turnRate(x);
+        if (std::abs(omega) < 1e-6) {
+            ConstantVelocityModel::transition(x, dt, F);
+            return;
+        }
+        const double s = std::sin(omega * dt);
+        const double c = std::cos(omega * dt);
+
+        F.setZero();
+        F.topLeftCorner<6, 6>().setIdentity();
+        F(0, 3) = s / omega;          F(0, 4) = -(1.0 - c) / omega;
+        F(1, 3) = (1.0 - c) / omega;  F(1, 4) = s / omega;
+        F(2, 5) = dt;
+        F(3, 3) = c;  F(3, 4) = -s;
+        F(4, 3) = s;  F(4, 4) = c;
+        // Centripetal acceleration rotates with the velocity vector
+        F(6, 6) = c;  F(6, 7) = -s;
+        F(7, 6) = s;  F(7, 7) = c;
+    }
+
+    static void processNoise(double dt, double q, StateMatrix& Q) {
+        ConstantVelocityModel::processNoise(dt, q, Q);
+        for (int i = 6; i < 8; ++i) {
+            Q(i, i) = dt * q * 0.1;
+        }
+    }
+};
+
+}  // namespace motion
+}  // namespace radar_tracking
@@ -0,0 +1,264 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "tracking/MotionModels.hpp"
+#include "utils/CheckpointSection.hpp"
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Detects filters whose per-track state beyond Track can be saved and restored
+ */
+template<typename Filter, typename = void>
+struct HasSnapshotInterface : std::false_type {};
+
+template<typename Filter>
+struct HasSnapshotInterface<Filter, std::void_t<typename Filter::Snapshot,
+                                                decltype(std::declval<Filter&>().snapshot(std::declval<const Track&>()))>>
+    : std::true_type {};
+
+/**
+ * @brief Configuration (processing.oosm section)
+ */
+struct OOSMConfig {
+    bool enabled = false;
+    size_t window = 8;                 ///< Recorded updates per track
+    double max_lag_s = 2.0;            ///< Older measurements are dropped
+    double tolerance_s = 1e-4;         ///< Lateness treated as in sequence
+
+    /**
+     * @brief Load configuration from YAML node
+     */
+    void loadFromYaml(const YAML::Node& node) {
+        if (!node) {
+            return;
+        }
+        enabled = node["enabled"].as<bool>(enabled);
+        window = node["window"].as<size_t>(window);
+        max_lag_s = node["max_lag_s"].as<double>(max_lag_s);
+        tolerance_s = node["tolerance_s"].as<double>(tolerance_s);
+    }
+};
+
+/**
+ * @brief Out-of-sequence measurement handling by bounded replay
+ *
+ * Every in-sequence update is recorded in a fixed-capacity, time-ordered
+ * window per track: the measurement, the posterior mean and packed upper
+ * covariance, and the filter's own per-track state (Filter::Snapshot, e.g.
+ * IMM mode states or square-root factors). A measurement older than the
+ * track's time of validity is fused by restoring the last recorded state at
+ * or before its time, predicting to it and updating, then replaying the
+ * recorded updates after it and predicting back to the original time of
+ * validity. Only the affected track is touched, and the replay is bounded
+ * by the window, so late data needs no reorder buffer in front of the
+ * pipeline.
+ *
+ * Filters without the snapshot interface (the particle filter) are not
+ * supported; the pipeline leaves OOSM handling disabled for them.
+ */
+template<typename Filter>
+class OOSMHandler {
+public:
+    using TimePoint = std::chrono::high_resolution_clock::time_point;
+
+    using Config = OOSMConfig;
+
+    struct Stats {
+        size_t recorded = 0;
+        size_t retrodicted = 0;
+        size_t replayed_updates = 0;
+        size_t dropped = 0;                ///< Older than the window or max_lag_s
+    };
+
+private:
+    using Snapshot = typename Filter::Snapshot;
+    static constexpr int PACKED = motion::STATE_DIM * (motion::STATE_DIM + 1) / 2;
+
+    struct Entry {
+        TimePoint time;
+        RadarDetection measurement;
+        motion::StateVector x;
+        std::array<double, PACKED> packed_P;
+        Snapshot snapshot;
+    };
+
+    Config config_;
+    Stats stats_;
+    std::unordered_map<uint32_t, std::vector<Entry>> windows_;
+    std::vector<uint32_t> live_ids_;   ///< retainTracks() scratch
+
+public:
+    OOSMHandler() = default;
+    explicit OOSMHandler(const Config& config) : config_(config) {}
+
+    const Config& getConfig() const { return config_; }
+    void setConfig(const Config& config) { config_ = config; windows_.clear(); }
+    const Stats& getStats() const { return stats_; }
+    size_t getWindowCount() const { return windows_.size(); }
+
+    /**
+     * @brief Check whether a measurement predates the track's time of validity
+     */
+    bool isLate(const Track& track, const RadarDetection& measurement) const {
+        return std::chrono::duration<double>(track.valid_time - measurement.timestamp).count() > config_.tolerance_s;
+    }
+
+    /**
+     * @brief Record the posterior after an in-sequence update
+     */
+    void record(const Track& track, const RadarDetection& measurement, Filter& filter) {
+        auto& window = windows_[track.track_id];
+        Entry entry = capture(track, measurement, filter);
+        auto position = std::upper_bound(window.begin(), window.end(), entry.time,
+                                         [](const TimePoint& t, const Entry& e) { return t < e.time; });
+        window.insert(position, std::move(entry));
+        if (window.size() > std::max<size_t>(config_.window, 1)) {
+            window.erase(window.begin());
+        }
+        ++stats_.recorded;
+    }
+
+    /**
+     * @brief Fuse a late measurement by restoring, updating and replaying
+     * @return false if the measurement is outside the window (dropped)
+     */
+    bool retrodict(Track& track, const RadarDetection& measurement, Filter& filter) {
+        auto found = windows_.find(track.track_id);
+        const double lag = std::chrono::duration<double>(track.valid_time - measurement.timestamp).count();
+        if (found == windows_.end() || lag > config_.max_lag_s) {
+            ++stats_.dropped;
+            return false;
+        }
+        auto& window = found->second;
+
+        // Last recorded update at or before the late measurement
+        auto after = std::upper_bound(window.begin(), window.end(), measurement.timestamp,
+                                      [](const TimePoint& t, const Entry& entry) { return t < entry.time; });
+        if (after == window.begin()) {
+            ++stats_.dropped;
+            return false;
+        }
+        const TimePoint valid_time = track.valid_time;
+        const TimePoint last_update = track.last_update;
+
+        restoreEntry(*(after - 1), track, filter);
+        predictTo(track, measurement.timestamp, filter);
+        filter.update(track, measurement);
+        const size_t inserted = static_cast<size_t>(after - window.begin());
+        window.insert(after, capture(track, measurement, filter));
+
+        for (size_t i = inserted + 1; i < window.size(); ++i) {
+            Entry& entry = window[i];
+            predictTo(track, entry.time, filter);
+            filter.update(track, entry.measurement);
+            entry = capture(track, entry.measurement, filter);
+            ++stats_.replayed_updates;
+        }
+        if (window.size() > std::max<size_t>(config_.window, 1)) {
+            window.erase(window.begin());
+        }
+
+        predictTo(track, valid_time, filter);
+        track.last_update = std::max(last_update, measurement.timestamp);
+        ++stats_.retrodicted;
+        return true;
+    }
+
+    /**
+     * @brief Drop windows of tracks that no longer exist
+     *
+     * Checked every scan: a deletion and a creation in the same scan leave
+     * the count unchanged but the deleted track's window stale.
+     */
+    void retainTracks(const std::vector<Track>& tracks) {
+        live_ids_.clear();
+        for (const auto& track : tracks) {
+            live_ids_.push_back(track.track_id);
+        }
+        std::sort(live_ids_.begin(), live_ids_.end());
+        for (auto it = windows_.begin(); it != windows_.end();) {
+            if (std::binary_search(live_ids_.begin(), live_ids_.end(), it->first)) {
+                ++it;
+            } else {
+                it = windows_.erase(it);
+            }
+        }
+    }
+
+    /**
+     * @brief Copy the replay windows of the given tracks into a checkpoint section
+     */
+    void exportWindows(const std::vector<Track>& tracks, const std::string& tag,
+                       CheckpointSection& section) const {
+        section.begin<Entry>(tag);
+        for (const auto& track : tracks) {
+            auto it = windows_.find(track.track_id);
+            if (it == windows_.end()) {
+                continue;
+            }
+            for (const Entry& entry : it->second) {
+                section.append(track.track_id, entry);
+            }
+        }
+    }
+
+    /**
+     * @brief Replace all replay windows with a checkpoint section's
+     * @return false if the section was written by another filter (windows left empty)
+     */
+    bool importWindows(const CheckpointSection& section, const std::string& tag) {
+        windows_.clear();
+        if (!section.matches<Entry>(tag)) {
+            return false;
+        }
+        Entry entry;
+        uint32_t track_id = 0;
+        for (uint32_t i = 0; i < section.count; ++i) {
+            section.read(i, track_id, entry);
+            windows_[track_id].push_back(entry);  // Exported in time order
+        }
+        return true;
+    }
+
+private:
+    static void predictTo(Track& track, TimePoint time, Filter& filter) {
+        const double dt = std::chrono::duration<double>(time - track.valid_time).count();
+        if (dt > 0.0) {
+            filter.predict(track, dt);
+            track.valid_time = time;
+        }
+    }
+
+    static Entry capture(const Track& track, const RadarDetection& measurement, Filter& filter) {
+        Entry entry{track.valid_time, measurement, {}, {}, filter.snapshot(track)};
+        motion::StateMatrix P;
+        motion::loadTrackState(track, entry.x, P);
+        for (int i = 0, k = 0; i < motion::STATE_DIM; ++i) {
+            for (int j = i; j < motion::STATE_DIM; ++j) {
+                entry.packed_P[k++] = P(i, j);
+            }
+        }
+        return entry;
+    }
+
+    static void restoreEntry(const Entry& entry, Track& track, Filter& filter) {
+        motion::StateMatrix P;
+        for (int i = 0, k = 0; i < motion::STATE_DIM; ++i) {
+            for (int j = i; j < motion::STATE_DIM; ++j) {
+                P(i, j) = P(j, i) = entry.packed_P[k++];
+            }
+        }
+        motion::storeTrackState(entry.x, P, track);
+        track.valid_time = entry.time;
+        filter.restore(track, entry.snapshot);
+    }
+};
+
+}  // namespace radar_tracking
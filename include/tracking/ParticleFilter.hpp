@@ -0,0 +1,266 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "core/ThreadPool.hpp"
+#include "tracking/MotionModels.hpp"
+#include <yaml-cpp/yaml.h>
+#include <Eigen/StdVector>
+#include <algorithm>
+#include <array>
+#include <future>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Structure-of-arrays particle storage for many tracks
+ *
+ * Each block holds the particles of one track in two halves (current and
+ * resampling target), and each half stores one contiguous float array per
+ * component. Component arrays are padded to a multiple of 16 floats so that
+ * propagation and likelihood loops vectorize without remainder handling.
+ * Released blocks are reused; storage only grows when the track count does.
+ */
+class ParticleArena {
+public:
+    enum Component { PX, PY, PZ, VX, VY, VZ, OMEGA, WEIGHT, NUM_COMPONENTS };
+
+    /**
+     * @brief Set the particle count per block (drops all blocks)
+     */
+    void configure(size_t particles_per_block);
+
+    /**
+     * @brief Preallocate storage for a number of blocks
+     */
+    void reserve(size_t blocks);
+
+    size_t acquire();
+    void release(size_t block);
+
+    float* data(size_t block, int half, int component) {
+        return data_.data() + ((block * 2 + half) * NUM_COMPONENTS + component) * stride_;
+    }
+    const float* data(size_t block, int half, int component) const {
+        return data_.data() + ((block * 2 + half) * NUM_COMPONENTS + component) * stride_;
+    }
+
+    size_t particles() const { return particles_; }
+    size_t blockCount() const { return blocks_; }
+
+private:
+    size_t particles_ = 0;
+    size_t stride_ = 0;
+    size_t blocks_ = 0;
+    std::vector<float, Eigen::aligned_allocator<float>> data_;
+    std::vector<size_t> free_blocks_;
+};
+
+/**
+ * @brief Bootstrap particle filter for manoeuvring targets
+ *
+ * Particles follow a nearly coordinated turn in the horizontal plane (with
+ * a per-particle turn rate driven by a random walk) and constant velocity
+ * in height, with white acceleration noise on every axis. Positions are
+ * stored in float relative to a per-track origin that is re-centred as the
+ * track moves, so single precision holds at long range.
+ *
+ * Weights are linear and normalized after each update, with likelihoods
+ * taken relative to the most likely particle. The effective sample size
+ * decides whether to resample; resampling is systematic and writes into
+ * the block's spare half, so it never allocates. Resampled particles
+ * are jittered with a shrinkage kernel that preserves the mean and
+ * variance, so the cloud keeps its diversity at high update rates.
+ *
+ * Tracks are processed in chunks over the ThreadPool; tracks with at least
+ * split_min_particles particles are instead split into particle slices
+ * processed in parallel.
+ *
+ * Provides the filter interface of StaticPipeline, including the batched
+ * predictAll/updateAll hooks.
+ */
+class ParticleFilter {
+public:
+    /**
+     * @brief Configuration parameters (particle_config.yaml)
+     */
+    struct Config {
+        size_t particles_per_track = 1024;
+        double resample_threshold = 0.5;       ///< Resample when ESS < threshold * N
+        double regularization = 0.5;           ///< Kernel bandwidth of post-resampling jitter (0: off)
+        double acceleration_noise = 3.0;       ///< White acceleration std (m/s^2)
+        double turn_rate_noise = 0.05;         ///< Turn rate random walk (rad/s per sqrt(s))
+        double max_turn_rate = 0.35;           ///< Turn rate clamp (rad/s)
+        double measurement_variance = 25.0;    ///< Position measurement variance (m^2)
+        double initial_position_std = 30.0;    ///< Spread of new tracks (m)
+        double initial_velocity_std = 15.0;    ///< Spread of new tracks (m/s)
+        double initial_turn_rate_std = 0.05;   ///< Spread of new tracks (rad/s)
+        double recenter_distance_m = 1000.0;   ///< Move the track origin beyond this offset
+        uint32_t seed = 42;
+
+        size_t chunk_size = 8;                 ///< Tracks per thread pool task
+        size_t parallel_min_tracks = 32;       ///< Use the pool from this many tracks
+        size_t split_min_particles = 16384;    ///< Split a track's particles from this count
+        size_t slice_size = 4096;              ///< Particles per slice when split
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+private:
+    static constexpr size_t MAX_SLICES = 64;
+
+    /**
+     * @brief Weighted sums over a particle range
+     *
+     * Position and velocity sums are of deviations d = [p v] - pivot.
+     */
+    struct Moments {
+        double weight = 0.0;
+        std::array<double, 6> pivot{};     ///< Reference state (relative coordinates)
+        std::array<double, 6> first{};     ///< Sum w * d
+        std::array<double, 21> second{};   ///< Sum w * d d^T, upper triangle
+        std::array<double, 2> accel{};     ///< Sum w * (omega x v) in the plane
+        std::array<double, 2> turn{};      ///< Sum w * omega and w * omega^2
+
+        void merge(const Moments& other);
+    };
+
+    Config config_;
+    ThreadPool* thread_pool_ = nullptr;
+    ParticleArena arena_;
+
+    // Per-slot metadata (slot == arena block)
+    std::vector<uint8_t> half_;                   ///< Active half of the block
+    std::vector<uint32_t> epoch_;                 ///< Noise stream counter
+    std::vector<uint32_t> last_seen_;
+    std::vector<float> ess_;
+    std::vector<std::array<double, 3>> origin_;   ///< Position offset of the particles
+
+    std::unordered_map<uint32_t, uint32_t> slot_of_id_;
+    std::vector<uint32_t> track_slot_;            ///< Slot of each track index this scan
+    uint32_t scan_ = 0;
+
+public:
+    ParticleFilter();
+    explicit ParticleFilter(const Config& config);
+
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Set configuration (drops all particle state)
+     */
+    void setConfig(const Config& config);
+
+    /**
+     * @brief Distribute tracks or particle slices over a thread pool (nullptr: serial)
+     */
+    void setThreadPool(ThreadPool* pool) { thread_pool_ = pool; }
+
+    /**
+     * @brief Preallocate particle storage for a number of tracks
+     */
+    void reserve(size_t tracks);
+
+    /**
+     * @brief Propagate every track, writing the weighted estimates
+     *
+     * Also drops the particles of tracks that are no longer present.
+     */
+    void predictAll(std::vector<Track>& tracks, double dt);
+
+    /**
+     * @brief Weight (and if needed resample) tracks with their measurements
+     * @param tracks Tracks predicted by predictAll() this scan
+     * @param measurements (track_index, measurement) pairs
+     */
+    void updateAll(std::vector<Track>& tracks,
+                   const std::vector<std::pair<uint32_t, RadarDetection>>& measurements);
+
+    // Per-track filter interface (StaticPipeline / GatingContext)
+    void predict(Track& track, double dt);
+    motion::MeasMatrix innovationCovariance(const Track& track) const;
+    void update(Track& track, const RadarDetection& detection);
+    Track initializeTrack(const RadarDetection& detection) const;
+    void retainTracks(const std::vector<Track>& tracks);
+
+    /**
+     * @brief Effective sample size of a track after its last update (0 if unknown)
+     */
+    double getEffectiveSampleSize(uint32_t track_id) const;
+
+    size_t getTrackCount() const { return slot_of_id_.size(); }
+
+private:
+    uint32_t slotFor(const Track& track);
+    void seedSlot(uint32_t slot, const Track& track);
+    void releaseUnseen();
+
+    void predictSlot(uint32_t slot, double dt, size_t slices);
+    void updateSlot(uint32_t slot, const motion::MeasVector& z, size_t slices);
+    void resampleSlot(uint32_t slot, const std::array<double, MAX_SLICES>& slice_weight,
+                      double total_weight, size_t slices);
+    void regularizeSlot(uint32_t slot, const Moments& moments, size_t slices);
+    Moments slotMoments(uint32_t slot, size_t slices);
+    void combineSlot(uint32_t slot, Track& track, size_t slices);
+
+    void propagateRange(uint32_t slot, float dt, size_t begin, size_t end);
+    Moments momentsRange(uint32_t slot, const std::array<float, 6>& pivot, size_t begin, size_t end) const;
+
+    /**
+     * @brief Number of particle slices per track (1 unless splitting is worthwhile)
+     */
+    size_t sliceCount() const;
+    std::pair<size_t, size_t> sliceRange(size_t slice, size_t slices) const;
+
+    /**
+     * @brief Run fn(slice) for every slice, on the pool when there are several
+     */
+    template<typename Fn>
+    void runSlices(size_t slices, Fn&& fn) {
+        if (slices <= 1) {
+            fn(size_t{0});
+            return;
+        }
+        std::vector<std::future<void>> futures;
+        futures.reserve(slices - 1);
+        for (size_t s = 1; s < slices; ++s) {
+            futures.push_back(thread_pool_->enqueue([&fn, s]() { fn(s); }));
+        }
+        fn(size_t{0});
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+
+    /**
+     * @brief Run fn(begin, end) over [0, count) tracks in chunks, in parallel when worthwhile
+     */
+    template<typename Fn>
+    void forChunks(size_t count, Fn&& fn) {
+        const size_t chunk = std::max<size_t>(config_.chunk_size, 1);
+        if (!thread_pool_ || thread_pool_->getThreadCount() < 2 || count < config_.parallel_min_tracks) {
+            fn(size_t{0}, count);
+            return;
+        }
+        std::vector<std::future<void>> futures;
+        futures.reserve((count + chunk - 1) / chunk);
+        for (size_t begin = 0; begin < count; begin += chunk) {
+            const size_t end = std::min(count, begin + chunk);
+            futures.push_back(thread_pool_->enqueue([&fn, begin, end]() { fn(begin, end); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    }
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,354 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "interfaces/ITracker.hpp"
+#include "tracking/MotionModels.hpp"
+#include <yaml-cpp/yaml.h>
+#include <Eigen/Cholesky>
+#include <Eigen/QR>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Header-only square-root covariance Kalman kernel
+ *
+ * Each track's covariance is carried as a lower-triangular factor S with
+ * P = S S^T, stored in Scalar precision in a side table keyed by track ID.
+ * Prediction re-triangularizes [F S, Q^1/2] and the update triangularizes
+ * the (measurement + state) pre-array, both with Householder QR, so P stays
+ * symmetric positive semi-definite by construction and the filter is
+ * stable in float. The track mean stays in double, and Track::covariance
+ * receives S S^T after every step for gating and output.
+ *
+ * Provides the filter interface of StaticPipeline.
+ */
+template<typename Model, typename Scalar = float>
+class SquareRootKalmanKernel {
+public:
+    static constexpr int N = motion::STATE_DIM;
+    static constexpr int M = motion::MEAS_DIM;
+
+    using Factor = Eigen::Matrix<Scalar, N, N>;
+
+    struct Params {
+        double process_noise = 1.0;          ///< Process noise spectral density
+        double measurement_noise = 25.0;     ///< Position measurement variance (m^2)
+        double initial_uncertainty = 1000.0; ///< Initial position variance (m^2)
+    };
+
+private:
+    Params params_;
+    std::unordered_map<uint32_t, Factor> factors_;
+    std::vector<uint32_t> live_ids_;     ///< retainTracks() scratch
+
+    // Q^1/2 depends only on dt
+    double prepared_dt_ = -1.0;
+    Factor noise_factor_;
+
+public:
+    SquareRootKalmanKernel() = default;
+    explicit SquareRootKalmanKernel(const Params& params) : params_(params) {}
+
+    const Params& getParams() const { return params_; }
+    void setParams(const Params& params) { params_ = params; prepared_dt_ = -1.0; }
+
+    void predict(Track& track, double dt) {
+        Factor& S = factorFor(track);
+        motion::StateVector x;
+        loadMean(track, x);
+
+        motion::StateMatrix F;
+        Model::transition(x, dt, F);
+        prepareNoise(dt);
+        x = F * x;
+
+        // [F S, Q^1/2] [F S, Q^1/2]^T = F P F^T + Q
+        Eigen::Matrix<Scalar, 2 * N, N> pre;
+        pre.template topRows<N>().noalias() = (F.template cast<Scalar>() * S).transpose();
+        pre.template bottomRows<N>() = noise_factor_.transpose();
+        triangularize(pre);
+        S = pre.template topRows<N>().template triangularView<Eigen::Upper>().transpose();
+
+        store(x, S, track);
+    }
+
+    motion::MeasMatrix innovationCovariance(const Track& track) const {
+        motion::MeasMatrix S = motion::ConstTrackCovarianceMap(&track.covariance[0][0]).topLeftCorner<3, 3>();
+        S.diagonal().array() += params_.measurement_noise;
+        return S;
+    }
+
+    void update(Track& track, const RadarDetection& detection) {
+        Factor& S = factorFor(track);
+        motion::StateVector x;
+        loadMean(track, x);
+
+        // Pre-array [[R^1/2, H S], [0, S]]; an orthogonal transform from the
+        // right gives the lower-triangular post-array [[Se, 0], [Kbar, S+]],
+        // with Se Se^T = H P H^T + R and K = Kbar Se^-1. The transpose is
+        // triangularized so that the reflections run down contiguous columns.
+        Eigen::Matrix<Scalar, M + N, M + N> pre = Eigen::Matrix<Scalar, M + N, M + N>::Zero();
+        pre.template topLeftCorner<M, M>().diagonal().setConstant(
+            static_cast<Scalar>(std::sqrt(params_.measurement_noise)));
+        pre.template bottomLeftCorner<N, M>() = S.template topRows<M>().transpose();
+        pre.template bottomRightCorner<N, N>() = S.transpose();
+        triangularize(pre);
+        const Eigen::Matrix<Scalar, M + N, M + N> post =
+            pre.template triangularView<Eigen::Upper>().transpose();
+
+        const Eigen::Matrix<Scalar, M, M> Se = post.template topLeftCorner<M, M>();
+        const Eigen::Matrix<Scalar, N, M> Kbar = post.template bottomLeftCorner<N, M>();
+        S = post.template bottomRightCorner<N, N>();
+
+        const motion::MeasVector y = motion::measurementOf(detection) - x.head<3>();
+        const Eigen::Matrix<Scalar, M, 1> w = Se.template triangularView<Eigen::Lower>().solve(y.template cast<Scalar>());
+        x += (Kbar * w).template cast<double>();
+
+        store(x, S, track);
+        track.last_update = detection.timestamp;
+        track.valid_time = detection.timestamp;
+    }
+
+    /**
+     * @brief Squared Mahalanobis distance of a detection under the innovation covariance
+     */
+    double mahalanobisSquared(const Track& track, const RadarDetection& detection) const {
+        const motion::MeasVector y = motion::measurementOf(detection) -
+                                     motion::MeasVector(track.position.x, track.position.y, track.position.z);
+        const Eigen::LLT<motion::MeasMatrix> llt(innovationCovariance(track));
+        return llt.matrixL().solve(y).squaredNorm();
+    }
+
+    Track initializeTrack(const RadarDetection& detection) const {
+        Track track;
+        track.position = detection.position;
+        track.velocity = detection.velocity;
+        track.last_update = detection.timestamp;
+        track.valid_time = detection.timestamp;
+        for (int i = 0; i < 3; ++i) {
+            track.covariance[i][i] = params_.initial_uncertainty;
+            track.covariance[i + 3][i + 3] = params_.initial_uncertainty * 0.01;
+            track.covariance[i + 6][i + 6] = params_.initial_uncertainty * 0.001;
+        }
+        return track;
+    }
+
+    /**
+     * @brief Drop factors of tracks that no longer exist
+     *
+     * Checked every scan: a deletion and a creation in the same scan leave
+     * the count unchanged but the deleted track's factor stale.
+     */
+    void retainTracks(const std::vector<Track>& tracks) {
+        live_ids_.clear();
+        for (const auto& track : tracks) {
+            live_ids_.push_back(track.track_id);
+        }
+        std::sort(live_ids_.begin(), live_ids_.end());
+        for (auto it = factors_.begin(); it != factors_.end();) {
+            if (std::binary_search(live_ids_.begin(), live_ids_.end(), it->first)) {
+                ++it;
+            } else {
+                it = factors_.erase(it);
+            }
+        }
+    }
+
+    /**
+     * @brief Re-derive a track's factor from Track::covariance on its next step
+     *
+     * Needed only when something other than this kernel rewrites the covariance.
+     */
+    void invalidate(uint32_t track_id) { factors_.erase(track_id); }
+
+    /**
+     * @brief Filter state beyond Track: the covariance factor
+     */
+    using Snapshot = Factor;
+    Snapshot snapshot(const Track& track) { return factorFor(track); }
+    void restore(const Track& track, const Snapshot& snapshot) { factors_[track.track_id] = snapshot; }
+
+    /**
+     * @brief Factor S (P = S S^T) of a track, or nullptr if unknown
+     */
+    const Factor* getFactor(uint32_t track_id) const {
+        auto it = factors_.find(track_id);
+        return it == factors_.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * @brief Lower-triangular factor of a symmetric positive semi-definite matrix
+     *
+     * Cholesky when P is positive definite; otherwise pivoted LDL^T with
+     * negative pivots (from rounding) clamped to zero.
+     */
+    static Factor psdFactor(const motion::StateMatrix& P) {
+        const Eigen::LLT<motion::StateMatrix> llt(P);
+        if (llt.info() == Eigen::Success) {
+            return llt.matrixL().toDenseMatrix().template cast<Scalar>();
+        }
+        const Eigen::LDLT<motion::StateMatrix> ldlt(P);
+        const motion::StateVector d = ldlt.vectorD().cwiseMax(0.0).cwiseSqrt();
+        motion::StateMatrix L = ldlt.matrixL().toDenseMatrix() * d.asDiagonal();
+        L = ldlt.transpositionsP().transpose() * L;
+
+        // L L^T = P but L is not triangular after un-pivoting; re-triangularize
+        const Eigen::HouseholderQR<motion::StateMatrix> qr(L.transpose());
+        return qr.matrixQR().template triangularView<Eigen::Upper>().transpose().toDenseMatrix().template cast<Scalar>();
+    }
+
+private:
+    /**
+     * @brief In-place Householder triangularization A -> R (A = Q R), Q discarded
+     *
+     * Only the upper triangle of the result is meaningful. Each reflector
+     * spans the whole column (zero above the pivot), so the dot products and
+     * column updates are fixed-length and vectorize.
+     */
+    template<int Rows, int Cols>
+    static void triangularize(Eigen::Matrix<Scalar, Rows, Cols>& A) {
+        static_assert(Rows >= Cols, "triangularize expects a tall matrix");
+        Eigen::Matrix<Scalar, Rows, 1> v;
+        for (int k = 0; k < Cols; ++k) {
+            v = A.col(k);
+            v.head(k + 1).setZero();
+            const Scalar tail = v.squaredNorm();
+            if (tail == Scalar(0)) {
+                continue;
+            }
+            const Scalar alpha = A(k, k);
+            const Scalar norm = std::sqrt(alpha * alpha + tail);
+            const Scalar beta = alpha > 0 ? -norm : norm;
+            v(k) = alpha - beta;
+            const Scalar scale = Scalar(2) / (v(k) * v(k) + tail);
+
+            A(k, k) = beta;
+            for (int j = k + 1; j < Cols; ++j) {
+                A.col(j) -= (scale * v.dot(A.col(j))) * v;
+            }
+        }
+    }
+
+    static void loadMean(const Track& track, motion::StateVector& x) {
+        x << track.position.x, track.position.y, track.position.z,
+             track.velocity.x, track.velocity.y, track.velocity.z,
+             track.acceleration.x, track.acceleration.y, track.acceleration.z;
+    }
+
+    static void store(const motion::StateVector& x, const Factor& S, Track& track) {
+        const motion::StateMatrix Sd = S.template cast<double>();
+        motion::StateMatrix P = Sd * Sd.transpose();
+        P = 0.5 * (P + P.transpose());
+        motion::storeTrackState(x, P, track);
+    }
+
+    Factor& factorFor(const Track& track) {
+        auto it = factors_.find(track.track_id);
+        if (it != factors_.end()) {
+            return it->second;
+        }
+        return factors_.emplace(track.track_id,
+                                psdFactor(motion::ConstTrackCovarianceMap(&track.covariance[0][0]))).first->second;
+    }
+
+    void prepareNoise(double dt) {
+        if (dt == prepared_dt_) {
+            return;
+        }
+        prepared_dt_ = dt;
+        motion::StateMatrix Q;
+        Model::processNoise(dt, params_.process_noise, Q);
+        noise_factor_ = psdFactor(Q);
+    }
+};
+
+using SquareRootKalmanCVKernel = SquareRootKalmanKernel<motion::ConstantVelocityModel, float>;
+using SquareRootKalmanCAKernel = SquareRootKalmanKernel<motion::ConstantAccelerationModel, float>;
+
+/**
+ * @brief Square-root covariance Kalman filter (float32 factors)
+ *
+ * ITracker wrapper around SquareRootKalmanKernel with a constant velocity
+ * or constant acceleration model.
+ */
+class SquareRootKalmanFilter : public ITracker {
+public:
+    /**
+     * @brief Configuration parameters (srkf_config.yaml)
+     */
+    struct Config {
+        std::string motion_model = "CV";     ///< CV or CA
+        double process_noise = 1.0;
+        double measurement_noise = 25.0;
+        double initial_uncertainty = 1000.0;
+
+        uint32_t confirmation_hits = 3;      ///< Hits before a track is confirmed
+        uint32_t max_consecutive_misses = 5; ///< Misses before a track is deleted
+        double max_position_std = 500.0;     ///< Delete when the position std exceeds this (m)
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+
+        /**
+         * @brief Kernel parameters
+         */
+        SquareRootKalmanCVKernel::Params kernelParams() const;
+    };
+
+private:
+    Config config_;
+    bool constant_acceleration_ = false;
+    SquareRootKalmanCVKernel cv_kernel_;
+    SquareRootKalmanCAKernel ca_kernel_;
+
+public:
+    SquareRootKalmanFilter() = default;
+    explicit SquareRootKalmanFilter(const Config& config);
+
+    // ITracker interface implementation
+    bool initialize(const std::string& config_file) override;
+    void predict(Track& track, double dt) override;
+    void update(Track& track, const RadarDetection& detection) override;
+
+    /**
+     * @brief Squared Mahalanobis distance of the detection under the innovation covariance
+     */
+    double getInnovationCovariance(const Track& track, const RadarDetection& detection) override;
+    Track initializeTrack(const RadarDetection& detection) override;
+    std::string getTrackerType() const override { return "SRKF"; }
+    double calculateQualityScore(const Track& track) const override;
+    bool shouldConfirmTrack(const Track& track) const override;
+    bool shouldDeleteTrack(const Track& track) const override;
+
+    /**
+     * @brief Drop factors of tracks that no longer exist
+     */
+    void retainTracks(const std::vector<Track>& tracks) override;
+
+    /**
+     * @brief Export the covariance factors (tag SRKF-CV or SRKF-CA)
+     */
+    void exportState(const std::vector<Track>& tracks, CheckpointSection& section) override;
+    bool importState(const std::vector<Track>& tracks, const CheckpointSection& section) override;
+
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Set configuration (drops all factors)
+     */
+    void setConfig(const Config& config);
+
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,272 @@
+#pragma once
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace radar_tracking {
+
+namespace async_log_detail {
+
+/**
+ * @brief Binary encoding of one log argument
+ *
+ * Arithmetic values are copied as is, enums as their underlying integer and
+ * strings as a 32-bit length plus bytes (decoded as string_view into the
+ * log buffer). Other argument types must be converted at the call site.
+ */
+template<typename T, typename = void>
+struct Codec {
+    static_assert(sizeof(T) == 0, "LOG_ASYNC_* arguments must be arithmetic, enum or string");
+};
+
+template<typename T>
+struct Codec<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+    using Decoded = T;
+    static size_t size(const T&) { return sizeof(T); }
+    static void encode(uint8_t*& out, const T& value) {
+        std::memcpy(out, &value, sizeof(T));
+        out += sizeof(T);
+    }
+    static T decode(const uint8_t*& in) {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return value;
+    }
+};
+
+template<typename T>
+struct Codec<T, std::enable_if_t<std::is_enum_v<T>>> {
+    using Underlying = std::underlying_type_t<T>;
+    using Decoded = Underlying;
+    static size_t size(const T&) { return sizeof(Underlying); }
+    static void encode(uint8_t*& out, const T& value) {
+        Codec<Underlying>::encode(out, static_cast<Underlying>(value));
+    }
+    static Decoded decode(const uint8_t*& in) { return Codec<Underlying>::decode(in); }
+};
+
+struct StringCodec {
+    using Decoded = std::string_view;
+    static size_t size(std::string_view value) { return sizeof(uint32_t) + value.size(); }
+    static void encode(uint8_t*& out, std::string_view value) {
+        const auto length = static_cast<uint32_t>(value.size());
+        std::memcpy(out, &length, sizeof(length));
+        std::memcpy(out + sizeof(length), value.data(), length);
+        out += sizeof(length) + length;
+    }
+    static std::string_view decode(const uint8_t*& in) {
+        uint32_t length;
+        std::memcpy(&length, in, sizeof(length));
+        std::string_view value(reinterpret_cast<const char*>(in + sizeof(length)), length);
+        in += sizeof(length) + length;
+        return value;
+    }
+};
+
+template<> struct Codec<std::string> : StringCodec {};
+template<> struct Codec<std::string_view> : StringCodec {};
+template<> struct Codec<const char*> : StringCodec {};
+template<> struct Codec<char*> : StringCodec {};
+
+}  // namespace async_log_detail
+
+/**
+ * @brief Asynchronous binary logging front-end (LOG_ASYNC_* macros)
+ *
+ * A call site whose level is enabled copies its arguments, a pointer to the
+ * format string literal and a pointer to a per-signature decoder into the
+ * calling thread's own single-producer ring buffer; no string is formatted
+ * and no lock is taken. A background thread drains every thread's buffer,
+ * orders the batch by capture time, formats each record with fmt and hands
+ * it to the system spdlog logger with its original timestamp. A full buffer
+ * drops the record (counted) rather than blocking the producer.
+ *
+ * When the front-end is not running, records are formatted synchronously
+ * through the system logger instead.
+ */
+class AsyncLog {
+public:
+    /**
+     * @brief Static description of a call site
+     */
+    struct Site {
+        spdlog::level::level_enum level;
+        const char* file;
+        int line;
+    };
+
+    /**
+     * @brief Configuration (logging.async section)
+     */
+    struct Config {
+        bool enabled = false;
+        size_t buffer_kb = 64;              ///< Per-thread ring size (rounded up to a power of two)
+        uint32_t flush_interval_ms = 5;     ///< Background drain period
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+    };
+
+    struct Stats {
+        uint64_t written = 0;
+        uint64_t dropped = 0;
+        size_t threads = 0;
+    };
+
+private:
+    using FormatFn = void (*)(const char* format, const uint8_t* args, fmt::memory_buffer& out);
+
+    struct RecordHeader {
+        uint32_t size;                      ///< Whole record incl. header and padding; 0 marks a wrap
+        uint32_t reserved;
+        const Site* site;
+        const char* format;
+        FormatFn format_fn;
+        int64_t timestamp;                  ///< spdlog::log_clock ticks
+    };
+
+    static constexpr size_t RECORD_ALIGN = alignof(RecordHeader);
+
+    /**
+     * @brief Per-thread single-producer single-consumer byte ring
+     */
+    struct Buffer {
+        std::vector<uint8_t> data;
+        uint64_t mask;
+        alignas(64) std::atomic<uint64_t> head{0};  ///< Producer position (bytes written)
+        uint64_t cached_tail = 0;                   ///< Producer's view of tail
+        uint64_t reserved_head = 0;
+        alignas(64) std::atomic<uint64_t> tail{0};  ///< Consumer position (bytes released)
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<bool> orphaned{false};          ///< Owning thread has exited
+
+        explicit Buffer(size_t capacity) : data(capacity), mask(capacity - 1) {}
+
+        uint8_t* reserve(size_t size);
+        void commit() { head.store(reserved_head, std::memory_order_release); }
+    };
+
+    struct Entry {
+        int64_t timestamp;
+        const Site* site;
+        std::string message;
+    };
+
+    Config config_;
+    std::shared_ptr<spdlog::logger> sink_;
+    std::atomic<bool> running_{false};
+    std::thread worker_;
+    std::mutex worker_mutex_;
+    std::condition_variable worker_cv_;
+    bool stop_requested_ = false;
+
+    std::mutex registry_mutex_;                     ///< Guards buffers_
+    std::vector<std::shared_ptr<Buffer>> buffers_;
+    std::mutex drain_mutex_;                        ///< Single consumer at a time
+    std::vector<Entry> batch_;
+    uint64_t written_ = 0;                          ///< Records formatted (under drain_mutex_)
+    uint64_t retired_dropped_ = 0;                  ///< Drops of released buffers (under registry_mutex_)
+
+    AsyncLog() = default;
+
+public:
+    static AsyncLog& getInstance() {
+        static AsyncLog instance;
+        return instance;
+    }
+
+    ~AsyncLog();
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+    /**
+     * @brief Start the background formatter writing to sink
+     */
+    bool start(const Config& config, std::shared_ptr<spdlog::logger> sink);
+
+    /**
+     * @brief Stop the formatter after draining all buffers
+     */
+    void stop();
+
+    /**
+     * @brief Format and emit everything captured so far
+     */
+    void flush();
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+    Stats getStats();
+
+    /**
+     * @brief Capture one record; called by the LOG_ASYNC_* macros after the level check
+     */
+    template<typename... Args>
+    static void log(const Site& site, const char* format, const Args&... args);
+
+private:
+    static Buffer* threadBuffer();
+    std::shared_ptr<Buffer> registerBuffer();
+    void run();
+    void drain();
+    void drainBuffer(Buffer& buffer);
+
+    template<typename... Ts>
+    static void formatRecord(const char* format, const uint8_t* args, fmt::memory_buffer& out) {
+        (void)args;
+        // Braced initialization evaluates the decoders left to right
+        std::tuple<typename async_log_detail::Codec<Ts>::Decoded...> values{
+            async_log_detail::Codec<Ts>::decode(args)...};
+        std::apply([&](const auto&... decoded) {
+            fmt::format_to(std::back_inserter(out), fmt::runtime(format), decoded...);
+        }, values);
+    }
+
+    static void logSynchronously(const Site& site, const std::string& message);
+};
+
+template<typename... Args>
+void AsyncLog::log(const Site& site, const char* format, const Args&... args) {
+    using namespace async_log_detail;
+    AsyncLog& self = getInstance();
+    if (!self.running_.load(std::memory_order_acquire)) {
+        logSynchronously(site, fmt::format(fmt::runtime(format),
+                                           static_cast<typename Codec<std::decay_t<Args>>::Decoded>(args)...));
+        return;
+    }
+
+    size_t size = sizeof(RecordHeader);
+    ((size += Codec<std::decay_t<Args>>::size(args)), ...);
+    size = (size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+
+    Buffer* buffer = threadBuffer();
+    uint8_t* out = buffer->reserve(size);
+    if (!out) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    RecordHeader header{static_cast<uint32_t>(size), 0, &site, format, &formatRecord<std::decay_t<Args>...>,
+                        spdlog::log_clock::now().time_since_epoch().count()};
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    (Codec<std::decay_t<Args>>::encode(out, args), ...);
+    buffer->commit();
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,125 @@
+#pragma once
+#include "utils/LockFreeQueue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Fixed set of reusable byte buffers with intrusive reference counts
+ *
+ * acquire() hands out a preallocated buffer as a Ref; copies of a Ref share
+ * the buffer and the last one to go returns it to the pool. Nothing is
+ * allocated per acquire or per copy, and acquire never waits: when every
+ * buffer is in use it returns an empty Ref and the caller sheds the frame.
+ * Acquire and release are safe from any thread. The pool must outlive all
+ * of its Refs.
+ */
+class BufferPool {
+private:
+    struct Block {
+        std::vector<uint8_t> bytes;
+        std::atomic<uint32_t> refs{0};
+        BufferPool* pool = nullptr;
+    };
+
+public:
+    class Ref {
+    private:
+        Block* block_ = nullptr;
+
+        explicit Ref(Block* block) : block_(block) {}
+        friend class BufferPool;
+
+    public:
+        Ref() = default;
+        ~Ref() { reset(); }
+
+        Ref(const Ref& other) : block_(other.block_) {
+            if (block_) {
+                block_->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        Ref(Ref&& other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+
+        Ref& operator=(Ref other) noexcept {
+            std::swap(block_, other.block_);
+            return *this;
+        }
+
+        void reset() {
+            if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                block_->pool->release(block_);
+            }
+            block_ = nullptr;
+        }
+
+        explicit operator bool() const { return block_ != nullptr; }
+
+        /**
+         * @brief Buffer contents; only write while holding the sole reference
+         */
+        std::vector<uint8_t>& bytes() { return block_->bytes; }
+        const std::vector<uint8_t>& bytes() const { return block_->bytes; }
+        const uint8_t* data() const { return block_->bytes.data(); }
+        size_t size() const { return block_->bytes.size(); }
+    };
+
+private:
+    std::unique_ptr<Block[]> blocks_;
+    LockFreeQueue<Block*> free_;
+    size_t count_;
+
+public:
+    /**
+     * @brief Preallocate buffers
+     * @param count Number of buffers, rounded up to a power of two
+     * @param capacity Bytes reserved in each buffer (buffers grow beyond it if needed)
+     */
+    BufferPool(size_t count, size_t capacity)
+        : blocks_(new Block[roundUp(count)]), free_(roundUp(count)), count_(roundUp(count)) {
+        for (size_t i = 0; i < count_; ++i) {
+            blocks_[i].bytes.reserve(capacity);
+            blocks_[i].pool = this;
+            Block* block = &blocks_[i];
+            free_.tryPush(block);
+        }
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Take an empty buffer
+     * @return Empty Ref if every buffer is in use
+     */
+    Ref acquire() {
+        Block* block = nullptr;
+        if (!free_.tryPop(block)) {
+            return Ref();
+        }
+        block->bytes.clear();
+        block->refs.store(1, std::memory_order_relaxed);
+        return Ref(block);
+    }
+
+    size_t size() const { return count_; }
+    size_t available() const { return free_.sizeApprox(); }
+
+private:
+    void release(Block* block) { free_.tryPush(block); }
+
+    static size_t roundUp(size_t count) {
+        size_t capacity = 2;
+        while (capacity < count) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+};
+
+}  // namespace radar_tracking
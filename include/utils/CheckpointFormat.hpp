@@ -0,0 +1,145 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "utils/CheckpointSection.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Tracker state captured for a fast restart
+ *
+ * Filled on the tracking thread by TrackManager::exportState() and
+ * ScanPipeline::saveState(), which only copy; encoding and I/O happen on
+ * the checkpoint writer thread.
+ */
+struct TrackerCheckpoint {
+    using Section = CheckpointSection;
+
+    uint64_t sequence = 0;
+    int64_t timestamp_ns = 0;                 ///< Capture time (system clock)
+    bool handover = false;                    ///< Final checkpoint of a primary handing over
+    uint32_t next_track_id = 1;
+    uint32_t total_tracks_created = 0;
+    uint32_t total_tracks_deleted = 0;
+    uint32_t tracks_confirmed = 0;
+    std::vector<Track> tracks;
+    Section filter_state;                     ///< Filter::Snapshot per track (IMM mode states, factors)
+    Section association_state;                ///< Association context (OOSM replay window entries)
+
+    void clear() {
+        sequence = 0;
+        timestamp_ns = 0;
+        handover = false;
+        tracks.clear();
+        filter_state.clear();
+        association_state.clear();
+    }
+};
+
+namespace checkpoint {
+
+/**
+ * @brief On-disk layout of a tracker checkpoint file
+ *
+ * A FileHeader followed by section_count sections, each a SectionHeader and
+ * its payload: TRACKS (TrackRecord per track), TRAJECTORY (Point3D history
+ * of all tracks, in track order, trajectory_count per TrackRecord), then
+ * the FILTER and ASSOCIATION sections as raw TrackerCheckpoint::Section
+ * bytes. checksum covers everything after the header. Values are
+ * host-endian; section element layouts are those of the build that wrote
+ * them, so a checkpoint is only restored by the same binary layout (the
+ * element size and producer tag are checked).
+ */
+
+constexpr uint32_t FILE_MAGIC = 0x4B435252;  // "RRCK"
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t TAG_SIZE = 32;
+
+enum class SectionType : uint16_t {
+    TRACKS = 1,
+    TRAJECTORY = 2,
+    FILTER = 3,
+    ASSOCIATION = 4
+};
+
+enum FileFlags : uint16_t {
+    FILE_FLAG_NONE = 0,
+    FILE_FLAG_HANDOVER = 1 << 0
+};
+
+#pragma pack(push, 1)
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint16_t flags;
+    uint16_t section_count;
+    uint32_t next_track_id;
+    uint64_t sequence;
+    int64_t timestamp_ns;
+    uint64_t writer_pid;
+    uint32_t total_tracks_created;
+    uint32_t total_tracks_deleted;
+    uint32_t tracks_confirmed;
+    uint32_t reserved;
+    uint64_t payload_size;                   ///< Bytes after this header
+    uint64_t checksum;                       ///< checksum() of those bytes
+};
+
+struct SectionHeader {
+    SectionType type;
+    uint16_t reserved;
+    uint32_t count;
+    uint32_t element_size;
+    uint64_t size;                           ///< Payload bytes after this header
+    char tag[TAG_SIZE];                      ///< Producer, NUL-padded
+};
+
+struct TrackRecord {
+    uint32_t track_id;
+    uint8_t state;
+    double position[3];
+    double velocity[3];
+    double acceleration[3];
+    double covariance[9][9];
+    double confidence;
+    double quality_score;
+    int64_t last_update_ns;
+    int64_t valid_time_ns;
+    int64_t creation_time_ns;
+    uint32_t consecutive_misses;
+    uint32_t hit_count;
+    uint32_t trajectory_count;
+};
+
+#pragma pack(pop)
+
+static_assert(std::is_trivially_copyable<FileHeader>::value, "FileHeader must be POD");
+static_assert(std::is_trivially_copyable<TrackRecord>::value, "TrackRecord must be POD");
+
+/**
+ * @brief 64-bit checksum, a word at a time (a few GB/s)
+ *
+ * Detects torn or truncated files; not a cryptographic hash.
+ */
+inline uint64_t checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ data[i]) * 0xC4CEB9FE1A85EC53ull;
+    }
+    return hash ^ (hash >> 32);
+}
+
+}  // namespace checkpoint
+}  // namespace radar_tracking
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Fixed-size per-track records of one pipeline component
+ *
+ * Each element is a uint32 track id followed by element_size - 4 bytes
+ * of component state. The tag names the producer (pipeline variant) so a
+ * checkpoint taken with another filter is not restored into this one.
+ * Kept apart from CheckpointFormat.hpp so the algorithm interfaces can
+ * exchange sections without the on-disk format.
+ */
+struct CheckpointSection {
+    std::string tag;
+    uint32_t element_size = 0;
+    uint32_t count = 0;
+    std::vector<uint8_t> data;
+
+    void clear() {
+        tag.clear();
+        element_size = 0;
+        count = 0;
+        data.clear();
+    }
+
+    /**
+     * @brief Start a section of T elements
+     */
+    template<typename T>
+    void begin(const std::string& section_tag) {
+        tag = section_tag;
+        element_size = static_cast<uint32_t>(sizeof(uint32_t) + sizeof(T));
+        count = 0;
+        data.clear();
+    }
+
+    template<typename T>
+    void append(uint32_t track_id, const T& value) {
+        static_assert(std::is_trivially_destructible<T>::value, "Section elements are copied as bytes");
+        const size_t offset = data.size();
+        data.resize(offset + element_size);
+        std::memcpy(data.data() + offset, &track_id, sizeof(track_id));
+        std::memcpy(data.data() + offset + sizeof(track_id), &value, sizeof(T));
+        ++count;
+    }
+
+    /**
+     * @brief Whether this section holds T elements from the given producer
+     */
+    template<typename T>
+    bool matches(const std::string& section_tag) const {
+        return count > 0 && tag == section_tag && element_size == sizeof(uint32_t) + sizeof(T) &&
+               data.size() == static_cast<size_t>(count) * element_size;
+    }
+
+    template<typename T>
+    void read(uint32_t index, uint32_t& track_id, T& value) const {
+        const uint8_t* element = data.data() + static_cast<size_t>(index) * element_size;
+        std::memcpy(&track_id, element, sizeof(track_id));
+        std::memcpy(static_cast<void*>(&value), element + sizeof(track_id), sizeof(T));
+    }
+};
+
+}  // namespace radar_tracking
@@ -7,19 +7,22 @@ namespace radar_tracking {
 
 /**
  * @brief Centralized configuration management using YAML
+ *
+ * Dotted-path lookups walk the YAML tree on every call and are meant for
+ * start-up code. Hot paths should read a compiled ConfigSnapshot
+ * (core/ConfigSnapshot.hpp) instead. The tree is replaced as a whole on
+ * reload, so lookups running concurrently with reloadConfig() see either
+ * the old or the new document.
  */
 class ConfigManager {
 private:
-    YAML::Node config_;
-    static std::unique_ptr<ConfigManager> instance_;
+    std::shared_ptr<const YAML::Node> config_ = std::make_shared<const YAML::Node>();  ///< atomic_load/store only
     std::string config_file_path_;
 
 public:
     static ConfigManager& getInstance() {
-        if (!instance_) {
-            instance_ = std::make_unique<ConfigManager>();
-        }
-        return *instance_;
+        static ConfigManager instance;
+        return instance;
     }
 
     bool loadConfig(const std::string& config_file);
@@ -28,13 +31,13 @@ public:
     
     template<typename T>
     T get(const std::string& key) const {
-        return getValueFromPath(config_, key).as<T>();
+        return getValueFromPath(*root(), key).as<T>();
     }
     
     template<typename T>
     T get(const std::string& key, const T& default_value) const {
         try {
-            auto node = getValueFromPath(config_, key);
+            auto node = getValueFromPath(*root(), key);
             if (node.IsDefined() && !node.IsNull()) {
                 return node.as<T>();
             }
@@ -50,6 +53,8 @@ public:
 
 private:
     ConfigManager() = default;
+    std::shared_ptr<const YAML::Node> root() const { return std::atomic_load(&config_); }
+    bool validateConfig(const YAML::Node& config) const;
     YAML::Node getValueFromPath(const YAML::Node& node, const std::string& path) const;
 };
 
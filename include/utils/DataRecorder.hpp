@@ -0,0 +1,166 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "utils/LockFreeQueue.hpp"
+#include "utils/RecordingFormat.hpp"
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Asynchronous binary recorder for pipeline data
+ *
+ * Pipeline stages hand detections, clusters, tracks and statistics to the
+ * recorder, which packs them into binary frames and pushes them onto a
+ * lock-free queue. A background thread drains the queue into preallocated,
+ * memory-mapped segment files and maintains a time index per segment.
+ * Producers never block: when the queue is full the frame is dropped and
+ * counted.
+ */
+class DataRecorder {
+public:
+    /**
+     * @brief Recorder configuration (logging.recorder section)
+     */
+    struct Config {
+        std::string output_path = "logs/data/";   ///< Directory for segment files
+        std::string file_prefix = "session";      ///< Segment file name prefix
+        size_t segment_size_mb = 256;             ///< Preallocated size of each segment
+        size_t queue_capacity = 4096;             ///< Frames buffered between producers and writer
+        int index_interval_ms = 100;              ///< Minimum spacing of time index entries
+        std::string compression = "none";         ///< Block compression: none or lz4
+        size_t min_compress_bytes = 512;          ///< Skip compression for smaller payloads
+        bool record_detections = true;
+        bool record_clusters = true;
+        bool record_tracks = true;
+        bool record_stats = true;
+        bool record_raw = false;                  ///< Capture raw adapter input for replay
+
+        /**
+         * @brief Load configuration from YAML node
+         */
+        void loadFromYaml(const YAML::Node& node);
+
+        /**
+         * @brief Validate configuration parameters
+         */
+        bool validate() const;
+    };
+
+    /**
+     * @brief Recorder statistics
+     */
+    struct RecorderStats {
+        uint64_t frames_written = 0;
+        uint64_t frames_dropped = 0;
+        uint64_t bytes_written = 0;
+        uint64_t bytes_uncompressed = 0;
+        uint32_t segments_written = 0;
+        size_t queue_depth = 0;
+    };
+
+private:
+    Config config_;
+    std::unique_ptr<LockFreeQueue<std::vector<uint8_t>>> frame_queue_;
+    std::unique_ptr<LockFreeQueue<std::vector<uint8_t>>> free_buffers_;
+
+    std::atomic<bool> running_{false};
+    std::thread writer_thread_;
+
+    // Writer thread state
+    int segment_fd_ = -1;
+    uint8_t* segment_data_ = nullptr;
+    size_t segment_capacity_ = 0;
+    size_t segment_offset_ = 0;
+    uint32_t segment_index_ = 0;
+    std::string session_base_;
+    std::vector<recording::IndexEntry> segment_index_entries_;
+    int64_t last_index_ns_ = 0;
+    std::vector<uint8_t> compress_buffer_;
+
+    // Statistics
+    std::atomic<uint64_t> frames_written_{0};
+    std::atomic<uint64_t> frames_dropped_{0};
+    std::atomic<uint64_t> bytes_written_{0};
+    std::atomic<uint64_t> bytes_uncompressed_{0};
+    std::atomic<uint32_t> segments_written_{0};
+
+public:
+    DataRecorder() = default;
+    ~DataRecorder();
+
+    DataRecorder(const DataRecorder&) = delete;
+    DataRecorder& operator=(const DataRecorder&) = delete;
+
+    /**
+     * @brief Initialize recorder
+     * @param config Recorder configuration
+     * @return true if initialization successful
+     */
+    bool initialize(const Config& config);
+
+    /**
+     * @brief Start the background writer thread
+     */
+    void start();
+
+    /**
+     * @brief Drain pending frames, close the current segment and stop
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Record a batch of detections (non-blocking)
+     * @return false if the frame was dropped
+     */
+    bool recordDetections(const std::vector<RadarDetection>& detections);
+
+    /**
+     * @brief Record a batch of clusters (non-blocking)
+     * @return false if the frame was dropped
+     */
+    bool recordClusters(const std::vector<Cluster>& clusters);
+
+    /**
+     * @brief Record the current track picture (non-blocking)
+     * @return false if the frame was dropped
+     */
+    bool recordTracks(const std::vector<Track>& tracks);
+
+    /**
+     * @brief Record system statistics (non-blocking)
+     * @return false if the frame was dropped
+     */
+    bool recordStats(const SystemStats& stats);
+
+    /**
+     * @brief Record a raw buffer received from a communication adapter (non-blocking)
+     * @return false if the frame was dropped
+     */
+    bool recordRaw(const std::vector<uint8_t>& data);
+
+    /**
+     * @brief Get recorder statistics
+     */
+    RecorderStats getStats() const;
+
+private:
+    std::vector<uint8_t> acquireBuffer();
+    bool enqueueFrame(std::vector<uint8_t>& buffer);
+
+    void writerLoop();
+    void writeFrame(std::vector<uint8_t>& buffer);
+    bool openSegment(size_t min_size);
+    void closeSegment();
+    void writeIndexFile() const;
+    std::string segmentPath(uint32_t index, const char* extension) const;
+};
+
+}  // namespace radar_tracking
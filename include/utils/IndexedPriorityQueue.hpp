@@ -0,0 +1,165 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Binary heap addressable by id
+ *
+ * Each id appears at most once. The heap position of every id is kept in a
+ * map, so the priority of a queued id can be raised or lowered, or the id
+ * removed, in O(log n) without searching. top() is the element that Compare
+ * orders first (the smallest priority with the default std::less).
+ */
+template<typename Priority, typename Compare = std::less<Priority>>
+class IndexedPriorityQueue {
+public:
+    using Id = uint32_t;
+
+    struct Node {
+        Id id;
+        Priority priority;
+    };
+
+private:
+    std::vector<Node> heap_;
+    std::unordered_map<Id, size_t> position_;
+    Compare compare_;
+
+public:
+    IndexedPriorityQueue() = default;
+    explicit IndexedPriorityQueue(Compare compare) : compare_(std::move(compare)) {}
+
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+    bool contains(Id id) const { return position_.count(id) != 0; }
+
+    void reserve(size_t count) {
+        heap_.reserve(count);
+        position_.reserve(count);
+    }
+
+    void clear() {
+        heap_.clear();
+        position_.clear();
+    }
+
+    /**
+     * @brief Element ordered first; the queue must not be empty
+     */
+    const Node& top() const { return heap_.front(); }
+
+    /**
+     * @brief Priority of a queued id; the id must be queued
+     */
+    const Priority& priority(Id id) const { return heap_[position_.at(id)].priority; }
+
+    /**
+     * @brief Insert an id, or change its priority if already queued
+     */
+    void push(Id id, Priority priority) {
+        auto [it, inserted] = position_.try_emplace(id, heap_.size());
+        if (inserted) {
+            heap_.push_back(Node{id, std::move(priority)});
+            siftUp(heap_.size() - 1);
+            return;
+        }
+        const size_t index = it->second;
+        const bool earlier = compare_(priority, heap_[index].priority);
+        heap_[index].priority = std::move(priority);
+        if (earlier) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+    }
+
+    /**
+     * @brief Remove and return the element ordered first; the queue must not be empty
+     */
+    Node pop() {
+        Node node = std::move(heap_.front());
+        removeAt(0);
+        return node;
+    }
+
+    /**
+     * @brief Remove an id if queued
+     * @return true if the id was queued
+     */
+    bool erase(Id id) {
+        auto it = position_.find(id);
+        if (it == position_.end()) {
+            return false;
+        }
+        removeAt(it->second);
+        return true;
+    }
+
+    /**
+     * @brief Queued elements in heap order
+     */
+    const std::vector<Node>& nodes() const { return heap_; }
+
+private:
+    void removeAt(size_t index) {
+        position_.erase(heap_[index].id);
+        const size_t last = heap_.size() - 1;
+        if (index != last) {
+            heap_[index] = std::move(heap_[last]);
+            position_[heap_[index].id] = index;
+            heap_.pop_back();
+            if (index > 0 && compare_(heap_[index].priority, heap_[(index - 1) / 2].priority)) {
+                siftUp(index);
+            } else {
+                siftDown(index);
+            }
+        } else {
+            heap_.pop_back();
+        }
+    }
+
+    void siftUp(size_t index) {
+        Node node = std::move(heap_[index]);
+        while (index > 0) {
+            const size_t parent = (index - 1) / 2;
+            if (!compare_(node.priority, heap_[parent].priority)) {
+                break;
+            }
+            heap_[index] = std::move(heap_[parent]);
+            position_[heap_[index].id] = index;
+            index = parent;
+        }
+        heap_[index] = std::move(node);
+        position_[heap_[index].id] = index;
+    }
+
+    void siftDown(size_t index) {
+        const size_t count = heap_.size();
+        Node node = std::move(heap_[index]);
+        while (true) {
+            size_t child = 2 * index + 1;
+            if (child >= count) {
+                break;
+            }
+            if (child + 1 < count && compare_(heap_[child + 1].priority, heap_[child].priority)) {
+                ++child;
+            }
+            if (!compare_(heap_[child].priority, node.priority)) {
+                break;
+            }
+            heap_[index] = std::move(heap_[child]);
+            position_[heap_[index].id] = index;
+            index = child;
+        }
+        heap_[index] = std::move(node);
+        position_[heap_[index].id] = index;
+    }
+};
+
+}  // namespace radar_tracking
@@ -0,0 +1,54 @@
+#pragma once
+#include <Eigen/Dense>
+#include <chrono>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Rectangular linear assignment and Murty k-best ranking
+ *
+ * Cost matrices have rows <= columns; every row is assigned to exactly one
+ * column. Entries at or above FORBIDDEN mark pairs that may not be assigned.
+ * Used by JPDA and MHT to enumerate the most likely joint association
+ * hypotheses without full enumeration.
+ */
+class KBestAssignment {
+public:
+    static constexpr double FORBIDDEN = 1e12;
+
+    /**
+     * @brief One ranked assignment
+     */
+    struct Solution {
+        std::vector<int> row_to_col;  ///< Column assigned to each row
+        double cost = 0.0;            ///< Sum of assigned entries
+    };
+
+    /**
+     * @brief Solve a minimum-cost rectangular assignment
+     * @param cost Cost matrix (rows <= cols)
+     * @param row_to_col Receives the column of each row
+     * @return Total cost, or FORBIDDEN if no feasible assignment exists
+     */
+    static double solve(const Eigen::MatrixXd& cost, std::vector<int>& row_to_col);
+
+    /**
+     * @brief The k lowest-cost assignments in increasing order of cost (Murty)
+     * @param cost Cost matrix (rows <= cols)
+     * @param k Maximum number of solutions
+     * @param deadline Stop partitioning once this time is reached (the best
+     *        solution is always returned)
+     * @return Up to k feasible solutions
+     */
+    static std::vector<Solution> murty(const Eigen::MatrixXd& cost, size_t k,
+                                       std::chrono::steady_clock::time_point deadline =
+                                           std::chrono::steady_clock::time_point::max());
+
+    /**
+     * @brief Check whether a solution cost denotes a feasible assignment
+     */
+    static bool isFeasible(double cost) { return cost < FORBIDDEN * 0.5; }
+};
+
+}  // namespace radar_tracking
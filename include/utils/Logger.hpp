@@ -1,4 +1,6 @@
 #pragma once
+#include "utils/AsyncLog.hpp"
+#include <atomic>
 #include <memory>
 #include <string>
 #include <spdlog/spdlog.h>
@@ -10,21 +12,29 @@ namespace radar_tracking {
 
 /**
  * @brief Centralized logging system using spdlog
+ *
+ * The LOG_* macros check the logger's level before their arguments are
+ * evaluated, so a disabled line builds no strings. Loggers are reached
+ * through raw pointers cached at initialization (no singleton lookup or
+ * shared_ptr copy per call). LOG_ASYNC_* take a fmt format string literal
+ * plus arithmetic, enum or string arguments and capture them in binary form
+ * for the AsyncLog formatter thread (logging.async); use them on hot paths.
  */
 class Logger {
 private:
-    static std::unique_ptr<Logger> instance_;
     std::shared_ptr<spdlog::logger> system_logger_;
     std::shared_ptr<spdlog::logger> data_logger_;
     std::shared_ptr<spdlog::logger> perf_logger_;
     bool initialized_;
 
+    static inline std::atomic<spdlog::logger*> system_raw_{nullptr};
+    static inline std::atomic<spdlog::logger*> data_raw_{nullptr};
+    static inline std::atomic<spdlog::logger*> perf_raw_{nullptr};
+
 public:
     static Logger& getInstance() {
-        if (!instance_) {
-            instance_ = std::make_unique<Logger>();
-        }
-        return *instance_;
+        static Logger instance;
+        return instance;
     }
 
     bool initialize(const std::string& config_file);
@@ -34,19 +44,47 @@ public:
     std::shared_ptr<spdlog::logger> getDataLogger() { return data_logger_; }
     std::shared_ptr<spdlog::logger> getPerfLogger() { return perf_logger_; }
 
+    // Cached pointers for the macros; loggers live until process exit once set
+    static spdlog::logger* systemLogger() { return system_raw_.load(std::memory_order_acquire); }
+    static spdlog::logger* dataLogger() { return data_raw_.load(std::memory_order_acquire); }
+    static spdlog::logger* perfLogger() { return perf_raw_.load(std::memory_order_acquire); }
+
 private:
     Logger() : initialized_(false) {}
 };
 
+#define RADAR_LOG_AT_(logger_fn, lvl, ...) \
+    do { \
+        spdlog::logger* radar_log_logger_ = radar_tracking::Logger::logger_fn(); \
+        if (radar_log_logger_ && radar_log_logger_->should_log(lvl)) { \
+            radar_log_logger_->log(lvl, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define RADAR_LOG_ASYNC_(lvl, ...) \
+    do { \
+        spdlog::logger* radar_log_logger_ = radar_tracking::Logger::systemLogger(); \
+        if (radar_log_logger_ && radar_log_logger_->should_log(lvl)) { \
+            static constexpr radar_tracking::AsyncLog::Site radar_log_site_{lvl, __FILE__, __LINE__}; \
+            radar_tracking::AsyncLog::log(radar_log_site_, __VA_ARGS__); \
+        } \
+    } while (0)
+
 // Convenience macros
-#define LOG_TRACE(...) if (radar_tracking::Logger::getInstance().getSystemLogger()) radar_tracking::Logger::getInstance().getSystemLogger()->trace(__VA_ARGS__)
-#define LOG_DEBUG(...) if (radar_tracking::Logger::getInstance().getSystemLogger()) radar_tracking::Logger::getInstance().getSystemLogger()->debug(__VA_ARGS__)
-#define LOG_INFO(...) if (radar_tracking::Logger::getInstance().getSystemLogger()) radar_tracking::Logger::getInstance().getSystemLogger()->info(__VA_ARGS__)
-#define LOG_WARN(...) if (radar_tracking::Logger::getInstance().getSystemLogger()) radar_tracking::Logger::getInstance().getSystemLogger()->warn(__VA_ARGS__)
-#define LOG_ERROR(...) if (radar_tracking::Logger::getInstance().getSystemLogger()) radar_tracking::Logger::getInstance().getSystemLogger()->error(__VA_ARGS__)
-#define LOG_CRITICAL(...) if (radar_tracking::Logger::getInstance().getSystemLogger()) radar_tracking::Logger::getInstance().getSystemLogger()->critical(__VA_ARGS__)
-
-#define LOG_DATA(...) if (radar_tracking::Logger::getInstance().getDataLogger()) radar_tracking::Logger::getInstance().getDataLogger()->info(__VA_ARGS__)
-#define LOG_PERF(...) if (radar_tracking::Logger::getInstance().getPerfLogger()) radar_tracking::Logger::getInstance().getPerfLogger()->info(__VA_ARGS__)
+#define LOG_TRACE(...) RADAR_LOG_AT_(systemLogger, spdlog::level::trace, __VA_ARGS__)
+#define LOG_DEBUG(...) RADAR_LOG_AT_(systemLogger, spdlog::level::debug, __VA_ARGS__)
+#define LOG_INFO(...) RADAR_LOG_AT_(systemLogger, spdlog::level::info, __VA_ARGS__)
+#define LOG_WARN(...) RADAR_LOG_AT_(systemLogger, spdlog::level::warn, __VA_ARGS__)
+#define LOG_ERROR(...) RADAR_LOG_AT_(systemLogger, spdlog::level::err, __VA_ARGS__)
+#define LOG_CRITICAL(...) RADAR_LOG_AT_(systemLogger, spdlog::level::critical, __VA_ARGS__)
+
+#define LOG_DATA(...) RADAR_LOG_AT_(dataLogger, spdlog::level::info, __VA_ARGS__)
+#define LOG_PERF(...) RADAR_LOG_AT_(perfLogger, spdlog::level::info, __VA_ARGS__)
+
+// Binary capture, formatted on the AsyncLog thread: LOG_ASYNC_DEBUG("gate {} of {}", i, n)
+#define LOG_ASYNC_TRACE(...) RADAR_LOG_ASYNC_(spdlog::level::trace, __VA_ARGS__)
+#define LOG_ASYNC_DEBUG(...) RADAR_LOG_ASYNC_(spdlog::level::debug, __VA_ARGS__)
+#define LOG_ASYNC_INFO(...) RADAR_LOG_ASYNC_(spdlog::level::info, __VA_ARGS__)
+#define LOG_ASYNC_WARN(...) RADAR_LOG_ASYNC_(spdlog::level::warn, __VA_ARGS__)
 
 }  // namespace radar_tracking
\ No newline at end of file
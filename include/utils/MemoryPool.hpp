@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Fixed-size block allocator
+ *
+ * Blocks are carved from large chunks and recycled through an intrusive
+ * free list, so allocation and release are O(1) and never touch the system
+ * allocator once the pool has grown to its working size. Chunks are only
+ * returned when the pool is destroyed. Not thread-safe: each pool belongs to
+ * one processing thread.
+ */
+class MemoryPool {
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    size_t block_size_;
+    size_t blocks_per_chunk_;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks_;
+    FreeBlock* free_list_ = nullptr;
+    size_t allocated_ = 0;
+
+public:
+    /**
+     * @brief Create a pool
+     * @param block_size Size of every block (rounded up for alignment)
+     * @param blocks_per_chunk Blocks obtained per system allocation
+     */
+    explicit MemoryPool(size_t block_size, size_t blocks_per_chunk = 1024);
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    /**
+     * @brief Get one block of getBlockSize() bytes
+     */
+    void* allocate();
+
+    /**
+     * @brief Return a block obtained from allocate()
+     */
+    void deallocate(void* block);
+
+    /**
+     * @brief Pre-grow the pool to hold at least this many blocks
+     */
+    void reserve(size_t blocks);
+
+    size_t getBlockSize() const { return block_size_; }
+    size_t getAllocatedCount() const { return allocated_; }
+    size_t getCapacity() const { return chunks_.size() * blocks_per_chunk_; }
+    size_t getMemoryUsage() const { return getCapacity() * block_size_; }
+
+private:
+    void addChunk();
+};
+
+/**
+ * @brief Typed object pool on top of MemoryPool
+ */
+template<typename T>
+class ObjectPool {
+private:
+    MemoryPool pool_;
+
+public:
+    explicit ObjectPool(size_t objects_per_chunk = 1024) : pool_(sizeof(T), objects_per_chunk) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+    }
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        void* block = pool_.allocate();
+        try {
+            return new (block) T(std::forward<Args>(args)...);
+        } catch (...) {
+            pool_.deallocate(block);
+            throw;
+        }
+    }
+
+    void destroy(T* object) {
+        if (object) {
+            object->~T();
+            pool_.deallocate(object);
+        }
+    }
+
+    void reserve(size_t objects) { pool_.reserve(objects); }
+    size_t getAllocatedCount() const { return pool_.getAllocatedCount(); }
+    size_t getMemoryUsage() const { return pool_.getMemoryUsage(); }
+};
+
+}  // namespace radar_tracking
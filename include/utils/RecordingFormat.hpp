@@ -0,0 +1,200 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace radar_tracking {
+namespace recording {
+
+/**
+ * @brief On-disk layout of binary recording segments
+ *
+ * A recording session is a sequence of segment files (<base>_NNNNNN.rec),
+ * each starting with a SegmentHeader followed by back-to-back frames. Every
+ * frame is a FrameHeader plus payload. A sidecar index (<base>_NNNNNN.idx)
+ * holds IndexEntry records used to seek by time. All values are little-endian.
+ */
+
+constexpr uint32_t SEGMENT_MAGIC = 0x43455252;  // "RREC"
+constexpr uint32_t FRAME_MAGIC = 0x4D524652;    // "RFRM"
+constexpr uint32_t FORMAT_VERSION = 1;
+
+enum class RecordType : uint16_t {
+    DETECTIONS = 1,
+    CLUSTERS = 2,
+    TRACKS = 3,
+    STATS = 4,
+    RAW = 5        ///< Raw sensor buffer as received by a communication adapter
+};
+
+enum FrameFlags : uint16_t {
+    FRAME_FLAG_NONE = 0,
+    FRAME_FLAG_LZ4 = 1 << 0
+};
+
+#pragma pack(push, 1)
+
+struct SegmentHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t segment_index;
+    uint32_t reserved;
+    int64_t created_ns;
+};
+
+struct FrameHeader {
+    uint32_t magic;
+    RecordType type;
+    uint16_t flags;
+    int64_t timestamp_ns;
+    uint32_t payload_size;   ///< Bytes stored on disk after this header
+    uint32_t raw_size;       ///< Payload size before compression
+};
+
+struct IndexEntry {
+    int64_t timestamp_ns;
+    uint64_t offset;         ///< Byte offset of the FrameHeader in the segment
+};
+
+struct DetectionRecord {
+    double position[3];
+    double velocity[3];
+    double range;
+    double azimuth;
+    double elevation;
+    double snr;
+    double rcs;
+    int64_t timestamp_ns;
+    uint64_t detection_id;
+    uint32_t beam_id;
+};
+
+struct ClusterRecord {
+    uint32_t cluster_id;
+    uint32_t detection_count;  ///< Followed by detection_count uint64 detection ids
+    double centroid[3];
+    double confidence;
+    double density;
+};
+
+struct TrackRecord {
+    uint32_t track_id;
+    uint8_t state;
+    double position[3];
+    double velocity[3];
+    double acceleration[3];
+    double covariance[9][9];
+    double confidence;
+    double quality_score;
+    int64_t last_update_ns;
+    uint32_t consecutive_misses;
+    uint32_t hit_count;
+};
+
+struct StatsRecord {
+    uint32_t active_tracks;
+    uint32_t total_tracks_created;
+    uint64_t total_detections_processed;
+    double detections_per_second;
+    double processing_latency_ms;
+    double cpu_usage_percent;
+    double memory_usage_mb;
+    double average_processing_rate;
+    double total_runtime_seconds;
+};
+
+#pragma pack(pop)
+
+static_assert(std::is_trivially_copyable<FrameHeader>::value, "FrameHeader must be POD");
+static_assert(std::is_trivially_copyable<TrackRecord>::value, "TrackRecord must be POD");
+
+/**
+ * @brief Convert a clock time point to nanoseconds since epoch
+ */
+inline int64_t toNanoseconds(std::chrono::high_resolution_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+}
+
+/**
+ * @brief Convert nanoseconds since epoch back to a clock time point
+ */
+inline std::chrono::high_resolution_clock::time_point fromNanoseconds(int64_t ns) {
+    return std::chrono::high_resolution_clock::time_point(
+        std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+            std::chrono::nanoseconds(ns)));
+}
+
+/**
+ * @brief Record conversions shared by the recorder and the live output adapters
+ */
+inline DetectionRecord toRecord(const RadarDetection& detection) {
+    DetectionRecord record{};
+    record.position[0] = detection.position.x;
+    record.position[1] = detection.position.y;
+    record.position[2] = detection.position.z;
+    record.velocity[0] = detection.velocity.x;
+    record.velocity[1] = detection.velocity.y;
+    record.velocity[2] = detection.velocity.z;
+    record.range = detection.range;
+    record.azimuth = detection.azimuth;
+    record.elevation = detection.elevation;
+    record.snr = detection.snr;
+    record.rcs = detection.rcs;
+    record.timestamp_ns = toNanoseconds(detection.timestamp);
+    record.detection_id = detection.detection_id;
+    record.beam_id = detection.beam_id;
+    return record;
+}
+
+inline ClusterRecord toRecord(const Cluster& cluster) {
+    ClusterRecord record{};
+    record.cluster_id = cluster.cluster_id;
+    record.detection_count = static_cast<uint32_t>(cluster.detections.size());
+    record.centroid[0] = cluster.centroid.x;
+    record.centroid[1] = cluster.centroid.y;
+    record.centroid[2] = cluster.centroid.z;
+    record.confidence = cluster.confidence;
+    record.density = cluster.density;
+    return record;
+}
+
+inline TrackRecord toRecord(const Track& track) {
+    TrackRecord record{};
+    record.track_id = track.track_id;
+    record.state = static_cast<uint8_t>(track.state);
+    record.position[0] = track.position.x;
+    record.position[1] = track.position.y;
+    record.position[2] = track.position.z;
+    record.velocity[0] = track.velocity.x;
+    record.velocity[1] = track.velocity.y;
+    record.velocity[2] = track.velocity.z;
+    record.acceleration[0] = track.acceleration.x;
+    record.acceleration[1] = track.acceleration.y;
+    record.acceleration[2] = track.acceleration.z;
+    std::memcpy(record.covariance, track.covariance, sizeof(record.covariance));
+    record.confidence = track.confidence;
+    record.quality_score = track.quality_score;
+    record.last_update_ns = toNanoseconds(track.last_update);
+    record.consecutive_misses = track.consecutive_misses;
+    record.hit_count = track.hit_count;
+    return record;
+}
+
+inline StatsRecord toRecord(const SystemStats& stats) {
+    StatsRecord record{};
+    record.active_tracks = stats.active_tracks;
+    record.total_tracks_created = stats.total_tracks_created;
+    record.total_detections_processed = stats.total_detections_processed;
+    record.detections_per_second = stats.detections_per_second;
+    record.processing_latency_ms = stats.processing_latency_ms;
+    record.cpu_usage_percent = stats.cpu_usage_percent;
+    record.memory_usage_mb = stats.memory_usage_mb;
+    record.average_processing_rate = stats.average_processing_rate;
+    record.total_runtime_seconds = stats.total_runtime_seconds;
+    return record;
+}
+
+}  // namespace recording
+}  // namespace radar_tracking
@@ -0,0 +1,99 @@
+#pragma once
+#include "core/DataTypes.hpp"
+#include "utils/RecordingFormat.hpp"
+#include <string>
+#include <vector>
+
+namespace radar_tracking {
+
+/**
+ * @brief Sequential and time-indexed reader for DataRecorder sessions
+ *
+ * Segments are memory-mapped read-only, so iterating frames never copies
+ * payloads unless they were block compressed.
+ */
+class RecordingReader {
+public:
+    /**
+     * @brief View of a single frame; valid until the next call to next() or seek()
+     */
+    struct FrameView {
+        recording::RecordType type = recording::RecordType::RAW;
+        int64_t timestamp_ns = 0;
+        const uint8_t* payload = nullptr;
+        size_t size = 0;
+    };
+
+private:
+    struct Segment {
+        std::string path;
+        int fd = -1;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        int64_t first_ns = 0;
+        std::vector<recording::IndexEntry> index;
+    };
+
+    std::vector<Segment> segments_;
+    size_t current_segment_ = 0;
+    size_t current_offset_ = 0;
+    std::vector<uint8_t> decompress_buffer_;
+
+public:
+    RecordingReader() = default;
+    ~RecordingReader();
+
+    RecordingReader(const RecordingReader&) = delete;
+    RecordingReader& operator=(const RecordingReader&) = delete;
+
+    /**
+     * @brief Open a recording session
+     * @param path Session base path (<prefix>_<date>_<time>) or any of its .rec segments
+     * @return true if at least one segment was mapped
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmap all segments
+     */
+    void close();
+
+    bool isOpen() const { return !segments_.empty(); }
+    size_t getSegmentCount() const { return segments_.size(); }
+
+    /**
+     * @brief Read the next frame
+     * @param frame Receives the frame view
+     * @return false at end of session
+     */
+    bool next(FrameView& frame);
+
+    /**
+     * @brief Position the reader on the first frame at or after a time
+     * @param timestamp_ns Target time in nanoseconds since epoch
+     * @return false if the time lies beyond the end of the session
+     */
+    bool seek(int64_t timestamp_ns);
+
+    /**
+     * @brief Rewind to the first frame of the session
+     */
+    void rewind();
+
+    /**
+     * @brief Timestamp of the first indexed frame
+     */
+    int64_t getStartTime() const;
+
+    // Payload decoders
+    static std::vector<RadarDetection> decodeDetections(const FrameView& frame);
+    static std::vector<Cluster> decodeClusters(const FrameView& frame);
+    static std::vector<Track> decodeTracks(const FrameView& frame);
+    static SystemStats decodeStats(const FrameView& frame);
+
+private:
+    bool mapSegment(const std::string& path, Segment& segment) const;
+    bool readFrameAt(size_t segment, size_t offset, FrameView& frame, size_t& frame_size);
+};
+
+}  // namespace radar_tracking
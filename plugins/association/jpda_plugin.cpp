@@ -0,0 +1,4 @@
+#include "interfaces/AlgorithmPlugin.hpp"
+#include "processing/JPDAAssociation.hpp"
+
+RADAR_TRACKING_PLUGIN(ASSOCIATION, radar_tracking::JPDAAssociation, "jpda", "1.0")
@@ -0,0 +1,4 @@
+#include "interfaces/AlgorithmPlugin.hpp"
+#include "processing/DBSCANClustering.hpp"
+
+RADAR_TRACKING_PLUGIN(CLUSTERING, radar_tracking::DBSCANClustering, "dbscan", "1.0")
@@ -0,0 +1,4 @@
+#include "interfaces/AlgorithmPlugin.hpp"
+#include "tracking/SquareRootKalmanFilter.hpp"
+
+RADAR_TRACKING_PLUGIN(TRACKER, radar_tracking::SquareRootKalmanFilter, "srkf", "1.0")
@@ -0,0 +1,173 @@
+#include "communication/BatchedUDPAdapter.hpp"
+#include "utils/Logger.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace radar_tracking {
+
+namespace {
+
+bool resolve(const std::string& host, uint16_t port, sockaddr_in& address) {
+    address = sockaddr_in{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    return ::inet_pton(AF_INET, host.c_str(), &address.sin_addr) == 1;
+}
+
+}  // namespace
+
+void BatchedUDPAdapter::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    host = node["host"].as<std::string>(host);
+    port = node["port"].as<uint16_t>(port);
+    remote_host = node["remote_host"].as<std::string>(remote_host);
+    remote_port = node["remote_port"].as<uint16_t>(remote_port);
+    socket_buffer_kb = node["socket_buffer_kb"].as<uint32_t>(socket_buffer_kb);
+    backend.loadFromYaml(node);
+}
+
+bool BatchedUDPAdapter::Config::validate() const {
+    if (!remote_host.empty() && remote_port == 0) {
+        LOG_ERROR("BatchedUDPAdapter: remote_port is required with remote_host");
+        return false;
+    }
+    return backend.validate();
+}
+
+BatchedUDPAdapter::~BatchedUDPAdapter() {
+    stop();
+}
+
+bool BatchedUDPAdapter::initialize(const std::string& config_file) {
+    try {
+        YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["communication"]["primary"]);
+        return initialize(config);
+    } catch (const std::exception& e) {
+        LOG_ERROR("BatchedUDPAdapter: failed to load configuration: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool BatchedUDPAdapter::initialize(const Config& config) {
+    if (!config.validate()) {
+        return false;
+    }
+    stop();
+    config_ = config;
+    backend_ = SocketBackend::create(config_.backend);
+    if (!backend_) {
+        return false;
+    }
+
+    sockaddr_in address;
+    if (!resolve(config_.host, config_.port, address)) {
+        LOG_ERROR("BatchedUDPAdapter: invalid bind address " + config_.host);
+        return false;
+    }
+    int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    const int buffer_bytes = static_cast<int>(config_.socket_buffer_kb * 1024);
+    if (fd >= 0) {
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_bytes, sizeof(buffer_bytes));
+    }
+    if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        LOG_ERROR("BatchedUDPAdapter: cannot bind " + config_.host + ":" + std::to_string(config_.port) + ": " +
+                  std::strerror(errno));
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+    receive_id_ = backend_->addSocket(fd, [this](const PacketView* packets, size_t count) {
+        onBatch(packets, count);
+    });
+
+    if (!config_.remote_host.empty()) {
+        if (!resolve(config_.remote_host, config_.remote_port, address)) {
+            LOG_ERROR("BatchedUDPAdapter: invalid remote address " + config_.remote_host);
+            return false;
+        }
+        fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            LOG_ERROR("BatchedUDPAdapter: cannot connect to " + config_.remote_host + ": " + std::strerror(errno));
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            return false;
+        }
+        send_id_ = backend_->addSocket(fd, nullptr);
+    }
+    scratch_.reserve(config_.backend.receive_buffer_size);
+    return receive_id_ >= 0;
+}
+
+void BatchedUDPAdapter::start() {
+    if (backend_ && !backend_->isRunning() && backend_->start()) {
+        LOG_INFO("BatchedUDPAdapter listening on " + config_.host + ":" + std::to_string(config_.port) +
+                 " (" + backend_->getName() + " backend)");
+    }
+}
+
+void BatchedUDPAdapter::stop() {
+    if (backend_) {
+        backend_->stop();
+    }
+}
+
+void BatchedUDPAdapter::registerCallback(std::function<void(const std::vector<uint8_t>&)> callback) {
+    callback_ = std::move(callback);
+}
+
+void BatchedUDPAdapter::registerBatchCallback(SocketBackend::BatchHandler callback) {
+    batch_callback_ = std::move(callback);
+}
+
+void BatchedUDPAdapter::onBatch(const PacketView* packets, size_t count) {
+    if (batch_callback_) {
+        batch_callback_(packets, count);
+    }
+    if (callback_) {
+        for (size_t i = 0; i < count; ++i) {
+            scratch_.assign(packets[i].data, packets[i].data + packets[i].size);
+            callback_(scratch_);
+        }
+    }
+}
+
+bool BatchedUDPAdapter::isConnected() const {
+    return backend_ && backend_->isRunning() && backend_->isOpen(receive_id_);
+}
+
+bool BatchedUDPAdapter::sendData(const std::vector<uint8_t>& data) {
+    return backend_ && send_id_ >= 0 && backend_->send(send_id_, data.data(), data.size());
+}
+
+SocketBackend::Stats BatchedUDPAdapter::getStats() const {
+    return backend_ ? backend_->getStats() : SocketBackend::Stats{};
+}
+
+std::string BatchedUDPAdapter::getConnectionStats() const {
+    const SocketBackend::Stats stats = getStats();
+    const uint64_t packets = stats.packets_received + stats.packets_sent;
+
+    std::ostringstream oss;
+    oss << "backend=" << (backend_ ? backend_->getName() : "none")
+        << " packets_received=" << stats.packets_received
+        << " bytes_received=" << stats.bytes_received
+        << " batches=" << stats.receive_batches
+        << " packets_sent=" << stats.packets_sent
+        << " send_dropped=" << stats.send_dropped
+        << " receive_starved=" << stats.receive_starved
+        << " syscalls_per_packet=" << (packets > 0 ? static_cast<double>(stats.syscalls) / packets : 0.0);
+    return oss.str();
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,63 @@
+#include "communication/CapturingAdapter.hpp"
+#include "utils/Logger.hpp"
+
+namespace radar_tracking {
+
+CapturingAdapter::CapturingAdapter(std::unique_ptr<ICommunicationAdapter> inner,
+                                   std::shared_ptr<DataRecorder> recorder)
+    : inner_(std::move(inner)), recorder_(std::move(recorder)) {
+    inner_->registerCallback([this](const std::vector<uint8_t>& data) { onDataReceived(data); });
+}
+
+bool CapturingAdapter::initialize(const std::string& config) {
+    if (!recorder_ || !recorder_->getConfig().record_raw) {
+        LOG_WARN("CapturingAdapter: recorder not configured for raw capture");
+    }
+    return inner_->initialize(config);
+}
+
+void CapturingAdapter::start() {
+    inner_->start();
+    LOG_INFO("Capturing raw input from " + inner_->getAdapterType() + " adapter");
+}
+
+void CapturingAdapter::stop() {
+    inner_->stop();
+}
+
+void CapturingAdapter::registerCallback(std::function<void(const std::vector<uint8_t>&)> callback) {
+    callback_ = std::move(callback);
+}
+
+bool CapturingAdapter::isConnected() const {
+    return inner_->isConnected();
+}
+
+std::string CapturingAdapter::getConnectionStats() const {
+    std::string stats = inner_->getConnectionStats();
+    if (recorder_) {
+        auto recorder_stats = recorder_->getStats();
+        stats += " captured_frames=" + std::to_string(recorder_stats.frames_written) +
+                 " capture_drops=" + std::to_string(recorder_stats.frames_dropped);
+    }
+    return stats;
+}
+
+bool CapturingAdapter::sendData(const std::vector<uint8_t>& data) {
+    return inner_->sendData(data);
+}
+
+std::string CapturingAdapter::getAdapterType() const {
+    return inner_->getAdapterType() + "+CAPTURE";
+}
+
+void CapturingAdapter::onDataReceived(const std::vector<uint8_t>& data) {
+    if (recorder_) {
+        recorder_->recordRaw(data);
+    }
+    if (callback_) {
+        callback_(data);
+    }
+}
+
+}  // namespace radar_tracking
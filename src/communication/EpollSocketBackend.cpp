@@ -0,0 +1,322 @@
+#include "communication/EpollSocketBackend.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace radar_tracking {
+
+namespace {
+
+constexpr int EPOLL_EVENTS = 64;
+constexpr int EPOLL_TIMEOUT_MS = 100;
+constexpr uint64_t WAKE_TAG = ~0ull;
+constexpr int MAX_RECEIVE_ROUNDS = 4;  // Per readiness event, so one busy socket cannot starve the rest
+
+uint32_t interestMask(bool receive, bool stream, bool want_write) {
+    uint32_t events = 0;
+    if (receive) events |= EPOLLIN;
+    if (stream) events |= EPOLLRDHUP;
+    if (want_write) events |= EPOLLOUT;
+    return events;
+}
+
+}  // namespace
+
+bool EpollSocketBackend::setup() {
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        LOG_ERROR("EpollSocketBackend: epoll_create1 failed: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKE_TAG;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+
+    const size_t batch = config_.batch_size;
+    const size_t buffer_size = config_.receive_buffer_size;
+    state_.resize(sockets_.size());
+    for (size_t i = 0; i < sockets_.size(); ++i) {
+        Socket& socket = sockets_[i];
+        ReceiveState& state = state_[i];
+        ::fcntl(socket.fd, F_SETFL, ::fcntl(socket.fd, F_GETFL) | O_NONBLOCK);
+
+        if (socket.handler) {
+            state.buffers.resize(batch * buffer_size);
+            state.messages.resize(batch);
+            state.iov.resize(batch);
+            state.views.resize(batch);
+            for (size_t k = 0; k < batch; ++k) {
+                state.iov[k].iov_base = state.buffers.data() + k * buffer_size;
+                state.iov[k].iov_len = buffer_size;
+                state.messages[k] = mmsghdr{};
+                state.messages[k].msg_hdr.msg_iov = &state.iov[k];
+                state.messages[k].msg_hdr.msg_iovlen = 1;
+            }
+        }
+        state.send_messages.resize(batch);
+        state.send_iov.resize(batch);
+
+        event.events = interestMask(static_cast<bool>(socket.handler), socket.stream, false);
+        event.data.u64 = i;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, socket.fd, &event) != 0) {
+            LOG_ERROR("EpollSocketBackend: epoll_ctl failed: " + std::string(std::strerror(errno)));
+            return false;
+        }
+    }
+    return true;
+}
+
+void EpollSocketBackend::teardown() {
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+    state_.clear();
+}
+
+void EpollSocketBackend::run() {
+    epoll_event events[EPOLL_EVENTS];
+    while (running_.load(std::memory_order_acquire)) {
+        const int count = ::epoll_wait(epoll_fd_, events, EPOLL_EVENTS, EPOLL_TIMEOUT_MS);
+        syscalls_.fetch_add(1, std::memory_order_relaxed);
+        if (count < 0 && errno != EINTR) {
+            LOG_ERROR("EpollSocketBackend: epoll_wait failed: " + std::string(std::strerror(errno)));
+            break;
+        }
+
+        for (int e = 0; e < count; ++e) {
+            if (events[e].data.u64 == WAKE_TAG) {
+                uint64_t value;
+                [[maybe_unused]] ssize_t drained = ::read(wake_fd_, &value, sizeof(value));
+                syscalls_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            const size_t index = events[e].data.u64;
+            const uint32_t flags = events[e].events;
+            if (!sockets_[index].open) {
+                continue;
+            }
+            if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                if (sockets_[index].stream) {
+                    receiveStream(index);
+                } else if (sockets_[index].handler) {
+                    receiveDatagrams(index);
+                } else {
+                    // Send-only datagram socket: consume the ICMP error so it stops signalling
+                    int error = 0;
+                    socklen_t length = sizeof(error);
+                    ::getsockopt(sockets_[index].fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                    syscalls_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            if ((flags & EPOLLOUT) && sockets_[index].open) {
+                if (sockets_[index].stream) {
+                    flushStream(index);
+                } else {
+                    flushDatagrams(index);
+                }
+            }
+        }
+
+        collectSubmissions();
+        for (size_t i = 0; i < sockets_.size(); ++i) {
+            Socket& socket = sockets_[i];
+            if (socket.pending.empty() || !socket.open) {
+                continue;
+            }
+            if (state_[i].want_write) {
+                continue;  // Resumes on EPOLLOUT
+            }
+            if (socket.stream) {
+                flushStream(i);
+            } else {
+                flushDatagrams(i);
+            }
+        }
+    }
+}
+
+void EpollSocketBackend::receiveDatagrams(size_t index) {
+    Socket& socket = sockets_[index];
+    ReceiveState& state = state_[index];
+    const unsigned int batch = static_cast<unsigned int>(state.messages.size());
+
+    for (int round = 0; round < MAX_RECEIVE_ROUNDS; ++round) {
+        const int received = ::recvmmsg(socket.fd, state.messages.data(), batch, MSG_DONTWAIT, nullptr);
+        syscalls_.fetch_add(1, std::memory_order_relaxed);
+        if (received <= 0) {
+            // EAGAIN, or an ICMP error reported on a connected socket
+            return;
+        }
+        size_t bytes = 0;
+        for (int k = 0; k < received; ++k) {
+            state.views[k] = PacketView{static_cast<const uint8_t*>(state.iov[k].iov_base), state.messages[k].msg_len};
+            bytes += state.messages[k].msg_len;
+        }
+        socket.handler(state.views.data(), static_cast<size_t>(received));
+        packets_received_.fetch_add(received, std::memory_order_relaxed);
+        bytes_received_.fetch_add(bytes, std::memory_order_relaxed);
+        receive_batches_.fetch_add(1, std::memory_order_relaxed);
+        if (static_cast<unsigned int>(received) < batch) {
+            return;
+        }
+    }
+}
+
+void EpollSocketBackend::receiveStream(size_t index) {
+    Socket& socket = sockets_[index];
+    ReceiveState& state = state_[index];
+    if (!socket.handler) {
+        // Send-only stream: only a hang-up is of interest
+        uint8_t scratch[512];
+        const ssize_t received = ::recv(socket.fd, scratch, sizeof(scratch), MSG_DONTWAIT);
+        syscalls_.fetch_add(1, std::memory_order_relaxed);
+        if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            closeSocket(socket, "closed by peer");
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, socket.fd, nullptr);
+        }
+        return;
+    }
+
+    const size_t buffer_size = config_.receive_buffer_size;
+    for (int round = 0; round < MAX_RECEIVE_ROUNDS; ++round) {
+        // One readv fills as many chunks as the socket has data for
+        const ssize_t received = ::readv(socket.fd, state.iov.data(), static_cast<int>(state.iov.size()));
+        syscalls_.fetch_add(1, std::memory_order_relaxed);
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return;
+        }
+        if (received <= 0) {
+            closeSocket(socket, received == 0 ? "closed by peer" : std::strerror(errno));
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, socket.fd, nullptr);
+            return;
+        }
+        size_t chunks = 0;
+        for (size_t remaining = static_cast<size_t>(received); remaining > 0; ++chunks) {
+            const size_t size = std::min(remaining, buffer_size);
+            state.views[chunks] = PacketView{static_cast<const uint8_t*>(state.iov[chunks].iov_base), size};
+            remaining -= size;
+        }
+        socket.handler(state.views.data(), chunks);
+        packets_received_.fetch_add(chunks, std::memory_order_relaxed);
+        bytes_received_.fetch_add(static_cast<uint64_t>(received), std::memory_order_relaxed);
+        receive_batches_.fetch_add(1, std::memory_order_relaxed);
+        if (static_cast<size_t>(received) < state.buffers.size()) {
+            return;
+        }
+    }
+}
+
+void EpollSocketBackend::flushDatagrams(size_t index) {
+    Socket& socket = sockets_[index];
+    ReceiveState& state = state_[index];
+    while (!socket.pending.empty()) {
+        const size_t count = std::min(socket.pending.size(), state.send_messages.size());
+        for (size_t k = 0; k < count; ++k) {
+            const SendRequest& request = socket.pending[k];
+            state.send_iov[k].iov_base = slotData(request.slot);
+            state.send_iov[k].iov_len = request.size;
+            state.send_messages[k] = mmsghdr{};
+            state.send_messages[k].msg_hdr.msg_iov = &state.send_iov[k];
+            state.send_messages[k].msg_hdr.msg_iovlen = 1;
+        }
+
+        const int sent = ::sendmmsg(socket.fd, state.send_messages.data(), static_cast<unsigned int>(count),
+                                    MSG_DONTWAIT | MSG_NOSIGNAL);
+        syscalls_.fetch_add(1, std::memory_order_relaxed);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            updateInterest(index, true);
+            return;
+        }
+        // An error (e.g. ICMP unreachable) drops the first datagram; UDP would lose it anyway
+        const size_t done = sent > 0 ? static_cast<size_t>(sent) : 1;
+        for (size_t k = 0; k < done; ++k) {
+            const SendRequest& request = socket.pending.front();
+            if (sent > 0) {
+                bytes_sent_.fetch_add(request.size, std::memory_order_relaxed);
+            }
+            releaseSlot(request.slot);
+            socket.pending.pop_front();
+        }
+        if (sent > 0) {
+            packets_sent_.fetch_add(done, std::memory_order_relaxed);
+        } else {
+            send_dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    updateInterest(index, false);
+}
+
+void EpollSocketBackend::flushStream(size_t index) {
+    Socket& socket = sockets_[index];
+    ReceiveState& state = state_[index];
+    while (!socket.pending.empty()) {
+        const size_t count = std::min(socket.pending.size(), state.send_iov.size());
+        for (size_t k = 0; k < count; ++k) {
+            const SendRequest& request = socket.pending[k];
+            const size_t skip = k == 0 ? socket.offset : 0;
+            state.send_iov[k].iov_base = slotData(request.slot) + skip;
+            state.send_iov[k].iov_len = request.size - skip;
+        }
+        msghdr message{};
+        message.msg_iov = state.send_iov.data();
+        message.msg_iovlen = count;
+        const int flags = MSG_DONTWAIT | MSG_NOSIGNAL | (count < socket.pending.size() ? MSG_MORE : 0);
+
+        const ssize_t sent = ::sendmsg(socket.fd, &message, flags);
+        syscalls_.fetch_add(1, std::memory_order_relaxed);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                updateInterest(index, true);
+                return;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            closeSocket(socket, std::strerror(errno));
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, socket.fd, nullptr);
+            return;
+        }
+
+        bytes_sent_.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+        size_t remaining = static_cast<size_t>(sent);
+        while (remaining > 0) {
+            const SendRequest& request = socket.pending.front();
+            const size_t left = request.size - socket.offset;
+            if (remaining < left) {
+                socket.offset += remaining;
+                break;
+            }
+            remaining -= left;
+            socket.offset = 0;
+            releaseSlot(request.slot);
+            socket.pending.pop_front();
+            packets_sent_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    updateInterest(index, false);
+}
+
+void EpollSocketBackend::updateInterest(size_t index, bool want_write) {
+    ReceiveState& state = state_[index];
+    if (state.want_write == want_write) {
+        return;
+    }
+    const Socket& socket = sockets_[index];
+    epoll_event event{};
+    event.events = interestMask(static_cast<bool>(socket.handler), socket.stream, want_write);
+    event.data.u64 = index;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, socket.fd, &event);
+    syscalls_.fetch_add(1, std::memory_order_relaxed);
+    state.want_write = want_write;
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,449 @@
+#include "communication/IoUringBackend.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace radar_tracking {
+
+namespace {
+
+constexpr uint16_t BUFFER_GROUP = 0;
+
+// user_data: operation in the top byte, socket index, send slot in the low 32 bits
+enum Operation : uint64_t {
+    OP_RECEIVE = 1,
+    OP_WAKE = 2,
+    OP_SEND = 3,
+    OP_SEND_ZC = 4,
+    OP_STREAM_SEND = 5
+};
+
+uint64_t tag(Operation op, size_t socket, uint32_t slot = 0) {
+    return (static_cast<uint64_t>(op) << 56) | (static_cast<uint64_t>(socket) << 32) | slot;
+}
+
+Operation tagOperation(uint64_t user_data) { return static_cast<Operation>(user_data >> 56); }
+size_t tagSocket(uint64_t user_data) { return (user_data >> 32) & 0xFFFFFF; }
+uint32_t tagSlot(uint64_t user_data) { return static_cast<uint32_t>(user_data); }
+
+int ringSetup(unsigned entries, io_uring_params& params) {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int ringRegister(int fd, unsigned opcode, const void* arg, unsigned nr_args) {
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+unsigned loadAcquire(const unsigned* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+void storeRelease(unsigned* p, unsigned value) { __atomic_store_n(p, value, __ATOMIC_RELEASE); }
+
+}  // namespace
+
+bool IoUringBackend::isSupported() {
+    static const bool supported = [] {
+        io_uring_params params{};
+        const int fd = ringSetup(4, params);
+        if (fd < 0) {
+            return false;  // ENOSYS, or disabled through kernel.io_uring_disabled
+        }
+        // SEND_ZC arrived in 6.0 together with multishot receive; provided buffer rings are 5.19
+        std::vector<uint8_t> storage(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op));
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        const bool ok = ringRegister(fd, IORING_REGISTER_PROBE, probe, 256) == 0 &&
+                        probe->last_op >= IORING_OP_SEND_ZC &&
+                        (probe->ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED) != 0 &&
+                        (probe->ops[IORING_OP_RECV].flags & IO_URING_OP_SUPPORTED) != 0;
+        ::close(fd);
+        return ok;
+    }();
+    return supported;
+}
+
+bool IoUringBackend::setup() {
+    // Fall back to fewer setup flags on kernels that predate them (SINGLE_ISSUER and DEFER_TASKRUN: 6.1)
+    const unsigned base_flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_R_DISABLED;
+    const unsigned preferred = base_flags | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+    if (!mapRings(preferred) && !mapRings(base_flags | IORING_SETUP_COOP_TASKRUN) && !mapRings(base_flags)) {
+        LOG_ERROR("IoUringBackend: io_uring_setup failed: " + std::string(std::strerror(errno)));
+        return false;
+    }
+
+    // Provided receive buffers
+    const size_t buffer_count = config_.receive_buffers;
+    const size_t buffer_size = config_.receive_buffer_size;
+    receive_slab_.reset(new uint8_t[buffer_count * buffer_size]);
+    buf_ring_size_ = buffer_count * sizeof(io_uring_buf);
+    void* ring_memory = ::mmap(nullptr, buf_ring_size_, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (ring_memory == MAP_FAILED) {
+        buf_ring_ = nullptr;
+        LOG_ERROR("IoUringBackend: cannot map the buffer ring: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    buf_ring_ = static_cast<io_uring_buf_ring*>(ring_memory);
+    io_uring_buf_reg registration{};
+    registration.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+    registration.ring_entries = static_cast<uint32_t>(buffer_count);
+    registration.bgid = BUFFER_GROUP;
+    if (ringRegister(ring_fd_, IORING_REGISTER_PBUF_RING, &registration, 1) != 0) {
+        LOG_ERROR("IoUringBackend: cannot register the buffer ring: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    buf_tail_ = 0;
+    returned_buffers_.reserve(buffer_count);
+    for (size_t bid = 0; bid < buffer_count; ++bid) {
+        returned_buffers_.push_back(static_cast<uint16_t>(bid));
+    }
+    returnBuffers();
+
+    // Registered send buffers; without them sends still work, only without pinning reuse
+    iovec slab{send_slab_.get(), static_cast<size_t>(config_.send_buffers) * config_.send_buffer_size};
+    fixed_send_buffers_ = ringRegister(ring_fd_, IORING_REGISTER_BUFFERS, &slab, 1) == 0;
+    if (!fixed_send_buffers_) {
+        LOG_WARN("IoUringBackend: send buffers not registered (" + std::string(std::strerror(errno)) +
+                 "); zero-copy sends disabled");
+    }
+
+    state_.clear();
+    state_.resize(sockets_.size());
+    for (size_t i = 0; i < sockets_.size(); ++i) {
+        // The ring waits for readiness itself; non-blocking sockets would surface EAGAIN instead
+        const int fd = sockets_[i].fd;
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+        state_[i].iov.resize(config_.batch_size);
+        state_[i].views.reserve(buffer_count);
+    }
+    ready_.reserve(sockets_.size());
+    return true;
+}
+
+bool IoUringBackend::mapRings(unsigned flags) {
+    io_uring_params params{};
+    params.flags = flags;
+    params.cq_entries = std::max(config_.ring_entries * 4, config_.receive_buffers * 2);
+    ring_fd_ = ringSetup(config_.ring_entries, params);
+    if (ring_fd_ < 0) {
+        return false;
+    }
+
+    sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_map_size_ = cq_map_size_ = std::max(sq_map_size_, cq_map_size_);
+    }
+    sq_map_ = ::mmap(nullptr, sq_map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                     IORING_OFF_SQ_RING);
+    cq_map_ = single_mmap ? sq_map_
+                          : ::mmap(nullptr, cq_map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                   ring_fd_, IORING_OFF_CQ_RING);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                        IORING_OFF_SQES);
+    if (sq_map_ == MAP_FAILED || cq_map_ == MAP_FAILED || sqes == MAP_FAILED) {
+        sqes_ = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe*>(sqes);
+        sq_map_ = sq_map_ == MAP_FAILED ? nullptr : sq_map_;
+        cq_map_ = cq_map_ == MAP_FAILED ? nullptr : cq_map_;
+        teardown();
+        return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sq = static_cast<uint8_t*>(sq_map_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sq_pending_ = 0;
+    auto* cq = static_cast<uint8_t*>(cq_map_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+}
+
+void IoUringBackend::teardown() {
+    if (sqes_) {
+        ::munmap(sqes_, sqes_size_);
+        sqes_ = nullptr;
+    }
+    if (cq_map_ && cq_map_ != sq_map_) {
+        ::munmap(cq_map_, cq_map_size_);
+    }
+    if (sq_map_) {
+        ::munmap(sq_map_, sq_map_size_);
+    }
+    sq_map_ = cq_map_ = nullptr;
+    if (ring_fd_ >= 0) {
+        ::close(ring_fd_);  // Cancels everything still armed
+        ring_fd_ = -1;
+    }
+    if (buf_ring_) {
+        ::munmap(buf_ring_, buf_ring_size_);
+        buf_ring_ = nullptr;
+    }
+    receive_slab_.reset();
+    returned_buffers_.clear();
+    state_.clear();
+}
+
+int IoUringBackend::enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+    syscalls_.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0));
+}
+
+io_uring_sqe* IoUringBackend::nextSqe() {
+    unsigned tail = *sq_tail_;
+    if (tail - loadAcquire(sq_head_) >= sq_entries_) {
+        // Submission queue full: hand it to the kernel without waiting
+        enter(sq_pending_, 0, 0);
+        sq_pending_ = 0;
+        tail = *sq_tail_;
+    }
+    const unsigned index = tail & sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    storeRelease(sq_tail_, tail + 1);
+    ++sq_pending_;
+    return sqe;
+}
+
+void IoUringBackend::armReceive(size_t index) {
+    io_uring_sqe* sqe = nextSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = sockets_[index].fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = tag(OP_RECEIVE, index);
+    state_[index].receive_armed = true;
+}
+
+void IoUringBackend::armWake() {
+    io_uring_sqe* sqe = nextSqe();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = wake_fd_;
+    sqe->addr = reinterpret_cast<uint64_t>(&wake_value_);
+    sqe->len = sizeof(wake_value_);
+    sqe->off = static_cast<uint64_t>(-1);
+    sqe->user_data = tag(OP_WAKE, 0);
+}
+
+void IoUringBackend::run() {
+    // The loop thread becomes the ring's only submitter
+    if (ringRegister(ring_fd_, IORING_REGISTER_ENABLE_RINGS, nullptr, 0) != 0) {
+        LOG_ERROR("IoUringBackend: cannot enable the ring: " + std::string(std::strerror(errno)));
+        return;
+    }
+    armWake();
+
+    while (running_.load(std::memory_order_acquire)) {
+        for (size_t i = 0; i < sockets_.size(); ++i) {
+            if (sockets_[i].handler && sockets_[i].open && !state_[i].receive_armed) {
+                armReceive(i);
+            }
+        }
+        collectSubmissions();
+        submitSends();
+
+        const int result = enter(sq_pending_, 1, IORING_ENTER_GETEVENTS);
+        if (result < 0 && errno != EINTR && errno != EBUSY && errno != EAGAIN) {
+            LOG_ERROR("IoUringBackend: io_uring_enter failed: " + std::string(std::strerror(errno)));
+            break;
+        }
+        if (result >= 0) {
+            sq_pending_ -= std::min(sq_pending_, static_cast<unsigned>(result));
+        }
+        reap();
+    }
+}
+
+void IoUringBackend::submitSends() {
+    for (size_t i = 0; i < sockets_.size(); ++i) {
+        Socket& socket = sockets_[i];
+        if (socket.pending.empty() || !socket.open) {
+            continue;
+        }
+        if (socket.stream) {
+            if (!state_[i].send_inflight) {
+                submitStream(i);
+            }
+            continue;
+        }
+        // Datagrams: one send each, all in this iteration's submission
+        for (const SendRequest& request : socket.pending) {
+            io_uring_sqe* sqe = nextSqe();
+            const bool zerocopy = fixed_send_buffers_ && request.size >= config_.zerocopy_min_bytes;
+            sqe->opcode = zerocopy ? IORING_OP_SEND_ZC : IORING_OP_SEND;
+            sqe->fd = socket.fd;
+            sqe->addr = reinterpret_cast<uint64_t>(slotData(request.slot));
+            sqe->len = request.size;
+            sqe->msg_flags = MSG_NOSIGNAL;
+            if (zerocopy) {
+                sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+                sqe->buf_index = 0;
+            }
+            sqe->user_data = tag(zerocopy ? OP_SEND_ZC : OP_SEND, i, request.slot);
+        }
+        socket.pending.clear();
+    }
+}
+
+void IoUringBackend::submitStream(size_t index) {
+    Socket& socket = sockets_[index];
+    SocketState& state = state_[index];
+    const size_t count = std::min(socket.pending.size(), state.iov.size());
+    for (size_t k = 0; k < count; ++k) {
+        const SendRequest& request = socket.pending[k];
+        const size_t skip = k == 0 ? socket.offset : 0;
+        state.iov[k].iov_base = slotData(request.slot) + skip;
+        state.iov[k].iov_len = request.size - skip;
+    }
+    state.message = msghdr{};
+    state.message.msg_iov = state.iov.data();
+    state.message.msg_iovlen = count;
+
+    io_uring_sqe* sqe = nextSqe();
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = socket.fd;
+    sqe->addr = reinterpret_cast<uint64_t>(&state.message);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;  // Retry short sends inside the kernel
+    sqe->user_data = tag(OP_STREAM_SEND, index);
+    state.send_inflight = true;
+}
+
+void IoUringBackend::reap() {
+    unsigned head = *cq_head_;
+    const unsigned tail = loadAcquire(cq_tail_);
+    for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+        const uint64_t user_data = cqe.user_data;
+        switch (tagOperation(user_data)) {
+        case OP_RECEIVE:
+            handleReceive(cqe, tagSocket(user_data));
+            break;
+        case OP_WAKE:
+            if (running_.load(std::memory_order_acquire)) {
+                armWake();
+            }
+            break;
+        case OP_SEND:
+        case OP_SEND_ZC: {
+            const bool notification = (cqe.flags & IORING_CQE_F_NOTIF) != 0;
+            if (!notification) {
+                if (cqe.res >= 0) {
+                    packets_sent_.fetch_add(1, std::memory_order_relaxed);
+                    bytes_sent_.fetch_add(static_cast<uint64_t>(cqe.res), std::memory_order_relaxed);
+                } else {
+                    send_dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            // A zero-copy send keeps its buffer until the notification that follows (F_MORE)
+            if (notification || !(cqe.flags & IORING_CQE_F_MORE)) {
+                releaseSlot(tagSlot(user_data));
+            }
+            break;
+        }
+        case OP_STREAM_SEND:
+            handleStreamSent(cqe, tagSocket(user_data));
+            break;
+        }
+    }
+    storeRelease(cq_head_, head);
+
+    for (size_t index : ready_) {
+        SocketState& state = state_[index];
+        sockets_[index].handler(state.views.data(), state.views.size());
+        receive_batches_.fetch_add(1, std::memory_order_relaxed);
+        state.views.clear();
+    }
+    ready_.clear();
+    returnBuffers();
+}
+
+void IoUringBackend::handleReceive(const io_uring_cqe& cqe, size_t index) {
+    Socket& socket = sockets_[index];
+    SocketState& state = state_[index];
+    if (!(cqe.flags & IORING_CQE_F_MORE)) {
+        state.receive_armed = false;  // Re-armed at the top of the next iteration
+    }
+
+    if (cqe.flags & IORING_CQE_F_BUFFER) {
+        const uint16_t bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        returned_buffers_.push_back(bid);
+        if (cqe.res > 0) {
+            if (state.views.empty()) {
+                ready_.push_back(index);
+            }
+            const uint8_t* data = receive_slab_.get() + static_cast<size_t>(bid) * config_.receive_buffer_size;
+            state.views.push_back(PacketView{data, static_cast<size_t>(cqe.res)});
+            packets_received_.fetch_add(1, std::memory_order_relaxed);
+            bytes_received_.fetch_add(static_cast<uint64_t>(cqe.res), std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    if (cqe.res == -ENOBUFS) {
+        receive_starved_.fetch_add(1, std::memory_order_relaxed);
+    } else if (cqe.res == 0 && socket.stream) {
+        closeSocket(socket, "closed by peer");
+    } else if (cqe.res == -ECONNREFUSED && !socket.stream) {
+        LOG_DEBUG("IoUringBackend: ICMP error on socket " + std::to_string(socket.fd));
+    } else if (cqe.res < 0 && cqe.res != -ECANCELED && cqe.res != -EINTR) {
+        closeSocket(socket, std::strerror(-cqe.res));
+    }
+}
+
+void IoUringBackend::handleStreamSent(const io_uring_cqe& cqe, size_t index) {
+    Socket& socket = sockets_[index];
+    state_[index].send_inflight = false;
+    if (cqe.res < 0) {
+        closeSocket(socket, std::strerror(-cqe.res));
+        return;
+    }
+    bytes_sent_.fetch_add(static_cast<uint64_t>(cqe.res), std::memory_order_relaxed);
+    size_t remaining = static_cast<size_t>(cqe.res);
+    while (remaining > 0 && !socket.pending.empty()) {
+        const SendRequest& request = socket.pending.front();
+        const size_t left = request.size - socket.offset;
+        if (remaining < left) {
+            socket.offset += remaining;
+            break;
+        }
+        remaining -= left;
+        socket.offset = 0;
+        releaseSlot(request.slot);
+        socket.pending.pop_front();
+        packets_sent_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void IoUringBackend::returnBuffers() {
+    if (returned_buffers_.empty()) {
+        return;
+    }
+    // Entries start at the ring base; in C++ the header's flexible bufs member sits one slot later
+    auto* entries = reinterpret_cast<io_uring_buf*>(buf_ring_);
+    const uint16_t mask = static_cast<uint16_t>(config_.receive_buffers - 1);
+    for (uint16_t bid : returned_buffers_) {
+        io_uring_buf& buffer = entries[buf_tail_ & mask];
+        buffer.addr = reinterpret_cast<uint64_t>(receive_slab_.get() + static_cast<size_t>(bid) * config_.receive_buffer_size);
+        buffer.len = config_.receive_buffer_size;
+        buffer.bid = bid;
+        ++buf_tail_;
+    }
+    // One release store publishes the whole batch to the kernel
+    __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+    returned_buffers_.clear();
+}
+
+}  // namespace radar_tracking
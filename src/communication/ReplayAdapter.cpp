@@ -0,0 +1,247 @@
+#include "communication/ReplayAdapter.hpp"
+#include "utils/Logger.hpp"
+#include <sstream>
+
+namespace radar_tracking {
+
+using namespace recording;
+
+namespace {
+
+bool lookupReplayMode(const std::string& name, ReplayAdapter::ReplayMode& mode) {
+    if (name == "original") {
+        mode = ReplayAdapter::ReplayMode::ORIGINAL_TIMING;
+    } else if (name == "scaled") {
+        mode = ReplayAdapter::ReplayMode::SCALED;
+    } else if (name == "afap" || name == "as_fast_as_possible") {
+        mode = ReplayAdapter::ReplayMode::AS_FAST_AS_POSSIBLE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+ReplayAdapter::ReplayMode parseReplayMode(const std::string& mode) {
+    ReplayAdapter::ReplayMode parsed = ReplayAdapter::ReplayMode::ORIGINAL_TIMING;
+    lookupReplayMode(mode, parsed);
+    return parsed;
+}
+
+void ReplayAdapter::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    session_path = node["session_path"].as<std::string>(session_path);
+    if (node["mode"]) {
+        mode_name = node["mode"].as<std::string>();
+        mode = parseReplayMode(mode_name);
+    }
+    rate_scale = node["rate_scale"].as<double>(rate_scale);
+    start_offset_sec = node["start_offset_sec"].as<double>(start_offset_sec);
+    loop = node["loop"].as<bool>(loop);
+    max_pending_frames = node["max_pending_frames"].as<size_t>(max_pending_frames);
+}
+
+bool ReplayAdapter::Config::validate() const {
+    ReplayMode parsed;
+    if (!mode_name.empty() && !lookupReplayMode(mode_name, parsed)) {
+        LOG_ERROR("ReplayAdapter: unknown mode \"" + mode_name + "\" (original, scaled or afap)");
+        return false;
+    }
+    return !session_path.empty() && rate_scale > 0.0 && start_offset_sec >= 0.0 &&
+           max_pending_frames > 0;
+}
+
+ReplayAdapter::~ReplayAdapter() {
+    stop();
+}
+
+bool ReplayAdapter::initialize(const std::string& config_file) {
+    try {
+        YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["communication"]["primary"]["replay"]);
+        return initialize(config);
+    } catch (const std::exception& e) {
+        LOG_ERROR("ReplayAdapter: failed to load configuration: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool ReplayAdapter::initialize(const Config& config) {
+    if (!config.validate()) {
+        LOG_ERROR("ReplayAdapter: invalid configuration");
+        return false;
+    }
+    config_ = config;
+
+    std::lock_guard<std::mutex> lock(reader_mutex_);
+    if (!reader_.open(config_.session_path)) {
+        return false;
+    }
+    session_start_ns_ = reader_.getStartTime();
+    if (config_.start_offset_sec > 0.0) {
+        reader_.seek(session_start_ns_ + static_cast<int64_t>(config_.start_offset_sec * 1e9));
+    }
+    return true;
+}
+
+void ReplayAdapter::start() {
+    if (running_ || !reader_.isOpen()) {
+        return;
+    }
+    running_ = true;
+    finished_ = false;
+    replay_thread_ = std::thread(&ReplayAdapter::replayLoop, this);
+    LOG_INFO("ReplayAdapter started: " + config_.session_path);
+}
+
+void ReplayAdapter::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    wake();
+    if (replay_thread_.joinable()) {
+        replay_thread_.join();
+    }
+    LOG_INFO("ReplayAdapter stopped after " + std::to_string(frames_replayed_.load()) + " frames");
+}
+
+void ReplayAdapter::registerCallback(std::function<void(const std::vector<uint8_t>&)> callback) {
+    callback_ = std::move(callback);
+}
+
+bool ReplayAdapter::isConnected() const {
+    return running_ && !finished_;
+}
+
+std::string ReplayAdapter::getConnectionStats() const {
+    const int64_t wall_start_ns = wall_start_ns_.load(std::memory_order_relaxed);
+    const double wall_sec = wall_start_ns == 0 ? 0.0 :
+        std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch() -
+                                      std::chrono::nanoseconds(wall_start_ns)).count();
+    double session_sec = (session_time_ns_.load() - session_start_ns_) / 1e9;
+
+    std::ostringstream oss;
+    oss << "frames=" << frames_replayed_.load()
+        << " bytes=" << bytes_replayed_.load()
+        << " session_time_s=" << session_sec
+        << " speedup=" << (wall_sec > 0.0 ? session_sec / wall_sec : 0.0)
+        << " backpressure_waits=" << backpressure_waits_.load();
+    return oss.str();
+}
+
+bool ReplayAdapter::sendData(const std::vector<uint8_t>& /*data*/) {
+    return false;  // Replay is receive-only
+}
+
+void ReplayAdapter::setBackpressureProbe(std::function<size_t()> probe) {
+    backpressure_probe_ = std::move(probe);
+}
+
+void ReplayAdapter::seek(double seconds_from_start) {
+    pending_seek_ns_ = session_start_ns_ + static_cast<int64_t>(seconds_from_start * 1e9);
+    wake();
+}
+
+void ReplayAdapter::wake() {
+    // Taking the lock orders the flag change before a waiter's predicate check
+    { std::lock_guard<std::mutex> lock(wake_mutex_); }
+    wake_cv_.notify_all();
+}
+
+void ReplayAdapter::replayLoop() {
+    std::vector<uint8_t> buffer;
+    RecordingReader::FrameView frame;
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    wall_start_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(wall_start.time_since_epoch()).count(),
+                         std::memory_order_relaxed);
+    auto pace_wall_origin = wall_start;
+    int64_t pace_session_origin = -1;
+    bool whole_pass = false;       // Playing from a rewind, not from a seek or start offset
+    uint64_t frames_this_pass = 0;
+
+    while (running_) {
+        int64_t seek_ns = pending_seek_ns_.exchange(-1);
+        if (seek_ns >= 0) {
+            std::lock_guard<std::mutex> lock(reader_mutex_);
+            reader_.seek(seek_ns);
+            pace_session_origin = -1;
+            whole_pass = false;
+        }
+
+        bool have_frame;
+        {
+            std::lock_guard<std::mutex> lock(reader_mutex_);
+            have_frame = reader_.next(frame);
+            if (!have_frame && config_.loop && !(whole_pass && frames_this_pass == 0)) {
+                reader_.rewind();
+                pace_session_origin = -1;
+                whole_pass = true;
+                frames_this_pass = 0;
+                continue;
+            }
+        }
+        if (!have_frame) {
+            if (config_.loop) {
+                LOG_WARN("ReplayAdapter: session has no RAW frames, not looping: " + config_.session_path);
+            }
+            break;
+        }
+        if (frame.type != RecordType::RAW) {
+            continue;
+        }
+
+        // Pace against the first frame replayed since start or the last seek
+        if (pace_session_origin < 0) {
+            pace_session_origin = frame.timestamp_ns;
+            pace_wall_origin = std::chrono::steady_clock::now();
+        }
+        if (config_.mode != ReplayMode::AS_FAST_AS_POSSIBLE) {
+            double scale = config_.mode == ReplayMode::SCALED ? config_.rate_scale : 1.0;
+            auto offset = std::chrono::nanoseconds(
+                static_cast<int64_t>((frame.timestamp_ns - pace_session_origin) / scale));
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            if (wake_cv_.wait_until(lock, pace_wall_origin + offset,
+                                    [this] { return !running_ || pending_seek_ns_.load() >= 0; })) {
+                continue;  // Stopped, or the seek is applied at the top of the loop
+            }
+        }
+        if (config_.mode != ReplayMode::ORIGINAL_TIMING) {
+            waitForConsumer();
+        }
+
+        if (callback_) {
+            buffer.assign(frame.payload, frame.payload + frame.size);
+            callback_(buffer);
+        }
+
+        ++frames_this_pass;
+        frames_replayed_.fetch_add(1, std::memory_order_relaxed);
+        bytes_replayed_.fetch_add(frame.size, std::memory_order_relaxed);
+        session_time_ns_.store(frame.timestamp_ns, std::memory_order_relaxed);
+    }
+
+    finished_ = true;
+    LOG_INFO("ReplayAdapter reached end of session: " + getConnectionStats());
+}
+
+void ReplayAdapter::waitForConsumer() {
+    if (!backpressure_probe_) {
+        return;
+    }
+    bool waited = false;
+    while (running_ && backpressure_probe_() > config_.max_pending_frames) {
+        waited = true;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    if (waited) {
+        backpressure_waits_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,242 @@
+#include "communication/SocketBackend.hpp"
+#include "communication/EpollSocketBackend.hpp"
+#include "utils/Logger.hpp"
+#include <cerrno>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef ENABLE_IO_URING
+    #include "communication/IoUringBackend.hpp"
+#endif
+
+namespace radar_tracking {
+
+namespace {
+
+SocketBackend::Kind parseBackendKind(const std::string& kind) {
+    if (kind == "io_uring") return SocketBackend::Kind::IO_URING;
+    if (kind == "socket" || kind == "epoll") return SocketBackend::Kind::SOCKET;
+    return SocketBackend::Kind::AUTO;
+}
+
+bool isPowerOfTwo(uint32_t value) {
+    return value >= 2 && (value & (value - 1)) == 0;
+}
+
+}  // namespace
+
+void SocketBackend::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    if (node["io_backend"]) {
+        kind = parseBackendKind(node["io_backend"].as<std::string>());
+    }
+    ring_entries = node["ring_entries"].as<uint32_t>(ring_entries);
+    receive_buffers = node["receive_buffers"].as<uint32_t>(receive_buffers);
+    receive_buffer_size = node["buffer_size"].as<uint32_t>(receive_buffer_size);
+    send_buffers = node["send_buffers"].as<uint32_t>(send_buffers);
+    send_buffer_size = node["send_buffer_size"].as<uint32_t>(send_buffer_size);
+    batch_size = node["batch_size"].as<uint32_t>(batch_size);
+    zerocopy_min_bytes = node["zerocopy_min_bytes"].as<uint32_t>(zerocopy_min_bytes);
+}
+
+bool SocketBackend::Config::validate() const {
+    if (!isPowerOfTwo(receive_buffers) || receive_buffers > 32768 || !isPowerOfTwo(send_buffers)) {
+        LOG_ERROR("SocketBackend: receive_buffers (<= 32768) and send_buffers must be powers of two");
+        return false;
+    }
+    if (receive_buffer_size == 0 || send_buffer_size == 0 || batch_size == 0 || ring_entries == 0) {
+        LOG_ERROR("SocketBackend: buffer sizes, batch_size and ring_entries must be positive");
+        return false;
+    }
+    return true;
+}
+
+SocketBackend::SocketBackend(const Config& config)
+    : config_(config),
+      send_slab_(new uint8_t[static_cast<size_t>(config.send_buffers) * config.send_buffer_size]),
+      free_slots_(std::make_unique<LockFreeQueue<uint32_t>>(config.send_buffers)),
+      submit_queue_(std::make_unique<LockFreeQueue<SendRequest>>(config.send_buffers)) {
+    for (uint32_t slot = 0; slot < config_.send_buffers; ++slot) {
+        free_slots_->tryPush(slot);
+    }
+}
+
+SocketBackend::~SocketBackend() {
+    // Derived destructors stop the loop; only descriptors can be left here
+    for (auto& socket : sockets_) {
+        if (socket.fd >= 0) {
+            ::close(socket.fd);
+        }
+    }
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+    }
+}
+
+std::unique_ptr<SocketBackend> SocketBackend::create(const Config& config) {
+    if (!config.validate()) {
+        return nullptr;
+    }
+    if (config.kind != Kind::SOCKET) {
+#ifdef ENABLE_IO_URING
+        if (IoUringBackend::isSupported()) {
+            return std::make_unique<IoUringBackend>(config);
+        }
+#endif
+        if (config.kind == Kind::IO_URING) {
+            LOG_WARN("SocketBackend: io_uring not available, using classic sockets");
+        }
+    }
+    return std::make_unique<EpollSocketBackend>(config);
+}
+
+int SocketBackend::addSocket(int fd, BatchHandler handler) {
+    if (running_ || fd < 0) {
+        return -1;
+    }
+    int type = 0;
+    socklen_t length = sizeof(type);
+    if (::getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &length) != 0) {
+        LOG_ERROR("SocketBackend: not a socket: " + std::string(std::strerror(errno)));
+        return -1;
+    }
+    Socket& socket = sockets_.emplace_back();
+    socket.fd = fd;
+    socket.stream = type == SOCK_STREAM;
+    socket.handler = std::move(handler);
+    return static_cast<int>(sockets_.size() - 1);
+}
+
+bool SocketBackend::start() {
+    if (running_) {
+        return true;
+    }
+    for (const auto& socket : sockets_) {
+        if (socket.fd < 0) {
+            LOG_ERROR("SocketBackend: a stopped backend cannot be restarted");
+            return false;
+        }
+    }
+    // Blocking, so an io_uring read of it waits; the epoll loop only reads it when readable
+    wake_fd_ = ::eventfd(0, EFD_CLOEXEC);
+    if (wake_fd_ < 0 || !setup()) {
+        LOG_ERROR("SocketBackend: " + getName() + " setup failed");
+        teardown();
+        return false;
+    }
+    running_ = true;
+    loop_thread_ = std::thread(&SocketBackend::run, this);
+    LOG_INFO("SocketBackend: " + getName() + " started with " + std::to_string(sockets_.size()) + " sockets");
+    return true;
+}
+
+void SocketBackend::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    const uint64_t one = 1;
+    [[maybe_unused]] ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+    if (loop_thread_.joinable()) {
+        loop_thread_.join();
+    }
+    teardown();
+
+    for (auto& socket : sockets_) {
+        if (socket.fd >= 0) {
+            ::close(socket.fd);
+            socket.fd = -1;
+        }
+        socket.open = false;
+        socket.pending.clear();
+    }
+    ::close(wake_fd_);
+    wake_fd_ = -1;
+
+    // Everything in flight was abandoned with the loop; rebuild the free list
+    SendRequest request;
+    while (submit_queue_->tryPop(request)) {
+    }
+    uint32_t slot;
+    while (free_slots_->tryPop(slot)) {
+    }
+    for (slot = 0; slot < config_.send_buffers; ++slot) {
+        free_slots_->tryPush(slot);
+    }
+}
+
+bool SocketBackend::send(int socket_id, const uint8_t* data, size_t size) {
+    uint32_t slot;
+    if (socket_id < 0 || static_cast<size_t>(socket_id) >= sockets_.size() ||
+        size > config_.send_buffer_size || !running_.load(std::memory_order_acquire) ||
+        !free_slots_->tryPop(slot)) {
+        send_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    std::memcpy(slotData(slot), data, size);
+    SendRequest request{static_cast<uint32_t>(socket_id), slot, static_cast<uint32_t>(size)};
+    if (!submit_queue_->tryPush(request)) {
+        releaseSlot(slot);
+        send_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // One wake-up per batch: the loop clears the flag before draining
+    if (!wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+    }
+    return true;
+}
+
+bool SocketBackend::collectSubmissions() {
+    wake_pending_.exchange(false, std::memory_order_acq_rel);
+    SendRequest request;
+    bool any = false;
+    while (submit_queue_->tryPop(request)) {
+        Socket& socket = sockets_[request.socket];
+        if (!socket.open) {
+            releaseSlot(request.slot);
+            send_dropped_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        socket.pending.push_back(request);
+        any = true;
+    }
+    return any;
+}
+
+void SocketBackend::closeSocket(Socket& socket, const char* reason) {
+    if (!socket.open.exchange(false)) {
+        return;
+    }
+    for (const auto& request : socket.pending) {
+        releaseSlot(request.slot);
+        send_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    socket.pending.clear();
+    socket.offset = 0;
+    LOG_WARN("SocketBackend: socket " + std::to_string(socket.fd) + " closed: " + reason);
+}
+
+bool SocketBackend::isOpen(int socket_id) const {
+    return socket_id >= 0 && static_cast<size_t>(socket_id) < sockets_.size() &&
+           sockets_[socket_id].open && sockets_[socket_id].fd >= 0;
+}
+
+SocketBackend::Stats SocketBackend::getStats() const {
+    Stats stats;
+    stats.packets_received = packets_received_.load(std::memory_order_relaxed);
+    stats.bytes_received = bytes_received_.load(std::memory_order_relaxed);
+    stats.receive_batches = receive_batches_.load(std::memory_order_relaxed);
+    stats.packets_sent = packets_sent_.load(std::memory_order_relaxed);
+    stats.bytes_sent = bytes_sent_.load(std::memory_order_relaxed);
+    stats.send_dropped = send_dropped_.load(std::memory_order_relaxed);
+    stats.receive_starved = receive_starved_.load(std::memory_order_relaxed);
+    stats.syscalls = syscalls_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace radar_tracking
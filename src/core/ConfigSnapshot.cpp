@@ -0,0 +1,267 @@
+#include "core/ConfigSnapshot.hpp"
+#include "utils/Logger.hpp"
+#include <cmath>
+
+namespace radar_tracking {
+
+namespace {
+
+YAML::Node loadAlgorithmFile(const std::string& path) {
+    return path.empty() ? YAML::Node() : YAML::LoadFile(path);
+}
+
+bool validateKalman(const KalmanCVKernel::Params& params) {
+    if (params.process_noise < 0.0 || params.measurement_noise <= 0.0 || params.initial_uncertainty <= 0.0) {
+        LOG_ERROR("Config: Kalman process_noise must be non-negative, measurement_noise and "
+                  "initial_uncertainty positive");
+        return false;
+    }
+    return true;
+}
+
+bool validateIMM(const IMMKernel::Params& params) {
+    for (size_t i = 0; i < IMMKernel::NUM_MODELS; ++i) {
+        double row_sum = 0.0;
+        for (double p : params.transition[i]) {
+            if (p < 0.0) {
+                LOG_ERROR("Config: IMM transition probabilities must be non-negative");
+                return false;
+            }
+            row_sum += p;
+        }
+        if (std::abs(row_sum - 1.0) > 1e-6) {
+            LOG_ERROR("Config: IMM transition matrix rows must sum to 1");
+            return false;
+        }
+        if (params.models[i].process_noise < 0.0 || params.models[i].measurement_noise <= 0.0) {
+            LOG_ERROR("Config: IMM model noise must be non-negative (process) and positive (measurement)");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool compileAlgorithms(const YAML::Node& node, ConfigSnapshot::Algorithms& algorithms) {
+    if (!node) {
+        LOG_ERROR("Config: missing 'algorithms' section");
+        return false;
+    }
+    algorithms.pipeline = node["pipeline"].as<std::string>(algorithms.pipeline);
+    algorithms.clustering_type = node["clustering"]["type"].as<std::string>("");
+    algorithms.association_type = node["association"]["type"].as<std::string>("");
+    algorithms.tracking_type = node["tracking"]["type"].as<std::string>("");
+    algorithms.clustering_config_file = node["clustering"]["config_file"].as<std::string>("");
+    algorithms.association_config_file = node["association"]["config_file"].as<std::string>("");
+    algorithms.tracking_config_file = node["tracking"]["config_file"].as<std::string>("");
+
+    if (algorithms.clustering_type == "DBSCAN") {
+        auto file = loadAlgorithmFile(algorithms.clustering_config_file);
+        if (file) {
+            algorithms.dbscan.loadFromYaml(file);
+        }
+        if (!algorithms.dbscan.validate()) {
+            LOG_ERROR("Config: invalid DBSCAN parameters");
+            return false;
+        }
+    }
+
+    if (algorithms.association_type == "GNN") {
+        auto params = loadAlgorithmFile(algorithms.association_config_file)["parameters"];
+        if (params) {
+            auto& gnn = algorithms.gnn;
+            gnn.gating_threshold = params["gating_threshold"].as<double>(gnn.gating_threshold);
+            gnn.max_association_distance = params["max_association_distance"].as<double>(gnn.max_association_distance);
+        }
+        if (algorithms.gnn.gating_threshold <= 0.0) {
+            LOG_ERROR("Config: GNN gating_threshold must be positive");
+            return false;
+        }
+    }
+
+    const auto& tracking_type = algorithms.tracking_type;
+    if (tracking_type == "IMM") {
+        auto file = loadAlgorithmFile(algorithms.tracking_config_file);
+        if (file) {
+            algorithms.imm.loadFromYaml(file);
+            algorithms.imm_batched = file["performance"]["enable_parallel_models"].as<bool>(false);
+            algorithms.imm_batch.loadFromYaml(file["performance"]["batch"]);
+        }
+        return validateIMM(algorithms.imm);
+    }
+    if (tracking_type == "PARTICLE") {
+        auto file = loadAlgorithmFile(algorithms.tracking_config_file);
+        if (file) {
+            algorithms.particle.loadFromYaml(file);
+        }
+        return algorithms.particle.validate();
+    }
+    if (tracking_type == "SRKF") {
+        auto file = loadAlgorithmFile(algorithms.tracking_config_file);
+        if (file) {
+            algorithms.srkf.loadFromYaml(file);
+        }
+        return algorithms.srkf.validate();
+    }
+    if (tracking_type == "KALMAN") {
+        auto tracking = node["tracking"];
+        auto& kalman = algorithms.kalman;
+        kalman.process_noise = tracking["process_noise"].as<double>(kalman.process_noise);
+        kalman.measurement_noise = tracking["measurement_noise"].as<double>(kalman.measurement_noise);
+        kalman.initial_uncertainty = tracking["initial_uncertainty"].as<double>(kalman.initial_uncertainty);
+        return validateKalman(kalman);
+    }
+    return true;
+}
+
+}  // namespace
+
+std::shared_ptr<ConfigSnapshot> ConfigSnapshot::compile(const YAML::Node& root, const std::string& source_file) {
+    try {
+        auto snapshot = std::make_shared<ConfigSnapshot>();
+        snapshot->source_file = source_file;
+
+        auto system = root["system"];
+        if (!system) {
+            LOG_ERROR("Config: missing 'system' section");
+            return nullptr;
+        }
+        const std::string mode = system["tracking_mode"].as<std::string>("TWS");
+        if (mode == "TWS") {
+            snapshot->system.tracking_mode = TrackingMode::TWS;
+        } else if (mode == "BEAM_REQUEST") {
+            snapshot->system.tracking_mode = TrackingMode::BEAM_REQUEST;
+        } else {
+            LOG_ERROR("Config: invalid tracking_mode " + mode + " (must be TWS or BEAM_REQUEST)");
+            return nullptr;
+        }
+        snapshot->system.max_tracks = system["max_tracks"].as<uint32_t>(snapshot->system.max_tracks);
+        snapshot->system.update_rate_hz = system["update_rate_hz"].as<double>(snapshot->system.update_rate_hz);
+        if (snapshot->system.max_tracks == 0 || snapshot->system.update_rate_hz <= 0.0) {
+            LOG_ERROR("Config: max_tracks and update_rate_hz must be positive");
+            return nullptr;
+        }
+
+        auto management = root["track_management"];
+        auto& track_management = snapshot->track_management;
+        track_management.confirmation_threshold =
+            management["confirmation_threshold"].as<uint32_t>(track_management.confirmation_threshold);
+        track_management.deletion_threshold =
+            management["deletion_threshold"].as<uint32_t>(track_management.deletion_threshold);
+        track_management.max_coast_time_sec =
+            management["max_coast_time_sec"].as<double>(track_management.max_coast_time_sec);
+        track_management.quality_threshold =
+            management["quality_threshold"].as<double>(track_management.quality_threshold);
+        track_management.max_tracks = snapshot->system.max_tracks;
+
+        auto processing_node = root["processing"];
+        auto& processing = snapshot->processing;
+        processing.thread_pool_size = processing_node["thread_pool_size"].as<uint32_t>(processing.thread_pool_size);
+        processing.queue_size_limit = processing_node["queue_size_limit"].as<uint32_t>(processing.queue_size_limit);
+        processing.processing_timeout_ms =
+            processing_node["processing_timeout_ms"].as<double>(processing.processing_timeout_ms);
+        processing.spatial_index.loadFromYaml(processing_node["spatial_index"]);
+        processing.lazy_prediction.loadFromYaml(processing_node["lazy_prediction"]);
+        processing.streaming.loadFromYaml(processing_node["streaming"]);
+        processing.oosm.loadFromYaml(processing_node["oosm"]);
+        if (processing.streaming.enabled && !processing.streaming.validate()) {
+            return nullptr;
+        }
+
+        // Sectors touch tracks at different times and late measurements are
+        // placed by time of validity; both need per-track prediction
+        if (processing.streaming.enabled || processing.oosm.enabled) {
+            processing.lazy_prediction.enabled = true;
+        }
+        if (processing.lazy_prediction.enabled && snapshot->system.tracking_mode != TrackingMode::TWS) {
+            LOG_INFO("Lazy prediction applies to TWS only; predicting every track each scan");
+            processing.lazy_prediction.enabled = false;
+        }
+        if (!processing.lazy_prediction.enabled) {
+            processing.oosm.enabled = false;
+        }
+
+        if (root["beam_scheduler"]) {
+            snapshot->beam_scheduler.loadFromYaml(root["beam_scheduler"]);
+            if (!snapshot->beam_scheduler.validate()) {
+                return nullptr;
+            }
+        }
+
+        if (!compileAlgorithms(root["algorithms"], snapshot->algorithms)) {
+            return nullptr;
+        }
+
+        snapshot->logging.level = root["logging"]["level"].as<std::string>(snapshot->logging.level);
+        snapshot->logging.file_path = root["logging"]["file_path"].as<std::string>(snapshot->logging.file_path);
+        return snapshot;
+
+    } catch (const std::exception& e) {
+        LOG_ERROR("Config: failed to compile " + source_file + ": " + std::string(e.what()));
+        return nullptr;
+    }
+}
+
+std::shared_ptr<ConfigSnapshot> ConfigSnapshot::compileFile(const std::string& config_file) {
+    try {
+        return compile(YAML::LoadFile(config_file), config_file);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Config: failed to load " + config_file + ": " + std::string(e.what()));
+        return nullptr;
+    }
+}
+
+bool ConfigPublisher::load(const std::string& config_file) {
+    auto snapshot = ConfigSnapshot::compileFile(config_file);
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    config_file_ = config_file;
+    if (!snapshot) {
+        return false;
+    }
+    publishLocked(std::move(snapshot));
+    return true;
+}
+
+bool ConfigPublisher::reload() {
+    std::string config_file;
+    {
+        std::lock_guard<std::mutex> lock(reload_mutex_);
+        config_file = config_file_;
+    }
+    if (config_file.empty()) {
+        return false;
+    }
+
+    auto snapshot = ConfigSnapshot::compileFile(config_file);
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    if (!snapshot) {
+        LOG_WARN("Configuration reload rejected; keeping generation " + std::to_string(generation_));
+        return false;
+    }
+    publishLocked(std::move(snapshot));
+    LOG_INFO("Configuration reloaded (generation " + std::to_string(generation_) + ")");
+    return true;
+}
+
+void ConfigPublisher::publish(std::shared_ptr<ConfigSnapshot> snapshot) {
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    publishLocked(std::move(snapshot));
+}
+
+void ConfigPublisher::subscribe(Listener listener) {
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    if (auto snapshot = std::atomic_load(&current_)) {
+        listener(snapshot);
+    }
+    listeners_.push_back(std::move(listener));
+}
+
+void ConfigPublisher::publishLocked(std::shared_ptr<ConfigSnapshot> snapshot) {
+    snapshot->generation = ++generation_;
+    SnapshotPtr published = std::move(snapshot);
+    std::atomic_store(&current_, published);
+    for (const auto& listener : listeners_) {
+        listener(published);
+    }
+}
+
+}  // namespace radar_tracking
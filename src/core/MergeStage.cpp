@@ -0,0 +1,409 @@
+#include "core/MergeStage.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace radar_tracking {
+
+using namespace shard_wire;
+
+namespace {
+
+constexpr int EPOLL_EVENTS = 64;
+
+}  // namespace
+
+void MergeStage::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    socket_dir = node["socket_dir"].as<std::string>(socket_dir);
+    publish_rate_hz = node["publish_rate_hz"].as<double>(publish_rate_hz);
+    merge.loadFromYaml(node["merge"]);
+    shards.clear();
+    for (const auto& entry : node["shards"]) {
+        ShardSpec spec;
+        spec.loadFromYaml(entry);
+        shards.push_back(spec);
+    }
+}
+
+bool MergeStage::Config::validate() const {
+    if (socket_dir.empty() || socketPath(socket_dir).size() >= sizeof(sockaddr_un::sun_path)) {
+        LOG_ERROR("MergeStage: socket_dir must be non-empty and short enough for a Unix socket path");
+        return false;
+    }
+    if (publish_rate_hz <= 0.0) {
+        LOG_ERROR("MergeStage: publish_rate_hz must be positive");
+        return false;
+    }
+    if (shards.empty()) {
+        LOG_ERROR("MergeStage: at least one shard is required");
+        return false;
+    }
+    uint64_t seen = 0;
+    for (const ShardSpec& shard : shards) {
+        if (shard.id >= TrackMerger::MAX_SHARDS || (seen & (uint64_t{1} << shard.id)) != 0) {
+            LOG_ERROR("MergeStage: shard ids must be unique and below " + std::to_string(TrackMerger::MAX_SHARDS));
+            return false;
+        }
+        seen |= uint64_t{1} << shard.id;
+    }
+    return merge.validate();
+}
+
+MergeStage::~MergeStage() {
+    stop();
+    closeAll();
+}
+
+bool MergeStage::initialize(const std::string& config_file) {
+    try {
+        YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["sharding"]);
+        return initialize(config);
+    } catch (const std::exception& e) {
+        LOG_ERROR("MergeStage: failed to load configuration: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool MergeStage::initialize(const Config& config) {
+    if (!config.validate() || isRunning()) {
+        return false;
+    }
+    closeAll();
+    config_ = config;
+    merger_ = TrackMerger(config_.merge);
+    for (const ShardSpec& shard : config_.shards) {
+        merger_.setRegion(shard.id, shard.region);
+    }
+    buffer_.resize(MAX_MESSAGE_BYTES);
+
+    if (::mkdir(config_.socket_dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        LOG_ERROR("MergeStage: cannot create " + config_.socket_dir + ": " + std::strerror(errno));
+        return false;
+    }
+    const std::string path = socketPath(config_.socket_dir);
+    ::unlink(path.c_str());
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (listen_fd_ < 0 || ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listen_fd_, static_cast<int>(TrackMerger::MAX_SHARDS)) != 0) {
+        LOG_ERROR("MergeStage: cannot listen on " + path + ": " + std::strerror(errno));
+        closeAll();
+        return false;
+    }
+
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        LOG_ERROR("MergeStage: cannot create event loop: " + std::string(std::strerror(errno)));
+        closeAll();
+        return false;
+    }
+    for (int fd : {listen_fd_, wake_fd_}) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    LOG_INFO("MergeStage: waiting for " + std::to_string(config_.shards.size()) + " shards on " + path);
+    return true;
+}
+
+void MergeStage::addOutputAdapter(std::unique_ptr<IOutputAdapter> adapter) {
+    if (adapter) {
+        outputs_.push_back(std::move(adapter));
+    }
+}
+
+bool MergeStage::start() {
+    if (epoll_fd_ < 0 || isRunning()) {
+        return false;
+    }
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&MergeStage::run, this);
+    return true;
+}
+
+void MergeStage::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    const uint64_t one = 1;
+    [[maybe_unused]] ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void MergeStage::closeAll() {
+    for (auto& peer : peers_) {
+        if (peer->fd >= 0) {
+            ::close(peer->fd);
+        }
+    }
+    peers_.clear();
+    connected_shards_.store(0, std::memory_order_relaxed);
+    for (int* fd : {&listen_fd_, &epoll_fd_, &wake_fd_}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+    if (!config_.socket_dir.empty()) {
+        ::unlink(socketPath(config_.socket_dir).c_str());
+    }
+}
+
+void MergeStage::run() {
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / config_.publish_rate_hz));
+    auto next_publish = Clock::now() + period;
+    epoll_event events[EPOLL_EVENTS];
+
+    while (running_.load(std::memory_order_acquire)) {
+        const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next_publish - Clock::now());
+        const int count = ::epoll_wait(epoll_fd_, events, EPOLL_EVENTS,
+                                       static_cast<int>(std::max<int64_t>(0, wait.count() + 1)));
+        if (count < 0 && errno != EINTR) {
+            LOG_ERROR("MergeStage: epoll_wait failed: " + std::string(std::strerror(errno)));
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == listen_fd_) {
+                accept();
+                continue;
+            }
+            if (fd == wake_fd_) {
+                uint64_t value;
+                [[maybe_unused]] ssize_t drained = ::read(wake_fd_, &value, sizeof(value));
+                continue;
+            }
+            auto it = std::find_if(peers_.begin(), peers_.end(), [fd](const auto& p) { return p->fd == fd; });
+            if (it == peers_.end()) {
+                continue;
+            }
+            Peer& peer = **it;
+            if (events[i].events & EPOLLIN) {
+                readPeer(peer);
+            }
+            if (peer.fd >= 0 && (events[i].events & (EPOLLHUP | EPOLLERR))) {
+                dropPeer(peer);
+            }
+        }
+        peers_.erase(std::remove_if(peers_.begin(), peers_.end(), [](const auto& p) { return p->fd < 0; }),
+                     peers_.end());
+
+        const auto now = Clock::now();
+        if (now >= next_publish) {
+            publish();
+            next_publish += period;
+            if (next_publish < now) {
+                next_publish = now + period;  // Fell behind; do not burst
+            }
+        }
+    }
+}
+
+void MergeStage::accept() {
+    while (true) {
+        const int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                LOG_WARN("MergeStage: accept failed: " + std::string(std::strerror(errno)));
+            }
+            return;
+        }
+        auto peer = std::make_unique<Peer>();
+        peer->fd = fd;
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+        peers_.push_back(std::move(peer));
+    }
+}
+
+void MergeStage::readPeer(Peer& peer) {
+    while (peer.fd >= 0) {
+        const ssize_t n = ::recv(peer.fd, buffer_.data(), buffer_.size(), 0);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                dropPeer(peer);
+            }
+            return;
+        }
+        if (n == 0) {
+            dropPeer(peer);
+            return;
+        }
+
+        MessageHeader header;
+        if (static_cast<size_t>(n) < sizeof(header)) {
+            messages_rejected_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        std::memcpy(&header, buffer_.data(), sizeof(header));
+        if (header.magic != MAGIC || header.version != VERSION || header.shard_id >= TrackMerger::MAX_SHARDS ||
+            sizeof(header) + static_cast<size_t>(header.record_count) * sizeof(TrackRecord) != static_cast<size_t>(n)) {
+            messages_rejected_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        applyMessage(peer, header, buffer_.data() + sizeof(header));
+    }
+}
+
+void MergeStage::applyMessage(Peer& peer, const MessageHeader& header, const uint8_t* records) {
+    const int shard = static_cast<int>(header.shard_id);
+
+    if (header.type == MSG_HELLO) {
+        if (peer.shard >= 0) {
+            messages_rejected_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // A restarted worker can reconnect before its old connection is noticed closed
+        for (auto& other : peers_) {
+            if (other.get() != &peer && other->shard == shard && other->fd >= 0) {
+                dropPeer(*other);
+            }
+        }
+        peer.shard = shard;
+        connected_shards_.fetch_add(1, std::memory_order_relaxed);
+        LOG_INFO("MergeStage: shard " + std::to_string(shard) + " connected");
+        return;
+    }
+
+    if (header.type != MSG_TRACKS || peer.shard != shard) {
+        messages_rejected_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (header.frame_seq != peer.frame_seq || header.chunk_index != peer.chunks_received) {
+        if (peer.chunks_received > 0) {
+            frames_incomplete_.fetch_add(1, std::memory_order_relaxed);
+        }
+        peer.frame_seq = header.frame_seq;
+        peer.chunks_received = 0;
+        peer.assembling.clear();
+        if (header.chunk_index != 0) {
+            return;  // Joined mid-frame; wait for the next one
+        }
+    }
+
+    const size_t offset = peer.assembling.size();
+    peer.assembling.resize(offset + header.record_count);
+    std::memcpy(peer.assembling.data() + offset, records, header.record_count * sizeof(TrackRecord));
+    if (++peer.chunks_received < header.chunk_count) {
+        return;
+    }
+
+    merger_.updateShard(static_cast<uint32_t>(shard), std::move(peer.assembling),
+                        std::chrono::high_resolution_clock::now());
+    peer.assembling = {};
+    peer.chunks_received = 0;
+    ++peer.frame_seq;  // Never matches a stale chunk of the completed frame
+    frames_received_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MergeStage::dropPeer(Peer& peer) {
+    if (peer.fd < 0) {
+        return;
+    }
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, peer.fd, nullptr);
+    ::close(peer.fd);
+    peer.fd = -1;
+    if (peer.shard >= 0) {
+        merger_.removeShard(static_cast<uint32_t>(peer.shard));
+        connected_shards_.fetch_sub(1, std::memory_order_relaxed);
+        LOG_WARN("MergeStage: shard " + std::to_string(peer.shard) + " disconnected");
+    }
+}
+
+void MergeStage::publish() {
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<Track>& tracks = merger_.merge(std::chrono::high_resolution_clock::now());
+    last_merge_ms_.store(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                         std::memory_order_relaxed);
+
+    for (auto& output : outputs_) {
+        if (output->isReady()) {
+            output->publishTracks(tracks);
+        }
+    }
+    if (callback_) {
+        callback_(tracks);
+    }
+    publishes_.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<TrackMerger::Handover> handovers = merger_.takeHandovers();
+    std::stable_sort(handovers.begin(), handovers.end(),
+                     [](const auto& a, const auto& b) { return a.shard_id < b.shard_id; });
+    for (size_t first = 0; first < handovers.size();) {
+        const uint32_t shard = handovers[first].shard_id;
+        size_t last = first;
+        while (last < handovers.size() && handovers[last].shard_id == shard && last - first < RECORDS_PER_MESSAGE) {
+            ++last;
+        }
+        auto it = std::find_if(peers_.begin(), peers_.end(), [shard](const auto& p) {
+            return p->fd >= 0 && p->shard == static_cast<int>(shard);
+        });
+        if (it != peers_.end()) {
+            MessageHeader header{};
+            header.magic = MAGIC;
+            header.version = VERSION;
+            header.type = MSG_HANDOVER;
+            header.shard_id = shard;
+            header.timestamp_ns = recording::toNanoseconds(std::chrono::high_resolution_clock::now());
+            header.chunk_count = 1;
+            header.record_count = static_cast<uint32_t>(last - first);
+            std::memcpy(buffer_.data(), &header, sizeof(header));
+            for (size_t i = first; i < last; ++i) {
+                std::memcpy(buffer_.data() + sizeof(header) + (i - first) * sizeof(TrackRecord),
+                            &handovers[i].record, sizeof(TrackRecord));
+            }
+            const size_t size = sizeof(header) + header.record_count * sizeof(TrackRecord);
+            if (::send((*it)->fd, buffer_.data(), size, MSG_DONTWAIT | MSG_NOSIGNAL) == static_cast<ssize_t>(size)) {
+                handovers_sent_.fetch_add(header.record_count, std::memory_order_relaxed);
+            }
+        }
+        first = last;
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    merger_stats_ = merger_.getStats();
+}
+
+MergeStage::Stats MergeStage::getStats() const {
+    Stats stats;
+    stats.frames_received = frames_received_.load(std::memory_order_relaxed);
+    stats.frames_incomplete = frames_incomplete_.load(std::memory_order_relaxed);
+    stats.messages_rejected = messages_rejected_.load(std::memory_order_relaxed);
+    stats.publishes = publishes_.load(std::memory_order_relaxed);
+    stats.handovers_sent = handovers_sent_.load(std::memory_order_relaxed);
+    stats.connected_shards = connected_shards_.load(std::memory_order_relaxed);
+    stats.last_merge_ms = last_merge_ms_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats.merger = merger_stats_;
+    return stats;
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,538 @@
+#include "core/PluginManager.hpp"
+#include "utils/Logger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <boost/filesystem.hpp>
+
+#ifndef _WIN32
+    #include <dlfcn.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace radar_tracking {
+
+namespace {
+
+constexpr PluginKind KINDS[PluginManager::KIND_COUNT] = {
+    PluginKind::CLUSTERING, PluginKind::ASSOCIATION, PluginKind::TRACKER
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string hex(uint64_t value) {
+    char text[24];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+    return text;
+}
+
+}  // namespace
+
+/**
+ * @brief A loaded plugin library, closed when its last instance is gone
+ */
+struct PluginManager::Library {
+    void* handle = nullptr;
+    const PluginDescriptor* descriptor = nullptr;
+
+    ~Library() {
+#ifndef _WIN32
+        if (handle) {
+            ::dlclose(handle);
+        }
+#endif
+    }
+};
+
+PluginManager::Instance::~Instance() {
+    if (object && library && library->descriptor) {
+        library->descriptor->destroy(object);
+    }
+}
+
+void PluginManager::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    enabled = node["enabled"].as<bool>(enabled);
+    directory = node["directory"].as<std::string>(directory);
+    staging_directory = node["staging_directory"].as<std::string>(staging_directory);
+    poll_interval_s = node["poll_interval_s"].as<double>(poll_interval_s);
+    migrate_tracker_state = node["migrate_tracker_state"].as<bool>(migrate_tracker_state);
+
+    auto loadSpec = [](const YAML::Node& spec_node, PluginSpec& spec) {
+        if (!spec_node) {
+            return;
+        }
+        spec.library = spec_node["library"].as<std::string>(spec.library);
+        spec.config_file = spec_node["config_file"].as<std::string>(spec.config_file);
+    };
+    loadSpec(node["clustering"], clustering);
+    loadSpec(node["association"], association);
+    loadSpec(node["tracking"], tracking);
+}
+
+bool PluginManager::Config::validate() const {
+    if (staging_directory.empty()) {
+        LOG_ERROR("PluginManager: staging_directory must be set");
+        return false;
+    }
+    if (poll_interval_s < 0.0) {
+        LOG_ERROR("PluginManager: poll_interval_s must not be negative");
+        return false;
+    }
+    for (const PluginKind kind : KINDS) {
+        const PluginSpec& plugin = spec(kind);
+        if (!plugin.library.empty() && plugin.config_file.empty()) {
+            LOG_ERROR(std::string("PluginManager: the ") + kindName(kind) + " plugin needs a config_file");
+            return false;
+        }
+    }
+    return true;
+}
+
+const PluginManager::PluginSpec& PluginManager::Config::spec(PluginKind kind) const {
+    switch (kind) {
+        case PluginKind::CLUSTERING:
+            return clustering;
+        case PluginKind::ASSOCIATION:
+            return association;
+        case PluginKind::TRACKER:
+        default:
+            return tracking;
+    }
+}
+
+std::string PluginManager::Config::libraryPath(const PluginSpec& spec) const {
+    if (spec.library.empty() || boost::filesystem::path(spec.library).is_absolute()) {
+        return spec.library;
+    }
+    return directory + "/" + spec.library;
+}
+
+const char* PluginManager::kindName(PluginKind kind) {
+    switch (kind) {
+        case PluginKind::CLUSTERING:
+            return "clustering";
+        case PluginKind::ASSOCIATION:
+            return "association";
+        case PluginKind::TRACKER:
+            return "tracker";
+        default:
+            return "unknown";
+    }
+}
+
+PluginManager::~PluginManager() {
+    shutdown();
+}
+
+bool PluginManager::initialize(const std::string& config_file) {
+    try {
+        YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["plugins"]);
+        if (!config.validate()) {
+            return false;
+        }
+        shutdown();
+        config_file_ = config_file;
+        config_file_stamp_ = stamp(config_file);
+        return start(config);
+    } catch (const std::exception& e) {
+        LOG_ERROR("PluginManager: failed to load configuration: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool PluginManager::initialize(const Config& config) {
+    if (!config.validate()) {
+        return false;
+    }
+    shutdown();
+    config_file_.clear();
+    return start(config);
+}
+
+bool PluginManager::start(const Config& config) {
+    config_ = config;
+    enabled_ = config.enabled;
+    migrate_tracker_state_.store(config.migrate_tracker_state, std::memory_order_relaxed);
+    if (!enabled_) {
+        return true;
+    }
+
+#ifdef _WIN32
+    LOG_ERROR("PluginManager: algorithm plugins need dlopen() and are not supported on Windows");
+    return false;
+#else
+    try {
+        boost::filesystem::create_directories(config_.staging_directory);
+    } catch (const std::exception& e) {
+        LOG_ERROR("PluginManager: cannot create " + config_.staging_directory + ": " + e.what());
+        return false;
+    }
+
+    const size_t staged = refresh();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = false;
+    }
+    if (config_.poll_interval_s > 0.0) {
+        watcher_ = std::thread(&PluginManager::watcherLoop, this);
+    }
+    LOG_INFO("PluginManager: " + std::to_string(staged) + " plugins staged from " + config_.directory +
+             (config_.poll_interval_s > 0.0 ? ", checking for changes every " + std::to_string(config_.poll_interval_s) + " s"
+                                            : std::string()));
+    return true;
+#endif
+}
+
+void PluginManager::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (watcher_.joinable()) {
+        watcher_.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& instance : staged_) {
+            if (instance) {
+                retired_.push_back(std::move(instance));
+            }
+        }
+        pending_.store(false, std::memory_order_relaxed);
+    }
+    releaseRetired();
+}
+
+void PluginManager::setDefaults(IClusteringAlgorithm* clustering, IAssociationAlgorithm* association,
+                                ITracker* tracker) {
+    default_clustering_ = clustering;
+    default_association_ = association;
+    default_tracker_ = tracker;
+}
+
+PluginManager::FileStamp PluginManager::stamp(const std::string& path) {
+    FileStamp result;
+    if (path.empty()) {
+        return result;
+    }
+#ifndef _WIN32
+    struct stat info;
+    if (::stat(path.c_str(), &info) != 0) {
+        return result;
+    }
+    #ifdef __APPLE__
+    result.mtime_ns = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+    #else
+    result.mtime_ns = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    #endif
+    result.size = static_cast<uint64_t>(info.st_size);
+#else
+    boost::system::error_code error;
+    const std::time_t modified = boost::filesystem::last_write_time(path, error);
+    if (error) {
+        return result;
+    }
+    result.mtime_ns = static_cast<int64_t>(modified) * 1000000000;
+    result.size = boost::filesystem::file_size(path, error);
+#endif
+    return result;
+}
+
+size_t PluginManager::refresh() {
+    std::lock_guard<std::mutex> refresh_lock(refresh_mutex_);
+    releaseRetired();
+    if (!enabled_) {
+        return 0;
+    }
+    reloadConfig();
+
+    size_t staged = 0;
+    for (const PluginKind kind : KINDS) {
+        const PluginSpec& spec = config_.spec(kind);
+        Source& source = sources_[slot(kind)];
+        const Source next{spec, stamp(config_.libraryPath(spec)), stamp(spec.config_file)};
+        if (next.spec == source.spec && next.library == source.library && next.config == source.config) {
+            continue;
+        }
+        source = next;  // A failed load is retried once a file changes again
+
+        InstancePtr instance;
+        if (spec.library.empty()) {
+            // No object: back to the built-in instance
+            instance = std::make_unique<Instance>();
+            instance->kind = kind;
+            instance->name = "built-in";
+        } else {
+            instance = load(kind, spec);
+            if (!instance) {
+                continue;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (staged_[slot(kind)]) {
+            retired_.push_back(std::move(staged_[slot(kind)]));  // Superseded before it ran
+        }
+        staged_[slot(kind)] = std::move(instance);
+        pending_.store(true, std::memory_order_release);
+        ++staged;
+    }
+    return staged;
+}
+
+bool PluginManager::reloadConfig() {
+    if (config_file_.empty()) {
+        return false;
+    }
+    const FileStamp current = stamp(config_file_);
+    if (current == config_file_stamp_) {
+        return false;
+    }
+    config_file_stamp_ = current;
+
+    try {
+        Config config;
+        config.loadFromYaml(YAML::LoadFile(config_file_)["plugins"]);
+        if (!config.validate()) {
+            LOG_WARN("PluginManager: invalid plugins section in " + config_file_ + " ignored");
+            return false;
+        }
+        // Slot selection and migration follow the file; the rest needs a restart
+        config_.directory = config.directory;
+        config_.migrate_tracker_state = config.migrate_tracker_state;
+        config_.clustering = config.clustering;
+        config_.association = config.association;
+        config_.tracking = config.tracking;
+        migrate_tracker_state_.store(config.migrate_tracker_state, std::memory_order_relaxed);
+        return true;
+    } catch (const std::exception& e) {
+        LOG_WARN("PluginManager: cannot re-read " + config_file_ + ": " + e.what());
+        return false;
+    }
+}
+
+PluginManager::InstancePtr PluginManager::load(PluginKind kind, const PluginSpec& spec) {
+    const auto start_time = std::chrono::steady_clock::now();
+    const std::string path = config_.libraryPath(spec);
+    auto fail = [&](const std::string& reason) -> InstancePtr {
+        load_failures_.fetch_add(1, std::memory_order_relaxed);
+        LOG_ERROR(std::string("PluginManager: cannot load ") + kindName(kind) + " plugin " + path + ": " + reason);
+        return nullptr;
+    };
+
+#ifdef _WIN32
+    return fail("plugins are not supported on Windows");
+#else
+    // Load a private copy: dlopen() of an already loaded path returns the old code
+    const boost::filesystem::path source(path);
+    const std::string staged = config_.staging_directory + "/" + source.stem().string() + "." +
+                               std::to_string(::getpid()) + "." + std::to_string(++load_sequence_) +
+                               source.extension().string();
+    try {
+        boost::filesystem::remove(staged);
+        boost::filesystem::copy_file(source, staged);
+    } catch (const std::exception& e) {
+        return fail(e.what());
+    }
+
+    void* handle = ::dlopen(staged.c_str(), RTLD_NOW | RTLD_LOCAL);
+    const char* dl_error = handle ? nullptr : ::dlerror();
+    boost::system::error_code ignored;
+    boost::filesystem::remove(staged, ignored);  // The mapping outlives the file
+    if (!handle) {
+        return fail(dl_error ? dl_error : "dlopen() failed");
+    }
+
+    auto library = std::make_shared<Library>();
+    library->handle = handle;
+    const auto entry = reinterpret_cast<PluginEntryPoint>(::dlsym(handle, PLUGIN_ENTRY_POINT));
+    if (!entry) {
+        return fail(std::string("no ") + PLUGIN_ENTRY_POINT + "() entry point");
+    }
+    const PluginDescriptor* descriptor = entry();
+    if (!descriptor) {
+        return fail("no plugin descriptor");
+    }
+    if (descriptor->abi_version != PLUGIN_ABI_VERSION || descriptor->layout != pluginLayoutFingerprint()) {
+        abi_rejections_.fetch_add(1, std::memory_order_relaxed);
+        LOG_ERROR(std::string("PluginManager: refusing ") + kindName(kind) + " plugin " + path + ": built for ABI " +
+                  std::to_string(descriptor->abi_version) + " layout " + hex(descriptor->layout) + ", this build has ABI " +
+                  std::to_string(PLUGIN_ABI_VERSION) + " layout " + hex(pluginLayoutFingerprint()));
+        return nullptr;
+    }
+    if (descriptor->kind != static_cast<uint32_t>(kind)) {
+        return fail("not a " + std::string(kindName(kind)) + " plugin");
+    }
+    if (!descriptor->create || !descriptor->destroy) {
+        return fail("incomplete plugin descriptor");
+    }
+    library->descriptor = descriptor;
+
+    auto instance = std::make_unique<Instance>();
+    instance->library = library;
+    instance->kind = kind;
+    instance->name = descriptor->name ? descriptor->name : "";
+    instance->version = descriptor->version ? descriptor->version : "";
+
+    bool initialized = false;
+    try {
+        instance->object = descriptor->create();
+        if (!instance->object) {
+            return fail("create() returned no instance");
+        }
+        switch (kind) {
+            case PluginKind::CLUSTERING:
+                initialized = static_cast<IClusteringAlgorithm*>(instance->object)->initialize(spec.config_file);
+                break;
+            case PluginKind::ASSOCIATION:
+                initialized = static_cast<IAssociationAlgorithm*>(instance->object)->initialize(spec.config_file);
+                break;
+            case PluginKind::TRACKER:
+                initialized = static_cast<ITracker*>(instance->object)->initialize(spec.config_file);
+                break;
+        }
+    } catch (const std::exception& e) {
+        return fail(e.what());
+    }
+    if (!initialized) {
+        return fail("initialize(" + spec.config_file + ") failed");
+    }
+
+    loads_.fetch_add(1, std::memory_order_relaxed);
+    last_load_ms_.store(millisecondsSince(start_time), std::memory_order_relaxed);
+    LOG_INFO(std::string("PluginManager: loaded ") + kindName(kind) + " plugin " + instance->name + " " +
+             instance->version + " from " + path + " (" + spec.config_file + ")");
+    return instance;
+#endif
+}
+
+bool PluginManager::applyPending(const std::vector<Track>& tracks, ScanPipeline* pipeline) {
+    if (!pending_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    const auto start_time = std::chrono::steady_clock::now();
+
+    std::array<InstancePtr, KIND_COUNT> incoming;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        incoming.swap(staged_);
+        pending_.store(false, std::memory_order_relaxed);
+    }
+
+    // The outgoing tracker hands its per-track state to the incoming one
+    const auto& next_tracker = incoming[slot(PluginKind::TRACKER)];
+    if (next_tracker && !tracks.empty() && migrate_tracker_state_.load(std::memory_order_relaxed)) {
+        ITracker* previous = tracker();
+        ITracker* next = next_tracker->object ? static_cast<ITracker*>(next_tracker->object) : default_tracker_;
+        if (previous && next && previous != next) {
+            previous->exportState(tracks, migration_);
+            if (migration_.count > 0) {
+                if (next->importState(tracks, migration_)) {
+                    migrated_tracks_.fetch_add(migration_.count, std::memory_order_relaxed);
+                } else {
+                    migration_failures_.fetch_add(1, std::memory_order_relaxed);
+                    LOG_WARN("PluginManager: " + next->getTrackerType() + " cannot adopt " + migration_.tag +
+                             " state; tracks continue from their estimates");
+                }
+            }
+        }
+    }
+
+    std::string swapped;
+    bool changed[KIND_COUNT] = {};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t k = 0; k < KIND_COUNT; ++k) {
+            if (!incoming[k]) {
+                continue;
+            }
+            changed[k] = true;
+            swapped += std::string(swapped.empty() ? "" : ", ") + kindName(incoming[k]->kind) + " " +
+                       incoming[k]->name + (incoming[k]->version.empty() ? "" : " " + incoming[k]->version);
+            if (active_[k]) {
+                retired_.push_back(std::move(active_[k]));  // Destroyed on the watcher thread
+            }
+            if (incoming[k]->object) {
+                active_[k] = std::move(incoming[k]);
+            } else {
+                retired_.push_back(std::move(incoming[k]));
+            }
+        }
+    }
+
+    if (pipeline &&
+        !pipeline->rebindAlgorithms(changed[slot(PluginKind::CLUSTERING)] ? clustering() : nullptr,
+                                    changed[slot(PluginKind::ASSOCIATION)] ? association() : nullptr,
+                                    changed[slot(PluginKind::TRACKER)] ? tracker() : nullptr) &&
+        !warned_static_pipeline_) {
+        warned_static_pipeline_ = true;
+        LOG_WARN("PluginManager: the " + pipeline->getVariantName() +
+                 " scan pipeline holds its own algorithms; plugins run with algorithms.pipeline: runtime");
+    }
+
+    swaps_.fetch_add(1, std::memory_order_relaxed);
+    last_swap_ms_.store(millisecondsSince(start_time), std::memory_order_relaxed);
+    LOG_INFO("PluginManager: now running " + swapped);
+    return true;
+}
+
+IClusteringAlgorithm* PluginManager::clustering() const {
+    const auto& instance = active_[slot(PluginKind::CLUSTERING)];
+    return instance ? static_cast<IClusteringAlgorithm*>(instance->object) : default_clustering_;
+}
+
+IAssociationAlgorithm* PluginManager::association() const {
+    const auto& instance = active_[slot(PluginKind::ASSOCIATION)];
+    return instance ? static_cast<IAssociationAlgorithm*>(instance->object) : default_association_;
+}
+
+ITracker* PluginManager::tracker() const {
+    const auto& instance = active_[slot(PluginKind::TRACKER)];
+    return instance ? static_cast<ITracker*>(instance->object) : default_tracker_;
+}
+
+void PluginManager::releaseRetired() {
+    std::vector<InstancePtr> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released.swap(retired_);
+    }
+    // Destroys the instances and closes libraries nothing uses any more
+}
+
+void PluginManager::watcherLoop() {
+    const auto period = std::chrono::duration<double>(config_.poll_interval_s);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (cv_.wait_for(lock, period, [this]() { return stopping_; })) {
+            break;
+        }
+        lock.unlock();
+        refresh();
+        lock.lock();
+    }
+}
+
+PluginManager::Stats PluginManager::getStats() const {
+    Stats stats;
+    stats.loads = loads_.load(std::memory_order_relaxed);
+    stats.load_failures = load_failures_.load(std::memory_order_relaxed);
+    stats.abi_rejections = abi_rejections_.load(std::memory_order_relaxed);
+    stats.swaps = swaps_.load(std::memory_order_relaxed);
+    stats.migrated_tracks = migrated_tracks_.load(std::memory_order_relaxed);
+    stats.migration_failures = migration_failures_.load(std::memory_order_relaxed);
+    stats.last_load_ms = last_load_ms_.load(std::memory_order_relaxed);
+    stats.last_swap_ms = last_swap_ms_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,270 @@
+#include "core/ShardSupervisor.hpp"
+#include "management/TrackCheckpointer.hpp"
+#include "utils/Logger.hpp"
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+    #include <sys/prctl.h>
+#endif
+
+namespace radar_tracking {
+
+namespace {
+
+constexpr auto WATCH_INTERVAL = std::chrono::milliseconds(100);
+
+std::string ownExecutable() {
+    char path[PATH_MAX];
+    const ssize_t n = ::readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (n <= 0) {
+        return {};
+    }
+    path[n] = '\0';
+    return path;
+}
+
+std::string describeExit(int status) {
+    if (WIFEXITED(status)) {
+        return "exited with status " + std::to_string(WEXITSTATUS(status));
+    }
+    if (WIFSIGNALED(status)) {
+        return "killed by signal " + std::to_string(WTERMSIG(status));
+    }
+    return "stopped";
+}
+
+}  // namespace
+
+void ShardSupervisor::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    socket_dir = node["socket_dir"].as<std::string>(socket_dir);
+    executable = node["executable"].as<std::string>(executable);
+    restart_delay_s = node["restart_delay_s"].as<double>(restart_delay_s);
+    max_restarts = node["max_restarts"].as<uint32_t>(max_restarts);
+    shards.clear();
+    for (const auto& entry : node["shards"]) {
+        ShardSpec spec;
+        spec.loadFromYaml(entry);
+        shards.push_back(spec);
+    }
+}
+
+bool ShardSupervisor::Config::validate() const {
+    if (socket_dir.empty() || restart_delay_s < 0.0) {
+        LOG_ERROR("ShardSupervisor: socket_dir is required and restart_delay_s must be non-negative");
+        return false;
+    }
+    if (shards.empty()) {
+        LOG_ERROR("ShardSupervisor: at least one shard is required");
+        return false;
+    }
+    return true;
+}
+
+ShardSupervisor::~ShardSupervisor() {
+    stop();
+}
+
+void ShardSupervisor::mergeOverrides(YAML::Node base, const YAML::Node& overrides) {
+    if (!overrides || !overrides.IsMap()) {
+        return;
+    }
+    for (const auto& item : overrides) {
+        const std::string key = item.first.as<std::string>();
+        YAML::Node target = base[key];
+        if (item.second.IsMap() && target.IsMap()) {
+            mergeOverrides(target, item.second);
+        } else {
+            base[key] = YAML::Clone(item.second);
+        }
+    }
+}
+
+bool ShardSupervisor::initialize(const std::string& config_file, const std::string& log_level) {
+    if (isRunning()) {
+        return false;
+    }
+    try {
+        const YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["sharding"]);
+        if (!config.validate()) {
+            return false;
+        }
+        if (config.executable.empty()) {
+            config.executable = ownExecutable();
+        }
+        if (::mkdir(config.socket_dir.c_str(), 0755) != 0 && errno != EEXIST) {
+            LOG_ERROR("ShardSupervisor: cannot create " + config.socket_dir + ": " + std::strerror(errno));
+            return false;
+        }
+
+        std::vector<Worker> workers;
+        for (const ShardSpec& shard : config.shards) {
+            // The supervisor publishes the merged picture; workers only feed the merge stage
+            YAML::Node worker_config = YAML::Clone(root);
+            for (auto output : worker_config["output"]) {
+                if (output.second.IsMap() && output.second["enabled"]) {
+                    output.second["enabled"] = false;
+                }
+            }
+            worker_config["output"]["shard"]["enabled"] = true;
+            worker_config["output"]["shard"]["adapter_type"] = "SHARD";
+            mergeOverrides(worker_config, shard.overrides);
+            worker_config["sharding"]["shard_id"] = shard.id;
+            if (!(shard.overrides && shard.overrides["checkpoint"] && shard.overrides["checkpoint"]["directory"])) {
+                // One checkpoint (and primary lock) per shard
+                TrackCheckpointer::Config checkpoint;
+                checkpoint.loadFromYaml(worker_config["checkpoint"]);
+                worker_config["checkpoint"]["directory"] =
+                    checkpoint.directory + "/shard_" + std::to_string(shard.id);
+            }
+
+            Worker worker;
+            worker.shard_id = shard.id;
+            worker.config_path = config.socket_dir + "/shard_" + std::to_string(shard.id) + ".yaml";
+            std::ofstream out(worker.config_path, std::ios::trunc);
+            YAML::Emitter emitter;
+            emitter << worker_config;
+            out << emitter.c_str() << '\n';
+            if (!out) {
+                LOG_ERROR("ShardSupervisor: cannot write " + worker.config_path);
+                return false;
+            }
+            workers.push_back(worker);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+        workers_ = std::move(workers);
+        log_level_ = log_level;
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR("ShardSupervisor: failed to prepare worker configurations: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool ShardSupervisor::start() {
+    if (workers_.empty() || isRunning()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Worker& worker : workers_) {
+            launch(worker);
+        }
+    }
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&ShardSupervisor::watch, this);
+    return true;
+}
+
+bool ShardSupervisor::launch(Worker& worker) {
+    // Everything the child needs is built before fork(): it may only exec or _exit
+    const std::string shard_id = std::to_string(worker.shard_id);
+    const char* argv[] = {config_.executable.c_str(), "--config", worker.config_path.c_str(),
+                          "--shard-id", shard_id.c_str(), "--log-level", log_level_.c_str(), nullptr};
+    const pid_t parent = ::getpid();
+
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        LOG_ERROR("ShardSupervisor: fork failed: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    if (pid == 0) {
+#ifdef __linux__
+        // Workers must not outlive a supervisor that died without stopping them
+        ::prctl(PR_SET_PDEATHSIG, SIGTERM);
+        if (::getppid() != parent) {
+            ::_exit(0);
+        }
+#endif
+        ::execv(argv[0], const_cast<char* const*>(argv));
+        ::_exit(127);
+    }
+
+    worker.pid = pid;
+    LOG_INFO("ShardSupervisor: shard " + shard_id + " started as pid " + std::to_string(pid));
+    return true;
+}
+
+void ShardSupervisor::watch() {
+    const auto restart_delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(config_.restart_delay_s));
+
+    while (running_.load(std::memory_order_acquire)) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto now = std::chrono::steady_clock::now();
+            for (Worker& worker : workers_) {
+                int status = 0;
+                if (worker.pid > 0 && ::waitpid(worker.pid, &status, WNOHANG) == worker.pid) {
+                    worker.pid = 0;
+                    if (worker.restarts >= config_.max_restarts) {
+                        worker.failed = true;
+                        LOG_ERROR("ShardSupervisor: shard " + std::to_string(worker.shard_id) + " " +
+                                  describeExit(status) + "; restart limit reached, giving up");
+                    } else {
+                        worker.restart_at = now + restart_delay;
+                        LOG_WARN("ShardSupervisor: shard " + std::to_string(worker.shard_id) + " " +
+                                 describeExit(status) + "; restarting");
+                    }
+                }
+                if (worker.pid == 0 && !worker.failed && now >= worker.restart_at && launch(worker)) {
+                    ++worker.restarts;
+                }
+            }
+        }
+        std::this_thread::sleep_for(WATCH_INTERVAL);
+    }
+}
+
+void ShardSupervisor::stop(double timeout_s) {
+    if (running_.exchange(false, std::memory_order_acq_rel) && thread_.joinable()) {
+        thread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Worker& worker : workers_) {
+        if (worker.pid > 0) {
+            ::kill(worker.pid, SIGTERM);
+        }
+    }
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeout_s));
+    for (Worker& worker : workers_) {
+        while (worker.pid > 0) {
+            if (::waitpid(worker.pid, nullptr, WNOHANG) == worker.pid) {
+                worker.pid = 0;
+            } else if (std::chrono::steady_clock::now() >= deadline) {
+                LOG_WARN("ShardSupervisor: shard " + std::to_string(worker.shard_id) + " did not stop; killing it");
+                ::kill(worker.pid, SIGKILL);
+                ::waitpid(worker.pid, nullptr, 0);
+                worker.pid = 0;
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+    }
+}
+
+std::vector<ShardSupervisor::WorkerStatus> ShardSupervisor::getStatus() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<WorkerStatus> status;
+    for (const Worker& worker : workers_) {
+        status.push_back({worker.shard_id, worker.pid, worker.restarts, worker.failed});
+    }
+    return status;
+}
+
+}  // namespace radar_tracking
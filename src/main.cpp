@@ -1,4 +1,9 @@
 #include "core/RadarSystem.hpp"
+#include "core/MergeStage.hpp"
+#include "core/ShardSupervisor.hpp"
+#include "management/TrackCheckpointer.hpp"
+#include "output/SharedMemoryOutputAdapter.hpp"
+#include "output/TcpOutputEngine.hpp"
 #include "utils/Logger.hpp"
 #include "utils/ConfigManager.hpp"
 #include "utils/PerformanceMonitor.hpp"
@@ -234,7 +239,7 @@ bool validateConfigFile(const std::string& config_file) {
  */
 bool parseCommandLine(int argc, char* argv[], std::string& config_file, 
                      std::string& log_level, bool& daemon_mode, bool& service_mode,
-                     bool& validation_mode, std::string& scenario_file) {
+                     bool& validation_mode, std::string& scenario_file, int& shard_id, bool& standby) {
     try {
         po::options_description desc("Radar Tracking System Options");
         desc.add_options()
@@ -253,6 +258,10 @@ bool parseCommandLine(int argc, char* argv[], std::string& config_file,
              "Validate configuration and exit")
             ("scenario,s", po::value<std::string>(&scenario_file),
              "Run simulation scenario")
+            ("shard-id", po::value<int>(&shard_id)->default_value(-1),
+             "Run as one worker of a sharded deployment (set by the shard supervisor)")
+            ("standby", po::bool_switch(&standby)->default_value(false),
+             "Hot standby: wait for the primary to exit, then warm-start from its checkpoint")
             ("version", "Show version information");
 
         po::variables_map vm;
@@ -428,6 +437,63 @@ void healthMonitoringThread() {
     LOG_INFO("Health monitoring thread stopped");
 }
 
+#ifndef _WIN32
+/**
+ * @brief Run the supervisor of a sharded deployment (sharding.enabled)
+ *
+ * Starts one worker process per configured shard and the merge stage, which
+ * publishes the merged picture on this process's fusion and shm outputs.
+ */
+int runShardSupervisor(const std::string& config_file, const std::string& log_level) {
+    auto& config_manager = ConfigManager::getInstance();
+    MergeStage merge_stage;
+    if (!merge_stage.initialize(config_file)) {
+        LOG_ERROR("Failed to initialize the merge stage");
+        return -1;
+    }
+
+    const YAML::Node output = config_manager.getNode("output");
+    if (output["fusion"]["enabled"].as<bool>(false)) {
+        auto adapter = std::make_unique<TcpOutputEngine>();
+        if (adapter->initialize(config_file)) {
+            merge_stage.addOutputAdapter(std::move(adapter));
+        }
+    }
+    if (output["shm"]["enabled"].as<bool>(false)) {
+        auto adapter = std::make_unique<SharedMemoryOutputAdapter>();
+        if (adapter->initialize(config_file)) {
+            merge_stage.addOutputAdapter(std::move(adapter));
+        }
+    }
+
+    ShardSupervisor supervisor;
+    if (!supervisor.initialize(config_file, log_level) || !merge_stage.start() || !supervisor.start()) {
+        LOG_ERROR("Failed to start the sharded deployment");
+        return -1;
+    }
+    LOG_INFO("Sharded deployment started with " + std::to_string(merge_stage.getConfig().shards.size()) + " workers");
+
+    int status_counter = 0;
+    while (!g_shutdown_requested) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (++status_counter % 50 == 0) {
+            const auto stats = merge_stage.getStats();
+            LOG_INFO("Merge Status - Shards: " + std::to_string(stats.connected_shards) +
+                     ", Frames: " + std::to_string(stats.frames_received) +
+                     ", Duplicates removed: " + std::to_string(stats.merger.duplicates_removed) +
+                     ", Handovers: " + std::to_string(stats.merger.handovers) +
+                     ", Merge: " + std::to_string(stats.last_merge_ms) + " ms");
+        }
+    }
+
+    LOG_INFO("Stopping shard workers...");
+    supervisor.stop();
+    merge_stage.stop();
+    LOG_INFO("Sharded deployment shutdown completed");
+    return 0;
+}
+#endif
+
 /**
  * @brief Main application entry point
  */
@@ -438,11 +504,13 @@ int main(int argc, char* argv[]) {
     bool daemon_mode = false;
     bool service_mode = false;
     bool validation_mode = false;
+    int shard_id = -1;
+    bool standby = false;
     
     try {
         // Parse command line arguments
         if (!parseCommandLine(argc, argv, config_file, log_level, daemon_mode, service_mode,
-                             validation_mode, scenario_file)) {
+                             validation_mode, scenario_file, shard_id, standby)) {
             return 0; // Help or version was shown
         }
         
@@ -529,6 +597,40 @@ int main(int argc, char* argv[]) {
         
         // Setup signal handlers
         setupSignalHandlers();
+
+#ifndef _WIN32
+        // Sharded deployment: this process supervises the workers, each started with --shard-id
+        if (shard_id < 0 && config_manager.getNode("sharding")["enabled"].as<bool>(false)) {
+            return runShardSupervisor(config_file, log_level);
+        }
+#endif
+        if (shard_id >= 0) {
+            LOG_INFO("Running as worker of shard " + std::to_string(shard_id));
+        }
+        
+        // Checkpoint handover: one primary per checkpoint directory, standbys wait for it to exit
+        TrackCheckpointer::Config checkpoint_config;
+        checkpoint_config.loadFromYaml(config_manager.getNode("checkpoint"));
+        PrimaryLock primary_lock;
+        if (checkpoint_config.enabled && checkpoint_config.handover) {
+            if (standby) {
+                LOG_INFO("Standby: waiting for the primary holding " + checkpoint_config.lockPath());
+            }
+            auto keep_waiting = [] { return !g_shutdown_requested; };
+            if (!primary_lock.acquire(checkpoint_config.lockPath(),
+                                      standby ? std::function<bool()>(keep_waiting) : std::function<bool()>())) {
+                if (g_shutdown_requested) {
+                    return 0;
+                }
+                LOG_ERROR("Another primary holds " + checkpoint_config.lockPath() + "; start this instance with --standby");
+                return -1;
+            }
+            if (standby) {
+                LOG_INFO("Standby: primary released, taking over");
+            }
+        } else if (standby) {
+            LOG_WARN("--standby needs checkpoint.enabled and checkpoint.handover; starting as primary");
+        }
         
         // Create and initialize radar system
         g_radar_system = std::make_unique<RadarSystem>();
@@ -0,0 +1,256 @@
+#include "management/BeamScheduler.hpp"
+#include "utils/Logger.hpp"
+#include "utils/RecordingFormat.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+
+namespace radar_tracking {
+
+namespace {
+
+constexpr int BISECTION_STEPS = 16;
+
+std::chrono::high_resolution_clock::duration toDuration(double seconds) {
+    return std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+        std::chrono::duration<double>(seconds));
+}
+
+/**
+ * @brief Largest per-axis position variance dt seconds past the track's validity
+ */
+double positionVariance(const Track& track, double dt, double process_noise) {
+    const double h[3] = {1.0, dt, 0.5 * dt * dt};
+    double worst = 0.0;
+    for (int axis = 0; axis < 3; ++axis) {
+        const int index[3] = {axis, axis + 3, axis + 6};
+        double variance = 0.0;
+        for (int a = 0; a < 3; ++a) {
+            for (int b = 0; b < 3; ++b) {
+                variance += h[a] * track.covariance[index[a]][index[b]] * h[b];
+            }
+        }
+        worst = std::max(worst, variance);
+    }
+    return worst + process_noise * dt * dt * dt / 3.0;
+}
+
+}  // namespace
+
+void BeamScheduler::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    slot_ms = node["slot_ms"].as<double>(slot_ms);
+    occupancy = node["occupancy"].as<double>(occupancy);
+    dwell_time_ms = node["dwell_time_ms"].as<double>(dwell_time_ms);
+    min_dwell_time_ms = node["min_dwell_time_ms"].as<double>(min_dwell_time_ms);
+    max_dwell_time_ms = node["max_dwell_time_ms"].as<double>(max_dwell_time_ms);
+    reference_range_m = node["reference_range_m"].as<double>(reference_range_m);
+    position_std_m = node["position_std_m"].as<double>(position_std_m);
+    process_noise = node["process_noise"].as<double>(process_noise);
+    min_revisit_s = node["min_revisit_s"].as<double>(min_revisit_s);
+    max_revisit_s = node["max_revisit_s"].as<double>(max_revisit_s);
+    quality_weight = node["quality_weight"].as<double>(quality_weight);
+    tentative_factor = node["tentative_factor"].as<double>(tentative_factor);
+}
+
+bool BeamScheduler::Config::validate() const {
+    if (slot_ms <= 0.0 || occupancy <= 0.0 || occupancy > 1.0) {
+        LOG_ERROR("Beam scheduler: slot_ms must be positive and occupancy in (0, 1]");
+        return false;
+    }
+    if (min_dwell_time_ms <= 0.0 || dwell_time_ms < min_dwell_time_ms || max_dwell_time_ms < dwell_time_ms) {
+        LOG_ERROR("Beam scheduler: dwell times must satisfy 0 < min <= dwell <= max");
+        return false;
+    }
+    if (max_dwell_time_ms > slot_ms * occupancy) {
+        LOG_ERROR("Beam scheduler: max_dwell_time_ms exceeds the slot budget");
+        return false;
+    }
+    if (reference_range_m <= 0.0 || position_std_m <= 0.0 || process_noise < 0.0) {
+        LOG_ERROR("Beam scheduler: reference range and position std must be positive");
+        return false;
+    }
+    if (min_revisit_s <= 0.0 || max_revisit_s < min_revisit_s) {
+        LOG_ERROR("Beam scheduler: revisit limits must satisfy 0 < min <= max");
+        return false;
+    }
+    if (quality_weight < 0.0 || quality_weight >= 1.0 || tentative_factor <= 0.0 || tentative_factor > 1.0) {
+        LOG_ERROR("Beam scheduler: quality_weight must be in [0, 1) and tentative_factor in (0, 1]");
+        return false;
+    }
+    return true;
+}
+
+double BeamScheduler::revisitInterval(const Track& track) const {
+    const double threshold = config_.position_std_m * config_.position_std_m;
+    double interval;
+    if (positionVariance(track, config_.min_revisit_s, config_.process_noise) >= threshold) {
+        interval = config_.min_revisit_s;
+    } else if (positionVariance(track, config_.max_revisit_s, config_.process_noise) < threshold) {
+        interval = config_.max_revisit_s;
+    } else {
+        double lo = config_.min_revisit_s;
+        double hi = config_.max_revisit_s;
+        for (int step = 0; step < BISECTION_STEPS; ++step) {
+            const double mid = 0.5 * (lo + hi);
+            if (positionVariance(track, mid, config_.process_noise) >= threshold) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+        }
+        interval = lo;
+    }
+
+    const double quality = std::clamp(track.quality_score, 0.0, 1.0);
+    interval *= 1.0 - config_.quality_weight * (1.0 - quality);
+    if (track.state == TrackState::TENTATIVE) {
+        interval *= config_.tentative_factor;
+    }
+    return std::max(interval, config_.min_revisit_s);
+}
+
+void BeamScheduler::updateTrack(const Track& track) {
+    if (track.state == TrackState::TERMINATED) {
+        removeTrack(track.track_id);
+        return;
+    }
+
+    auto& entry = tracks_[track.track_id];
+    entry.valid_time = track.valid_time;
+    entry.position = track.position;
+    entry.velocity = track.velocity;
+    entry.acceleration = track.acceleration;
+
+    TimePoint deadline = track.valid_time + toDuration(revisitInterval(track));
+    if (entry.dwelt) {
+        deadline = std::max(deadline, entry.last_dwell + toDuration(config_.min_revisit_s));
+    }
+    queue_.push(track.track_id, deadline);
+}
+
+void BeamScheduler::removeTrack(uint32_t track_id) {
+    queue_.erase(track_id);
+    tracks_.erase(track_id);
+}
+
+void BeamScheduler::updateTracks(const std::vector<Track>& tracks) {
+    std::unordered_set<uint32_t> present;
+    present.reserve(tracks.size());
+    for (const auto& track : tracks) {
+        updateTrack(track);
+        present.insert(track.track_id);
+    }
+
+    if (tracks_.size() > present.size()) {
+        for (auto it = tracks_.begin(); it != tracks_.end();) {
+            if (present.count(it->first) == 0) {
+                queue_.erase(it->first);
+                it = tracks_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+double BeamScheduler::dwellTime(double range) const {
+    // Equal SNR on a given target needs dwell proportional to range^4
+    const double ratio = range / config_.reference_range_m;
+    return std::clamp(config_.dwell_time_ms * ratio * ratio * ratio * ratio,
+                      config_.min_dwell_time_ms, config_.max_dwell_time_ms);
+}
+
+std::vector<BeamRequest> BeamScheduler::scheduleSlot(TimePoint slot_start) {
+    std::vector<BeamRequest> requests;
+    const TimePoint slot_end = slot_start + toDuration(config_.slot_ms * 1e-3);
+    const double budget_ms = config_.slot_ms * config_.occupancy;
+    double used_ms = 0.0;
+    ++stats_.slots;
+
+    while (!queue_.empty() && queue_.top().priority <= slot_end) {
+        const uint32_t track_id = queue_.top().id;
+        const TimePoint deadline = queue_.top().priority;
+        auto& entry = tracks_[track_id];
+
+        // Point at the position predicted for the dwell start
+        const TimePoint dwell_start = slot_start + toDuration(used_ms * 1e-3);
+        const double dt = std::chrono::duration<double>(dwell_start - entry.valid_time).count();
+        const double x = entry.position.x + entry.velocity.x * dt + 0.5 * entry.acceleration.x * dt * dt;
+        const double y = entry.position.y + entry.velocity.y * dt + 0.5 * entry.acceleration.y * dt * dt;
+        const double z = entry.position.z + entry.velocity.z * dt + 0.5 * entry.acceleration.z * dt * dt;
+        const double ground = std::hypot(x, y);
+        const double dwell_ms = dwellTime(std::hypot(ground, z));
+        if (used_ms + dwell_ms > budget_ms) {
+            break;
+        }
+
+        BeamRequest request;
+        request.beam_id = next_beam_id_++;
+        request.azimuth = std::atan2(y, x);
+        request.elevation = std::atan2(z, ground);
+        request.dwell_time_ms = dwell_ms;
+        request.track_id = track_id;
+        request.request_time = dwell_start;
+        requests.push_back(request);
+
+        if (dwell_start > deadline) {
+            ++stats_.late_requests;
+        }
+        used_ms += dwell_ms;
+
+        // Reacquisition look unless the track is updated from this dwell first
+        entry.last_dwell = dwell_start;
+        entry.dwelt = true;
+        queue_.push(track_id, dwell_start + toDuration(config_.min_revisit_s));
+    }
+
+    if (!queue_.empty() && queue_.top().priority <= slot_end) {
+        ++stats_.deferred;
+    }
+    stats_.requests += requests.size();
+    stats_.budget_used_ms += used_ms;
+    return requests;
+}
+
+std::vector<uint8_t> BeamScheduler::encode(const std::vector<BeamRequest>& requests, TimePoint slot_start) {
+    beam::RequestBatchHeader header;
+    header.magic = beam::REQUEST_MAGIC;
+    header.version = beam::REQUEST_VERSION;
+    header.request_count = static_cast<uint16_t>(std::min<size_t>(requests.size(), UINT16_MAX));
+    header.slot_start_ns = recording::toNanoseconds(slot_start);
+
+    std::vector<uint8_t> buffer(sizeof(header) + header.request_count * sizeof(beam::RequestRecord));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    size_t offset = sizeof(header);
+    for (size_t i = 0; i < header.request_count; ++i) {
+        const auto& request = requests[i];
+        beam::RequestRecord record;
+        record.beam_id = request.beam_id;
+        record.track_id = request.track_id;
+        record.azimuth = request.azimuth;
+        record.elevation = request.elevation;
+        record.dwell_time_ms = request.dwell_time_ms;
+        record.request_time_ns = recording::toNanoseconds(request.request_time);
+        std::memcpy(buffer.data() + offset, &record, sizeof(record));
+        offset += sizeof(record);
+    }
+    return buffer;
+}
+
+bool BeamScheduler::dispatch(ICommunicationAdapter& adapter, const std::vector<BeamRequest>& requests,
+                             TimePoint slot_start) {
+    if (requests.empty()) {
+        return true;
+    }
+    if (!adapter.sendData(encode(requests, slot_start))) {
+        LOG_WARN("Beam scheduler: failed to send " + std::to_string(requests.size()) + " beam requests");
+        return false;
+    }
+    return true;
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,548 @@
+#include "management/TrackCheckpointer.hpp"
+#include "utils/Logger.hpp"
+#include "utils/RecordingFormat.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <boost/filesystem.hpp>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/file.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace radar_tracking {
+
+using namespace checkpoint;
+using recording::fromNanoseconds;
+using recording::toNanoseconds;
+
+namespace {
+
+template<typename T>
+void appendPod(std::vector<uint8_t>& buffer, const T& value) {
+    const size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+SectionHeader sectionHeader(SectionType type, uint32_t count, uint32_t element_size, uint64_t size,
+                            const std::string& tag = {}) {
+    SectionHeader header{};
+    header.type = type;
+    header.count = count;
+    header.element_size = element_size;
+    header.size = size;
+    std::memcpy(header.tag, tag.data(), std::min(tag.size(), TAG_SIZE - 1));
+    return header;
+}
+
+void appendSection(std::vector<uint8_t>& buffer, SectionType type, const TrackerCheckpoint::Section& section) {
+    appendPod(buffer, sectionHeader(type, section.count, section.element_size, section.data.size(), section.tag));
+    buffer.insert(buffer.end(), section.data.begin(), section.data.end());
+}
+
+TrackRecord toRecord(const Track& track) {
+    TrackRecord record{};
+    record.track_id = track.track_id;
+    record.state = static_cast<uint8_t>(track.state);
+    record.position[0] = track.position.x;
+    record.position[1] = track.position.y;
+    record.position[2] = track.position.z;
+    record.velocity[0] = track.velocity.x;
+    record.velocity[1] = track.velocity.y;
+    record.velocity[2] = track.velocity.z;
+    record.acceleration[0] = track.acceleration.x;
+    record.acceleration[1] = track.acceleration.y;
+    record.acceleration[2] = track.acceleration.z;
+    std::memcpy(record.covariance, track.covariance, sizeof(record.covariance));
+    record.confidence = track.confidence;
+    record.quality_score = track.quality_score;
+    record.last_update_ns = toNanoseconds(track.last_update);
+    record.valid_time_ns = toNanoseconds(track.valid_time);
+    record.creation_time_ns = toNanoseconds(track.creation_time);
+    record.consecutive_misses = track.consecutive_misses;
+    record.hit_count = track.hit_count;
+    record.trajectory_count = static_cast<uint32_t>(track.trajectory.size());
+    return record;
+}
+
+void fromRecord(const TrackRecord& record, Track& track) {
+    track.track_id = record.track_id;
+    track.state = static_cast<TrackState>(record.state);
+    track.position = Point3D(record.position[0], record.position[1], record.position[2]);
+    track.velocity = Point3D(record.velocity[0], record.velocity[1], record.velocity[2]);
+    track.acceleration = Point3D(record.acceleration[0], record.acceleration[1], record.acceleration[2]);
+    std::memcpy(track.covariance, record.covariance, sizeof(track.covariance));
+    track.confidence = record.confidence;
+    track.quality_score = record.quality_score;
+    track.last_update = fromNanoseconds(record.last_update_ns);
+    track.valid_time = fromNanoseconds(record.valid_time_ns);
+    track.creation_time = fromNanoseconds(record.creation_time_ns);
+    track.consecutive_misses = record.consecutive_misses;
+    track.hit_count = record.hit_count;
+}
+
+bool writeFile(const std::string& path, const std::vector<uint8_t>& data, bool sync) {
+#ifdef _WIN32
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+#else
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < data.size()) {
+        const ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ::close(fd);
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    const bool synced = !sync || ::fdatasync(fd) == 0;
+    return ::close(fd) == 0 && synced;
+#endif
+}
+
+void syncDirectory(const std::string& directory) {
+#ifndef _WIN32
+    const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#endif
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+void TrackCheckpointer::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    enabled = node["enabled"].as<bool>(enabled);
+    directory = node["directory"].as<std::string>(directory);
+    interval_s = node["interval_s"].as<double>(interval_s);
+    max_age_s = node["max_age_s"].as<double>(max_age_s);
+    sync = node["sync"].as<bool>(sync);
+    handover = node["handover"].as<bool>(handover);
+}
+
+bool TrackCheckpointer::Config::validate() const {
+    if (directory.empty()) {
+        LOG_ERROR("TrackCheckpointer: directory must be set");
+        return false;
+    }
+    if (interval_s <= 0.0 || max_age_s <= 0.0) {
+        LOG_ERROR("TrackCheckpointer: interval_s and max_age_s must be positive");
+        return false;
+    }
+    return true;
+}
+
+TrackCheckpointer::~TrackCheckpointer() {
+    shutdown();
+}
+
+bool TrackCheckpointer::initialize(const std::string& config_file) {
+    try {
+        YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["checkpoint"]);
+        return initialize(config);
+    } catch (const std::exception& e) {
+        LOG_ERROR("TrackCheckpointer: failed to load configuration: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool TrackCheckpointer::initialize(const Config& config) {
+    if (!config.validate()) {
+        return false;
+    }
+    shutdown();
+    config_ = config;
+    if (!config_.enabled) {
+        return true;
+    }
+
+    try {
+        boost::filesystem::create_directories(config_.directory);
+    } catch (const std::exception& e) {
+        LOG_ERROR("TrackCheckpointer: cannot create " + config_.directory + ": " + e.what());
+        return false;
+    }
+
+    stopping_ = false;
+    pending_ = false;
+    next_capture_ = {};
+    writer_ = std::thread(&TrackCheckpointer::writerLoop, this);
+    LOG_INFO("TrackCheckpointer: checkpointing every " + std::to_string(config_.interval_s) + " s to " +
+             config_.checkpointPath());
+    return true;
+}
+
+void TrackCheckpointer::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+void TrackCheckpointer::fill(const TrackManager& tracks, ScanPipeline* pipeline, TimePoint now,
+                             TrackerCheckpoint& checkpoint) {
+    checkpoint.clear();
+    checkpoint.sequence = ++sequence_;
+    checkpoint.timestamp_ns = toNanoseconds(now);
+    tracks.exportState(checkpoint);
+    if (pipeline) {
+        pipeline->saveState(checkpoint);
+    }
+}
+
+bool TrackCheckpointer::capture(const TrackManager& tracks, ScanPipeline* pipeline, TimePoint now) {
+    next_capture_ = now + std::chrono::duration_cast<TimePoint::duration>(
+        std::chrono::duration<double>(config_.interval_s));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_ || !writer_.joinable()) {
+            captures_skipped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    // The writer does not touch capture_; only the swap below is synchronized
+    const auto start = std::chrono::steady_clock::now();
+    fill(tracks, pipeline, now, capture_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(capture_, write_);
+        pending_ = true;
+    }
+    cv_.notify_one();
+    last_capture_ms_.store(millisecondsSince(start), std::memory_order_relaxed);
+    return true;
+}
+
+bool TrackCheckpointer::writeFinal(const TrackManager& tracks, ScanPipeline* pipeline) {
+    if (!config_.enabled) {
+        return false;
+    }
+    shutdown();  // Let an in-flight periodic checkpoint finish first
+    fill(tracks, pipeline, std::chrono::high_resolution_clock::now(), write_);
+    write_.handover = true;
+    const bool written = write(write_);
+    if (written) {
+        LOG_INFO("TrackCheckpointer: final checkpoint with " + std::to_string(write_.tracks.size()) + " tracks written");
+    }
+    return written;
+}
+
+bool TrackCheckpointer::write(const TrackerCheckpoint& checkpoint) {
+    const auto start = std::chrono::steady_clock::now();
+    encode(checkpoint, buffer_);
+
+    const std::string temporary = config_.directory + "/checkpoint.tmp";
+    if (!writeFile(temporary, buffer_, config_.sync)) {
+        write_failures_.fetch_add(1, std::memory_order_relaxed);
+        LOG_WARN("TrackCheckpointer: cannot write " + temporary + ": " + std::strerror(errno));
+        return false;
+    }
+    std::rename(config_.checkpointPath().c_str(), config_.previousPath().c_str());
+    if (std::rename(temporary.c_str(), config_.checkpointPath().c_str()) != 0) {
+        write_failures_.fetch_add(1, std::memory_order_relaxed);
+        LOG_WARN("TrackCheckpointer: cannot replace " + config_.checkpointPath() + ": " + std::strerror(errno));
+        return false;
+    }
+    if (config_.sync) {
+        syncDirectory(config_.directory);
+    }
+
+    checkpoints_written_.fetch_add(1, std::memory_order_relaxed);
+    last_bytes_.store(buffer_.size(), std::memory_order_relaxed);
+    last_write_ms_.store(millisecondsSince(start), std::memory_order_relaxed);
+    return true;
+}
+
+void TrackCheckpointer::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return pending_ || stopping_; });
+        if (!pending_) {
+            break;
+        }
+        lock.unlock();
+        write(write_);
+        lock.lock();
+        pending_ = false;
+    }
+}
+
+bool TrackCheckpointer::warmStart(TrackManager& tracks, ScanPipeline* pipeline) {
+    if (!config_.enabled) {
+        return false;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    TrackerCheckpoint checkpoint;
+    std::string path = config_.checkpointPath();
+    if (!load(path, checkpoint)) {
+        path = config_.previousPath();
+        if (!load(path, checkpoint)) {
+            LOG_INFO("TrackCheckpointer: no usable checkpoint in " + config_.directory + ", cold start");
+            return false;
+        }
+    }
+
+    const double age_s = static_cast<double>(toNanoseconds(std::chrono::high_resolution_clock::now()) -
+                                             checkpoint.timestamp_ns) * 1e-9;
+    if (age_s > config_.max_age_s) {
+        LOG_INFO("TrackCheckpointer: checkpoint is " + std::to_string(age_s) + " s old, cold start");
+        return false;
+    }
+
+    tracks.importState(checkpoint);
+    const bool filter_restored = pipeline && pipeline->restoreState(checkpoint);
+    sequence_ = checkpoint.sequence;
+
+    restored_tracks_.store(checkpoint.tracks.size(), std::memory_order_relaxed);
+    restore_ms_.store(millisecondsSince(start), std::memory_order_relaxed);
+    LOG_INFO("TrackCheckpointer: warm start with " + std::to_string(checkpoint.tracks.size()) + " tracks from " +
+             path + (checkpoint.handover ? " (handover)" : "") + ", " + std::to_string(age_s) + " s old, " +
+             (filter_restored ? "filter state restored" : "filters restart from track estimates") + ", " +
+             std::to_string(restore_ms_.load()) + " ms");
+    return true;
+}
+
+TrackCheckpointer::Stats TrackCheckpointer::getStats() const {
+    Stats stats;
+    stats.checkpoints_written = checkpoints_written_.load(std::memory_order_relaxed);
+    stats.captures_skipped = captures_skipped_.load(std::memory_order_relaxed);
+    stats.write_failures = write_failures_.load(std::memory_order_relaxed);
+    stats.last_bytes = last_bytes_.load(std::memory_order_relaxed);
+    stats.last_capture_ms = last_capture_ms_.load(std::memory_order_relaxed);
+    stats.last_write_ms = last_write_ms_.load(std::memory_order_relaxed);
+    stats.restored_tracks = restored_tracks_.load(std::memory_order_relaxed);
+    stats.restore_ms = restore_ms_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void TrackCheckpointer::encode(const TrackerCheckpoint& checkpoint, std::vector<uint8_t>& out) {
+    size_t trajectory_points = 0;
+    for (const auto& track : checkpoint.tracks) {
+        trajectory_points += track.trajectory.size();
+    }
+
+    out.clear();
+    out.reserve(sizeof(FileHeader) + 4 * sizeof(SectionHeader) + checkpoint.tracks.size() * sizeof(TrackRecord) +
+                trajectory_points * sizeof(Point3D) + checkpoint.filter_state.data.size() +
+                checkpoint.association_state.data.size());
+    out.resize(sizeof(FileHeader));
+
+    appendPod(out, sectionHeader(SectionType::TRACKS, static_cast<uint32_t>(checkpoint.tracks.size()),
+                                 sizeof(TrackRecord), checkpoint.tracks.size() * sizeof(TrackRecord)));
+    for (const auto& track : checkpoint.tracks) {
+        appendPod(out, toRecord(track));
+    }
+    appendPod(out, sectionHeader(SectionType::TRAJECTORY, static_cast<uint32_t>(trajectory_points),
+                                 sizeof(Point3D), trajectory_points * sizeof(Point3D)));
+    for (const auto& track : checkpoint.tracks) {
+        for (const auto& point : track.trajectory) {
+            appendPod(out, point);
+        }
+    }
+    appendSection(out, SectionType::FILTER, checkpoint.filter_state);
+    appendSection(out, SectionType::ASSOCIATION, checkpoint.association_state);
+
+    FileHeader header{};
+    header.magic = FILE_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.flags = checkpoint.handover ? FILE_FLAG_HANDOVER : FILE_FLAG_NONE;
+    header.section_count = 4;
+    header.next_track_id = checkpoint.next_track_id;
+    header.sequence = checkpoint.sequence;
+    header.timestamp_ns = checkpoint.timestamp_ns;
+#ifndef _WIN32
+    header.writer_pid = static_cast<uint64_t>(::getpid());
+#endif
+    header.total_tracks_created = checkpoint.total_tracks_created;
+    header.total_tracks_deleted = checkpoint.total_tracks_deleted;
+    header.tracks_confirmed = checkpoint.tracks_confirmed;
+    header.payload_size = out.size() - sizeof(FileHeader);
+    header.checksum = checksum(out.data() + sizeof(FileHeader), out.size() - sizeof(FileHeader));
+    std::memcpy(out.data(), &header, sizeof(header));
+}
+
+bool TrackCheckpointer::decode(const uint8_t* data, size_t size, TrackerCheckpoint& checkpoint) {
+    FileHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != FILE_MAGIC || header.version != FORMAT_VERSION ||
+        header.payload_size != size - sizeof(header) ||
+        header.checksum != checksum(data + sizeof(header), size - sizeof(header))) {
+        return false;
+    }
+
+    checkpoint.clear();
+    checkpoint.sequence = header.sequence;
+    checkpoint.timestamp_ns = header.timestamp_ns;
+    checkpoint.handover = (header.flags & FILE_FLAG_HANDOVER) != 0;
+    checkpoint.next_track_id = header.next_track_id;
+    checkpoint.total_tracks_created = header.total_tracks_created;
+    checkpoint.total_tracks_deleted = header.total_tracks_deleted;
+    checkpoint.tracks_confirmed = header.tracks_confirmed;
+
+    std::vector<uint32_t> trajectory_counts;
+    size_t offset = sizeof(header);
+    for (uint16_t s = 0; s < header.section_count; ++s) {
+        SectionHeader section;
+        if (size - offset < sizeof(section)) {
+            return false;
+        }
+        std::memcpy(&section, data + offset, sizeof(section));
+        offset += sizeof(section);
+        if (size - offset < section.size ||
+            section.size != static_cast<uint64_t>(section.count) * section.element_size) {
+            return false;
+        }
+        const uint8_t* payload = data + offset;
+        offset += section.size;
+
+        switch (section.type) {
+            case SectionType::TRACKS: {
+                if (section.element_size != sizeof(TrackRecord)) {
+                    return false;
+                }
+                checkpoint.tracks.resize(section.count);
+                trajectory_counts.resize(section.count);
+                for (uint32_t i = 0; i < section.count; ++i) {
+                    TrackRecord record;
+                    std::memcpy(&record, payload + static_cast<size_t>(i) * sizeof(record), sizeof(record));
+                    fromRecord(record, checkpoint.tracks[i]);
+                    trajectory_counts[i] = record.trajectory_count;
+                }
+                break;
+            }
+            case SectionType::TRAJECTORY: {
+                if (section.element_size != sizeof(Point3D)) {
+                    return false;
+                }
+                size_t point = 0;
+                for (size_t i = 0; i < checkpoint.tracks.size(); ++i) {
+                    if (section.count - point < trajectory_counts[i]) {
+                        return false;
+                    }
+                    auto& trajectory = checkpoint.tracks[i].trajectory;
+                    trajectory.resize(trajectory_counts[i]);
+                    std::memcpy(static_cast<void*>(trajectory.data()), payload + point * sizeof(Point3D),
+                                trajectory.size() * sizeof(Point3D));
+                    point += trajectory_counts[i];
+                }
+                break;
+            }
+            case SectionType::FILTER:
+            case SectionType::ASSOCIATION: {
+                auto& target = section.type == SectionType::FILTER ? checkpoint.filter_state
+                                                                   : checkpoint.association_state;
+                target.tag.assign(section.tag, strnlen(section.tag, TAG_SIZE));
+                target.element_size = section.element_size;
+                target.count = section.count;
+                target.data.assign(payload, payload + section.size);
+                break;
+            }
+            default:
+                break;  // Unknown sections from a newer writer are skipped
+        }
+    }
+    return true;
+}
+
+bool TrackCheckpointer::load(const std::string& path, TrackerCheckpoint& checkpoint) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        return false;
+    }
+    if (!decode(data.data(), data.size(), checkpoint)) {
+        LOG_WARN("TrackCheckpointer: " + path + " is truncated or corrupt, ignored");
+        return false;
+    }
+    return true;
+}
+
+PrimaryLock::~PrimaryLock() {
+    release();
+}
+
+bool PrimaryLock::acquire(const std::string& path, const std::function<bool()>& keep_waiting) {
+#ifdef _WIN32
+    (void)path;
+    (void)keep_waiting;
+    return true;
+#else
+    if (fd_ >= 0) {
+        return true;
+    }
+    try {
+        boost::filesystem::create_directories(boost::filesystem::path(path).parent_path());
+    } catch (const std::exception& e) {
+        LOG_ERROR("PrimaryLock: cannot create the directory of " + path + ": " + e.what());
+        return false;
+    }
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG_ERROR("PrimaryLock: cannot open " + path + ": " + std::strerror(errno));
+        return false;
+    }
+
+    // Polled rather than blocking, so a waiting standby still reacts to shutdown signals
+    while (::flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        if ((errno != EWOULDBLOCK && errno != EINTR) || !keep_waiting || !keep_waiting()) {
+            ::close(fd);
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    const std::string pid = std::to_string(::getpid()) + "\n";
+    if (::ftruncate(fd, 0) != 0 || ::pwrite(fd, pid.data(), pid.size(), 0) < 0) {
+        LOG_WARN("PrimaryLock: cannot record the owner pid in " + path);
+    }
+    fd_ = fd;
+    return true;
+#endif
+}
+
+void PrimaryLock::release() {
+#ifndef _WIN32
+    if (fd_ >= 0) {
+        ::close(fd_);  // Drops the flock
+        fd_ = -1;
+    }
+#endif
+}
+
+}  // namespace radar_tracking
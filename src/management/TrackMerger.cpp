@@ -0,0 +1,378 @@
+#include "management/TrackMerger.hpp"
+#include "utils/Logger.hpp"
+#include "utils/RecordingFormat.hpp"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace radar_tracking {
+
+using shard_wire::TrackRecord;
+
+namespace {
+
+uint64_t bindingKey(uint32_t shard, uint32_t track_id) {
+    return (static_cast<uint64_t>(shard) << 32) | track_id;
+}
+
+uint64_t cellKey(int64_t ix, int64_t iy) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(ix)) << 32) | static_cast<uint32_t>(iy);
+}
+
+Eigen::Matrix3d unpack(const double* c) {
+    Eigen::Matrix3d m;
+    m << c[0], c[1], c[2],
+         c[1], c[3], c[4],
+         c[2], c[4], c[5];
+    return m;
+}
+
+double seconds(std::chrono::high_resolution_clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+}  // namespace
+
+void TrackMerger::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    gate_chi2 = node["gate_chi2"].as<double>(gate_chi2);
+    max_gate_distance_m = node["max_gate_distance_m"].as<double>(max_gate_distance_m);
+    min_position_variance = node["min_position_variance"].as<double>(min_position_variance);
+    velocity_std_mps = node["velocity_std_mps"].as<double>(velocity_std_mps);
+    shard_timeout_s = node["shard_timeout_s"].as<double>(shard_timeout_s);
+    confirmed_only = node["confirmed_only"].as<bool>(confirmed_only);
+}
+
+bool TrackMerger::Config::validate() const {
+    if (gate_chi2 <= 0.0 || max_gate_distance_m <= 0.0) {
+        LOG_ERROR("TrackMerger: gate_chi2 and max_gate_distance_m must be positive");
+        return false;
+    }
+    if (min_position_variance <= 0.0 || velocity_std_mps < 0.0) {
+        LOG_ERROR("TrackMerger: min_position_variance must be positive and velocity_std_mps non-negative");
+        return false;
+    }
+    if (shard_timeout_s <= 0.0) {
+        LOG_ERROR("TrackMerger: shard_timeout_s must be positive");
+        return false;
+    }
+    return true;
+}
+
+void TrackMerger::setRegion(uint32_t shard_id, const ShardRegion& region) {
+    if (shard_id >= MAX_SHARDS) {
+        LOG_ERROR("TrackMerger: shard id " + std::to_string(shard_id) + " out of range");
+        return;
+    }
+    if (shards_.size() <= shard_id) {
+        shards_.resize(shard_id + 1);
+    }
+    shards_[shard_id].region = region;
+}
+
+void TrackMerger::updateShard(uint32_t shard_id, std::vector<TrackRecord>&& records, TimePoint received) {
+    if (shard_id >= MAX_SHARDS) {
+        return;
+    }
+    if (shards_.size() <= shard_id) {
+        shards_.resize(shard_id + 1);
+    }
+    ShardState& shard = shards_[shard_id];
+    shard.connected = true;
+    shard.records = std::move(records);
+    shard.received = received;
+}
+
+void TrackMerger::removeShard(uint32_t shard_id) {
+    if (shard_id < shards_.size()) {
+        shards_[shard_id].connected = false;
+        shards_[shard_id].records.clear();
+    }
+}
+
+const std::vector<Track>& TrackMerger::merge(TimePoint now) {
+    output_.clear();
+    collectEntries(now);
+    findPairs();
+    buildGroups();
+
+    for (size_t g = 0; g + 1 < group_start_.size(); ++g) {
+        emitGroup(group_members_.data() + group_start_[g], group_start_[g + 1] - group_start_[g], now);
+    }
+    prune(now);
+
+    ++stats_.merges;
+    stats_.input_tracks += entries_.size();
+    stats_.output_tracks += output_.size();
+    return output_;
+}
+
+std::vector<TrackMerger::Handover> TrackMerger::takeHandovers() {
+    std::vector<Handover> handovers;
+    handovers.swap(handovers_);
+    return handovers;
+}
+
+void TrackMerger::collectEntries(TimePoint now) {
+    entries_.clear();
+    const double timeout = config_.shard_timeout_s;
+
+    for (uint32_t s = 0; s < shards_.size(); ++s) {
+        const ShardState& shard = shards_[s];
+        if (!shard.connected || seconds(now - shard.received) > timeout) {
+            continue;
+        }
+        for (uint32_t r = 0; r < shard.records.size(); ++r) {
+            const TrackRecord& record = shard.records[r];
+            const auto state = static_cast<TrackState>(record.state);
+            if (state == TrackState::TERMINATED || (config_.confirmed_only && state == TrackState::TENTATIVE)) {
+                continue;
+            }
+
+            Entry entry;
+            entry.shard = s;
+            entry.record = r;
+            auto binding = bindings_.find(bindingKey(s, record.track_id));
+            entry.bound_global = binding != bindings_.end() ? binding->second.global_id : 0;
+            entry.associable = !shard.region.bounded ||
+                               (record.flags & (shard_wire::TRACK_BOUNDARY | shard_wire::TRACK_FOREIGN)) != 0;
+
+            const double dt = std::max(0.0, seconds(now - recording::fromNanoseconds(record.valid_time_ns)));
+            entry.position = Point3D(record.position[0] + record.velocity[0] * dt,
+                                     record.position[1] + record.velocity[1] * dt,
+                                     record.position[2] + record.velocity[2] * dt);
+            const double growth = config_.velocity_std_mps * config_.velocity_std_mps * dt * dt;
+            std::copy(record.position_covariance, record.position_covariance + 6, entry.covariance);
+            for (int d : {0, 3, 5}) {
+                entry.covariance[d] = std::max(entry.covariance[d] + growth, config_.min_position_variance);
+            }
+            entries_.push_back(entry);
+        }
+    }
+}
+
+double TrackMerger::gateDistance2(const Entry& a, const Entry& b) const {
+    const Eigen::Matrix3d S = unpack(a.covariance) + unpack(b.covariance);
+    const Eigen::Vector3d d(a.position.x - b.position.x, a.position.y - b.position.y, a.position.z - b.position.z);
+    const Eigen::LDLT<Eigen::Matrix3d> ldlt(S);
+    if (ldlt.info() != Eigen::Success) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return d.dot(ldlt.solve(d));
+}
+
+void TrackMerger::findPairs() {
+    pairs_.clear();
+    grid_.clear();
+    const double cell = config_.max_gate_distance_m;
+    const double max_distance2 = cell * cell;
+
+    for (uint32_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i].associable) {
+            const Point3D& p = entries_[i].position;
+            grid_.emplace_back(cellKey(static_cast<int64_t>(std::floor(p.x / cell)),
+                                       static_cast<int64_t>(std::floor(p.y / cell))), i);
+        }
+    }
+    std::sort(grid_.begin(), grid_.end());
+
+    for (const auto& item : grid_) {
+        const uint32_t i = item.second;
+        const Entry& a = entries_[i];
+        const int64_t ix = static_cast<int64_t>(std::floor(a.position.x / cell));
+        const int64_t iy = static_cast<int64_t>(std::floor(a.position.y / cell));
+
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            for (int64_t dy = -1; dy <= 1; ++dy) {
+                const uint64_t key = cellKey(ix + dx, iy + dy);
+                auto it = std::lower_bound(grid_.begin(), grid_.end(), std::make_pair(key, uint32_t{0}));
+                for (; it != grid_.end() && it->first == key; ++it) {
+                    const uint32_t j = it->second;
+                    const Entry& b = entries_[j];
+                    if (j <= i || b.shard == a.shard) {
+                        continue;
+                    }
+                    const Point3D diff = a.position - b.position;
+                    if (diff.x * diff.x + diff.y * diff.y + diff.z * diff.z > max_distance2) {
+                        continue;
+                    }
+                    ++stats_.candidate_pairs;
+                    const double d2 = gateDistance2(a, b);
+                    if (d2 <= config_.gate_chi2) {
+                        pairs_.push_back({i, j, d2, a.bound_global != 0 && a.bound_global == b.bound_global});
+                    }
+                }
+            }
+        }
+    }
+
+    // Keep established correspondences, then the closest pairs first
+    std::sort(pairs_.begin(), pairs_.end(), [](const Pair& x, const Pair& y) {
+        if (x.same_global != y.same_global) {
+            return x.same_global;
+        }
+        return x.distance2 < y.distance2;
+    });
+}
+
+uint32_t TrackMerger::find(uint32_t i) {
+    while (parent_[i] != i) {
+        parent_[i] = parent_[parent_[i]];
+        i = parent_[i];
+    }
+    return i;
+}
+
+void TrackMerger::buildGroups() {
+    const uint32_t n = static_cast<uint32_t>(entries_.size());
+    parent_.resize(n);
+    shard_mask_.resize(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        parent_[i] = i;
+        shard_mask_[i] = uint64_t{1} << entries_[i].shard;
+    }
+
+    // One track per shard in a group: a worker already resolved its own duplicates
+    for (const Pair& pair : pairs_) {
+        const uint32_t a = find(pair.a);
+        const uint32_t b = find(pair.b);
+        if (a == b || (shard_mask_[a] & shard_mask_[b]) != 0) {
+            continue;
+        }
+        parent_[b] = a;
+        shard_mask_[a] |= shard_mask_[b];
+        ++stats_.associated_pairs;
+    }
+
+    // Counting sort of entries by root
+    roots_.resize(n);
+    group_start_.assign(n + 1, 0);
+    for (uint32_t i = 0; i < n; ++i) {
+        roots_[i] = find(i);
+        ++group_start_[roots_[i] + 1];
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        group_start_[i + 1] += group_start_[i];
+    }
+    group_members_.resize(n);
+    std::vector<uint32_t>& cursor = parent_;  // No longer needed once roots are resolved
+    std::copy(group_start_.begin(), group_start_.end() - 1, cursor.begin());
+    for (uint32_t i = 0; i < n; ++i) {
+        group_members_[cursor[roots_[i]]++] = i;
+    }
+
+    // Drop empty buckets so every [start, next) range is one group
+    size_t groups = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (group_start_[i + 1] > group_start_[i]) {
+            group_start_[groups++] = group_start_[i];
+        }
+    }
+    group_start_[groups] = n;
+    group_start_.resize(groups + 1);
+}
+
+int TrackMerger::ownerShard(const Point3D& position) const {
+    for (uint32_t s = 0; s < shards_.size(); ++s) {
+        if (shards_[s].connected && shards_[s].region.bounded && shards_[s].region.contains(position)) {
+            return static_cast<int>(s);
+        }
+    }
+    return -1;
+}
+
+void TrackMerger::emitGroup(const uint32_t* members, size_t count, TimePoint now) {
+    // Representative: reported by a shard whose region holds it, most certain first
+    const Entry* representative = nullptr;
+    bool representative_inside = false;
+    uint64_t mask = 0;
+    for (size_t m = 0; m < count; ++m) {
+        const Entry& entry = entries_[members[m]];
+        mask |= uint64_t{1} << entry.shard;
+        const bool inside = shards_[entry.shard].region.contains(entry.position);
+        const double trace = entry.covariance[0] + entry.covariance[3] + entry.covariance[5];
+        if (!representative || (inside && !representative_inside) ||
+            (inside == representative_inside &&
+             trace < representative->covariance[0] + representative->covariance[3] + representative->covariance[5])) {
+            representative = &entry;
+            representative_inside = inside;
+        }
+    }
+
+    // Global id: the oldest one any member is bound to and no other group took this merge
+    uint32_t global_id = 0;
+    for (size_t m = 0; m < count; ++m) {
+        const uint32_t bound = entries_[members[m]].bound_global;
+        auto it = globals_.find(bound);
+        if (bound != 0 && (global_id == 0 || bound < global_id) && it != globals_.end() &&
+            it->second.last_merge != stats_.merges) {
+            global_id = bound;
+        }
+    }
+    const bool created = global_id == 0;
+    if (created) {
+        global_id = next_global_id_++;
+        ++stats_.global_ids_created;
+    }
+    for (size_t m = 0; m < count; ++m) {
+        const uint32_t bound = entries_[members[m]].bound_global;
+        auto it = globals_.find(bound);
+        if (bound != global_id && it != globals_.end() && it->second.last_merge != stats_.merges) {
+            globals_.erase(it);
+            ++stats_.global_ids_merged;
+        }
+    }
+
+    const TrackRecord& source = shards_[representative->shard].records[representative->record];
+    for (size_t m = 0; m < count; ++m) {
+        const Entry& entry = entries_[members[m]];
+        const uint32_t track_id = shards_[entry.shard].records[entry.record].track_id;
+        bindings_[bindingKey(entry.shard, track_id)] = Binding{global_id, now};
+    }
+    stats_.duplicates_removed += count - 1;
+
+    TrackRecord record = source;
+    record.global_id = global_id;
+    record.flags = 0;
+    record.valid_time_ns = recording::toNanoseconds(now);
+    record.position[0] = representative->position.x;
+    record.position[1] = representative->position.y;
+    record.position[2] = representative->position.z;
+    std::copy(representative->covariance, representative->covariance + 6, record.position_covariance);
+
+    // Ownership follows the region holding the track; a new owner without its own report is seeded
+    const int region_owner = representative_inside && shards_[representative->shard].region.bounded
+                                 ? static_cast<int>(representative->shard)
+                                 : ownerShard(representative->position);
+    const uint32_t owner = region_owner >= 0 ? static_cast<uint32_t>(region_owner) : representative->shard;
+    Global& global = globals_[global_id];
+    if (!created && region_owner >= 0 && global.owner_shard != owner) {
+        ++stats_.handovers;
+        if ((mask & (uint64_t{1} << owner)) == 0) {
+            handovers_.push_back({owner, record});
+        }
+    }
+    global.owner_shard = owner;
+    global.last_seen = now;
+    global.last_merge = stats_.merges;
+
+    Track track = shard_wire::fromRecord(record);
+    track.track_id = global_id;
+    track.last_update = recording::fromNanoseconds(source.valid_time_ns);
+    output_.push_back(std::move(track));
+}
+
+void TrackMerger::prune(TimePoint now) {
+    const double timeout = config_.shard_timeout_s;
+    for (auto it = bindings_.begin(); it != bindings_.end();) {
+        it = seconds(now - it->second.last_seen) > timeout ? bindings_.erase(it) : std::next(it);
+    }
+    for (auto it = globals_.begin(); it != globals_.end();) {
+        it = seconds(now - it->second.last_seen) > timeout ? globals_.erase(it) : std::next(it);
+    }
+}
+
+}  // namespace radar_tracking
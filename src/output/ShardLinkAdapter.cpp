@@ -0,0 +1,259 @@
+#include "output/ShardLinkAdapter.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace radar_tracking {
+
+using namespace shard_wire;
+
+void ShardLinkAdapter::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    if (node["socket_dir"]) {
+        socket_path = socketPath(node["socket_dir"].as<std::string>());
+    }
+    shard_id = node["shard_id"].as<uint32_t>(shard_id);
+    boundary_margin_m = node["boundary_margin_m"].as<double>(boundary_margin_m);
+    reconnect_interval_s = node["reconnect_interval_s"].as<double>(reconnect_interval_s);
+    send_timeout_ms = node["send_timeout_ms"].as<uint32_t>(send_timeout_ms);
+    send_buffer_kb = node["send_buffer_kb"].as<uint32_t>(send_buffer_kb);
+    for (const auto& entry : node["shards"]) {
+        ShardSpec spec;
+        spec.loadFromYaml(entry);
+        if (spec.id == shard_id) {
+            region = spec.region;
+            origin = spec.origin;
+        }
+    }
+}
+
+bool ShardLinkAdapter::Config::validate() const {
+    if (socket_path.empty() || socket_path.size() >= 108) {
+        LOG_ERROR("ShardLinkAdapter: socket path must be non-empty and shorter than 108 bytes");
+        return false;
+    }
+    if (boundary_margin_m < 0.0 || reconnect_interval_s <= 0.0) {
+        LOG_ERROR("ShardLinkAdapter: boundary_margin_m must be non-negative and reconnect_interval_s positive");
+        return false;
+    }
+    return true;
+}
+
+ShardLinkAdapter::~ShardLinkAdapter() {
+    close();
+}
+
+bool ShardLinkAdapter::initialize(const std::string& config_file) {
+    try {
+        YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["sharding"]);
+        return initialize(config);
+    } catch (const std::exception& e) {
+        LOG_ERROR("ShardLinkAdapter: failed to load configuration: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool ShardLinkAdapter::initialize(const Config& config) {
+    if (!config.validate()) {
+        return false;
+    }
+    close();
+    config_ = config;
+    buffer_.resize(MAX_MESSAGE_BYTES);
+    next_connect_ = {};
+    if (!connect()) {
+        LOG_WARN("ShardLinkAdapter: merge stage not reachable at " + config_.socket_path + " yet; will retry");
+    }
+    return true;
+}
+
+void ShardLinkAdapter::close() {
+#ifndef _WIN32
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+#endif
+}
+
+bool ShardLinkAdapter::connect() {
+#ifdef _WIN32
+    return false;
+#else
+    const auto now = std::chrono::steady_clock::now();
+    if (now < next_connect_) {
+        return false;
+    }
+    next_connect_ = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(config_.reconnect_interval_s));
+
+    int fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    const int buffer_bytes = static_cast<int>(config_.send_buffer_kb * 1024);
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_bytes, sizeof(buffer_bytes));
+    timeval timeout{};
+    timeout.tv_sec = config_.send_timeout_ms / 1000;
+    timeout.tv_usec = static_cast<suseconds_t>(config_.send_timeout_ms % 1000) * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, config_.socket_path.c_str(), sizeof(address.sun_path) - 1);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    fd_ = fd;
+    if (!sendMessage(MSG_HELLO, 0, 1, nullptr, 0, 0)) {
+        close();
+        return false;
+    }
+    connects_.fetch_add(1, std::memory_order_relaxed);
+    LOG_INFO("ShardLinkAdapter: shard " + std::to_string(config_.shard_id) + " connected to " + config_.socket_path);
+    return true;
+#endif
+}
+
+bool ShardLinkAdapter::sendMessage(MessageType type, uint16_t chunk_index, uint16_t chunk_count,
+                                   const TrackRecord* records, uint32_t count, int64_t timestamp_ns) {
+#ifdef _WIN32
+    return false;
+#else
+    MessageHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.type = type;
+    header.shard_id = config_.shard_id;
+    header.frame_seq = frame_seq_;
+    header.timestamp_ns = timestamp_ns;
+    header.chunk_index = chunk_index;
+    header.chunk_count = chunk_count;
+    header.record_count = count;
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+    if (count > 0) {
+        std::memcpy(buffer_.data() + sizeof(header), records, count * sizeof(TrackRecord));
+    }
+
+    const size_t size = sizeof(header) + count * sizeof(TrackRecord);
+    const ssize_t sent = ::send(fd_, buffer_.data(), size, MSG_NOSIGNAL);  // Bounded by SO_SNDTIMEO
+    if (sent == static_cast<ssize_t>(size)) {
+        return true;
+    }
+    if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        LOG_WARN("ShardLinkAdapter: link to merge stage lost: " + std::string(std::strerror(errno)));
+        close();
+    }
+    return false;
+#endif
+}
+
+void ShardLinkAdapter::receiveHandovers() {
+#ifndef _WIN32
+    std::vector<Track> handed_over;
+    while (fd_ >= 0) {
+        const ssize_t n = ::recv(fd_, buffer_.data(), buffer_.size(), MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                close();
+            }
+            break;
+        }
+        if (n == 0) {
+            LOG_WARN("ShardLinkAdapter: merge stage closed the link");
+            close();
+            break;
+        }
+
+        MessageHeader header;
+        if (static_cast<size_t>(n) < sizeof(header)) {
+            continue;
+        }
+        std::memcpy(&header, buffer_.data(), sizeof(header));
+        if (header.magic != MAGIC || header.version != VERSION || header.type != MSG_HANDOVER ||
+            sizeof(header) + static_cast<size_t>(header.record_count) * sizeof(TrackRecord) != static_cast<size_t>(n)) {
+            continue;
+        }
+        for (uint32_t i = 0; i < header.record_count; ++i) {
+            TrackRecord record;
+            std::memcpy(&record, buffer_.data() + sizeof(header) + i * sizeof(TrackRecord), sizeof(record));
+            Track track = fromRecord(record, config_.origin);
+            track.track_id = record.global_id;
+            handed_over.push_back(std::move(track));
+        }
+    }
+
+    if (!handed_over.empty()) {
+        handovers_received_.fetch_add(handed_over.size(), std::memory_order_relaxed);
+        if (handover_callback_) {
+            handover_callback_(std::move(handed_over));
+        }
+    }
+#endif
+}
+
+void ShardLinkAdapter::publishTracks(const std::vector<Track>& tracks) {
+    if (fd_ < 0 && !connect()) {
+        frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    receiveHandovers();
+
+    // Interior tracks of a bounded region are this shard's alone; the rest go through association
+    records_.clear();
+    uint64_t boundary = 0;
+    for (const Track& track : tracks) {
+        const double edge = config_.region.edgeDistance(track.position + config_.origin);
+        uint8_t flags = 0;
+        if (edge < 0.0) {
+            flags = TRACK_FOREIGN;
+        } else if (edge < config_.boundary_margin_m) {
+            flags = TRACK_BOUNDARY;
+        }
+        boundary += flags != 0;
+        records_.push_back(toRecord(track, config_.origin, flags));
+    }
+
+    ++frame_seq_;
+    const int64_t timestamp_ns = recording::toNanoseconds(std::chrono::high_resolution_clock::now());
+    const size_t chunks = std::max<size_t>(1, (records_.size() + RECORDS_PER_MESSAGE - 1) / RECORDS_PER_MESSAGE);
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t first = chunk * RECORDS_PER_MESSAGE;
+        const uint32_t count = static_cast<uint32_t>(std::min(RECORDS_PER_MESSAGE, records_.size() - first));
+        if (fd_ < 0 || !sendMessage(MSG_TRACKS, static_cast<uint16_t>(chunk), static_cast<uint16_t>(chunks),
+                                    records_.data() + first, count, timestamp_ns)) {
+            // Timed out or lost; the merge stage discards the partial frame when the next one starts
+            frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    frames_sent_.fetch_add(1, std::memory_order_relaxed);
+    tracks_sent_.fetch_add(records_.size(), std::memory_order_relaxed);
+    boundary_tracks_.fetch_add(boundary, std::memory_order_relaxed);
+}
+
+ShardLinkAdapter::Stats ShardLinkAdapter::getStats() const {
+    Stats stats;
+    stats.frames_sent = frames_sent_.load(std::memory_order_relaxed);
+    stats.frames_dropped = frames_dropped_.load(std::memory_order_relaxed);
+    stats.tracks_sent = tracks_sent_.load(std::memory_order_relaxed);
+    stats.boundary_tracks = boundary_tracks_.load(std::memory_order_relaxed);
+    stats.handovers_received = handovers_received_.load(std::memory_order_relaxed);
+    stats.connects = connects_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace radar_tracking
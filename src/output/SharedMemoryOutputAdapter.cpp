@@ -0,0 +1,270 @@
+#include "output/SharedMemoryOutputAdapter.hpp"
+#include "utils/Logger.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace radar_tracking {
+
+using namespace recording;
+
+namespace {
+
+template<typename T>
+void writePod(uint8_t*& out, const T& value) {
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+int64_t steadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+void SharedMemoryOutputAdapter::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    segment_name = node["segment_name"].as<std::string>(segment_name);
+    slot_count = node["slot_count"].as<uint32_t>(slot_count);
+    slot_size_kb = node["slot_size_kb"].as<uint32_t>(slot_size_kb);
+    publish_detections = node["publish_detections"].as<bool>(publish_detections);
+    publish_clusters = node["publish_clusters"].as<bool>(publish_clusters);
+    publish_stats = node["publish_stats"].as<bool>(publish_stats);
+}
+
+bool SharedMemoryOutputAdapter::Config::validate() const {
+    if (segment_name.size() < 2 || segment_name[0] != '/' ||
+        segment_name.find('/', 1) != std::string::npos) {
+        LOG_ERROR("SharedMemoryOutputAdapter: segment_name must be '/' followed by a name without slashes");
+        return false;
+    }
+    if (slot_count < 2 || (slot_count & (slot_count - 1)) != 0) {
+        LOG_ERROR("SharedMemoryOutputAdapter: slot_count must be a power of two >= 2");
+        return false;
+    }
+    if (slot_size_kb == 0 || slot_size_kb > 64 * 1024) {
+        LOG_ERROR("SharedMemoryOutputAdapter: slot_size_kb must be in [1, 65536]");
+        return false;
+    }
+    return true;
+}
+
+SharedMemoryOutputAdapter::~SharedMemoryOutputAdapter() {
+    close();
+}
+
+bool SharedMemoryOutputAdapter::initialize(const std::string& config_file) {
+    try {
+        YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["output"]["shm"]);
+        return initialize(config);
+    } catch (const std::exception& e) {
+        LOG_ERROR("SharedMemoryOutputAdapter: failed to load configuration: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool SharedMemoryOutputAdapter::initialize(const Config& config) {
+    if (!config.validate()) {
+        return false;
+    }
+    close();
+    config_ = config;
+
+#ifdef _WIN32
+    LOG_ERROR("SharedMemoryOutputAdapter: POSIX shared memory is not available on this platform");
+    return false;
+#else
+    const uint32_t slot_size = config_.slot_size_kb * 1024;
+    const size_t size = shm::segmentSize(config_.slot_count, slot_size);
+
+    // A fresh object per writer: readers still mapping the old one see it go quiet
+    ::shm_unlink(config_.segment_name.c_str());
+    int fd = ::shm_open(config_.segment_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        LOG_ERROR("SharedMemoryOutputAdapter: shm_open " + config_.segment_name + " failed: " + std::strerror(errno));
+        return false;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        LOG_ERROR("SharedMemoryOutputAdapter: cannot size segment: " + std::string(std::strerror(errno)));
+        ::close(fd);
+        ::shm_unlink(config_.segment_name.c_str());
+        return false;
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        LOG_ERROR("SharedMemoryOutputAdapter: mmap failed: " + std::string(std::strerror(errno)));
+        ::close(fd);
+        ::shm_unlink(config_.segment_name.c_str());
+        return false;
+    }
+
+    // Touch every page now so publishing never takes a first-use page fault
+    std::memset(data, 0, size);
+
+    fd_ = fd;
+    segment_ = static_cast<uint8_t*>(data);
+    segment_size_ = size;
+    next_frame_ = 0;
+
+    auto* header = new (segment_) shm::SegmentHeader{};
+    header->version = shm::FORMAT_VERSION;
+    header->slot_count = config_.slot_count;
+    header->slot_size = slot_size;
+    header->created_ns = toNanoseconds(std::chrono::high_resolution_clock::now());
+    header->writer_pid = static_cast<uint64_t>(::getpid());
+    header->published.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < config_.slot_count; ++i) {
+        new (segment_ + sizeof(shm::SegmentHeader) + static_cast<size_t>(i) * slot_size) shm::SlotHeader{};
+    }
+    header->magic.store(shm::SEGMENT_MAGIC, std::memory_order_release);
+    header_ = header;
+
+    LOG_INFO("SharedMemoryOutputAdapter: publishing to " + config_.segment_name + " (" +
+             std::to_string(config_.slot_count) + " slots of " + std::to_string(config_.slot_size_kb) + " KB)");
+    return true;
+#endif
+}
+
+void SharedMemoryOutputAdapter::close() {
+#ifndef _WIN32
+    if (!segment_) {
+        return;
+    }
+    ::munmap(segment_, segment_size_);
+    ::close(fd_);
+    ::shm_unlink(config_.segment_name.c_str());
+    segment_ = nullptr;
+    header_ = nullptr;
+    fd_ = -1;
+#endif
+}
+
+shm::SlotHeader* SharedMemoryOutputAdapter::slot(uint64_t frame) const {
+    const size_t index = frame & (header_->slot_count - 1);
+    return reinterpret_cast<shm::SlotHeader*>(segment_ + sizeof(shm::SegmentHeader) + index * header_->slot_size);
+}
+
+uint8_t* SharedMemoryOutputAdapter::beginFrame(RecordType type, size_t payload_size, int64_t timestamp_ns) {
+    if (!header_) {
+        return nullptr;
+    }
+    if (payload_size > shm::slotCapacity(header_->slot_size)) {
+        const uint64_t dropped = frames_dropped_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if ((dropped & (dropped - 1)) == 0) {  // Log the 1st, 2nd, 4th, ... drop
+            LOG_WARN("SharedMemoryOutputAdapter: " + std::to_string(payload_size) +
+                     "-byte frame exceeds slot_size_kb; dropped " + std::to_string(dropped) + " so far");
+        }
+        return nullptr;
+    }
+
+    shm::SlotHeader* header = slot(next_frame_);
+    header->sequence.store(2 * next_frame_ + 1, std::memory_order_relaxed);
+    // Keep the slot writes below from becoming visible before the odd sequence
+    std::atomic_thread_fence(std::memory_order_release);
+    header->type = type;
+    header->payload_size = static_cast<uint32_t>(payload_size);
+    header->timestamp_ns = timestamp_ns;
+    return reinterpret_cast<uint8_t*>(header) + sizeof(shm::SlotHeader);
+}
+
+void SharedMemoryOutputAdapter::commitFrame(size_t payload_size) {
+    shm::SlotHeader* header = slot(next_frame_);
+    header->publish_ns = steadyNanoseconds();
+    header->sequence.store(2 * next_frame_ + 2, std::memory_order_release);
+    header_->published.store(++next_frame_, std::memory_order_release);
+
+    frames_published_.fetch_add(1, std::memory_order_relaxed);
+    bytes_published_.fetch_add(payload_size, std::memory_order_relaxed);
+}
+
+void SharedMemoryOutputAdapter::publishTracks(const std::vector<Track>& tracks) {
+    const size_t size = sizeof(uint32_t) + tracks.size() * sizeof(TrackRecord);
+    uint8_t* out = beginFrame(RecordType::TRACKS, size,
+                              toNanoseconds(std::chrono::high_resolution_clock::now()));
+    if (!out) {
+        return;
+    }
+    writePod(out, static_cast<uint32_t>(tracks.size()));
+    for (const auto& track : tracks) {
+        writePod(out, toRecord(track));
+    }
+    commitFrame(size);
+}
+
+void SharedMemoryOutputAdapter::publishDetections(const std::vector<RadarDetection>& detections) {
+    if (!config_.publish_detections) {
+        return;
+    }
+    const size_t size = sizeof(uint32_t) + detections.size() * sizeof(DetectionRecord);
+    uint8_t* out = beginFrame(RecordType::DETECTIONS, size,
+                              toNanoseconds(std::chrono::high_resolution_clock::now()));
+    if (!out) {
+        return;
+    }
+    writePod(out, static_cast<uint32_t>(detections.size()));
+    for (const auto& detection : detections) {
+        writePod(out, toRecord(detection));
+    }
+    commitFrame(size);
+}
+
+void SharedMemoryOutputAdapter::publishClusters(const std::vector<Cluster>& clusters) {
+    if (!config_.publish_clusters) {
+        return;
+    }
+    size_t size = sizeof(uint32_t) + clusters.size() * sizeof(ClusterRecord);
+    for (const auto& cluster : clusters) {
+        size += cluster.detections.size() * sizeof(uint64_t);
+    }
+    uint8_t* out = beginFrame(RecordType::CLUSTERS, size,
+                              toNanoseconds(std::chrono::high_resolution_clock::now()));
+    if (!out) {
+        return;
+    }
+    writePod(out, static_cast<uint32_t>(clusters.size()));
+    for (const auto& cluster : clusters) {
+        writePod(out, toRecord(cluster));
+        for (const auto& detection : cluster.detections) {
+            writePod(out, detection.detection_id);
+        }
+    }
+    commitFrame(size);
+}
+
+void SharedMemoryOutputAdapter::publishStats(const SystemStats& stats) {
+    if (!config_.publish_stats) {
+        return;
+    }
+    const size_t size = sizeof(StatsRecord);
+    uint8_t* out = beginFrame(RecordType::STATS, size,
+                              toNanoseconds(std::chrono::high_resolution_clock::now()));
+    if (!out) {
+        return;
+    }
+    writePod(out, toRecord(stats));
+    commitFrame(size);
+}
+
+SharedMemoryOutputAdapter::Stats SharedMemoryOutputAdapter::getStats() const {
+    Stats stats;
+    stats.frames_published = frames_published_.load(std::memory_order_relaxed);
+    stats.frames_dropped = frames_dropped_.load(std::memory_order_relaxed);
+    stats.bytes_published = bytes_published_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace radar_tracking
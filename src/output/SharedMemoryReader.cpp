@@ -0,0 +1,166 @@
+#include "output/SharedMemoryReader.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace radar_tracking {
+
+SharedMemoryReader::~SharedMemoryReader() {
+    close();
+}
+
+bool SharedMemoryReader::open(const std::string& segment_name, StartPosition start) {
+    close();
+    error_.clear();
+
+#ifdef _WIN32
+    (void)segment_name;
+    (void)start;
+    error_ = "POSIX shared memory is not available on this platform";
+    return false;
+#else
+    int fd = ::shm_open(segment_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        error_ = "shm_open " + segment_name + ": " + std::strerror(errno);
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(shm::SegmentHeader)) {
+        error_ = "segment " + segment_name + " is not initialized";
+        ::close(fd);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        error_ = std::string("mmap: ") + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    const auto* header = static_cast<const shm::SegmentHeader*>(data);
+    if (header->magic.load(std::memory_order_acquire) != shm::SEGMENT_MAGIC ||
+        header->version != shm::FORMAT_VERSION || header->slot_count == 0 ||
+        (header->slot_count & (header->slot_count - 1)) != 0 ||
+        header->slot_size <= sizeof(shm::SlotHeader) ||
+        shm::segmentSize(header->slot_count, header->slot_size) > size) {
+        error_ = "segment " + segment_name + " has an unsupported layout";
+        ::munmap(data, size);
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    segment_ = static_cast<const uint8_t*>(data);
+    segment_size_ = size;
+    header_ = header;
+    frames_read_ = 0;
+    frames_missed_ = 0;
+
+    const uint64_t published = getPublishedCount();
+    switch (start) {
+        case StartPosition::LATEST:
+            next_frame_ = published > 0 ? published - 1 : 0;
+            break;
+        case StartPosition::NEXT:
+            next_frame_ = published;
+            break;
+        case StartPosition::OLDEST:
+            next_frame_ = published > header_->slot_count ? published - header_->slot_count : 0;
+            break;
+    }
+    return true;
+#endif
+}
+
+void SharedMemoryReader::close() {
+#ifndef _WIN32
+    if (!segment_) {
+        return;
+    }
+    ::munmap(const_cast<uint8_t*>(segment_), segment_size_);
+    ::close(fd_);
+    segment_ = nullptr;
+    header_ = nullptr;
+    fd_ = -1;
+#endif
+}
+
+uint64_t SharedMemoryReader::getPublishedCount() const {
+    return header_ ? header_->published.load(std::memory_order_acquire) : 0;
+}
+
+const shm::SlotHeader* SharedMemoryReader::slot(uint64_t frame) const {
+    const size_t index = frame & (header_->slot_count - 1);
+    return reinterpret_cast<const shm::SlotHeader*>(
+        segment_ + sizeof(shm::SegmentHeader) + index * header_->slot_size);
+}
+
+void SharedMemoryReader::seekLatest() {
+    const uint64_t published = getPublishedCount();
+    if (published > next_frame_ + 1) {
+        frames_missed_ += published - 1 - next_frame_;
+        next_frame_ = published - 1;
+    }
+}
+
+SharedMemoryReader::PollResult SharedMemoryReader::poll(Frame& frame) {
+    if (!header_) {
+        return PollResult::NOT_OPEN;
+    }
+    const size_t capacity = shm::slotCapacity(header_->slot_size);
+
+    while (true) {
+        const uint64_t published = getPublishedCount();
+        if (next_frame_ >= published) {
+            return PollResult::EMPTY;
+        }
+        // Lapped: everything older than one ring behind is already overwritten
+        if (published - next_frame_ > header_->slot_count) {
+            const uint64_t oldest = published - header_->slot_count;
+            frames_missed_ += oldest - next_frame_;
+            next_frame_ = oldest;
+        }
+
+        const shm::SlotHeader* header = slot(next_frame_);
+        const uint64_t expected = 2 * next_frame_ + 2;
+        const uint64_t before = header->sequence.load(std::memory_order_acquire);
+        if (before != expected) {
+            // The writer has moved on to a later frame in this slot; resync
+            ++frames_missed_;
+            ++next_frame_;
+            continue;
+        }
+
+        frame.type = header->type;
+        frame.timestamp_ns = header->timestamp_ns;
+        frame.publish_ns = header->publish_ns;
+        const size_t size = std::min<size_t>(header->payload_size, capacity);
+        frame.payload.resize(size);
+        std::memcpy(frame.payload.data(), reinterpret_cast<const uint8_t*>(header) + sizeof(shm::SlotHeader), size);
+
+        // Order the copy before re-reading the sequence
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->sequence.load(std::memory_order_relaxed) != expected) {
+            ++frames_missed_;
+            ++next_frame_;
+            continue;
+        }
+
+        frame.sequence = next_frame_++;
+        ++frames_read_;
+        return PollResult::FRAME;
+    }
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,622 @@
+#include "output/TcpOutputEngine.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <linux/errqueue.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <sys/socket.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+namespace radar_tracking {
+
+using namespace recording;
+
+namespace {
+
+constexpr size_t IOV_BATCH = 64;
+constexpr int EPOLL_EVENTS = 64;
+constexpr int EPOLL_TIMEOUT_MS = 100;
+constexpr uint64_t LISTEN_TAG = ~0ull;
+constexpr uint64_t WAKE_TAG = ~0ull - 1;
+
+template<typename T>
+void writePod(uint8_t*& out, const T& value) {
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+}
+
+TcpOutputEngine::SlowClientPolicy parseSlowClientPolicy(const std::string& policy) {
+    if (policy == "disconnect") return TcpOutputEngine::SlowClientPolicy::DISCONNECT;
+    return TcpOutputEngine::SlowClientPolicy::DROP_OLDEST;
+}
+
+}  // namespace
+
+void TcpOutputEngine::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    host = node["host"].as<std::string>(host);
+    port = node["port"].as<uint16_t>(port);
+    max_clients = node["max_clients"].as<uint32_t>(max_clients);
+    client_queue_frames = node["client_queue_frames"].as<uint32_t>(client_queue_frames);
+    if (node["slow_client_policy"]) {
+        slow_client_policy = parseSlowClientPolicy(node["slow_client_policy"].as<std::string>());
+    }
+    buffer_count = node["buffer_count"].as<uint32_t>(buffer_count);
+    buffer_size_kb = node["buffer_size_kb"].as<uint32_t>(buffer_size_kb);
+    submit_queue_frames = node["submit_queue_frames"].as<uint32_t>(submit_queue_frames);
+    zerocopy = node["zerocopy"].as<bool>(zerocopy);
+    zerocopy_min_bytes = node["zerocopy_min_bytes"].as<uint32_t>(zerocopy_min_bytes);
+    publish_detections = node["publish_detections"].as<bool>(publish_detections);
+    publish_clusters = node["publish_clusters"].as<bool>(publish_clusters);
+    publish_stats = node["publish_stats"].as<bool>(publish_stats);
+}
+
+bool TcpOutputEngine::Config::validate() const {
+    if (max_clients == 0 || client_queue_frames == 0) {
+        LOG_ERROR("TcpOutputEngine: max_clients and client_queue_frames must be positive");
+        return false;
+    }
+    if (submit_queue_frames < 2 || (submit_queue_frames & (submit_queue_frames - 1)) != 0) {
+        LOG_ERROR("TcpOutputEngine: submit_queue_frames must be a power of two >= 2");
+        return false;
+    }
+    if (buffer_count < 2) {
+        LOG_ERROR("TcpOutputEngine: buffer_count must be at least 2");
+        return false;
+    }
+    return true;
+}
+
+TcpOutputEngine::~TcpOutputEngine() {
+    stop();
+}
+
+bool TcpOutputEngine::initialize(const std::string& config_file) {
+    try {
+        YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["output"]["fusion"]);
+        return initialize(config);
+    } catch (const std::exception& e) {
+        LOG_ERROR("TcpOutputEngine: failed to load configuration: " + std::string(e.what()));
+        return false;
+    }
+}
+
+#ifdef __linux__
+
+bool TcpOutputEngine::initialize(const Config& config) {
+    if (!config.validate()) {
+        return false;
+    }
+    stop();
+    config_ = config;
+    pool_ = std::make_unique<BufferPool>(config_.buffer_count, static_cast<size_t>(config_.buffer_size_kb) * 1024);
+    submit_queue_ = std::make_unique<LockFreeQueue<BufferPool::Ref>>(config_.submit_queue_frames);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config_.port);
+    if (::inet_pton(AF_INET, config_.host.c_str(), &address.sin_addr) != 1) {
+        LOG_ERROR("TcpOutputEngine: invalid listen address " + config_.host);
+        return false;
+    }
+
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int enable = 1;
+    if (listen_fd_ < 0 ||
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) != 0 ||
+        ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listen_fd_, SOMAXCONN) != 0) {
+        LOG_ERROR("TcpOutputEngine: cannot listen on " + config_.host + ":" + std::to_string(config_.port) +
+                  ": " + std::strerror(errno));
+        stop();
+        return false;
+    }
+
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        LOG_ERROR("TcpOutputEngine: epoll/eventfd setup failed: " + std::string(std::strerror(errno)));
+        stop();
+        return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = LISTEN_TAG;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event);
+    event.data.u64 = WAKE_TAG;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+
+    running_ = true;
+    loop_thread_ = std::thread(&TcpOutputEngine::run, this);
+    LOG_INFO("TcpOutputEngine: listening on " + config_.host + ":" + std::to_string(getPort()));
+    return true;
+}
+
+void TcpOutputEngine::stop() {
+    if (running_.exchange(false)) {
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+        if (loop_thread_.joinable()) {
+            loop_thread_.join();
+        }
+    }
+    for (auto& [fd, client] : clients_) {
+        ::close(fd);
+    }
+    clients_.clear();
+    client_count_ = 0;
+    for (int* fd : {&listen_fd_, &epoll_fd_, &wake_fd_}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+    if (submit_queue_) {
+        BufferPool::Ref frame;
+        while (submit_queue_->tryPop(frame)) {
+        }
+    }
+}
+
+uint16_t TcpOutputEngine::getPort() const {
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+    if (listen_fd_ < 0 || ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        return 0;
+    }
+    return ntohs(address.sin_port);
+}
+
+bool TcpOutputEngine::submit(BufferPool::Ref& buffer) {
+    if (!submit_queue_->tryPush(buffer)) {
+        frames_dropped_queue_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    frames_submitted_.fetch_add(1, std::memory_order_relaxed);
+    // One wake-up per batch: the loop clears the flag before draining
+    if (!wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+    }
+    return true;
+}
+
+void TcpOutputEngine::run() {
+    epoll_event events[EPOLL_EVENTS];
+    while (running_.load(std::memory_order_acquire)) {
+        const int count = ::epoll_wait(epoll_fd_, events, EPOLL_EVENTS, EPOLL_TIMEOUT_MS);
+        if (count < 0 && errno != EINTR) {
+            LOG_ERROR("TcpOutputEngine: epoll_wait failed: " + std::string(std::strerror(errno)));
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const uint64_t tag = events[i].data.u64;
+            if (tag == LISTEN_TAG) {
+                acceptClients();
+                continue;
+            }
+            if (tag == WAKE_TAG) {
+                uint64_t value;
+                [[maybe_unused]] ssize_t drained = ::read(wake_fd_, &value, sizeof(value));
+                continue;
+            }
+
+            const int fd = static_cast<int>(tag);
+            auto it = clients_.find(fd);
+            if (it == clients_.end()) {
+                continue;
+            }
+            Client& client = it->second;
+            const uint32_t flags = events[i].events;
+
+            if ((flags & EPOLLERR) && !drainZeroCopyCompletions(client)) {
+                disconnect(fd, "socket error");
+                continue;
+            }
+            if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+                // Clients only listen; anything they send is discarded
+                uint8_t scratch[512];
+                const ssize_t received = ::recv(fd, scratch, sizeof(scratch), MSG_DONTWAIT);
+                if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    disconnect(fd, "closed by peer");
+                    continue;
+                }
+            }
+            if ((flags & EPOLLOUT) && !flushClient(client)) {
+                disconnect(fd, "send failed");
+            }
+        }
+
+        drainSubmissions();
+    }
+}
+
+void TcpOutputEngine::drainSubmissions() {
+    wake_pending_.exchange(false, std::memory_order_acq_rel);
+    BufferPool::Ref frame;
+    bool any = false;
+    while (submit_queue_->tryPop(frame)) {
+        for (auto& [fd, client] : clients_) {
+            enqueue(client, frame);
+        }
+        frame.reset();
+        any = true;
+    }
+    if (!any) {
+        return;
+    }
+
+    std::vector<int> failed;
+    for (auto& [fd, client] : clients_) {
+        if (client.fd < 0 || !flushClient(client)) {
+            failed.push_back(fd);
+        }
+    }
+    for (int fd : failed) {
+        const bool slow = clients_.at(fd).fd < 0;
+        disconnect(fd, slow ? "send queue full" : "send failed");
+    }
+}
+
+void TcpOutputEngine::enqueue(Client& client, const BufferPool::Ref& frame) {
+    if (client.fd < 0) {
+        return;  // Marked for disconnection
+    }
+    if (client.queue.size() >= config_.client_queue_frames) {
+        if (config_.slow_client_policy == SlowClientPolicy::DISCONNECT) {
+            client.fd = -1;
+            clients_disconnected_slow_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Never cut a frame that is partly on the wire
+        auto victim = client.offset > 0 ? std::next(client.queue.begin()) : client.queue.begin();
+        if (victim != client.queue.end()) {
+            client.queue.erase(victim);
+            frames_dropped_slow_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    client.queue.push_back(frame);
+}
+
+bool TcpOutputEngine::flushClient(Client& client) {
+    while (!client.queue.empty()) {
+        iovec iov[IOV_BATCH];
+        size_t iov_count = 0;
+        size_t batch_bytes = 0;
+        for (auto it = client.queue.begin(); it != client.queue.end() && iov_count < IOV_BATCH; ++it) {
+            const size_t skip = iov_count == 0 ? client.offset : 0;
+            iov[iov_count].iov_base = const_cast<uint8_t*>(it->data()) + skip;
+            iov[iov_count].iov_len = it->size() - skip;
+            batch_bytes += iov[iov_count].iov_len;
+            ++iov_count;
+        }
+
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = iov_count;
+        int flags = MSG_NOSIGNAL | MSG_DONTWAIT;
+        if (iov_count < client.queue.size()) {
+            flags |= MSG_MORE;  // Cork: the next batch follows immediately
+        }
+        bool zerocopy = false;
+#ifdef MSG_ZEROCOPY
+        if (client.zerocopy && batch_bytes >= config_.zerocopy_min_bytes) {
+            flags |= MSG_ZEROCOPY;
+            zerocopy = true;
+        }
+#endif
+
+        const ssize_t sent = ::sendmsg(client.fd, &message, flags);
+        send_calls_.fetch_add(1, std::memory_order_relaxed);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                updateInterest(client, true);
+                return true;
+            }
+#ifdef MSG_ZEROCOPY
+            if (zerocopy && errno == ENOBUFS) {
+                // Out of optmem for zero-copy bookkeeping; copy from now on
+                client.zerocopy = false;
+                continue;
+            }
+#endif
+            return false;
+        }
+        bytes_sent_.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+
+        if (zerocopy) {
+            // The kernel reads these pages until it reports completion
+            ZeroCopyBatch batch;
+            batch.id = client.zerocopy_next++;
+            size_t remaining = static_cast<size_t>(sent);
+            for (size_t i = 0; i < iov_count && remaining > 0; ++i) {
+                batch.buffers.push_back(client.queue[i]);
+                remaining -= std::min(remaining, iov[i].iov_len);
+            }
+            client.zerocopy_inflight.push_back(std::move(batch));
+            zerocopy_sends_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        size_t remaining = static_cast<size_t>(sent);
+        while (remaining > 0) {
+            const size_t left = client.queue.front().size() - client.offset;
+            if (remaining < left) {
+                client.offset += remaining;
+                break;
+            }
+            remaining -= left;
+            client.queue.pop_front();
+            client.offset = 0;
+        }
+        if (static_cast<size_t>(sent) < batch_bytes) {
+            updateInterest(client, true);
+            return true;
+        }
+    }
+    updateInterest(client, false);
+    return true;
+}
+
+bool TcpOutputEngine::drainZeroCopyCompletions(Client& client) {
+#ifdef MSG_ZEROCOPY
+    if (client.zerocopy_inflight.empty()) {
+        return false;
+    }
+    while (true) {
+        char control[128];
+        msghdr message{};
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        if (::recvmsg(client.fd, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            // Error queue drained; EPOLLERR may also stand for a real socket error
+            int error = 0;
+            socklen_t length = sizeof(error);
+            return ::getsockopt(client.fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0;
+        }
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+            const auto* error = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+            if (error->ee_errno != 0 || error->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                return false;
+            }
+            // Sends ee_info..ee_data (inclusive) are done with their pages
+            const uint32_t last = error->ee_data;
+            while (!client.zerocopy_inflight.empty() &&
+                   static_cast<int32_t>(client.zerocopy_inflight.front().id - last) <= 0) {
+                client.zerocopy_inflight.pop_front();
+            }
+            if (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+                // E.g. loopback or a NIC without scatter-gather: zero-copy only adds overhead
+                zerocopy_copied_.fetch_add(1, std::memory_order_relaxed);
+                client.zerocopy = false;
+            }
+        }
+    }
+#else
+    (void)client;
+    return false;
+#endif
+}
+
+void TcpOutputEngine::updateInterest(Client& client, bool want_write) {
+    if (client.want_write == want_write) {
+        return;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | (want_write ? EPOLLOUT : 0u);
+    event.data.u64 = static_cast<uint64_t>(client.fd);
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, client.fd, &event);
+    client.want_write = want_write;
+}
+
+void TcpOutputEngine::acceptClients() {
+    while (true) {
+        sockaddr_in address{};
+        socklen_t length = sizeof(address);
+        const int fd = ::accept4(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length,
+                                 SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        char host[INET_ADDRSTRLEN] = {};
+        ::inet_ntop(AF_INET, &address.sin_addr, host, sizeof(host));
+        const std::string peer = std::string(host) + ":" + std::to_string(ntohs(address.sin_port));
+
+        if (clients_.size() >= config_.max_clients) {
+            clients_rejected_.fetch_add(1, std::memory_order_relaxed);
+            LOG_WARN("TcpOutputEngine: rejecting " + peer + " (max_clients reached)");
+            ::close(fd);
+            continue;
+        }
+
+        int enable = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        Client client;
+        client.fd = fd;
+        client.peer = peer;
+#ifdef SO_ZEROCOPY
+        client.zerocopy = config_.zerocopy &&
+                          ::setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) == 0;
+#endif
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = static_cast<uint64_t>(fd);
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+        clients_.emplace(fd, std::move(client));
+        client_count_.store(clients_.size(), std::memory_order_relaxed);
+        clients_accepted_.fetch_add(1, std::memory_order_relaxed);
+        LOG_INFO("TcpOutputEngine: client " + peer + " connected");
+    }
+}
+
+void TcpOutputEngine::disconnect(int fd, const char* reason) {
+    auto it = clients_.find(fd);
+    if (it == clients_.end()) {
+        return;
+    }
+    LOG_INFO("TcpOutputEngine: client " + it->second.peer + " disconnected (" + reason + ")");
+    // Abortive close: discard unsent data so zero-copy pages can go back to the pool
+    linger abort{1, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    clients_.erase(it);
+    client_count_.store(clients_.size(), std::memory_order_relaxed);
+}
+
+#else
+
+bool TcpOutputEngine::initialize(const Config& config) {
+    config_ = config;
+    LOG_ERROR("TcpOutputEngine: epoll is not available on this platform");
+    return false;
+}
+
+void TcpOutputEngine::stop() {}
+
+uint16_t TcpOutputEngine::getPort() const {
+    return 0;
+}
+
+bool TcpOutputEngine::submit(BufferPool::Ref& /*buffer*/) {
+    return false;
+}
+
+#endif
+
+uint8_t* TcpOutputEngine::beginFrame(BufferPool::Ref& buffer, RecordType type, size_t payload_size) {
+    if (!running_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    buffer = pool_->acquire();
+    if (!buffer) {
+        frames_dropped_pool_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    FrameHeader header{};
+    header.magic = FRAME_MAGIC;
+    header.type = type;
+    header.flags = FRAME_FLAG_NONE;
+    header.timestamp_ns = toNanoseconds(std::chrono::high_resolution_clock::now());
+    header.payload_size = static_cast<uint32_t>(payload_size);
+    header.raw_size = static_cast<uint32_t>(payload_size);
+
+    auto& bytes = buffer.bytes();
+    bytes.resize(sizeof(FrameHeader) + payload_size);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    return bytes.data() + sizeof(FrameHeader);
+}
+
+void TcpOutputEngine::publishTracks(const std::vector<Track>& tracks) {
+    BufferPool::Ref buffer;
+    uint8_t* out = beginFrame(buffer, RecordType::TRACKS, sizeof(uint32_t) + tracks.size() * sizeof(TrackRecord));
+    if (!out) {
+        return;
+    }
+    writePod(out, static_cast<uint32_t>(tracks.size()));
+    for (const auto& track : tracks) {
+        writePod(out, toRecord(track));
+    }
+    submit(buffer);
+}
+
+void TcpOutputEngine::publishDetections(const std::vector<RadarDetection>& detections) {
+    if (!config_.publish_detections) {
+        return;
+    }
+    BufferPool::Ref buffer;
+    uint8_t* out = beginFrame(buffer, RecordType::DETECTIONS,
+                              sizeof(uint32_t) + detections.size() * sizeof(DetectionRecord));
+    if (!out) {
+        return;
+    }
+    writePod(out, static_cast<uint32_t>(detections.size()));
+    for (const auto& detection : detections) {
+        writePod(out, toRecord(detection));
+    }
+    submit(buffer);
+}
+
+void TcpOutputEngine::publishClusters(const std::vector<Cluster>& clusters) {
+    if (!config_.publish_clusters) {
+        return;
+    }
+    size_t size = sizeof(uint32_t) + clusters.size() * sizeof(ClusterRecord);
+    for (const auto& cluster : clusters) {
+        size += cluster.detections.size() * sizeof(uint64_t);
+    }
+    BufferPool::Ref buffer;
+    uint8_t* out = beginFrame(buffer, RecordType::CLUSTERS, size);
+    if (!out) {
+        return;
+    }
+    writePod(out, static_cast<uint32_t>(clusters.size()));
+    for (const auto& cluster : clusters) {
+        writePod(out, toRecord(cluster));
+        for (const auto& detection : cluster.detections) {
+            writePod(out, detection.detection_id);
+        }
+    }
+    submit(buffer);
+}
+
+void TcpOutputEngine::publishStats(const SystemStats& stats) {
+    if (!config_.publish_stats) {
+        return;
+    }
+    BufferPool::Ref buffer;
+    uint8_t* out = beginFrame(buffer, RecordType::STATS, sizeof(StatsRecord));
+    if (!out) {
+        return;
+    }
+    writePod(out, toRecord(stats));
+    submit(buffer);
+}
+
+bool TcpOutputEngine::publishFrame(RecordType type, const uint8_t* payload, size_t size) {
+    BufferPool::Ref buffer;
+    uint8_t* out = beginFrame(buffer, type, size);
+    if (!out) {
+        return false;
+    }
+    std::memcpy(out, payload, size);
+    return submit(buffer);
+}
+
+TcpOutputEngine::Stats TcpOutputEngine::getStats() const {
+    Stats stats;
+    stats.frames_submitted = frames_submitted_.load(std::memory_order_relaxed);
+    stats.frames_dropped_pool = frames_dropped_pool_.load(std::memory_order_relaxed);
+    stats.frames_dropped_queue = frames_dropped_queue_.load(std::memory_order_relaxed);
+    stats.frames_dropped_slow = frames_dropped_slow_.load(std::memory_order_relaxed);
+    stats.clients_accepted = clients_accepted_.load(std::memory_order_relaxed);
+    stats.clients_rejected = clients_rejected_.load(std::memory_order_relaxed);
+    stats.clients_disconnected_slow = clients_disconnected_slow_.load(std::memory_order_relaxed);
+    stats.send_calls = send_calls_.load(std::memory_order_relaxed);
+    stats.bytes_sent = bytes_sent_.load(std::memory_order_relaxed);
+    stats.zerocopy_sends = zerocopy_sends_.load(std::memory_order_relaxed);
+    stats.zerocopy_copied = zerocopy_copied_.load(std::memory_order_relaxed);
+    stats.clients = client_count_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,437 @@
+#include "output/TrackPublisher.hpp"
+#include "utils/Logger.hpp"
+#include "utils/RecordingFormat.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace radar_tracking {
+
+using namespace track_delta;
+
+namespace {
+
+int32_t quantizeSigned(double value, double resolution) {
+    const double scaled = std::round(value / resolution);
+    return static_cast<int32_t>(std::clamp(scaled, static_cast<double>(std::numeric_limits<int32_t>::min()),
+                                           static_cast<double>(std::numeric_limits<int32_t>::max())));
+}
+
+uint8_t quantizeUnit(double value) {
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0, 1.0) * 255.0));
+}
+
+template<typename T>
+void appendPod(std::vector<uint8_t>& buffer, const T& value) {
+    const size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template<typename T>
+bool readPod(const uint8_t*& cursor, const uint8_t* end, T& value) {
+    if (cursor + sizeof(T) > end) {
+        return false;
+    }
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+}  // namespace
+
+void TrackPublisher::SubscriberConfig::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    update_rate_hz = node["update_rate_hz"].as<double>(update_rate_hz);
+    position_resolution_m = node["position_resolution_m"].as<double>(position_resolution_m);
+    velocity_resolution_mps = node["velocity_resolution_mps"].as<double>(velocity_resolution_mps);
+    include_covariance = node["include_covariance"].as<bool>(include_covariance);
+    keyframe_interval_s = node["keyframe_interval_s"].as<double>(keyframe_interval_s);
+    acknowledged = node["acknowledged"].as<bool>(acknowledged);
+}
+
+bool TrackPublisher::SubscriberConfig::validate() const {
+    if (position_resolution_m <= 0.0 || velocity_resolution_mps <= 0.0) {
+        LOG_ERROR("TrackPublisher: " + name + " resolutions must be positive");
+        return false;
+    }
+    if (keyframe_interval_s <= 0.0) {
+        LOG_ERROR("TrackPublisher: " + name + " keyframe_interval_s must be positive");
+        return false;
+    }
+    return true;
+}
+
+void TrackPublisher::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    removal_history_entries = node["removal_history_entries"].as<uint32_t>(removal_history_entries);
+}
+
+uint32_t TrackPublisher::addSubscriber(const SubscriberConfig& config, Sink sink) {
+    if (!config.validate() || !sink) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Subscriber subscriber;
+    subscriber.id = next_subscriber_id_++;
+    subscriber.config = config;
+    subscriber.sink = std::move(sink);
+    subscriber.format = formatFor(config);
+    subscribers_.push_back(std::move(subscriber));
+    return subscribers_.back().id;
+}
+
+void TrackPublisher::removeSubscriber(uint32_t subscriber_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+                                      [&](const Subscriber& s) { return s.id == subscriber_id; }),
+                       subscribers_.end());
+}
+
+void TrackPublisher::acknowledge(uint32_t subscriber_id, uint64_t frame_seq) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& subscriber : subscribers_) {
+        if (subscriber.id == subscriber_id && subscriber.config.acknowledged) {
+            // Only frames actually sent can be a baseline
+            subscriber.acked_seq = std::max(subscriber.acked_seq, std::min(frame_seq, subscriber.baseline_seq));
+        }
+    }
+}
+
+size_t TrackPublisher::formatFor(const SubscriberConfig& config) {
+    for (size_t i = 0; i < formats_.size(); ++i) {
+        const auto& format = *formats_[i];
+        if (format.position_resolution_m == config.position_resolution_m &&
+            format.velocity_resolution_mps == config.velocity_resolution_mps &&
+            format.include_covariance == config.include_covariance) {
+            return i;
+        }
+    }
+    auto format = std::make_unique<FormatState>();
+    format->position_resolution_m = config.position_resolution_m;
+    format->velocity_resolution_mps = config.velocity_resolution_mps;
+    format->include_covariance = config.include_covariance;
+    format->history_start = frame_seq_;
+    formats_.push_back(std::move(format));
+    return formats_.size() - 1;
+}
+
+TrackPublisher::Quantized TrackPublisher::quantize(const FormatState& format, const Track& track) const {
+    Quantized value{};
+    const double position[3] = {track.position.x, track.position.y, track.position.z};
+    const double velocity[3] = {track.velocity.x, track.velocity.y, track.velocity.z};
+    for (int i = 0; i < 3; ++i) {
+        value.position[i] = quantizeSigned(position[i], format.position_resolution_m);
+        value.velocity[i] = quantizeSigned(velocity[i], format.velocity_resolution_mps);
+        if (format.include_covariance) {
+            const double std_units = std::sqrt(std::max(track.covariance[i][i], 0.0)) / format.position_resolution_m;
+            value.position_std[i] = static_cast<uint16_t>(std::min(std::round(std_units), 65535.0));
+        }
+    }
+    value.state = static_cast<uint8_t>(track.state);
+    value.confidence = quantizeUnit(track.confidence);
+    value.quality = quantizeUnit(track.quality_score);
+    return value;
+}
+
+void TrackPublisher::ingest(FormatState& format, const std::vector<Track>& tracks, uint64_t seq) {
+    size_t present = 0;
+    for (const auto& track : tracks) {
+        if (track.state == TrackState::TERMINATED) {
+            continue;
+        }
+        ++present;
+        const Quantized value = quantize(format, track);
+        auto [it, inserted] = format.tracks.try_emplace(track.track_id);
+        TrackEntry& entry = it->second;
+        entry.seen_seq = seq;
+
+        if (inserted) {
+            entry.value = value;
+            std::fill(std::begin(entry.field_seq), std::end(entry.field_seq), seq);
+            entry.changed_seq = seq;
+            format.recency.push_front(track.track_id);
+            entry.recency = format.recency.begin();
+            continue;
+        }
+
+        const Quantized& old = entry.value;
+        bool changed = false;
+        if (std::memcmp(old.position, value.position, sizeof(value.position)) != 0) {
+            entry.field_seq[0] = seq;
+            changed = true;
+        }
+        if (std::memcmp(old.velocity, value.velocity, sizeof(value.velocity)) != 0) {
+            entry.field_seq[1] = seq;
+            changed = true;
+        }
+        if (old.state != value.state || old.confidence != value.confidence || old.quality != value.quality) {
+            entry.field_seq[2] = seq;
+            changed = true;
+        }
+        if (std::memcmp(old.position_std, value.position_std, sizeof(value.position_std)) != 0) {
+            entry.field_seq[3] = seq;
+            changed = true;
+        }
+        if (changed) {
+            entry.value = value;
+            entry.changed_seq = seq;
+            format.recency.splice(format.recency.begin(), format.recency, entry.recency);
+        }
+    }
+
+    if (format.tracks.size() > present) {
+        for (auto it = format.tracks.begin(); it != format.tracks.end();) {
+            if (it->second.seen_seq != seq) {
+                format.recency.erase(it->second.recency);
+                format.removals.emplace_back(seq, it->first);
+                it = format.tracks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    while (format.removals.size() > config_.removal_history_entries) {
+        format.history_start = format.removals.front().first;
+        format.removals.pop_front();
+    }
+    format.ingested_seq = seq;
+    format.encoded.clear();
+    ++stats_.ingests;
+}
+
+TrackPublisher::Buffer TrackPublisher::encode(FormatState& format, uint64_t baseline_seq, uint64_t seq,
+                                              TimePoint now) {
+    auto cached = format.encoded.find(baseline_seq);
+    if (cached != format.encoded.end()) {
+        return cached->second;
+    }
+
+    auto buffer = std::make_shared<std::vector<uint8_t>>();
+    FrameHeader header{};
+    header.magic = FRAME_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.flags = baseline_seq == 0 ? FRAME_FLAG_KEYFRAME : FRAME_FLAG_NONE;
+    header.frame_seq = seq;
+    header.baseline_seq = baseline_seq;
+    header.timestamp_ns = recording::toNanoseconds(now);
+    header.position_resolution_m = static_cast<float>(format.position_resolution_m);
+    header.velocity_resolution_mps = static_cast<float>(format.velocity_resolution_mps);
+    appendPod(*buffer, header);
+
+    uint32_t removal_count = 0;
+    if (baseline_seq != 0) {
+        for (auto it = format.removals.rbegin(); it != format.removals.rend() && it->first > baseline_seq; ++it) {
+            appendPod(*buffer, it->second);
+            ++removal_count;
+        }
+    }
+
+    const uint8_t available = format.include_covariance ? FIELD_ALL : FIELD_ALL & ~FIELD_COVARIANCE;
+    uint32_t update_count = 0;
+    for (uint32_t track_id : format.recency) {
+        const TrackEntry& entry = format.tracks.at(track_id);
+        if (entry.changed_seq <= baseline_seq) {
+            break;
+        }
+        uint8_t fields = 0;
+        for (int group = 0; group < FIELD_GROUPS; ++group) {
+            if (entry.field_seq[group] > baseline_seq) {
+                fields |= static_cast<uint8_t>(1u << group);
+            }
+        }
+        fields &= available;
+        if (fields == 0) {
+            continue;
+        }
+
+        appendPod(*buffer, TrackUpdateHeader{track_id, fields});
+        const Quantized& value = entry.value;
+        if (fields & FIELD_POSITION) {
+            PositionField field;
+            std::memcpy(field.position, value.position, sizeof(field.position));
+            appendPod(*buffer, field);
+        }
+        if (fields & FIELD_VELOCITY) {
+            VelocityField field;
+            std::memcpy(field.velocity, value.velocity, sizeof(field.velocity));
+            appendPod(*buffer, field);
+        }
+        if (fields & FIELD_STATUS) {
+            appendPod(*buffer, StatusField{value.state, value.confidence, value.quality});
+        }
+        if (fields & FIELD_COVARIANCE) {
+            CovarianceField field;
+            std::memcpy(field.position_std, value.position_std, sizeof(field.position_std));
+            appendPod(*buffer, field);
+        }
+        ++update_count;
+    }
+
+    auto* written = reinterpret_cast<FrameHeader*>(buffer->data());
+    std::memcpy(&written->removal_count, &removal_count, sizeof(removal_count));
+    std::memcpy(&written->update_count, &update_count, sizeof(update_count));
+    ++stats_.encodes;
+
+    Buffer shared = std::move(buffer);
+    format.encoded.emplace(baseline_seq, shared);
+    return shared;
+}
+
+uint64_t TrackPublisher::publish(const std::vector<Track>& tracks, TimePoint now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t seq = ++frame_seq_;
+    ++stats_.frames;
+
+    for (auto& subscriber : subscribers_) {
+        const auto& config = subscriber.config;
+        if (subscriber.sent && config.update_rate_hz > 0.0 &&
+            std::chrono::duration<double>(now - subscriber.last_sent).count() < 1.0 / config.update_rate_hz) {
+            continue;
+        }
+
+        FormatState& format = *formats_[subscriber.format];
+        if (format.ingested_seq != seq) {
+            ingest(format, tracks, seq);
+        }
+
+        uint64_t baseline = config.acknowledged ? subscriber.acked_seq : subscriber.baseline_seq;
+        const bool keyframe_due = !subscriber.sent ||
+            std::chrono::duration<double>(now - subscriber.last_keyframe).count() >= config.keyframe_interval_s;
+        if (keyframe_due || baseline < format.history_start) {
+            baseline = 0;
+        }
+
+        const Buffer frame = encode(format, baseline, seq, now);
+        if (!subscriber.sink(frame)) {
+            ++stats_.send_failures;
+            continue;
+        }
+
+        subscriber.sent = true;
+        subscriber.last_sent = now;
+        subscriber.bytes_sent += frame->size();
+        subscriber.baseline_seq = seq;
+        stats_.bytes_sent += frame->size();
+        if (baseline == 0) {
+            subscriber.last_keyframe = now;
+            ++stats_.keyframes_sent;
+        } else {
+            ++stats_.deltas_sent;
+        }
+    }
+    return seq;
+}
+
+TrackPublisher::Stats TrackPublisher::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+uint64_t TrackPublisher::getSubscriberBytes(uint32_t subscriber_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& subscriber : subscribers_) {
+        if (subscriber.id == subscriber_id) {
+            return subscriber.bytes_sent;
+        }
+    }
+    return 0;
+}
+
+bool TrackDeltaDecoder::apply(const uint8_t* data, size_t size) {
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + size;
+    FrameHeader header;
+    if (!readPod(cursor, end, header) || header.magic != FRAME_MAGIC || header.version != FORMAT_VERSION) {
+        return false;
+    }
+
+    const bool keyframe = (header.flags & FRAME_FLAG_KEYFRAME) != 0;
+    if (!keyframe && (!synchronized_ || header.baseline_seq > frame_seq_)) {
+        return false;
+    }
+    if (synchronized_ && header.frame_seq <= frame_seq_) {
+        return true;  // Stale or duplicate; the current state is newer
+    }
+
+    // Validate the whole frame before touching the state
+    const uint8_t* removals = cursor;
+    if (static_cast<size_t>(end - cursor) < static_cast<size_t>(header.removal_count) * sizeof(uint32_t)) {
+        return false;
+    }
+    cursor += static_cast<size_t>(header.removal_count) * sizeof(uint32_t);
+    const uint8_t* updates = cursor;
+    for (uint32_t i = 0; i < header.update_count; ++i) {
+        TrackUpdateHeader update;
+        if (!readPod(cursor, end, update)) {
+            return false;
+        }
+        size_t fields_size = 0;
+        if (update.fields & FIELD_POSITION) fields_size += sizeof(PositionField);
+        if (update.fields & FIELD_VELOCITY) fields_size += sizeof(VelocityField);
+        if (update.fields & FIELD_STATUS) fields_size += sizeof(StatusField);
+        if (update.fields & FIELD_COVARIANCE) fields_size += sizeof(CovarianceField);
+        if (static_cast<size_t>(end - cursor) < fields_size) {
+            return false;
+        }
+        cursor += fields_size;
+    }
+
+    if (keyframe) {
+        tracks_.clear();
+    }
+    cursor = removals;
+    for (uint32_t i = 0; i < header.removal_count; ++i) {
+        uint32_t track_id;
+        readPod(cursor, end, track_id);
+        tracks_.erase(track_id);
+    }
+
+    const double position_resolution = header.position_resolution_m;
+    const double velocity_resolution = header.velocity_resolution_mps;
+    cursor = updates;
+    for (uint32_t i = 0; i < header.update_count; ++i) {
+        TrackUpdateHeader update;
+        readPod(cursor, end, update);
+        DecodedTrack& track = tracks_[update.track_id];
+        track.track_id = update.track_id;
+        if (update.fields & FIELD_POSITION) {
+            PositionField field;
+            readPod(cursor, end, field);
+            track.position = Point3D(field.position[0] * position_resolution, field.position[1] * position_resolution,
+                                     field.position[2] * position_resolution);
+        }
+        if (update.fields & FIELD_VELOCITY) {
+            VelocityField field;
+            readPod(cursor, end, field);
+            track.velocity = Point3D(field.velocity[0] * velocity_resolution, field.velocity[1] * velocity_resolution,
+                                     field.velocity[2] * velocity_resolution);
+        }
+        if (update.fields & FIELD_STATUS) {
+            StatusField field;
+            readPod(cursor, end, field);
+            track.state = static_cast<TrackState>(field.state);
+            track.confidence = field.confidence / 255.0;
+            track.quality_score = field.quality / 255.0;
+        }
+        if (update.fields & FIELD_COVARIANCE) {
+            CovarianceField field;
+            readPod(cursor, end, field);
+            track.position_std = Point3D(field.position_std[0] * position_resolution,
+                                         field.position_std[1] * position_resolution,
+                                         field.position_std[2] * position_resolution);
+        }
+    }
+
+    frame_seq_ = header.frame_seq;
+    synchronized_ = true;
+    return true;
+}
+
+}  // namespace radar_tracking
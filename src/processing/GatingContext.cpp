@@ -0,0 +1,82 @@
+#include "processing/GatingContext.hpp"
+#include <limits>
+
+namespace radar_tracking {
+
+void GatingContext::buildTracks(const std::vector<Track>& tracks, double measurement_variance,
+                                double gate_threshold) {
+    reserveTracks(tracks.size(), gate_threshold);
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        motion::MeasMatrix S = motion::ConstTrackCovarianceMap(&tracks[t].covariance[0][0]).topLeftCorner<3, 3>();
+        S.diagonal().array() += measurement_variance;
+        setTrack(t, tracks[t], S);
+    }
+}
+
+void GatingContext::setClusters(const std::vector<Cluster>& clusters) {
+    cx_.resize(clusters.size());
+    cy_.resize(clusters.size());
+    cz_.resize(clusters.size());
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        cx_[c] = clusters[c].centroid.x;
+        cy_[c] = clusters[c].centroid.y;
+        cz_[c] = clusters[c].centroid.z;
+    }
+}
+
+void GatingContext::distancesToClusters(size_t track, const uint32_t* clusters, size_t count,
+                                        double* d2_out) const {
+    // Gather candidates into contiguous lanes, then run the batched kernel
+    gx_.resize(count);
+    gy_.resize(count);
+    gz_.resize(count);
+    for (size_t k = 0; k < count; ++k) {
+        gx_[k] = cx_[clusters[k]];
+        gy_[k] = cy_[clusters[k]];
+        gz_[k] = cz_[clusters[k]];
+    }
+    mahalanobisBatch(track, gx_.data(), gy_.data(), gz_.data(), count, d2_out);
+}
+
+void GatingContext::reserveTracks(size_t count, double gate_threshold) {
+    gate_threshold_ = gate_threshold;
+    for (auto* column : {&px_, &py_, &pz_, &s00_, &s11_, &s22_, &s10_, &s20_, &s21_,
+                         &l10_, &l20_, &l21_, &inv_l00_, &inv_l11_, &inv_l22_, &log_det_}) {
+        column->resize(count);
+    }
+    valid_.resize(count);
+}
+
+void GatingContext::setTrack(size_t index, const Track& track, const motion::MeasMatrix& S) {
+    px_[index] = track.position.x;
+    py_[index] = track.position.y;
+    pz_[index] = track.position.z;
+    s00_[index] = S(0, 0);
+    s11_[index] = S(1, 1);
+    s22_[index] = S(2, 2);
+    s10_[index] = S(1, 0);
+    s20_[index] = S(2, 0);
+    s21_[index] = S(2, 1);
+
+    const Eigen::LLT<motion::MeasMatrix> llt(S);
+    if (llt.info() != Eigen::Success) {
+        // Gate nothing rather than propagating NaNs into the cost matrix
+        valid_[index] = 0;
+        l10_[index] = l20_[index] = l21_[index] = 0.0;
+        inv_l00_[index] = inv_l11_[index] = inv_l22_[index] = std::numeric_limits<double>::infinity();
+        log_det_[index] = std::numeric_limits<double>::infinity();
+        return;
+    }
+
+    const auto& L = llt.matrixLLT();
+    valid_[index] = 1;
+    l10_[index] = L(1, 0);
+    l20_[index] = L(2, 0);
+    l21_[index] = L(2, 1);
+    inv_l00_[index] = 1.0 / L(0, 0);
+    inv_l11_[index] = 1.0 / L(1, 1);
+    inv_l22_[index] = 1.0 / L(2, 2);
+    log_det_[index] = 2.0 * (std::log(L(0, 0)) + std::log(L(1, 1)) + std::log(L(2, 2)));
+}
+
+}  // namespace radar_tracking
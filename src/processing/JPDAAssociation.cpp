@@ -0,0 +1,173 @@
+#include "processing/JPDAAssociation.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace radar_tracking {
+
+void JPDAAssociation::Config::loadFromYaml(const YAML::Node& node) {
+    engine.loadFromYaml(node);
+    if (node["parameters"]) {
+        measurement_variance = node["parameters"]["measurement_variance"].as<double>(measurement_variance);
+    }
+    spatial_index.loadFromYaml(node["spatial_index"]);
+}
+
+bool JPDAAssociation::Config::validate() const {
+    if (measurement_variance <= 0.0) {
+        LOG_ERROR("JPDA: measurement_variance must be positive");
+        return false;
+    }
+    return engine.validate();
+}
+
+JPDAAssociation::JPDAAssociation(const Config& config) {
+    setConfig(config);
+}
+
+void JPDAAssociation::setConfig(const Config& config) {
+    config_ = config;
+    engine_.setConfig(config_.engine);
+    spatial_index_.setConfig(config_.spatial_index);
+}
+
+bool JPDAAssociation::initialize(const std::string& config_file) {
+    try {
+        Config config;
+        if (!config_file.empty()) {
+            config.loadFromYaml(YAML::LoadFile(config_file));
+        }
+        if (!config.validate()) {
+            LOG_ERROR("Invalid JPDA configuration");
+            return false;
+        }
+        setConfig(config);
+
+        LOG_INFO("JPDA initialized: P_D=" + std::to_string(config_.engine.detection_probability) +
+                 ", exact<=" + std::to_string(config_.engine.exact_max_tracks) +
+                 " tracks, k_best=" + std::to_string(config_.engine.k_best) +
+                 ", budget=" + std::to_string(config_.engine.time_budget_ms) + "ms");
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to initialize JPDA: " + std::string(e.what()));
+        return false;
+    }
+}
+
+void JPDAAssociation::setGatingThreshold(double threshold) {
+    config_.engine.gating_threshold = threshold;
+    engine_.setConfig(config_.engine);
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> JPDAAssociation::associate(
+    const std::vector<Track>& tracks,
+    const std::vector<Cluster>& clusters) {
+    std::vector<std::pair<uint32_t, uint32_t>> candidates;
+    gating_.buildTracks(tracks, config_.measurement_variance, config_.engine.gating_threshold);
+
+    if (config_.spatial_index.enabled && tracks.size() >= config_.spatial_index.min_tracks) {
+        spatial_index_.build(gating_);
+        candidates = spatial_index_.candidatePairs(clusters);
+    } else {
+        candidates.reserve(tracks.size() * clusters.size());
+        for (uint32_t t = 0; t < tracks.size(); ++t) {
+            for (uint32_t c = 0; c < clusters.size(); ++c) {
+                candidates.emplace_back(t, c);
+            }
+        }
+    }
+    return associateGated(clusters, candidates);
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> JPDAAssociation::associateCandidates(
+    const std::vector<Track>& tracks,
+    const std::vector<Cluster>& clusters,
+    const std::vector<std::pair<uint32_t, uint32_t>>& candidates) {
+    gating_.buildTracks(tracks, config_.measurement_variance, config_.engine.gating_threshold);
+    return associateGated(clusters, candidates);
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> JPDAAssociation::associateGated(
+    const std::vector<Cluster>& clusters,
+    const std::vector<std::pair<uint32_t, uint32_t>>& candidates) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    gating_.setClusters(clusters);
+    last_result_ = engine_.compute(gating_, candidates);
+    auto associations = selectAssociations(last_result_);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    double processing_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+    if (last_result_.budget_exceeded) {
+        LOG_ASYNC_DEBUG("JPDA time budget exceeded: {} of {} gate clusters approximated",
+                        last_result_.parametric_clusters, last_result_.gate_clusters);
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++total_scans_;
+    total_associations_ += associations.size();
+    total_processing_time_ms_ += processing_time_ms;
+    return associations;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> JPDAAssociation::selectAssociations(const JPDAResult& result) const {
+    std::vector<const AssociationMarginal*> ranked;
+    ranked.reserve(result.marginals.size());
+    for (const auto& marginal : result.marginals) {
+        if (marginal.probability > result.miss_probability[marginal.track_index]) {
+            ranked.push_back(&marginal);
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const AssociationMarginal* a, const AssociationMarginal* b) {
+        return a->probability > b->probability;
+    });
+
+    std::vector<bool> track_used(result.miss_probability.size(), false);
+    std::vector<bool> cluster_used(gating_.getClusterCount(), false);
+    std::vector<std::pair<uint32_t, uint32_t>> associations;
+    for (const AssociationMarginal* marginal : ranked) {
+        if (!track_used[marginal->track_index] && !cluster_used[marginal->cluster_index]) {
+            track_used[marginal->track_index] = true;
+            cluster_used[marginal->cluster_index] = true;
+            associations.emplace_back(marginal->track_index, marginal->cluster_index);
+        }
+    }
+    std::sort(associations.begin(), associations.end());
+    return associations;
+}
+
+double JPDAAssociation::calculateAssociationProbability(const Track& track, const Cluster& cluster) const {
+    // Single track/cluster pair: beta = w / (1 + w)
+    GatingContext pair_gating;
+    pair_gating.buildTracks(std::vector<Track>{track}, config_.measurement_variance,
+                            config_.engine.gating_threshold);
+    pair_gating.setClusters(std::vector<Cluster>{cluster});
+    if (!pair_gating.isValid(0)) {
+        return 0.0;
+    }
+    const double d2 = pair_gating.distanceSquared(0, 0);
+    if (d2 > config_.engine.gating_threshold) {
+        return 0.0;
+    }
+
+    const auto& engine = config_.engine;
+    const double weight = engine.detection_probability * std::exp(pair_gating.logLikelihood(0, d2)) /
+                          (engine.clutter_density * (1.0 - engine.detection_probability * engine.gate_probability));
+    return weight / (1.0 + weight);
+}
+
+SystemStats JPDAAssociation::getStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    SystemStats stats;
+    stats.processing_latency_ms = total_scans_ > 0 ? total_processing_time_ms_ / total_scans_ : 0.0;
+    stats.average_processing_rate = total_scans_ > 0 ? static_cast<double>(total_associations_) / total_scans_ : 0.0;
+    return stats;
+}
+
+std::unique_ptr<IAssociationAlgorithm> createJPDAAssociation() {
+    return std::make_unique<JPDAAssociation>();
+}
+
+} // namespace radar_tracking
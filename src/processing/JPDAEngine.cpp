@@ -0,0 +1,351 @@
+#include "processing/JPDAEngine.hpp"
+#include "utils/KBestAssignment.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <numeric>
+
+namespace radar_tracking {
+
+void JPDAEngine::Config::loadFromYaml(const YAML::Node& node) {
+    auto params = node["parameters"];
+    if (params) {
+        gating_threshold = params["gating_threshold"].as<double>(gating_threshold);
+        detection_probability = params["detection_probability"].as<double>(detection_probability);
+        gate_probability = params["gate_probability"].as<double>(gate_probability);
+        clutter_density = params["clutter_density"].as<double>(clutter_density);
+    }
+
+    auto hypotheses = node["hypotheses"];
+    if (hypotheses) {
+        exact_max_tracks = hypotheses["exact_max_tracks"].as<size_t>(exact_max_tracks);
+        exact_max_events = hypotheses["exact_max_events"].as<size_t>(exact_max_events);
+        k_best = hypotheses["k_best"].as<size_t>(k_best);
+        kbest_max_tracks = hypotheses["kbest_max_tracks"].as<size_t>(kbest_max_tracks);
+    }
+
+    auto performance = node["performance"];
+    if (performance) {
+        time_budget_ms = performance["time_budget_ms"].as<double>(time_budget_ms);
+        parallel_min_clusters = performance["parallel_min_clusters"].as<size_t>(parallel_min_clusters);
+    }
+}
+
+bool JPDAEngine::Config::validate() const {
+    if (gating_threshold <= 0.0) {
+        LOG_ERROR("JPDA: gating_threshold must be positive");
+        return false;
+    }
+    if (detection_probability <= 0.0 || detection_probability > 1.0 ||
+        gate_probability <= 0.0 || gate_probability > 1.0) {
+        LOG_ERROR("JPDA: detection and gate probabilities must be in (0, 1]");
+        return false;
+    }
+    if (detection_probability * gate_probability >= 1.0) {
+        LOG_ERROR("JPDA: P_D * P_G must be below 1");
+        return false;
+    }
+    if (clutter_density <= 0.0) {
+        LOG_ERROR("JPDA: clutter_density must be positive");
+        return false;
+    }
+    if (k_best == 0) {
+        LOG_ERROR("JPDA: k_best must be at least 1");
+        return false;
+    }
+    return true;
+}
+
+JPDAResult JPDAEngine::compute(const GatingContext& gating,
+                               const std::vector<std::pair<uint32_t, uint32_t>>& candidates) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                      std::chrono::duration<double, std::milli>(config_.time_budget_ms));
+
+    JPDAResult result;
+    result.miss_probability.assign(gating.getTrackCount(), 1.0);
+
+    gatePairs(gating, candidates);
+    buildGateClusters(gating.getTrackCount(), gating.getClusterCount());
+    result.gate_clusters = gate_clusters_.size();
+    if (gated_.empty()) {
+        return result;
+    }
+
+    // Largest gate clusters first so the budget is spent where it matters
+    std::vector<uint32_t> order(gate_clusters_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return gate_clusters_[a].tracks.size() > gate_clusters_[b].tracks.size();
+    });
+    result.largest_gate_cluster = gate_clusters_[order.front()].tracks.size();
+
+    std::vector<double> pair_probability(gated_.size(), 0.0);
+    using StrategyCounts = std::array<size_t, 3>;
+
+    auto solveRange = [&](size_t first, size_t stride) {
+        StrategyCounts counts{0, 0, 0};
+        for (size_t i = first; i < order.size(); i += stride) {
+            Strategy strategy = solveGateCluster(gate_clusters_[order[i]], deadline, pair_probability);
+            ++counts[static_cast<size_t>(strategy)];
+        }
+        return counts;
+    };
+
+    StrategyCounts totals{0, 0, 0};
+    if (thread_pool_ && thread_pool_->getThreadCount() > 1 && order.size() >= config_.parallel_min_clusters) {
+        // Interleaved partition balances the size-sorted work across workers;
+        // gate clusters own disjoint pair ranges, so no synchronization is needed
+        const size_t workers = std::min(thread_pool_->getThreadCount(), order.size());
+        std::vector<std::future<StrategyCounts>> futures;
+        futures.reserve(workers);
+        for (size_t w = 0; w < workers; ++w) {
+            futures.push_back(thread_pool_->enqueue(solveRange, w, workers));
+        }
+        for (auto& future : futures) {
+            const StrategyCounts counts = future.get();
+            for (size_t s = 0; s < totals.size(); ++s) {
+                totals[s] += counts[s];
+            }
+        }
+    } else {
+        totals = solveRange(0, 1);
+    }
+
+    result.exact_clusters = totals[static_cast<size_t>(Strategy::EXACT)];
+    result.kbest_clusters = totals[static_cast<size_t>(Strategy::KBEST)];
+    result.parametric_clusters = totals[static_cast<size_t>(Strategy::PARAMETRIC)];
+    result.budget_exceeded = std::chrono::steady_clock::now() >= deadline;
+
+    result.marginals.reserve(gated_.size());
+    for (size_t p = 0; p < gated_.size(); ++p) {
+        const GatedPair& pair = gated_[p];
+        result.marginals.push_back({pair.track, pair.cluster, pair_probability[p]});
+        result.miss_probability[pair.track] -= pair_probability[p];
+    }
+    for (double& miss : result.miss_probability) {
+        miss = std::max(miss, 0.0);
+    }
+    return result;
+}
+
+void JPDAEngine::gatePairs(const GatingContext& gating,
+                           const std::vector<std::pair<uint32_t, uint32_t>>& candidates) {
+    gated_.clear();
+
+    // w = P_D * N(z; z_pred, S) / (lambda * (1 - P_D * P_G)), evaluated in log space
+    const double log_offset = std::log(config_.detection_probability) - std::log(config_.clutter_density) -
+                              std::log(1.0 - config_.detection_probability * config_.gate_probability);
+
+    for (size_t begin = 0; begin < candidates.size();) {
+        const uint32_t track = candidates[begin].first;
+        size_t end = begin;
+        candidate_row_.clear();
+        while (end < candidates.size() && candidates[end].first == track) {
+            candidate_row_.push_back(candidates[end++].second);
+        }
+        begin = end;
+
+        if (!gating.isValid(track)) {
+            continue;
+        }
+        d2_row_.resize(candidate_row_.size());
+        gating.distancesToClusters(track, candidate_row_.data(), candidate_row_.size(), d2_row_.data());
+        for (size_t k = 0; k < candidate_row_.size(); ++k) {
+            if (d2_row_[k] <= config_.gating_threshold) {
+                const double weight = std::exp(gating.logLikelihood(track, d2_row_[k]) + log_offset);
+                gated_.push_back({track, candidate_row_[k], 0, 0, weight});
+            }
+        }
+    }
+}
+
+uint32_t JPDAEngine::findRoot(uint32_t node) {
+    while (parent_[node] != node) {
+        parent_[node] = parent_[parent_[node]];
+        node = parent_[node];
+    }
+    return node;
+}
+
+void JPDAEngine::buildGateClusters(size_t track_count, size_t cluster_count) {
+    gate_clusters_.clear();
+
+    // Nodes [0, tracks) are tracks, [tracks, tracks + clusters) are clusters
+    const size_t nodes = track_count + cluster_count;
+    parent_.resize(nodes);
+    std::iota(parent_.begin(), parent_.end(), 0);
+    for (const auto& pair : gated_) {
+        const uint32_t a = findRoot(pair.track);
+        const uint32_t b = findRoot(static_cast<uint32_t>(track_count + pair.cluster));
+        if (a != b) {
+            parent_[a] = b;
+        }
+    }
+
+    // node_slot_ maps a root to its gate cluster, and a member to its local index
+    std::vector<int32_t> root_slot(nodes, -1);
+    node_slot_.assign(nodes, -1);
+    for (uint32_t p = 0; p < gated_.size(); ++p) {
+        GatedPair& pair = gated_[p];
+        const uint32_t root = findRoot(pair.track);
+        if (root_slot[root] < 0) {
+            root_slot[root] = static_cast<int32_t>(gate_clusters_.size());
+            gate_clusters_.emplace_back();
+        }
+        GateCluster& cluster = gate_clusters_[root_slot[root]];
+
+        const uint32_t cluster_node = static_cast<uint32_t>(track_count + pair.cluster);
+        if (node_slot_[pair.track] < 0) {
+            node_slot_[pair.track] = static_cast<int32_t>(cluster.tracks.size());
+            cluster.tracks.push_back(pair.track);
+        }
+        if (node_slot_[cluster_node] < 0) {
+            node_slot_[cluster_node] = static_cast<int32_t>(cluster.clusters.size());
+            cluster.clusters.push_back(pair.cluster);
+        }
+        pair.local_track = static_cast<uint32_t>(node_slot_[pair.track]);
+        pair.local_cluster = static_cast<uint32_t>(node_slot_[cluster_node]);
+        cluster.pairs.push_back(p);
+    }
+}
+
+JPDAEngine::Strategy JPDAEngine::solveGateCluster(const GateCluster& cluster,
+                                                  std::chrono::steady_clock::time_point deadline,
+                                                  std::vector<double>& pair_probability) const {
+    const size_t n = cluster.tracks.size();
+    Eigen::MatrixXd weights = Eigen::MatrixXd::Zero(n, cluster.clusters.size());
+    std::vector<size_t> degree(n, 0);
+    for (uint32_t p : cluster.pairs) {
+        weights(gated_[p].local_track, gated_[p].local_cluster) = gated_[p].weight;
+        ++degree[gated_[p].local_track];
+    }
+
+    // Upper bound on the number of joint events: each track picks one gated cluster or none
+    double events = 1.0;
+    for (size_t d : degree) {
+        events *= static_cast<double>(d + 1);
+    }
+
+    if (n <= config_.exact_max_tracks && events <= static_cast<double>(config_.exact_max_events)) {
+        solveExact(cluster, weights, pair_probability);
+        return Strategy::EXACT;
+    }
+    if (n <= config_.kbest_max_tracks && std::chrono::steady_clock::now() < deadline &&
+        solveKBest(cluster, weights, deadline, pair_probability)) {
+        return Strategy::KBEST;
+    }
+    solveParametric(cluster, weights, pair_probability);
+    return Strategy::PARAMETRIC;
+}
+
+void JPDAEngine::solveExact(const GateCluster& cluster, const Eigen::MatrixXd& weights,
+                            std::vector<double>& pair_probability) const {
+    const size_t n = static_cast<size_t>(weights.rows());
+    const size_t m = static_cast<size_t>(weights.cols());
+
+    std::vector<std::vector<uint32_t>> gated(n);
+    for (uint32_t p : cluster.pairs) {
+        gated[gated_[p].local_track].push_back(gated_[p].local_cluster);
+    }
+
+    Eigen::MatrixXd pair_mass = Eigen::MatrixXd::Zero(n, m);
+    std::vector<int> assignment(n, -1);
+    std::vector<char> used(m, 0);
+    double total_mass = 0.0;
+
+    // Depth-first over tracks; a missed detection has weight 1 after normalization
+    auto enumerate = [&](auto&& self, size_t track, double mass) -> void {
+        if (track == n) {
+            total_mass += mass;
+            for (size_t t = 0; t < n; ++t) {
+                if (assignment[t] >= 0) {
+                    pair_mass(t, assignment[t]) += mass;
+                }
+            }
+            return;
+        }
+        assignment[track] = -1;
+        self(self, track + 1, mass);
+        for (uint32_t c : gated[track]) {
+            if (!used[c]) {
+                used[c] = 1;
+                assignment[track] = static_cast<int>(c);
+                self(self, track + 1, mass * weights(track, c));
+                used[c] = 0;
+            }
+        }
+        assignment[track] = -1;
+    };
+    enumerate(enumerate, 0, 1.0);
+
+    for (uint32_t p : cluster.pairs) {
+        pair_probability[p] = pair_mass(gated_[p].local_track, gated_[p].local_cluster) / total_mass;
+    }
+}
+
+bool JPDAEngine::solveKBest(const GateCluster& cluster, const Eigen::MatrixXd& weights,
+                            std::chrono::steady_clock::time_point deadline,
+                            std::vector<double>& pair_probability) const {
+    const Eigen::Index n = weights.rows();
+    const Eigen::Index m = weights.cols();
+
+    // Columns [0, m) are clusters, column m + t is the missed detection of track t
+    Eigen::MatrixXd cost = Eigen::MatrixXd::Constant(n, m + n, KBestAssignment::FORBIDDEN);
+    for (uint32_t p : cluster.pairs) {
+        cost(gated_[p].local_track, gated_[p].local_cluster) = -std::log(gated_[p].weight);
+    }
+    for (Eigen::Index t = 0; t < n; ++t) {
+        cost(t, m + t) = 0.0;
+    }
+
+    const auto hypotheses = KBestAssignment::murty(cost, config_.k_best, deadline);
+    if (hypotheses.empty()) {
+        return false;
+    }
+
+    // Hypothesis weights relative to the best one to stay in range
+    Eigen::MatrixXd pair_mass = Eigen::MatrixXd::Zero(n, m);
+    double total_mass = 0.0;
+    const double best_cost = hypotheses.front().cost;
+    for (const auto& hypothesis : hypotheses) {
+        const double mass = std::exp(best_cost - hypothesis.cost);
+        total_mass += mass;
+        for (Eigen::Index t = 0; t < n; ++t) {
+            if (hypothesis.row_to_col[t] < m) {
+                pair_mass(t, hypothesis.row_to_col[t]) += mass;
+            }
+        }
+    }
+
+    for (uint32_t p : cluster.pairs) {
+        pair_probability[p] = pair_mass(gated_[p].local_track, gated_[p].local_cluster) / total_mass;
+    }
+    return true;
+}
+
+void JPDAEngine::solveParametric(const GateCluster& cluster, const Eigen::MatrixXd& weights,
+                                 std::vector<double>& pair_probability) const {
+    // Cheap JPDA (Fitzgerald): beta_tj = w_tj / (sum_t' w_t'j + sum_j' w_tj' - w_tj + 1)
+    const Eigen::VectorXd track_sum = weights.rowwise().sum();
+    const Eigen::RowVectorXd cluster_sum = weights.colwise().sum();
+
+    Eigen::VectorXd row_total = Eigen::VectorXd::Zero(weights.rows());
+    for (uint32_t p : cluster.pairs) {
+        const uint32_t t = gated_[p].local_track;
+        const uint32_t c = gated_[p].local_cluster;
+        const double w = weights(t, c);
+        pair_probability[p] = w / (track_sum(t) + cluster_sum(c) - w + 1.0);
+        row_total(t) += pair_probability[p];
+    }
+    for (uint32_t p : cluster.pairs) {
+        const uint32_t t = gated_[p].local_track;
+        if (row_total(t) > 1.0) {
+            pair_probability[p] /= row_total(t);
+        }
+    }
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,134 @@
+#include "processing/LazyPrediction.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace radar_tracking {
+
+void LazyPredictionPlanner::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    enabled = node["enabled"].as<bool>(enabled);
+    max_acceleration = node["max_acceleration"].as<double>(max_acceleration);
+    measurement_variance = node["measurement_variance"].as<double>(measurement_variance);
+}
+
+LazyPredictionPlanner::Box LazyPredictionPlanner::boundedGate(const Track& track, double dt_begin, double dt_end,
+                                                              double gate_threshold, double measurement_variance,
+                                                              double max_acceleration, double max_distance) {
+    const double p[3] = {track.position.x, track.position.y, track.position.z};
+    const double v[3] = {track.velocity.x, track.velocity.y, track.velocity.z};
+    const double a[3] = {track.acceleration.x, track.acceleration.y, track.acceleration.z};
+    const double gate = std::sqrt(gate_threshold);
+    const double sigma_r = std::sqrt(std::max(measurement_variance, 0.0));
+    const double manoeuvre = 0.5 * max_acceleration * dt_end * dt_end;
+
+    double lo[3], hi[3];
+    for (int i = 0; i < 3; ++i) {
+        // std(p + v dt + a dt^2/2) <= sigma_p + sigma_v dt + sigma_a dt^2/2
+        const double sigma_p = std::sqrt(std::max(track.covariance[i][i], 0.0));
+        const double sigma_v = std::sqrt(std::max(track.covariance[i + 3][i + 3], 0.0));
+        const double sigma_a = std::sqrt(std::max(track.covariance[i + 6][i + 6], 0.0));
+        double half = gate * (sigma_p + sigma_v * dt_end + 0.5 * sigma_a * dt_end * dt_end + sigma_r);
+        if (max_distance > 0.0) {
+            half = std::min(half, max_distance);
+        }
+        half += manoeuvre;
+
+        const double begin = p[i] + v[i] * dt_begin + 0.5 * a[i] * dt_begin * dt_begin;
+        const double end = p[i] + v[i] * dt_end + 0.5 * a[i] * dt_end * dt_end;
+        lo[i] = std::min(begin, end) - half;
+        hi[i] = std::max(begin, end) + half;
+    }
+    return Box{lo[0], lo[1], lo[2], hi[0], hi[1], hi[2]};
+}
+
+void LazyPredictionPlanner::plan(const std::vector<Track>& tracks,
+                                 const std::vector<Cluster>& clusters,
+                                 const std::vector<RadarDetection>& measurements,
+                                 double gate_threshold,
+                                 double max_distance) {
+    selected_.clear();
+    target_time_.clear();
+    compact_of_.assign(tracks.size(), NONE);
+    if (tracks.empty() || clusters.empty()) {
+        return;
+    }
+
+    auto [first, last] = std::minmax_element(measurements.begin(), measurements.end(),
+        [](const RadarDetection& a, const RadarDetection& b) { return a.timestamp < b.timestamp; });
+    const TimePoint scan_begin = first->timestamp;
+    const TimePoint scan_end = last->timestamp;
+
+    boxes_.resize(tracks.size());
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        const double dt_begin = std::max(secondsBetween(tracks[t].valid_time, scan_begin), 0.0);
+        const double dt_end = std::max(secondsBetween(tracks[t].valid_time, scan_end), 0.0);
+        boxes_[t] = boundedGate(tracks[t], dt_begin, dt_end, gate_threshold,
+                                config_.measurement_variance, config_.max_acceleration, max_distance);
+    }
+
+    // Earliest reachable cluster time per track (scan_end + 1 tick: unreached)
+    const TimePoint unreached = scan_end + TimePoint::duration(1);
+    std::vector<TimePoint> earliest(tracks.size(), unreached);
+    auto reach = [&](uint32_t t, uint32_t c) {
+        earliest[t] = std::min(earliest[t], measurements[c].timestamp);
+    };
+
+    const auto& index_config = index_.getConfig();
+    if (index_config.enabled && tracks.size() >= index_config.min_tracks) {
+        index_.build(boxes_);
+        for (const auto& [t, c] : index_.candidatePairs(clusters)) {
+            reach(t, c);
+        }
+    } else {
+        for (uint32_t t = 0; t < tracks.size(); ++t) {
+            for (uint32_t c = 0; c < clusters.size(); ++c) {
+                if (boxes_[t].contains(clusters[c].centroid)) {
+                    reach(t, c);
+                }
+            }
+        }
+    }
+
+    for (uint32_t t = 0; t < tracks.size(); ++t) {
+        if (earliest[t] == unreached) {
+            continue;
+        }
+        compact_of_[t] = static_cast<uint32_t>(selected_.size());
+        selected_.push_back(t);
+        target_time_.push_back(std::max(earliest[t], tracks[t].valid_time));
+    }
+}
+
+void LazyPredictionPlanner::gather(std::vector<Track>& tracks, std::vector<Track>& compact) const {
+    compact.resize(selected_.size());
+    for (size_t k = 0; k < selected_.size(); ++k) {
+        compact[k] = std::move(tracks[selected_[k]]);
+    }
+}
+
+void LazyPredictionPlanner::scatter(std::vector<Track>& compact, std::vector<Track>& tracks) const {
+    for (size_t k = 0; k < selected_.size(); ++k) {
+        tracks[selected_[k]] = std::move(compact[k]);
+    }
+}
+
+void LazyPredictionPlanner::remap(std::vector<std::pair<uint32_t, uint32_t>>& associations) const {
+    for (auto& association : associations) {
+        association.first = selected_[association.first];
+    }
+}
+
+std::vector<uint32_t> LazyPredictionPlanner::deferredTracks(size_t track_count) const {
+    std::vector<uint32_t> deferred;
+    deferred.reserve(track_count - std::min(track_count, selected_.size()));
+    for (uint32_t t = 0; t < track_count; ++t) {
+        if (t >= compact_of_.size() || compact_of_[t] == NONE) {
+            deferred.push_back(t);
+        }
+    }
+    return deferred;
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,599 @@
+#include "processing/MHTAssociation.hpp"
+#include "utils/KBestAssignment.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_set>
+
+namespace radar_tracking {
+
+namespace {
+constexpr double LOG_2PI = 1.8378770664093453;
+}
+
+void MHTAssociation::Config::loadFromYaml(const YAML::Node& node) {
+    auto params = node["parameters"];
+    if (params) {
+        gating_threshold = params["gating_threshold"].as<double>(gating_threshold);
+        detection_probability = params["detection_probability"].as<double>(detection_probability);
+        clutter_density = params["clutter_density"].as<double>(clutter_density);
+        measurement_variance = params["measurement_variance"].as<double>(measurement_variance);
+        process_noise = params["process_noise"].as<double>(process_noise);
+        scan_period_sec = params["scan_period_sec"].as<double>(scan_period_sec);
+    }
+
+    auto hypotheses = node["hypotheses"];
+    if (hypotheses) {
+        n_scan = hypotheses["n_scan"].as<int>(n_scan);
+        k_best = hypotheses["k_best"].as<size_t>(k_best);
+        max_leaves_per_tree = hypotheses["max_leaves_per_tree"].as<size_t>(max_leaves_per_tree);
+        prune_log_ratio = hypotheses["prune_log_ratio"].as<double>(prune_log_ratio);
+        min_hypothesis_probability = hypotheses["min_hypothesis_probability"].as<double>(min_hypothesis_probability);
+    }
+
+    if (node["performance"]) {
+        time_budget_ms = node["performance"]["time_budget_ms"].as<double>(time_budget_ms);
+    }
+}
+
+bool MHTAssociation::Config::validate() const {
+    if (gating_threshold <= 0.0 || measurement_variance <= 0.0 || clutter_density <= 0.0) {
+        LOG_ERROR("MHT: gating_threshold, measurement_variance and clutter_density must be positive");
+        return false;
+    }
+    if (detection_probability <= 0.0 || detection_probability >= 1.0) {
+        LOG_ERROR("MHT: detection_probability must be in (0, 1)");
+        return false;
+    }
+    if (n_scan < 1 || k_best == 0 || max_leaves_per_tree == 0) {
+        LOG_ERROR("MHT: n_scan, k_best and max_leaves_per_tree must be at least 1");
+        return false;
+    }
+    if (time_budget_ms <= 0.0) {
+        LOG_ERROR("MHT: time_budget_ms must be positive");
+        return false;
+    }
+    return true;
+}
+
+MHTAssociation::MHTAssociation() : node_pool_(4096) {
+    leaf_limit_ = config_.max_leaves_per_tree;
+}
+
+MHTAssociation::MHTAssociation(const Config& config) : node_pool_(4096) {
+    setConfig(config);
+}
+
+MHTAssociation::~MHTAssociation() {
+    reset();
+}
+
+void MHTAssociation::setConfig(const Config& config) {
+    config_ = config;
+    leaf_limit_ = config_.max_leaves_per_tree;
+}
+
+void MHTAssociation::reset() {
+    for (auto& [track_id, tree] : trees_) {
+        destroySubtree(tree.root);
+    }
+    trees_.clear();
+    has_scan_time_ = false;
+}
+
+bool MHTAssociation::initialize(const std::string& config_file) {
+    try {
+        Config config;
+        if (!config_file.empty()) {
+            config.loadFromYaml(YAML::LoadFile(config_file));
+        }
+        if (!config.validate()) {
+            LOG_ERROR("Invalid MHT configuration");
+            return false;
+        }
+        reset();
+        setConfig(config);
+
+        LOG_INFO("MHT initialized: N=" + std::to_string(config_.n_scan) +
+                 ", k_best=" + std::to_string(config_.k_best) +
+                 ", max_leaves=" + std::to_string(config_.max_leaves_per_tree) +
+                 ", budget=" + std::to_string(config_.time_budget_ms) + "ms");
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to initialize MHT: " + std::string(e.what()));
+        return false;
+    }
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> MHTAssociation::associate(
+    const std::vector<Track>& tracks,
+    const std::vector<Cluster>& clusters) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                      std::chrono::duration<double, std::milli>(config_.time_budget_ms));
+
+    ++scan_;
+    const double dt = scanInterval(clusters);
+    retainTrees(tracks);
+
+    cx_.resize(clusters.size());
+    cy_.resize(clusters.size());
+    cz_.resize(clusters.size());
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        cx_[c] = clusters[c].centroid.x;
+        cy_[c] = clusters[c].centroid.y;
+        cz_[c] = clusters[c].centroid.z;
+    }
+
+    // Branch every tree; gated[t] lists clusters reachable from any of its leaves
+    const size_t track_count = tracks.size();
+    std::vector<HypothesisTree*> tree_of(track_count);
+    std::vector<std::vector<uint32_t>> gated(track_count);
+    for (size_t t = 0; t < track_count; ++t) {
+        tree_of[t] = &treeFor(tracks[t]);
+        extendTree(*tree_of[t], dt, gated[t]);
+    }
+
+    // Trees competing for a cluster must be resolved jointly (union-find over tracks + clusters)
+    std::vector<uint32_t> parent(track_count + clusters.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](uint32_t node) {
+        while (parent[node] != node) {
+            parent[node] = parent[parent[node]];
+            node = parent[node];
+        }
+        return node;
+    };
+    for (uint32_t t = 0; t < track_count; ++t) {
+        for (uint32_t c : gated[t]) {
+            const uint32_t a = find(t);
+            const uint32_t b = find(static_cast<uint32_t>(track_count + c));
+            if (a != b) {
+                parent[a] = b;
+            }
+        }
+    }
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> groups;
+    for (uint32_t t = 0; t < track_count; ++t) {
+        groups[find(t)].push_back(t);
+    }
+
+    HypothesisStats stats;
+    stats.groups = groups.size();
+    std::vector<HypothesisTree*> group_trees;
+    std::vector<std::vector<uint32_t>> group_gated;
+    for (const auto& [root, members] : groups) {
+        group_trees.clear();
+        group_gated.clear();
+        for (uint32_t t : members) {
+            group_trees.push_back(tree_of[t]);
+            group_gated.push_back(gated[t]);
+        }
+        stats.global_hypotheses += solveGroup(group_trees, group_gated, deadline);
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> associations;
+    for (uint32_t t = 0; t < track_count; ++t) {
+        HypothesisTree& tree = *tree_of[t];
+        if (tree.selected && tree.selected->cluster >= 0) {
+            associations.emplace_back(t, static_cast<uint32_t>(tree.selected->cluster));
+        }
+        pruneTree(tree);
+        nScanPrune(tree);
+        stats.leaves += tree.leaves.size();
+    }
+
+    const double processing_time_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    adaptLeafLimit(processing_time_ms);
+
+    stats.trees = trees_.size();
+    stats.nodes = node_pool_.getAllocatedCount();
+    stats.leaf_limit = leaf_limit_;
+    stats.processing_time_ms = processing_time_ms;
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    last_stats_ = stats;
+    ++total_scans_;
+    total_associations_ += associations.size();
+    total_processing_time_ms_ += processing_time_ms;
+    return associations;
+}
+
+MHTAssociation::HypothesisTree& MHTAssociation::treeFor(const Track& track) {
+    auto [it, inserted] = trees_.try_emplace(track.track_id);
+    HypothesisTree& tree = it->second;
+    tree.last_seen_scan = scan_;
+    if (!inserted) {
+        return tree;
+    }
+
+    // Root from the track's current estimate; unset covariances fall back to priors
+    HypothesisNode* root = node_pool_.create();
+    root->scan = scan_ - 1;
+    const double position[3] = {track.position.x, track.position.y, track.position.z};
+    const double velocity[3] = {track.velocity.x, track.velocity.y, track.velocity.z};
+    for (int i = 0; i < 3; ++i) {
+        AxisState& axis = root->axes[i];
+        axis.pos = position[i];
+        axis.vel = velocity[i];
+        axis.p00 = std::max(track.covariance[i][i], config_.measurement_variance);
+        axis.p01 = track.covariance[i][i + 3];
+        axis.p11 = std::max(track.covariance[i + 3][i + 3], 100.0 * config_.measurement_variance);
+    }
+
+    tree.track_id = track.track_id;
+    tree.root = root;
+    tree.selected = root;
+    tree.leaves.assign(1, root);
+    return tree;
+}
+
+void MHTAssociation::retainTrees(const std::vector<Track>& tracks) {
+    std::unordered_set<uint32_t> live;
+    live.reserve(tracks.size());
+    for (const auto& track : tracks) {
+        live.insert(track.track_id);
+    }
+    for (auto it = trees_.begin(); it != trees_.end();) {
+        if (live.count(it->first) == 0) {
+            destroySubtree(it->second.root);
+            it = trees_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+double MHTAssociation::scanInterval(const std::vector<Cluster>& clusters) {
+    bool found = false;
+    std::chrono::high_resolution_clock::time_point latest;
+    for (const auto& cluster : clusters) {
+        for (const auto& detection : cluster.detections) {
+            if (!found || detection.timestamp > latest) {
+                latest = detection.timestamp;
+                found = true;
+            }
+        }
+    }
+    if (!found) {
+        // The trees are predicted over this scan too; the next scan starts from there
+        if (has_scan_time_) {
+            last_scan_time_ += std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                std::chrono::duration<double>(config_.scan_period_sec));
+        }
+        return config_.scan_period_sec;
+    }
+
+    double dt = config_.scan_period_sec;
+    if (has_scan_time_) {
+        const double elapsed = std::chrono::duration<double>(latest - last_scan_time_).count();
+        if (elapsed > 0.0) {
+            dt = elapsed;
+        }
+    }
+    last_scan_time_ = latest;
+    has_scan_time_ = true;
+    return dt;
+}
+
+void MHTAssociation::predictAxis(AxisState& axis, double dt, double q) {
+    const double dt2 = dt * dt;
+    axis.pos += axis.vel * dt;
+    axis.p00 += 2.0 * dt * axis.p01 + dt2 * axis.p11 + 0.25 * dt2 * dt2 * q;
+    axis.p01 += dt * axis.p11 + 0.5 * dt2 * dt * q;
+    axis.p11 += dt2 * q;
+}
+
+void MHTAssociation::extendTree(HypothesisTree& tree, double dt, std::vector<uint32_t>& gated) {
+    const double r = config_.measurement_variance;
+    const double miss_score = std::log(1.0 - config_.detection_probability);
+    const double detection_score = std::log(config_.detection_probability) - std::log(config_.clutter_density) -
+                                   1.5 * LOG_2PI;
+
+    std::vector<HypothesisNode*> new_leaves;
+    new_leaves.reserve(tree.leaves.size() * 2);
+
+    for (HypothesisNode* leaf : tree.leaves) {
+        AxisState predicted[3] = {leaf->axes[0], leaf->axes[1], leaf->axes[2]};
+        for (auto& axis : predicted) {
+            predictAxis(axis, dt, config_.process_noise);
+        }
+
+        HypothesisNode* miss = addChild(leaf);
+        std::copy(predicted, predicted + 3, miss->axes);
+        miss->score = leaf->score + miss_score;
+        new_leaves.push_back(miss);
+
+        const double sx = predicted[0].p00 + r, sy = predicted[1].p00 + r, sz = predicted[2].p00 + r;
+        const double isx = 1.0 / sx, isy = 1.0 / sy, isz = 1.0 / sz;
+        const double half_x2 = config_.gating_threshold * sx;
+        const double log_det = std::log(sx * sy * sz);
+
+        for (uint32_t c = 0; c < cx_.size(); ++c) {
+            const double nx = cx_[c] - predicted[0].pos;
+            if (nx * nx > half_x2) {
+                continue;
+            }
+            const double ny = cy_[c] - predicted[1].pos;
+            const double nz = cz_[c] - predicted[2].pos;
+            const double d2 = nx * nx * isx + ny * ny * isy + nz * nz * isz;
+            if (d2 > config_.gating_threshold) {
+                continue;
+            }
+
+            HypothesisNode* child = addChild(leaf);
+            child->cluster = static_cast<int32_t>(c);
+            child->score = leaf->score + detection_score - 0.5 * (d2 + log_det);
+
+            const double innovation[3] = {nx, ny, nz};
+            const double inv_s[3] = {isx, isy, isz};
+            for (int i = 0; i < 3; ++i) {
+                AxisState axis = predicted[i];
+                const double k0 = axis.p00 * inv_s[i];
+                const double k1 = axis.p01 * inv_s[i];
+                axis.pos += k0 * innovation[i];
+                axis.vel += k1 * innovation[i];
+                axis.p11 -= k1 * axis.p01;
+                axis.p01 *= (1.0 - k0);
+                axis.p00 *= (1.0 - k0);
+                child->axes[i] = axis;
+            }
+            new_leaves.push_back(child);
+            gated.push_back(c);
+        }
+    }
+
+    tree.leaves.swap(new_leaves);
+    std::sort(gated.begin(), gated.end());
+    gated.erase(std::unique(gated.begin(), gated.end()), gated.end());
+}
+
+size_t MHTAssociation::solveGroup(const std::vector<HypothesisTree*>& group,
+                                  const std::vector<std::vector<uint32_t>>& gated,
+                                  std::chrono::steady_clock::time_point deadline) {
+    // Columns: the group's clusters, then one missed-detection column per tree
+    std::vector<uint32_t> columns;
+    for (const auto& list : gated) {
+        columns.insert(columns.end(), list.begin(), list.end());
+    }
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+    const size_t n = group.size();
+    const size_t m = columns.size();
+    const size_t width = m + n;
+    Eigen::MatrixXd cost = Eigen::MatrixXd::Constant(n, width, KBestAssignment::FORBIDDEN);
+    std::vector<HypothesisNode*> best_node(n * width, nullptr);
+
+    for (size_t row = 0; row < n; ++row) {
+        for (HypothesisNode* leaf : group[row]->leaves) {
+            leaf->marginal = 0.0;
+            size_t col;
+            if (leaf->cluster < 0) {
+                col = m + row;
+            } else {
+                col = static_cast<size_t>(std::lower_bound(columns.begin(), columns.end(),
+                                                           static_cast<uint32_t>(leaf->cluster)) - columns.begin());
+            }
+            // Best history per (tree, column); other histories survive through score pruning
+            if (-leaf->score < cost(row, col)) {
+                cost(row, col) = -leaf->score;
+                best_node[row * width + col] = leaf;
+            }
+        }
+    }
+
+    const size_t k = std::chrono::steady_clock::now() < deadline ? config_.k_best : 1;
+    const auto hypotheses = KBestAssignment::murty(cost, k, deadline);
+    if (hypotheses.empty()) {
+        for (HypothesisTree* tree : group) {
+            tree->selected = nullptr;
+        }
+        return 0;
+    }
+
+    double total = 0.0;
+    std::vector<double> weights(hypotheses.size());
+    for (size_t h = 0; h < hypotheses.size(); ++h) {
+        weights[h] = std::exp(hypotheses.front().cost - hypotheses[h].cost);
+        total += weights[h];
+    }
+    for (size_t h = 0; h < hypotheses.size(); ++h) {
+        for (size_t row = 0; row < n; ++row) {
+            HypothesisNode* node = best_node[row * width + hypotheses[h].row_to_col[row]];
+            node->marginal += weights[h] / total;
+            if (h == 0) {
+                group[row]->selected = node;
+            }
+        }
+    }
+    return hypotheses.size();
+}
+
+void MHTAssociation::pruneTree(HypothesisTree& tree) {
+    if (tree.leaves.empty()) {
+        return;
+    }
+    double best_score = tree.leaves.front()->score;
+    for (HypothesisNode* leaf : tree.leaves) {
+        best_score = std::max(best_score, leaf->score);
+    }
+
+    // A leaf qualifies on its marginal or its score, so filter before ranking
+    auto worth_keeping = [&](const HypothesisNode* leaf) {
+        return leaf == tree.selected ||
+               leaf->marginal >= config_.min_hypothesis_probability ||
+               leaf->score >= best_score - config_.prune_log_ratio;
+    };
+    auto rank = [&tree](const HypothesisNode* a, const HypothesisNode* b) {
+        if ((a == tree.selected) != (b == tree.selected)) {
+            return a == tree.selected;
+        }
+        if (a->marginal != b->marginal) {
+            return a->marginal > b->marginal;
+        }
+        return a->score > b->score;
+    };
+    auto kept_end = std::partition(tree.leaves.begin(), tree.leaves.end(), worth_keeping);
+    std::sort(tree.leaves.begin(), kept_end, rank);
+
+    size_t keep = std::min<size_t>(static_cast<size_t>(kept_end - tree.leaves.begin()), leaf_limit_);
+    keep = std::max<size_t>(keep, 1);
+
+    // Remove pruned leaves and any ancestors left without children
+    for (size_t i = keep; i < tree.leaves.size(); ++i) {
+        HypothesisNode* node = tree.leaves[i];
+        while (node != tree.root && node->first_child == nullptr) {
+            HypothesisNode* parent = node->parent;
+            detachChild(parent, node);
+            node_pool_.destroy(node);
+            node = parent;
+        }
+    }
+    tree.leaves.resize(keep);
+}
+
+void MHTAssociation::nScanPrune(HypothesisTree& tree) {
+    if (!tree.selected) {
+        return;
+    }
+
+    // Commit the selected history older than the window
+    HypothesisNode* anchor = tree.selected;
+    const uint32_t window_start = scan_ >= static_cast<uint32_t>(config_.n_scan) ? scan_ - config_.n_scan : 0;
+    while (anchor->parent && anchor->scan > window_start) {
+        anchor = anchor->parent;
+    }
+    if (anchor == tree.root) {
+        return;
+    }
+
+    for (HypothesisNode* node = anchor; node->parent; node = node->parent) {
+        HypothesisNode* parent = node->parent;
+        for (HypothesisNode* child = parent->first_child; child;) {
+            HypothesisNode* next = child->next_sibling;
+            if (child != node) {
+                destroySubtree(child);
+            }
+            child = next;
+        }
+        parent->first_child = node;
+        node->next_sibling = nullptr;
+    }
+    for (HypothesisNode* node = tree.root; node != anchor;) {
+        HypothesisNode* next = node->first_child;
+        node_pool_.destroy(node);
+        node = next;
+    }
+    anchor->parent = nullptr;
+    tree.root = anchor;
+
+    tree.leaves.clear();
+    collectLeaves(anchor, tree.leaves);
+}
+
+void MHTAssociation::collectLeaves(HypothesisNode* node, std::vector<HypothesisNode*>& leaves) const {
+    if (!node->first_child) {
+        leaves.push_back(node);
+        return;
+    }
+    for (HypothesisNode* child = node->first_child; child; child = child->next_sibling) {
+        collectLeaves(child, leaves);
+    }
+}
+
+void MHTAssociation::destroySubtree(HypothesisNode* node) {
+    if (!node) {
+        return;
+    }
+    for (HypothesisNode* child = node->first_child; child;) {
+        HypothesisNode* next = child->next_sibling;
+        destroySubtree(child);
+        child = next;
+    }
+    node_pool_.destroy(node);
+}
+
+void MHTAssociation::detachChild(HypothesisNode* parent, HypothesisNode* child) {
+    HypothesisNode** link = &parent->first_child;
+    while (*link && *link != child) {
+        link = &(*link)->next_sibling;
+    }
+    if (*link) {
+        *link = child->next_sibling;
+    }
+}
+
+MHTAssociation::HypothesisNode* MHTAssociation::addChild(HypothesisNode* parent) {
+    HypothesisNode* child = node_pool_.create();
+    child->parent = parent;
+    child->scan = scan_;
+    child->next_sibling = parent->first_child;
+    parent->first_child = child;
+    return child;
+}
+
+void MHTAssociation::adaptLeafLimit(double processing_time_ms) {
+    if (processing_time_ms > config_.time_budget_ms) {
+        leaf_limit_ = std::max<size_t>(1, leaf_limit_ / 2);
+        LOG_ASYNC_DEBUG("MHT over budget ({:.3f}ms), leaf limit {}", processing_time_ms, leaf_limit_);
+    } else if (processing_time_ms < 0.5 * config_.time_budget_ms && leaf_limit_ < config_.max_leaves_per_tree) {
+        leaf_limit_ = std::min(config_.max_leaves_per_tree, leaf_limit_ * 2);
+    }
+}
+
+double MHTAssociation::calculateAssociationProbability(const Track& track, const Cluster& cluster) const {
+    const double position[3] = {track.position.x, track.position.y, track.position.z};
+    const double measured[3] = {cluster.centroid.x, cluster.centroid.y, cluster.centroid.z};
+    double d2 = 0.0;
+    double log_det = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        const double s = std::max(track.covariance[i][i], 0.0) + config_.measurement_variance;
+        const double innovation = measured[i] - position[i];
+        d2 += innovation * innovation / s;
+        log_det += std::log(s);
+    }
+    if (d2 > config_.gating_threshold) {
+        return 0.0;
+    }
+
+    const double log_ratio = std::log(config_.detection_probability) - std::log(config_.clutter_density) -
+                             1.5 * LOG_2PI - 0.5 * (d2 + log_det) -
+                             std::log(1.0 - config_.detection_probability);
+    return 1.0 / (1.0 + std::exp(-log_ratio));
+}
+
+MHTAssociation::HypothesisStats MHTAssociation::getHypothesisStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return last_stats_;
+}
+
+bool MHTAssociation::getSelectedState(uint32_t track_id, Point3D& position, Point3D& velocity) const {
+    auto it = trees_.find(track_id);
+    if (it == trees_.end()) {
+        return false;
+    }
+    const HypothesisNode* node = it->second.selected ? it->second.selected : it->second.root;
+    position = Point3D(node->axes[0].pos, node->axes[1].pos, node->axes[2].pos);
+    velocity = Point3D(node->axes[0].vel, node->axes[1].vel, node->axes[2].vel);
+    return true;
+}
+
+SystemStats MHTAssociation::getStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    SystemStats stats;
+    stats.active_tracks = static_cast<uint32_t>(last_stats_.trees);
+    stats.processing_latency_ms = total_scans_ > 0 ? total_processing_time_ms_ / total_scans_ : 0.0;
+    stats.average_processing_rate = total_scans_ > 0 ? static_cast<double>(total_associations_) / total_scans_ : 0.0;
+    stats.memory_usage_mb = node_pool_.getMemoryUsage() / (1024.0 * 1024.0);
+    return stats;
+}
+
+std::unique_ptr<IAssociationAlgorithm> createMHTAssociation() {
+    return std::make_unique<MHTAssociation>();
+}
+
+} // namespace radar_tracking
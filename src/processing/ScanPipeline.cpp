@@ -0,0 +1,308 @@
+#include "processing/ScanPipeline.hpp"
+#include "core/ConfigSnapshot.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+
+namespace radar_tracking {
+
+template class StaticPipeline<DBSCANClustering, GNNPolicy, IMMKernel>;
+template class StaticPipeline<DBSCANClustering, GNNPolicy, KalmanCVKernel>;
+template class StaticPipeline<DBSCANClustering, GNNPolicy, IMMBatchEngine>;
+template class StaticPipeline<DBSCANClustering, GNNPolicy, ParticleFilter>;
+template class StaticPipeline<DBSCANClustering, GNNPolicy, SquareRootKalmanCVKernel>;
+
+RadarDetection clusterMeasurement(const Cluster& cluster) {
+    RadarDetection measurement;
+    measurement.position = cluster.centroid;
+
+    if (!cluster.detections.empty()) {
+        Point3D velocity;
+        auto latest = cluster.detections.front().timestamp;
+        for (const auto& detection : cluster.detections) {
+            velocity = velocity + detection.velocity;
+            latest = std::max(latest, detection.timestamp);
+        }
+        measurement.velocity = velocity * (1.0 / cluster.detections.size());
+        measurement.timestamp = latest;
+        measurement.beam_id = cluster.detections.front().beam_id;
+        measurement.detection_id = cluster.detections.front().detection_id;
+    }
+    return measurement;
+}
+
+void completeScanResult(size_t track_count, ScanResult& result) {
+    std::vector<bool> track_used(track_count, false);
+    std::vector<bool> cluster_used(result.clusters.size(), false);
+    for (const auto& [track_index, cluster_index] : result.associations) {
+        track_used[track_index] = true;
+        cluster_used[cluster_index] = true;
+    }
+
+    result.unassigned_tracks.clear();
+    result.unassigned_clusters.clear();
+    for (uint32_t t = 0; t < track_count; ++t) {
+        if (!track_used[t]) {
+            result.unassigned_tracks.push_back(t);
+        }
+    }
+    for (uint32_t c = 0; c < cluster_used.size(); ++c) {
+        if (!cluster_used[c]) {
+            result.unassigned_clusters.push_back(c);
+        }
+    }
+}
+
+RuntimePipeline::RuntimePipeline(IClusteringAlgorithm* clustering,
+                                 IAssociationAlgorithm* association,
+                                 ITracker* tracker)
+    : clustering_(clustering), association_(association), tracker_(tracker) {
+}
+
+void RuntimePipeline::enableSpatialIndex(const TrackSpatialIndex::Config& config) {
+    spatial_index_.setConfig(config);
+    use_spatial_index_ = config.enabled;
+}
+
+void RuntimePipeline::enableLazyPrediction(const LazyPredictionPlanner::Config& config,
+                                           const TrackSpatialIndex::Config& index_config) {
+    lazy_.setConfig(config);
+    lazy_.setIndexConfig(index_config);
+}
+
+bool RuntimePipeline::rebindAlgorithms(IClusteringAlgorithm* clustering,
+                                       IAssociationAlgorithm* association,
+                                       ITracker* tracker) {
+    if (clustering) {
+        clustering_ = clustering;
+    }
+    if (association) {
+        association_ = association;
+    }
+    if (tracker) {
+        tracker_ = tracker;
+    }
+    return true;
+}
+
+ScanResult RuntimePipeline::processScan(const std::vector<RadarDetection>& detections,
+                                        std::vector<Track>& tracks,
+                                        double dt) {
+    ScanResult result;
+    tracker_->retainTracks(tracks);
+
+    if (lazy_.getConfig().enabled) {
+        auto predict_to = [this](Track& track, LazyPredictionPlanner::TimePoint time) {
+            const double step = secondsBetween(track.valid_time, time);
+            if (step > 0.0) {
+                tracker_->predict(track, step);
+                track.valid_time = time;
+            }
+        };
+
+        result.clusters = clustering_->cluster(detections);
+        measurements_.clear();
+        for (const auto& cluster : result.clusters) {
+            measurements_.push_back(clusterMeasurement(cluster));
+        }
+
+        lazy_.plan(tracks, result.clusters, measurements_, association_->getGatingThreshold(), 0.0);
+        const auto& selected = lazy_.getSelected();
+        for (size_t k = 0; k < selected.size(); ++k) {
+            predict_to(tracks[selected[k]], lazy_.getTargetTime(k));
+        }
+
+        lazy_.gather(tracks, selected_tracks_);
+        result.associations = association_->associate(selected_tracks_, result.clusters);
+        for (const auto& [track_index, cluster_index] : result.associations) {
+            Track& track = selected_tracks_[track_index];
+            predict_to(track, measurements_[cluster_index].timestamp);
+            tracker_->update(track, measurements_[cluster_index]);
+        }
+        lazy_.scatter(selected_tracks_, tracks);
+        lazy_.remap(result.associations);
+
+        completeScanResult(tracks.size(), result);
+        result.deferred_tracks = lazy_.deferredTracks(tracks.size());
+        return result;
+    }
+
+    for (auto& track : tracks) {
+        tracker_->predict(track, dt);
+        advanceValidTime(track, dt);
+    }
+
+    result.clusters = clustering_->cluster(detections);
+
+    const auto& index_config = spatial_index_.getConfig();
+    if (use_spatial_index_ && tracks.size() >= index_config.min_tracks) {
+        gating_.buildTracks(tracks, index_config.measurement_variance, association_->getGatingThreshold());
+        spatial_index_.build(gating_);
+        result.associations = association_->associateCandidates(
+            tracks, result.clusters, spatial_index_.candidatePairs(result.clusters));
+    } else {
+        result.associations = association_->associate(tracks, result.clusters);
+    }
+
+    for (const auto& [track_index, cluster_index] : result.associations) {
+        tracker_->update(tracks[track_index], clusterMeasurement(result.clusters[cluster_index]));
+    }
+
+    completeScanResult(tracks.size(), result);
+    return result;
+}
+
+void GNNPolicy::loadFromYaml(const YAML::Node& node) {
+    auto params = node["parameters"];
+    if (!params) {
+        return;
+    }
+    gating_threshold = params["gating_threshold"].as<double>(gating_threshold);
+    max_association_distance = params["max_association_distance"].as<double>(max_association_distance);
+}
+
+void IMMKernel::Params::loadFromYaml(const YAML::Node& node) {
+    if (node["models"]) {
+        for (const auto& model : node["models"]) {
+            std::string type = model["type"].as<std::string>("");
+            int index = -1;
+            if (type == "constant_velocity") index = CV;
+            else if (type == "constant_acceleration") index = CA;
+            else if (type == "coordinated_turn") index = CT;
+            if (index < 0) {
+                LOG_WARN("IMM: ignoring unsupported model type " + type);
+                continue;
+            }
+
+            auto& params = models[index];
+            params.initial_probability = model["initial_probability"].as<double>(params.initial_probability);
+            if (model["process_noise"]) {
+                params.process_noise = model["process_noise"]["position"].as<double>(params.process_noise);
+            }
+            if (model["measurement_noise"]) {
+                params.measurement_noise = model["measurement_noise"]["position"].as<double>(params.measurement_noise);
+            }
+        }
+    }
+
+    if (node["transition_matrix"]) {
+        static const char* const names[NUM_MODELS] = {"CV", "CA", "CT"};
+        for (int i = 0; i < NUM_MODELS; ++i) {
+            auto row = node["transition_matrix"][names[i]];
+            if (row && row.size() == NUM_MODELS) {
+                for (int j = 0; j < NUM_MODELS; ++j) {
+                    transition[i][j] = row[j].as<double>();
+                }
+            }
+        }
+    }
+
+    if (node["parameters"]) {
+        auto params = node["parameters"];
+        mixing_threshold = params["mixing_threshold"].as<double>(mixing_threshold);
+        if (params["initial_covariance"]) {
+            auto cov = params["initial_covariance"];
+            initial_position_variance = cov["position"].as<double>(initial_position_variance);
+            initial_velocity_variance = cov["velocity"].as<double>(initial_velocity_variance);
+            initial_acceleration_variance = cov["acceleration"].as<double>(initial_acceleration_variance);
+        }
+    }
+}
+
+std::unique_ptr<ScanPipeline> createScanPipeline(const ConfigSnapshot& config,
+                                                 IClusteringAlgorithm* clustering,
+                                                 IAssociationAlgorithm* association,
+                                                 ITracker* tracker,
+                                                 ThreadPool* thread_pool) {
+    const auto& processing = config.processing;
+    const auto& algorithms = config.algorithms;
+    const auto& index_config = processing.spatial_index;
+    const auto& lazy_config = processing.lazy_prediction;
+    auto runtime = [&]() -> std::unique_ptr<ScanPipeline> {
+        auto pipeline = std::make_unique<RuntimePipeline>(clustering, association, tracker);
+        pipeline->enableSpatialIndex(index_config);
+        pipeline->enableLazyPrediction(lazy_config, index_config);
+        return pipeline;
+    };
+    auto lazy = [&](auto pipeline) -> std::unique_ptr<ScanPipeline> {
+        pipeline->enableLazyPrediction(lazy_config, index_config);
+        if (!pipeline->enableOOSM(processing.oosm) && processing.oosm.enabled) {
+            LOG_WARN(pipeline->getVariantName() + ": filter cannot snapshot track state, OOSM handling disabled");
+        }
+        return pipeline;
+    };
+
+    if (lazy_config.enabled) {
+        LOG_INFO("Lazy track prediction enabled");
+    }
+
+    const auto& tracking_type = algorithms.tracking_type;
+    if (algorithms.pipeline != "static") {
+        LOG_INFO("Using runtime-polymorphic scan pipeline");
+        return runtime();
+    }
+    if (algorithms.clustering_type != "DBSCAN" || algorithms.association_type != "GNN" ||
+        (tracking_type != "IMM" && tracking_type != "KALMAN" && tracking_type != "PARTICLE" &&
+         tracking_type != "SRKF")) {
+        LOG_INFO("No static pipeline for " + algorithms.clustering_type + "+" + algorithms.association_type + "+" +
+                 tracking_type + ", using runtime pipeline");
+        return runtime();
+    }
+
+    DBSCANClustering clusterer(algorithms.dbscan);
+
+    GNNPolicy associator;
+    associator.gating_threshold = algorithms.gnn.gating_threshold;
+    associator.max_association_distance = algorithms.gnn.max_association_distance;
+    associator.spatial_index.setConfig(index_config);
+
+    if (tracking_type == "IMM") {
+        if (algorithms.imm_batched) {
+            IMMBatchEngine engine(algorithms.imm, algorithms.imm_batch);
+            engine.setThreadPool(thread_pool);
+            LOG_INFO("Using static DBSCAN+GNN+IMM scan pipeline (batched model bank)");
+            return lazy(std::make_unique<DBSCANGNNIMMBatchPipeline>(
+                std::move(clusterer), associator, std::move(engine), "static:DBSCAN+GNN+IMM-batch"));
+        }
+        LOG_INFO("Using static DBSCAN+GNN+IMM scan pipeline");
+        return lazy(std::make_unique<DBSCANGNNIMMPipeline>(
+            std::move(clusterer), associator, IMMKernel(algorithms.imm), "static:DBSCAN+GNN+IMM"));
+    }
+
+    if (tracking_type == "PARTICLE") {
+        ParticleFilter filter(algorithms.particle);
+        filter.setThreadPool(thread_pool);
+        LOG_INFO("Using static DBSCAN+GNN+Particle scan pipeline");
+        return lazy(std::make_unique<DBSCANGNNParticlePipeline>(
+            std::move(clusterer), associator, std::move(filter), "static:DBSCAN+GNN+Particle"));
+    }
+
+    if (tracking_type == "SRKF") {
+        if (algorithms.srkf.motion_model != "CV") {
+            LOG_WARN("Static pipeline: SRKF specialization needs the CV model, using runtime pipeline");
+            return runtime();
+        }
+        LOG_INFO("Using static DBSCAN+GNN+SRKF scan pipeline");
+        return lazy(std::make_unique<DBSCANGNNSquareRootKalmanPipeline>(
+            std::move(clusterer), associator, SquareRootKalmanCVKernel(algorithms.srkf.kernelParams()),
+            "static:DBSCAN+GNN+SRKF"));
+    }
+
+    LOG_INFO("Using static DBSCAN+GNN+Kalman scan pipeline");
+    return lazy(std::make_unique<DBSCANGNNKalmanPipeline>(
+        std::move(clusterer), associator, KalmanCVKernel(algorithms.kalman), "static:DBSCAN+GNN+Kalman"));
+}
+
+std::unique_ptr<ScanPipeline> createScanPipeline(const std::string& config_file,
+                                                 IClusteringAlgorithm* clustering,
+                                                 IAssociationAlgorithm* association,
+                                                 ITracker* tracker,
+                                                 ThreadPool* thread_pool) {
+    auto config = ConfigSnapshot::compileFile(config_file);
+    if (!config) {
+        LOG_WARN("Static pipeline: invalid configuration, using runtime pipeline");
+        return std::make_unique<RuntimePipeline>(clustering, association, tracker);
+    }
+    return createScanPipeline(*config, clustering, association, tracker, thread_pool);
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,230 @@
+#include "processing/SectorStreamProcessor.hpp"
+#include "processing/LazyPrediction.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace radar_tracking {
+
+namespace {
+
+constexpr double TWO_PI = 2.0 * M_PI;
+
+}  // namespace
+
+void SectorStreamProcessor::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    enabled = node["enabled"].as<bool>(enabled);
+    num_sectors = node["num_sectors"].as<uint32_t>(num_sectors);
+    seam_margin_m = node["seam_margin_m"].as<double>(seam_margin_m);
+    track_margin_m = node["track_margin_m"].as<double>(track_margin_m);
+    clockwise = node["clockwise"].as<bool>(clockwise);
+    use_beam_id = node["use_beam_id"].as<bool>(use_beam_id);
+    beams_per_sector = node["beams_per_sector"].as<uint32_t>(beams_per_sector);
+}
+
+bool SectorStreamProcessor::Config::validate() const {
+    if (num_sectors < 2) {
+        LOG_ERROR("Streaming: num_sectors must be at least 2");
+        return false;
+    }
+    if (seam_margin_m < 0.0 || track_margin_m < 0.0) {
+        LOG_ERROR("Streaming: seam and track margins must be non-negative");
+        return false;
+    }
+    if (use_beam_id && beams_per_sector == 0) {
+        LOG_ERROR("Streaming: beams_per_sector must be positive");
+        return false;
+    }
+    return true;
+}
+
+SectorStreamProcessor::SectorStreamProcessor(const Config& config, ScanPipeline* pipeline)
+    : config_(config), pipeline_(pipeline), sector_width_(TWO_PI / std::max<uint32_t>(config.num_sectors, 1)) {
+}
+
+double SectorStreamProcessor::rotationAngle(double azimuth) const {
+    double angle = std::fmod(config_.clockwise ? -azimuth : azimuth, TWO_PI);
+    if (angle < 0.0) {
+        angle += TWO_PI;
+    }
+    return angle;
+}
+
+uint32_t SectorStreamProcessor::sectorOf(const RadarDetection& detection) const {
+    if (config_.use_beam_id) {
+        return (detection.beam_id / config_.beams_per_sector) % config_.num_sectors;
+    }
+    const auto sector = static_cast<uint32_t>(rotationAngle(detection.azimuth) / sector_width_);
+    return std::min(sector, config_.num_sectors - 1);
+}
+
+std::vector<SectorStreamProcessor::SectorResult> SectorStreamProcessor::push(
+    const std::vector<RadarDetection>& detections, std::vector<Track>& tracks) {
+    std::vector<SectorResult> results;
+
+    for (const auto& detection : detections) {
+        const uint32_t sector = sectorOf(detection);
+        if (open_sector_ == NO_SECTOR) {
+            open_sector_ = sector;
+        } else if (sector != open_sector_) {
+            // Ahead in the rotation: the beam has left the open sector. Behind:
+            // a late detection, kept with the open sector.
+            const uint32_t ahead = sectorsAhead(open_sector_, sector);
+            if (ahead <= config_.num_sectors / 2) {
+                closeSector(sector, tracks, results);
+                open_sector_ = sector;
+            }
+        }
+        pending_.push_back(detection);
+    }
+    return results;
+}
+
+std::vector<SectorStreamProcessor::SectorResult> SectorStreamProcessor::flush(std::vector<Track>& tracks) {
+    std::vector<SectorResult> results;
+    if (open_sector_ != NO_SECTOR) {
+        closeSector(NO_SECTOR, tracks, results);
+        open_sector_ = NO_SECTOR;
+        carry_into_open_ = false;
+    }
+    return results;
+}
+
+void SectorStreamProcessor::closeSector(uint32_t next_sector, std::vector<Track>& tracks,
+                                        std::vector<SectorResult>& results) {
+    const bool adjacent = next_sector != NO_SECTOR && sectorsAhead(open_sector_, next_sector) == 1 &&
+                          config_.seam_margin_m > 0.0;
+    const bool leading = carry_into_open_;
+    const double boundary = (open_sector_ + 1) * sector_width_;
+
+    batch_.swap(carry_);
+    carry_.clear();
+    if (adjacent) {
+        // Hold the detections in the band at the trailing boundary and every
+        // detection linked to them within the margin, so clusters that may
+        // continue into the next sector are clustered whole there
+        std::vector<uint8_t> held(pending_.size(), 0);
+        std::vector<size_t> frontier;
+        for (size_t i = 0; i < pending_.size(); ++i) {
+            const auto& detection = pending_[i];
+            const double gap = boundary - rotationAngle(detection.azimuth);
+            const double range = std::hypot(detection.position.x, detection.position.y);
+            if (gap >= 0.0 && gap <= sector_width_ && gap * range <= config_.seam_margin_m) {
+                held[i] = 1;
+                frontier.push_back(i);
+            }
+        }
+        while (!frontier.empty()) {
+            const Point3D origin = pending_[frontier.back()].position;
+            frontier.pop_back();
+            for (size_t j = 0; j < pending_.size(); ++j) {
+                if (!held[j] && origin.distance(pending_[j].position) <= config_.seam_margin_m) {
+                    held[j] = 1;
+                    frontier.push_back(j);
+                }
+            }
+        }
+        for (size_t i = 0; i < pending_.size(); ++i) {
+            (held[i] ? carry_ : batch_).push_back(std::move(pending_[i]));
+        }
+    } else {
+        batch_.insert(batch_.end(), std::make_move_iterator(pending_.begin()),
+                      std::make_move_iterator(pending_.end()));
+    }
+    pending_.clear();
+    carry_into_open_ = adjacent;
+
+    processBatch(open_sector_, leading, adjacent, tracks, results);
+}
+
+void SectorStreamProcessor::selectTracks(uint32_t sector, bool leading_seam, bool trailing_seam,
+                                         const std::vector<Track>& tracks, TimePoint time) {
+    selected_.clear();
+    owned_.clear();
+
+    const double center = (sector + 0.5) * sector_width_;
+    const double half_width = 0.5 * sector_width_;
+    const uint32_t previous = (sector + config_.num_sectors - 1) % config_.num_sectors;
+    for (uint32_t t = 0; t < tracks.size(); ++t) {
+        const Track& track = tracks[t];
+        const double dt = std::max(secondsBetween(track.valid_time, time), 0.0);
+        const double x = track.position.x + track.velocity.x * dt;
+        const double y = track.position.y + track.velocity.y * dt;
+        const double range = std::max(std::hypot(x, y), 1.0);
+
+        const double angle = rotationAngle(std::atan2(y, x));
+        double offset = std::fabs(angle - center);
+        offset = std::min(offset, TWO_PI - offset);
+        if (offset > half_width + config_.track_margin_m / range) {
+            continue;
+        }
+        // Owned: in the sector, less the band handed on, plus the band taken over
+        const auto track_sector = std::min(static_cast<uint32_t>(angle / sector_width_), config_.num_sectors - 1);
+        const double to_boundary = ((track_sector + 1) * sector_width_ - angle) * range;
+        bool owned = track_sector == sector;
+        if (owned && trailing_seam && to_boundary <= config_.seam_margin_m) {
+            owned = false;
+        } else if (track_sector == previous && leading_seam && to_boundary <= config_.seam_margin_m) {
+            owned = true;
+        }
+        selected_.push_back(t);
+        owned_.push_back(owned ? 1 : 0);
+    }
+}
+
+void SectorStreamProcessor::processBatch(uint32_t sector, bool leading_seam, bool trailing_seam,
+                                         std::vector<Track>& tracks, std::vector<SectorResult>& results) {
+    SectorResult result;
+    result.sector = sector;
+    result.sector_time = last_sector_time_;
+    for (const auto& detection : batch_) {
+        if (!have_last_time_ || detection.timestamp > result.sector_time) {
+            result.sector_time = detection.timestamp;
+            have_last_time_ = true;
+        }
+    }
+    const double dt = std::max(secondsBetween(last_sector_time_, result.sector_time), 0.0);
+    last_sector_time_ = result.sector_time;
+
+    selectTracks(sector, leading_seam, trailing_seam, tracks, result.sector_time);
+    sector_tracks_.resize(selected_.size());
+    for (size_t k = 0; k < selected_.size(); ++k) {
+        sector_tracks_[k] = std::move(tracks[selected_[k]]);
+    }
+
+    ScanResult scan = pipeline_->processScan(batch_, sector_tracks_, dt);
+
+    for (size_t k = 0; k < selected_.size(); ++k) {
+        tracks[selected_[k]] = std::move(sector_tracks_[k]);
+    }
+    batch_.clear();
+
+    // Back to full track indices; only wedge tracks can be missed
+    for (auto& association : scan.associations) {
+        association.first = selected_[association.first];
+    }
+    std::vector<uint32_t> unassigned;
+    for (uint32_t k : scan.unassigned_tracks) {
+        if (owned_[k]) {
+            unassigned.push_back(selected_[k]);
+        }
+    }
+    scan.unassigned_tracks.swap(unassigned);
+    for (auto& k : scan.deferred_tracks) {
+        k = selected_[k];
+    }
+    for (size_t k = 0; k < selected_.size(); ++k) {
+        if (owned_[k]) {
+            result.owned_tracks.push_back(selected_[k]);
+        }
+    }
+
+    result.scan = std::move(scan);
+    results.push_back(std::move(result));
+    ++sectors_processed_;
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,560 @@
+#include "processing/ShadowExecutor.hpp"
+#include "processing/DBSCANClustering.hpp"
+#include "processing/JPDAAssociation.hpp"
+#include "processing/MHTAssociation.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/eventfd.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace radar_tracking {
+
+namespace {
+
+constexpr uint64_t NO_CLUSTER = std::numeric_limits<uint64_t>::max();
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Copy the state estimate of a track, not its detection history
+ */
+void copyKinematics(const Track& from, Track& to) {
+    to.track_id = from.track_id;
+    to.position = from.position;
+    to.velocity = from.velocity;
+    to.acceleration = from.acceleration;
+    std::memcpy(to.covariance, from.covariance, sizeof(to.covariance));
+    to.confidence = from.confidence;
+    to.quality_score = from.quality_score;
+    to.state = from.state;
+    to.last_update = from.last_update;
+    to.valid_time = from.valid_time;
+    to.creation_time = from.creation_time;
+    to.consecutive_misses = from.consecutive_misses;
+    to.hit_count = from.hit_count;
+}
+
+uint64_t leadDetection(const Cluster& cluster) {
+    uint64_t lead = NO_CLUSTER;
+    for (const auto& detection : cluster.detections) {
+        lead = std::min(lead, detection.detection_id);
+    }
+    return lead;
+}
+
+/**
+ * @brief Per track, the lowest detection_id of the cluster it was assigned
+ * @return Number of assigned tracks
+ */
+uint32_t assignedLeads(const std::vector<Cluster>& clusters,
+                       const std::vector<std::pair<uint32_t, uint32_t>>& associations,
+                       size_t track_count, std::vector<uint64_t>& leads) {
+    leads.assign(track_count, NO_CLUSTER);
+    uint32_t assigned = 0;
+    for (const auto& [track_index, cluster_index] : associations) {
+        if (track_index < track_count && cluster_index < clusters.size() && leads[track_index] == NO_CLUSTER) {
+            leads[track_index] = leadDetection(clusters[cluster_index]);
+            ++assigned;
+        }
+    }
+    return assigned;
+}
+
+void addTo(std::atomic<double>& total, double value) {
+    total.store(total.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+void ShadowExecutor::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    enabled = node["enabled"].as<bool>(enabled);
+    if (node["clustering"]) {
+        clustering.type = node["clustering"]["type"].as<std::string>(clustering.type);
+        clustering.config_file = node["clustering"]["config_file"].as<std::string>(clustering.config_file);
+    }
+    if (node["association"]) {
+        association.type = node["association"]["type"].as<std::string>(association.type);
+        association.config_file = node["association"]["config_file"].as<std::string>(association.config_file);
+    }
+    sample_interval = node["sample_interval"].as<uint32_t>(sample_interval);
+    cpus = node["cpus"].as<std::vector<int>>(cpus);
+    idle_priority = node["idle_priority"].as<bool>(idle_priority);
+    nice = node["nice"].as<int>(nice);
+    history_size = node["history_size"].as<size_t>(history_size);
+    record_file = node["record_file"].as<std::string>(record_file);
+    log_interval_s = node["log_interval_s"].as<double>(log_interval_s);
+}
+
+bool ShadowExecutor::Config::validate() const {
+    if (sample_interval == 0 || history_size == 0) {
+        LOG_ERROR("ShadowExecutor: sample_interval and history_size must be positive");
+        return false;
+    }
+    if (nice < -20 || nice > 19) {
+        LOG_ERROR("ShadowExecutor: nice must be in [-20, 19]");
+        return false;
+    }
+    if (log_interval_s < 0.0) {
+        LOG_ERROR("ShadowExecutor: log_interval_s must not be negative");
+        return false;
+    }
+    return true;
+}
+
+ShadowExecutor::~ShadowExecutor() {
+    shutdown();
+}
+
+std::unique_ptr<IClusteringAlgorithm> ShadowExecutor::createClustering(const std::string& type) {
+    if (type == "DBSCAN") {
+        return createDBSCANClustering();
+    }
+    return nullptr;
+}
+
+std::unique_ptr<IAssociationAlgorithm> ShadowExecutor::createAssociation(const std::string& type) {
+    if (type == "JPDA") {
+        return createJPDAAssociation();
+    }
+    if (type == "MHT") {
+        return createMHTAssociation();
+    }
+    return nullptr;
+}
+
+bool ShadowExecutor::initialize(const std::string& config_file) {
+    try {
+        YAML::Node root = YAML::LoadFile(config_file);
+        Config config;
+        config.loadFromYaml(root["shadow"]);
+        return initialize(config);
+    } catch (const std::exception& e) {
+        LOG_ERROR("ShadowExecutor: failed to load configuration: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool ShadowExecutor::initialize(const Config& config) {
+    if (!config.enabled) {
+        return initialize(config, nullptr, nullptr);
+    }
+
+    std::unique_ptr<IClusteringAlgorithm> clustering;
+    if (!config.reusesPrimaryClusters()) {
+        clustering = createClustering(config.clustering.type);
+        if (!clustering || !clustering->initialize(config.clustering.config_file)) {
+            LOG_ERROR("ShadowExecutor: cannot create " + config.clustering.type + " clustering from " +
+                      config.clustering.config_file);
+            return false;
+        }
+    }
+    auto association = createAssociation(config.association.type);
+    if (!association || !association->initialize(config.association.config_file)) {
+        LOG_ERROR("ShadowExecutor: cannot create " + config.association.type + " association from " +
+                  config.association.config_file);
+        return false;
+    }
+    return initialize(config, std::move(clustering), std::move(association));
+}
+
+bool ShadowExecutor::initialize(const Config& config,
+                                std::unique_ptr<IClusteringAlgorithm> clustering,
+                                std::unique_ptr<IAssociationAlgorithm> association) {
+    if (!config.validate()) {
+        return false;
+    }
+    shutdown();
+    config_ = config;
+    if (!config_.enabled) {
+        return true;
+    }
+    if (!association || (!config_.reusesPrimaryClusters() && !clustering)) {
+        LOG_ERROR("ShadowExecutor: shadow chain needs a clustering and an association algorithm");
+        return false;
+    }
+    clustering_ = std::move(clustering);
+    association_ = std::move(association);
+
+    if (!config_.record_file.empty()) {
+        record_stream_.open(config_.record_file, std::ios::out | std::ios::app);
+        if (!record_stream_) {
+            LOG_ERROR("ShadowExecutor: cannot open " + config_.record_file);
+            return false;
+        }
+        if (record_stream_.tellp() == 0) {
+            record_stream_ << "scan,primary_ms,clustering_ms,association_ms,detections,tracks,primary_clusters,"
+                              "shadow_clusters,cluster_mismatches,primary_assignments,shadow_assignments,"
+                              "assignment_disagreements\n";
+        }
+    }
+
+#ifdef __linux__
+    wake_fd_ = ::eventfd(0, EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        LOG_ERROR("ShadowExecutor: eventfd failed: " + std::string(std::strerror(errno)));
+        return false;
+    }
+#endif
+
+    records_.clear();
+    records_.reserve(config_.history_size);
+    record_next_ = 0;
+    scan_counter_ = 0;
+    stopping_.store(false, std::memory_order_relaxed);
+    worker_ = std::thread(&ShadowExecutor::workerLoop, this);
+
+    LOG_INFO("ShadowExecutor: shadow chain " + config_.clustering.type + "+" + config_.association.type +
+             " every " + std::to_string(config_.sample_interval) + " scans" +
+             (config_.idle_priority ? ", idle priority" : ", nice " + std::to_string(config_.nice)));
+    return true;
+}
+
+void ShadowExecutor::shutdown() {
+    stopping_.store(true, std::memory_order_release);
+    if (worker_.joinable()) {
+        wake();
+        worker_.join();
+    }
+    if (wake_fd_ >= 0) {
+        ::close(wake_fd_);
+        wake_fd_ = -1;
+    }
+    job_.detections.reset();
+    job_.primary.reset();
+    primary_done_.store(false, std::memory_order_relaxed);
+    busy_.store(false, std::memory_order_relaxed);
+    awaiting_result_ = false;
+    if (record_stream_.is_open()) {
+        record_stream_.close();
+    }
+}
+
+bool ShadowExecutor::beginScan(std::shared_ptr<const std::vector<RadarDetection>> detections,
+                               const std::vector<Track>& tracks, double dt) {
+    if (!worker_.joinable() || !detections) {
+        return false;
+    }
+    if (awaiting_result_) {
+        completeScan(nullptr, 0.0);  // The previous scan never reported its result
+    }
+    if (scan_counter_++ % config_.sample_interval != 0) {
+        return false;
+    }
+    if (busy_.load(std::memory_order_acquire)) {
+        scans_skipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // The shadow thread does not touch job_ until busy_ is set
+    job_.scan = ++sampled_scans_;
+    job_.tracks.resize(tracks.size());
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        copyKinematics(tracks[i], job_.tracks[i]);
+    }
+    job_.detections = std::move(detections);
+    job_.dt = dt;
+    job_.primary.reset();
+    primary_done_.store(false, std::memory_order_relaxed);
+    busy_.store(true, std::memory_order_release);
+    wake();
+    awaiting_result_ = true;
+    return true;
+}
+
+void ShadowExecutor::completeScan(std::shared_ptr<const ScanResult> primary, double primary_ms) {
+    if (!awaiting_result_) {
+        return;
+    }
+    awaiting_result_ = false;
+    // The shadow thread reads these only after primary_done_, and keeps busy_ set until then
+    job_.primary = std::move(primary);
+    job_.primary_ms = primary_ms;
+    primary_done_.store(true, std::memory_order_release);
+    wake();
+}
+
+void ShadowExecutor::wake() {
+#ifdef __linux__
+    const uint64_t one = 1;
+    [[maybe_unused]] ssize_t written = ::write(wake_fd_, &one, sizeof(one));
+#endif
+}
+
+void ShadowExecutor::waitForWake() {
+#ifdef __linux__
+    // Wake-ups accumulate in the eventfd counter, so none is lost between a check and the read
+    uint64_t value;
+    [[maybe_unused]] ssize_t drained = ::read(wake_fd_, &value, sizeof(value));
+#else
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+}
+
+void ShadowExecutor::applyThreadPolicy() {
+#ifdef __linux__
+    if (!config_.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (const int cpu : config_.cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            LOG_WARN("ShadowExecutor: cannot pin the shadow thread to the configured cpus");
+        }
+    }
+    if (config_.idle_priority) {
+        sched_param param{};
+        if (pthread_setschedparam(pthread_self(), SCHED_IDLE, &param) != 0) {
+            LOG_WARN("ShadowExecutor: cannot set SCHED_IDLE for the shadow thread");
+        }
+    } else if (config_.nice != 0) {
+        // Linux applies a thread id to that thread only
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), config_.nice) != 0) {
+            LOG_WARN("ShadowExecutor: cannot set nice " + std::to_string(config_.nice) + " for the shadow thread");
+        }
+    }
+#endif
+}
+
+void ShadowExecutor::workerLoop() {
+    applyThreadPolicy();
+    const auto log_period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(config_.log_interval_s));
+    auto next_log = std::chrono::steady_clock::now() + log_period;
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        if (!busy_.load(std::memory_order_acquire)) {
+            waitForWake();
+            continue;
+        }
+        runScan(job_);
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+        job_.detections.reset();
+        job_.primary.reset();
+        busy_.store(false, std::memory_order_release);
+
+        if (config_.log_interval_s > 0.0 && std::chrono::steady_clock::now() >= next_log) {
+            next_log = std::chrono::steady_clock::now() + log_period;
+            logSummary();
+        }
+    }
+}
+
+void ShadowExecutor::runScan(Job& job) {
+    // Shadow clustering overlaps the primary scan
+    ScanRecord record;
+    record.scan = job.scan;
+    record.detections = static_cast<uint32_t>(job.detections->size());
+    record.tracks = static_cast<uint32_t>(job.tracks.size());
+    bool ok = true;
+    try {
+        if (!config_.reusesPrimaryClusters()) {
+            const auto start = std::chrono::steady_clock::now();
+            clusters_ = clustering_->cluster(*job.detections);
+            record.clustering_ms = millisecondsSince(start);
+        }
+        predictTracks(job.tracks, job.dt);
+    } catch (const std::exception& e) {
+        ok = false;
+        LOG_WARN("ShadowExecutor: shadow clustering failed: " + std::string(e.what()));
+    }
+
+    while (!primary_done_.load(std::memory_order_acquire)) {
+        if (stopping_.load(std::memory_order_acquire)) {
+            return;
+        }
+        waitForWake();
+    }
+    const std::shared_ptr<const ScanResult> primary = job.primary;
+    record.primary_ms = job.primary_ms;
+
+    const std::vector<Cluster>& shadow_clusters = config_.reusesPrimaryClusters() && primary ? primary->clusters : clusters_;
+    if (ok && primary) {
+        try {
+            const auto start = std::chrono::steady_clock::now();
+            associations_ = association_->associate(job.tracks, shadow_clusters);
+            record.association_ms = millisecondsSince(start);
+        } catch (const std::exception& e) {
+            ok = false;
+            LOG_WARN("ShadowExecutor: shadow association failed: " + std::string(e.what()));
+        }
+    }
+
+    if (ok && primary) {
+        compare(*primary, shadow_clusters, record);
+        addRecord(record);
+    } else {
+        scans_failed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ShadowExecutor::predictTracks(std::vector<Track>& tracks, double dt) const {
+    if (dt <= 0.0) {
+        return;
+    }
+    // Constant velocity: x' = F x, P' = F P F^T with F = [I dt*I 0; 0 I 0; 0 0 I]
+    for (auto& track : tracks) {
+        track.position = track.position + track.velocity * dt;
+        auto& P = track.covariance;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 9; ++j) {
+                P[i][j] += dt * P[i + 3][j];
+            }
+        }
+        for (int i = 0; i < 9; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                P[i][j] += dt * P[i][j + 3];
+            }
+        }
+    }
+}
+
+void ShadowExecutor::compare(const ScanResult& primary, const std::vector<Cluster>& shadow_clusters,
+                             ScanRecord& record) {
+    const auto& primary_clusters = primary.clusters;
+    record.primary_clusters = static_cast<uint32_t>(primary_clusters.size());
+    record.shadow_clusters = static_cast<uint32_t>(shadow_clusters.size());
+
+    // Clusters holding exactly the same detections in both chains
+    uint32_t matched = 0;
+    if (&shadow_clusters == &primary_clusters) {
+        matched = record.primary_clusters;
+    } else {
+        primary_cluster_of_.clear();
+        for (uint32_t p = 0; p < primary_clusters.size(); ++p) {
+            for (const auto& detection : primary_clusters[p].detections) {
+                primary_cluster_of_[detection.detection_id] = p;
+            }
+        }
+        for (const auto& cluster : shadow_clusters) {
+            if (cluster.detections.empty()) {
+                continue;
+            }
+            const auto it = primary_cluster_of_.find(cluster.detections.front().detection_id);
+            if (it == primary_cluster_of_.end() ||
+                primary_clusters[it->second].detections.size() != cluster.detections.size()) {
+                continue;
+            }
+            const uint32_t p = it->second;
+            const bool same = std::all_of(cluster.detections.begin(), cluster.detections.end(),
+                                          [this, p](const RadarDetection& detection) {
+                                              const auto found = primary_cluster_of_.find(detection.detection_id);
+                                              return found != primary_cluster_of_.end() && found->second == p;
+                                          });
+            matched += same ? 1 : 0;
+        }
+    }
+    record.cluster_mismatches = (record.primary_clusters - matched) + (record.shadow_clusters - matched);
+
+    // Tracks assigned to different clusters, or assigned in one chain only
+    record.primary_assignments = assignedLeads(primary_clusters, primary.associations, record.tracks, primary_lead_);
+    record.shadow_assignments = assignedLeads(shadow_clusters, associations_, record.tracks, shadow_lead_);
+    uint64_t compared = 0;
+    for (size_t t = 0; t < record.tracks; ++t) {
+        if (primary_lead_[t] == NO_CLUSTER && shadow_lead_[t] == NO_CLUSTER) {
+            continue;
+        }
+        ++compared;
+        record.assignment_disagreements += primary_lead_[t] != shadow_lead_[t] ? 1 : 0;
+    }
+    assignments_compared_.fetch_add(compared, std::memory_order_relaxed);
+}
+
+void ShadowExecutor::addRecord(const ScanRecord& record) {
+    const double shadow_ms = record.clustering_ms + record.association_ms;
+    scans_compared_.fetch_add(1, std::memory_order_relaxed);
+    addTo(primary_ms_total_, record.primary_ms);
+    addTo(shadow_ms_total_, shadow_ms);
+    if (shadow_ms > max_shadow_ms_.load(std::memory_order_relaxed)) {
+        max_shadow_ms_.store(shadow_ms, std::memory_order_relaxed);
+    }
+    cluster_count_diff_total_.fetch_add(
+        static_cast<uint64_t>(std::abs(static_cast<int64_t>(record.shadow_clusters) - record.primary_clusters)),
+        std::memory_order_relaxed);
+    cluster_mismatches_.fetch_add(record.cluster_mismatches, std::memory_order_relaxed);
+    assignment_disagreements_.fetch_add(record.assignment_disagreements, std::memory_order_relaxed);
+
+    if (record_stream_.is_open()) {
+        record_stream_ << record.scan << ',' << record.primary_ms << ',' << record.clustering_ms << ','
+                       << record.association_ms << ',' << record.detections << ',' << record.tracks << ','
+                       << record.primary_clusters << ',' << record.shadow_clusters << ','
+                       << record.cluster_mismatches << ',' << record.primary_assignments << ','
+                       << record.shadow_assignments << ',' << record.assignment_disagreements << '\n';
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (records_.size() < config_.history_size) {
+        records_.push_back(record);
+    } else {
+        records_[record_next_] = record;
+    }
+    record_next_ = (record_next_ + 1) % config_.history_size;
+}
+
+std::vector<ShadowExecutor::ScanRecord> ShadowExecutor::getRecords() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (records_.size() < config_.history_size) {
+        return records_;
+    }
+    std::vector<ScanRecord> ordered(records_.begin() + static_cast<std::ptrdiff_t>(record_next_), records_.end());
+    ordered.insert(ordered.end(), records_.begin(), records_.begin() + static_cast<std::ptrdiff_t>(record_next_));
+    return ordered;
+}
+
+ShadowExecutor::Stats ShadowExecutor::getStats() const {
+    Stats stats;
+    stats.scans_compared = scans_compared_.load(std::memory_order_relaxed);
+    stats.scans_skipped = scans_skipped_.load(std::memory_order_relaxed);
+    stats.scans_failed = scans_failed_.load(std::memory_order_relaxed);
+    if (stats.scans_compared > 0) {
+        const double scans = static_cast<double>(stats.scans_compared);
+        stats.mean_primary_ms = primary_ms_total_.load(std::memory_order_relaxed) / scans;
+        stats.mean_shadow_ms = shadow_ms_total_.load(std::memory_order_relaxed) / scans;
+        stats.mean_cluster_count_diff = cluster_count_diff_total_.load(std::memory_order_relaxed) / scans;
+    }
+    stats.max_shadow_ms = max_shadow_ms_.load(std::memory_order_relaxed);
+    stats.cluster_mismatches = cluster_mismatches_.load(std::memory_order_relaxed);
+    stats.assignments_compared = assignments_compared_.load(std::memory_order_relaxed);
+    stats.assignment_disagreements = assignment_disagreements_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ShadowExecutor::logSummary() const {
+    const Stats stats = getStats();
+    if (stats.scans_compared == 0) {
+        return;
+    }
+    const double disagreement = stats.assignments_compared > 0
+                                    ? 100.0 * stats.assignment_disagreements / stats.assignments_compared
+                                    : 0.0;
+    LOG_INFO("ShadowExecutor: " + std::to_string(stats.scans_compared) + " scans compared, " +
+             std::to_string(stats.scans_skipped) + " skipped; primary " + std::to_string(stats.mean_primary_ms) +
+             " ms, shadow " + std::to_string(stats.mean_shadow_ms) + " ms (max " +
+             std::to_string(stats.max_shadow_ms) + "); cluster count diff " +
+             std::to_string(stats.mean_cluster_count_diff) + "/scan, assignment disagreement " +
+             std::to_string(disagreement) + "%");
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,583 @@
+#include "processing/TrackFusionEngine.hpp"
+#include "utils/Logger.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace radar_tracking {
+
+using namespace recording;
+
+namespace {
+
+constexpr uint32_t MAX_FRAME_PAYLOAD = 64u << 20;
+
+enum Outcome : uint8_t {
+    OUTCOME_CI = 0,
+    OUTCOME_INFORMATION = 1,
+    OUTCOME_FALLBACK = 2,
+    OUTCOME_SKIPPED = 3
+};
+
+uint64_t remoteKey(uint32_t source, uint32_t track_id) {
+    return (static_cast<uint64_t>(source) << 32) | track_id;
+}
+
+double seconds(int64_t ns) {
+    return static_cast<double>(ns) * 1e-9;
+}
+
+void packUpper(const double (&covariance)[9][9], double* P) {
+    int k = 0;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = i; j < 6; ++j) {
+            P[k++] = covariance[i][j];
+        }
+    }
+}
+
+}  // namespace
+
+TrackFusionEngine::Method TrackFusionEngine::parseMethod(const std::string& method) {
+    if (method == "information") return Method::INFORMATION;
+    return Method::COVARIANCE_INTERSECTION;
+}
+
+void TrackFusionEngine::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    if (node["method"]) {
+        method = parseMethod(node["method"].as<std::string>());
+    }
+    gate_chi2 = node["gate_chi2"].as<double>(gate_chi2);
+    process_noise = node["process_noise"].as<double>(process_noise);
+    max_age_s = node["max_age_s"].as<double>(max_age_s);
+    ci_iterations = node["ci_iterations"].as<int>(ci_iterations);
+    include_remote_only = node["include_remote_only"].as<bool>(include_remote_only);
+    remote_id_base = node["remote_id_base"].as<uint32_t>(remote_id_base);
+    cell_size_m = node["cell_size_m"].as<double>(cell_size_m);
+    chunk_size = node["chunk_size"].as<size_t>(chunk_size);
+    parallel_min_pairs = node["parallel_min_pairs"].as<size_t>(parallel_min_pairs);
+}
+
+bool TrackFusionEngine::Config::validate() const {
+    if (gate_chi2 <= 0.0 || process_noise < 0.0 || max_age_s <= 0.0) {
+        LOG_ERROR("TrackFusionEngine: gate_chi2 and max_age_s must be positive, process_noise non-negative");
+        return false;
+    }
+    if (ci_iterations < 1 || ci_iterations > 64) {
+        LOG_ERROR("TrackFusionEngine: ci_iterations must be in [1, 64]");
+        return false;
+    }
+    if (cell_size_m <= 0.0 || chunk_size == 0) {
+        LOG_ERROR("TrackFusionEngine: cell_size_m and chunk_size must be positive");
+        return false;
+    }
+    return true;
+}
+
+TrackFusionEngine::TrackFusionEngine(const Config& config) {
+    setConfig(config);
+}
+
+void TrackFusionEngine::setConfig(const Config& config) {
+    config_ = config;
+    TrackSpatialIndex::Config index_config;
+    index_config.cell_size_m = config_.cell_size_m;
+    index_.setConfig(index_config);
+}
+
+void TrackFusionEngine::ingest(uint32_t source, const std::vector<Track>& tracks) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    for (const Track& track : tracks) {
+        RemoteUpdate update;
+        update.source = source;
+        update.track_id = track.track_id;
+        update.state = static_cast<uint8_t>(track.state);
+        update.time_ns = toNanoseconds(track.valid_time);
+        const double x[6] = {track.position.x, track.position.y, track.position.z,
+                             track.velocity.x, track.velocity.y, track.velocity.z};
+        std::memcpy(update.x, x, sizeof(x));
+        packUpper(track.covariance, update.P);
+        pending_.push_back(update);
+    }
+}
+
+size_t TrackFusionEngine::ingestBytes(uint32_t source, const uint8_t* data, size_t size) {
+    // Decodes back-to-back frames from [data, data + size); returns the bytes consumed
+    size_t queued = 0;
+    auto decode = [&](const uint8_t* bytes, size_t length) -> size_t {
+        size_t offset = 0;
+        while (length - offset >= sizeof(FrameHeader)) {
+            FrameHeader header;
+            std::memcpy(&header, bytes + offset, sizeof(header));
+            if (header.magic != FRAME_MAGIC || header.payload_size > MAX_FRAME_PAYLOAD) {
+                // Lost framing: skip to the next frame magic
+                ++pending_rejected_;
+                const uint32_t magic = FRAME_MAGIC;
+                const uint8_t* next = std::search(bytes + offset + 1, bytes + length,
+                                                  reinterpret_cast<const uint8_t*>(&magic),
+                                                  reinterpret_cast<const uint8_t*>(&magic) + sizeof(magic));
+                offset = static_cast<size_t>(next - bytes);
+                continue;
+            }
+            if (length - offset - sizeof(header) < header.payload_size) {
+                break;
+            }
+
+            const uint8_t* payload = bytes + offset + sizeof(header);
+            offset += sizeof(header) + header.payload_size;
+            if (header.type != RecordType::TRACKS) {
+                continue;
+            }
+            uint32_t count = 0;
+            if (header.flags != FRAME_FLAG_NONE || header.payload_size < sizeof(count)) {
+                ++pending_rejected_;
+                continue;
+            }
+            std::memcpy(&count, payload, sizeof(count));
+            if (sizeof(count) + static_cast<size_t>(count) * sizeof(TrackRecord) != header.payload_size) {
+                ++pending_rejected_;
+                continue;
+            }
+            for (uint32_t i = 0; i < count; ++i) {
+                TrackRecord record;
+                std::memcpy(&record, payload + sizeof(count) + i * sizeof(TrackRecord), sizeof(record));
+                RemoteUpdate update;
+                update.source = source;
+                update.track_id = record.track_id;
+                update.state = record.state;
+                update.time_ns = record.last_update_ns;
+                const double x[6] = {record.position[0], record.position[1], record.position[2],
+                                     record.velocity[0], record.velocity[1], record.velocity[2]};
+                std::memcpy(update.x, x, sizeof(x));
+                int k = 0;
+                for (int r = 0; r < 6; ++r) {
+                    for (int c = r; c < 6; ++c) {
+                        update.P[k++] = record.covariance[r][c];  // Packed record: read element-wise
+                    }
+                }
+                pending_.push_back(update);
+            }
+            queued += count;
+        }
+        return offset;
+    };
+
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    auto partial = partial_.find(source);
+    if (partial == partial_.end() || partial->second.empty()) {
+        // Common case: whole frames, decoded in place
+        const size_t consumed = decode(data, size);
+        if (consumed < size) {
+            partial_[source].assign(data + consumed, data + size);
+        }
+        return queued;
+    }
+    std::vector<uint8_t>& buffer = partial->second;
+    buffer.insert(buffer.end(), data, data + size);
+    buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(decode(buffer.data(), buffer.size())));
+    return queued;
+}
+
+void TrackFusionEngine::removeSource(uint32_t source) {
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        partial_.erase(source);
+        pending_.erase(std::remove_if(pending_.begin(), pending_.end(),
+                                      [source](const RemoteUpdate& u) { return u.source == source; }),
+                       pending_.end());
+    }
+    for (size_t slot = remotes_.size(); slot-- > 0;) {
+        if (remotes_[slot].source == source) {
+            eraseRemote(static_cast<uint32_t>(slot));
+        }
+    }
+}
+
+void TrackFusionEngine::eraseRemote(uint32_t slot) {
+    const uint32_t last = static_cast<uint32_t>(remotes_.size() - 1);
+    remote_index_.erase(remoteKey(remotes_[slot].source, remotes_[slot].track_id));
+    if (slot != last) {
+        remotes_[slot] = remotes_[last];
+        remote_x_[slot] = remote_x_[last];
+        remote_P_[slot] = remote_P_[last];
+        previous_x_[slot] = previous_x_[last];
+        previous_P_[slot] = previous_P_[last];
+        remote_index_[remoteKey(remotes_[slot].source, remotes_[slot].track_id)] = slot;
+    }
+    remotes_.pop_back();
+    remote_x_.pop_back();
+    remote_P_.pop_back();
+    previous_x_.pop_back();
+    previous_P_.pop_back();
+}
+
+void TrackFusionEngine::applyPending(int64_t now_ns) {
+    std::vector<RemoteUpdate> updates;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        updates.swap(pending_);
+        stats_.rejected_frames += pending_rejected_;
+        pending_rejected_ = 0;
+    }
+    stats_.remote_updates += updates.size();
+
+    for (const RemoteUpdate& update : updates) {
+        const uint64_t key = remoteKey(update.source, update.track_id);
+        auto it = remote_index_.find(key);
+        const auto state = static_cast<TrackState>(update.state);
+        if (state == TrackState::TERMINATED) {
+            if (it != remote_index_.end()) {
+                eraseRemote(it->second);
+            }
+            continue;
+        }
+
+        uint32_t slot;
+        if (it == remote_index_.end()) {
+            slot = static_cast<uint32_t>(remotes_.size());
+            remote_index_.emplace(key, slot);
+            Remote remote;
+            remote.source = update.source;
+            remote.track_id = update.track_id;
+            remotes_.push_back(remote);
+            remote_x_.emplace_back();
+            remote_P_.emplace_back();
+            previous_x_.emplace_back();
+            previous_P_.emplace_back();
+        } else {
+            slot = it->second;
+            if (update.time_ns < remotes_[slot].time_ns) {
+                continue;  // Reordered in transit; keep the newer estimate
+            }
+        }
+
+        Remote& remote = remotes_[slot];
+        remote.state = state;
+        remote.time_ns = update.time_ns;
+        remote_x_[slot] = Eigen::Map<const Vector6>(update.x);
+        int k = 0;
+        for (int i = 0; i < 6; ++i) {
+            for (int j = i; j < 6; ++j) {
+                remote_P_[slot](i, j) = remote_P_[slot](j, i) = update.P[k++];
+            }
+        }
+    }
+
+    const int64_t max_age_ns = static_cast<int64_t>(config_.max_age_s * 1e9);
+    for (size_t slot = remotes_.size(); slot-- > 0;) {
+        if (now_ns - remotes_[slot].time_ns > max_age_ns) {
+            eraseRemote(static_cast<uint32_t>(slot));
+        }
+    }
+}
+
+void TrackFusionEngine::predict(Vector6& x, Matrix6& P, double dt) const {
+    if (dt == 0.0) {
+        return;
+    }
+    Matrix6 F = Matrix6::Identity();
+    F.block<3, 3>(0, 3).diagonal().setConstant(dt);
+    x = F * x;
+    P = F * P * F.transpose();
+
+    // White-noise acceleration over |dt|, so a remote estimate slightly ahead of now is still widened
+    const double t = std::abs(dt);
+    const double q = config_.process_noise;
+    for (int i = 0; i < 3; ++i) {
+        P(i, i) += 0.25 * t * t * t * t * q;
+        P(i, i + 3) += 0.5 * t * t * dt * q;
+        P(i + 3, i) += 0.5 * t * t * dt * q;
+        P(i + 3, i + 3) += t * t * q;
+    }
+}
+
+void TrackFusionEngine::store(const Vector6& x, const Matrix6& P, Track& track) {
+    track.position = Point3D(x(0), x(1), x(2));
+    track.velocity = Point3D(x(3), x(4), x(5));
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            track.covariance[i][j] = P(i, j);
+        }
+        // The fused kinematic block no longer matches the old acceleration cross terms
+        for (int j = 6; j < 9; ++j) {
+            track.covariance[i][j] = track.covariance[j][i] = 0.0;
+        }
+    }
+}
+
+void TrackFusionEngine::alignStates(const std::vector<Track>& local, int64_t now_ns) {
+    local_x_.resize(local.size());
+    local_P_.resize(local.size());
+    forChunks(local.size(), [this, &local, now_ns](size_t begin, size_t end) {
+        for (size_t l = begin; l < end; ++l) {
+            const Track& track = local[l];
+            local_x_[l] << track.position.x, track.position.y, track.position.z,
+                           track.velocity.x, track.velocity.y, track.velocity.z;
+            for (int i = 0; i < 6; ++i) {
+                for (int j = 0; j < 6; ++j) {
+                    local_P_[l](i, j) = track.covariance[i][j];
+                }
+            }
+            predict(local_x_[l], local_P_[l], seconds(now_ns - toNanoseconds(track.valid_time)));
+        }
+    });
+
+    aligned_remote_x_.resize(remotes_.size());
+    aligned_remote_P_.resize(remotes_.size());
+    forChunks(remotes_.size(), [this, now_ns](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            aligned_remote_x_[r] = remote_x_[r];
+            aligned_remote_P_[r] = remote_P_[r];
+            predict(aligned_remote_x_[r], aligned_remote_P_[r], seconds(now_ns - remotes_[r].time_ns));
+        }
+    });
+}
+
+void TrackFusionEngine::findPairs(const std::vector<Track>& local) {
+    pairs_.clear();
+    if (local.empty() || remotes_.empty()) {
+        return;
+    }
+
+    // Gate boxes padded by the largest remote variance per axis: a superset of every pair's gate
+    double remote_variance[3] = {0.0, 0.0, 0.0};
+    for (const Matrix6& P : aligned_remote_P_) {
+        for (int axis = 0; axis < 3; ++axis) {
+            remote_variance[axis] = std::max(remote_variance[axis], P(axis, axis));
+        }
+    }
+    boxes_.resize(local.size());
+    for (size_t l = 0; l < local.size(); ++l) {
+        double half[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            half[axis] = std::sqrt(config_.gate_chi2 * std::max(0.0, local_P_[l](axis, axis) + remote_variance[axis]));
+        }
+        const Vector6& x = local_x_[l];
+        boxes_[l] = {x(0) - half[0], x(1) - half[1], x(2) - half[2], x(0) + half[0], x(1) + half[1], x(2) + half[2]};
+    }
+    index_.build(boxes_);
+
+    for (uint32_t r = 0; r < remotes_.size(); ++r) {
+        const Vector6& x = aligned_remote_x_[r];
+        index_.query(Point3D(x(0), x(1), x(2)), candidates_);
+        for (uint32_t l : candidates_) {
+            pairs_.push_back({r, l, 0.0, remotes_[r].local_id != 0 && remotes_[r].local_id == local[l].track_id});
+        }
+    }
+    stats_.gate_tests += pairs_.size();
+
+    forChunks(pairs_.size(), [this](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            Pair& pair = pairs_[p];
+            const Vector6 d = aligned_remote_x_[pair.remote] - local_x_[pair.local];
+            const Eigen::LLT<Matrix6> llt(aligned_remote_P_[pair.remote] + local_P_[pair.local]);
+            pair.distance2 = llt.info() == Eigen::Success ? d.dot(llt.solve(d))
+                                                          : std::numeric_limits<double>::infinity();
+        }
+    });
+    pairs_.erase(std::remove_if(pairs_.begin(), pairs_.end(),
+                                [this](const Pair& pair) { return !(pair.distance2 <= config_.gate_chi2); }),
+                 pairs_.end());
+}
+
+void TrackFusionEngine::assign(const std::vector<Track>& local) {
+    // Keep established associations, then the closest pairs first
+    std::sort(pairs_.begin(), pairs_.end(), [](const Pair& a, const Pair& b) {
+        if (a.kept != b.kept) {
+            return a.kept;
+        }
+        return a.distance2 < b.distance2;
+    });
+
+    remote_match_.assign(remotes_.size(), -1);
+    local_sources_.clear();
+    for (const Pair& pair : pairs_) {
+        if (remote_match_[pair.remote] >= 0 ||
+            !local_sources_.insert((static_cast<uint64_t>(pair.local) << 32) | remotes_[pair.remote].source).second) {
+            continue;
+        }
+        remote_match_[pair.remote] = static_cast<int32_t>(pair.local);
+    }
+
+    // Group matched remotes by local track (counting sort)
+    local_start_.assign(local.size() + 1, 0);
+    for (uint32_t r = 0; r < remotes_.size(); ++r) {
+        Remote& remote = remotes_[r];
+        const int32_t l = remote_match_[r];
+        const uint32_t local_id = l >= 0 ? local[l].track_id : 0;
+        if (l >= 0) {
+            ++local_start_[l + 1];
+            ++stats_.associations;
+            if (remote.local_id != local_id) {
+                ++stats_.new_associations;
+            }
+        }
+        if (remote.local_id != local_id) {
+            remote.has_previous = false;  // Its earlier information went into another track
+        }
+        remote.local_id = local_id;
+    }
+    for (size_t l = 0; l < local.size(); ++l) {
+        local_start_[l + 1] += local_start_[l];
+    }
+    local_order_.resize(local_start_.back());
+    matched_locals_.clear();
+    std::vector<uint32_t>& cursor = candidates_;
+    cursor.assign(local_start_.begin(), local_start_.end() - 1);
+    for (uint32_t r = 0; r < remotes_.size(); ++r) {
+        if (remote_match_[r] >= 0) {
+            local_order_[cursor[remote_match_[r]]++] = r;
+        }
+    }
+    for (uint32_t l = 0; l < local.size(); ++l) {
+        if (local_start_[l + 1] > local_start_[l]) {
+            matched_locals_.push_back(l);
+        }
+    }
+}
+
+void TrackFusionEngine::fusePairs(const std::vector<Track>& local, int64_t now_ns) {
+    fused_x_.resize(local_x_.size());
+    fused_P_.resize(local_P_.size());
+    outcome_.resize(remotes_.size());
+    const bool information = config_.method == Method::INFORMATION;
+    if (information) {
+        next_history_.resize(matched_locals_.size());
+    }
+
+    // Each task owns whole local tracks, fusing their remotes in sequence
+    forChunks(matched_locals_.size(), [this, &local, information, now_ns](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            const uint32_t l = matched_locals_[m];
+            Vector6 x = local_x_[l];
+            Matrix6 P = local_P_[l];
+            Vector6 fused_x;
+            Matrix6 fused_P;
+
+            // Continue the fused track with the local tracker's new information
+            bool incremental = false;
+            auto history = information ? history_index_.find(local[l].track_id) : history_index_.end();
+            if (history != history_index_.end()) {
+                const History& h = history_[history->second];
+                const double dt = seconds(now_ns - h.time_ns);
+                Vector6 fx = h.x, lx = h.local_x;
+                Matrix6 fP = h.P, lP = h.local_P;
+                predict(fx, fP, dt);
+                predict(lx, lP, dt);
+                incremental = fusion::informationFusion<6>(fx, fP, local_x_[l], local_P_[l], lx, lP, fused_x, fused_P);
+                if (incremental) {
+                    x = fused_x;
+                    P = 0.5 * (fused_P + fused_P.transpose());
+                }
+            }
+
+            for (uint32_t k = local_start_[l]; k < local_start_[l + 1]; ++k) {
+                const uint32_t r = local_order_[k];
+                const Remote& remote = remotes_[r];
+                outcome_[r] = OUTCOME_CI;
+                if (remote.has_previous) {
+                    if (incremental) {
+                        Vector6 b0 = previous_x_[r];
+                        Matrix6 B0 = previous_P_[r];
+                        predict(b0, B0, seconds(now_ns - remote.previous_time_ns));
+                        outcome_[r] = fusion::informationFusion<6>(x, P, aligned_remote_x_[r], aligned_remote_P_[r],
+                                                                    b0, B0, fused_x, fused_P)
+                                          ? OUTCOME_INFORMATION : OUTCOME_FALLBACK;
+                    } else if (information) {
+                        outcome_[r] = OUTCOME_FALLBACK;
+                    }
+                }
+                if (outcome_[r] != OUTCOME_INFORMATION &&
+                    !fusion::covarianceIntersection<6>(x, P, aligned_remote_x_[r], aligned_remote_P_[r],
+                                                       config_.ci_iterations, fused_x, fused_P)) {
+                    outcome_[r] = OUTCOME_SKIPPED;  // Not positive definite; leave this remote out
+                    continue;
+                }
+                x = fused_x;
+                P = 0.5 * (fused_P + fused_P.transpose());
+            }
+            fused_x_[l] = x;
+            fused_P_[l] = P;
+
+            if (information) {
+                History& next = next_history_[m];
+                next.local_id = local[l].track_id;
+                next.time_ns = now_ns;
+                next.x = x;
+                next.P = P;
+                next.local_x = local_x_[l];
+                next.local_P = local_P_[l];
+            }
+        }
+    });
+
+    for (uint32_t r = 0; r < remotes_.size(); ++r) {
+        if (remote_match_[r] < 0) {
+            continue;
+        }
+        stats_.information_fusions += outcome_[r] == OUTCOME_INFORMATION;
+        stats_.information_fallbacks += outcome_[r] == OUTCOME_FALLBACK;
+        Remote& remote = remotes_[r];
+        remote.has_previous = outcome_[r] != OUTCOME_SKIPPED;
+        previous_x_[r] = aligned_remote_x_[r];
+        previous_P_[r] = aligned_remote_P_[r];
+        remote.previous_time_ns = now_ns;
+    }
+
+    // Fused tracks of local tracks not fused this time are restarted on their next association
+    history_.swap(next_history_);
+    history_index_.clear();
+    for (uint32_t slot = 0; slot < history_.size(); ++slot) {
+        history_index_.emplace(history_[slot].local_id, slot);
+    }
+}
+
+void TrackFusionEngine::buildOutput(const std::vector<Track>& local, TimePoint now) {
+    output_.assign(local.begin(), local.end());
+    for (uint32_t l : matched_locals_) {
+        store(fused_x_[l], fused_P_[l], output_[l]);
+        output_[l].valid_time = now;
+    }
+
+    if (!config_.include_remote_only) {
+        return;
+    }
+    for (uint32_t r = 0; r < remotes_.size(); ++r) {
+        Remote& remote = remotes_[r];
+        if (remote_match_[r] >= 0 || remote.state != TrackState::CONFIRMED) {
+            continue;
+        }
+        if (remote.output_id == 0) {
+            remote.output_id = config_.remote_id_base + next_output_id_++;
+        }
+        Track track;
+        track.track_id = remote.output_id;
+        track.state = remote.state;
+        track.last_update = fromNanoseconds(remote.time_ns);
+        track.valid_time = now;
+        store(aligned_remote_x_[r], aligned_remote_P_[r], track);
+        output_.push_back(std::move(track));
+        ++stats_.remote_only;
+    }
+}
+
+const std::vector<Track>& TrackFusionEngine::fuse(const std::vector<Track>& local, TimePoint now) {
+    const auto start = std::chrono::steady_clock::now();
+    const int64_t now_ns = toNanoseconds(now);
+
+    applyPending(now_ns);
+    alignStates(local, now_ns);
+    findPairs(local);
+    assign(local);
+    fusePairs(local, now_ns);
+    buildOutput(local, now);
+
+    ++stats_.fusions;
+    stats_.remote_tracks = remotes_.size();
+    stats_.last_fuse_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return output_;
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,111 @@
+#include "processing/TrackSpatialIndex.hpp"
+#include <algorithm>
+
+namespace radar_tracking {
+
+void TrackSpatialIndex::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    enabled = node["enabled"].as<bool>(enabled);
+    cell_size_m = node["cell_size_m"].as<double>(cell_size_m);
+    min_tracks = node["min_tracks"].as<size_t>(min_tracks);
+    max_cells_per_track = node["max_cells_per_track"].as<size_t>(max_cells_per_track);
+    measurement_variance = node["measurement_variance"].as<double>(measurement_variance);
+}
+
+TrackSpatialIndex::TrackSpatialIndex(const Config& config) {
+    setConfig(config);
+}
+
+void TrackSpatialIndex::setConfig(const Config& config) {
+    config_ = config;
+    inv_cell_size_ = 1.0 / std::max(config_.cell_size_m, 1.0);
+}
+
+TrackSpatialIndex::Box TrackSpatialIndex::gateBox(const GatingContext& gating, size_t track) {
+    const Point3D center = gating.getPredictedPosition(track);
+    const Point3D half = gating.getGateHalfExtents(track);
+    return Box{center.x - half.x, center.y - half.y, center.z - half.z,
+               center.x + half.x, center.y + half.y, center.z + half.z};
+}
+
+void TrackSpatialIndex::build(const GatingContext& gating) {
+    boxes_.resize(gating.getTrackCount());
+    for (size_t t = 0; t < boxes_.size(); ++t) {
+        if (gating.isValid(t)) {
+            boxes_[t] = gateBox(gating, t);
+        } else {
+            // Unfactorizable gates never match; keep them out of the grid
+            boxes_[t] = Box{1.0, 1.0, 1.0, -1.0, -1.0, -1.0};
+        }
+    }
+    build(boxes_);
+}
+
+void TrackSpatialIndex::build(const std::vector<Box>& boxes) {
+    if (&boxes != &boxes_) {
+        boxes_ = boxes;
+    }
+
+    entries_.clear();
+    always_check_.clear();
+
+    for (uint32_t t = 0; t < boxes_.size(); ++t) {
+        if (boxes_[t].min_x > boxes_[t].max_x) {
+            continue;
+        }
+        insertEntries(t, boxes_[t]);
+    }
+    std::sort(entries_.begin(), entries_.end());
+}
+
+void TrackSpatialIndex::query(const Point3D& point, std::vector<uint32_t>& tracks) const {
+    tracks.clear();
+
+    const uint64_t key = cellKey(cellCoord(point.x), cellCoord(point.y));
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), Entry{key, 0});
+    for (; it != entries_.end() && it->cell == key; ++it) {
+        if (boxes_[it->track].contains(point)) {
+            tracks.push_back(it->track);
+        }
+    }
+    for (uint32_t track : always_check_) {
+        if (boxes_[track].contains(point)) {
+            tracks.push_back(track);
+        }
+    }
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> TrackSpatialIndex::candidatePairs(
+    const std::vector<Cluster>& clusters) const {
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    std::vector<uint32_t> tracks;
+
+    for (uint32_t c = 0; c < clusters.size(); ++c) {
+        query(clusters[c].centroid, tracks);
+        for (uint32_t t : tracks) {
+            pairs.emplace_back(t, c);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+void TrackSpatialIndex::insertEntries(uint32_t track, const Box& box) {
+    const int64_t x0 = cellCoord(box.min_x), x1 = cellCoord(box.max_x);
+    const int64_t y0 = cellCoord(box.min_y), y1 = cellCoord(box.max_y);
+    const uint64_t cells = static_cast<uint64_t>(x1 - x0 + 1) * static_cast<uint64_t>(y1 - y0 + 1);
+
+    if (cells > config_.max_cells_per_track) {
+        always_check_.push_back(track);
+        return;
+    }
+    for (int64_t ix = x0; ix <= x1; ++ix) {
+        for (int64_t iy = y0; iy <= y1; ++iy) {
+            entries_.push_back(Entry{cellKey(ix, iy), track});
+        }
+    }
+}
+
+}  // namespace radar_tracking
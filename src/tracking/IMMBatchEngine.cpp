@@ -0,0 +1,398 @@
+#include "tracking/IMMBatchEngine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace radar_tracking {
+
+namespace {
+constexpr int CV = IMMKernel::CV;
+constexpr int CA = IMMKernel::CA;
+constexpr int CT = IMMKernel::CT;
+constexpr double LOG_2PI = 1.8378770664093453;
+}
+
+void IMMBatchEngine::BatchConfig::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    chunk_size = node["chunk_size"].as<size_t>(chunk_size);
+    parallel_min_tracks = node["parallel_min_tracks"].as<size_t>(parallel_min_tracks);
+}
+
+void IMMBatchEngine::predictAll(std::vector<Track>& tracks, double dt) {
+    ++scan_;
+    prepareScan(dt);
+
+    // Slot lookup is serial; the per-slot work below touches disjoint storage
+    track_slot_.resize(tracks.size());
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        track_slot_[t] = slotFor(tracks[t]);
+    }
+    releaseUnseen();
+
+    forChunks(tracks.size(), [this, &tracks](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            predictSlot(track_slot_[t]);
+            combineSlot(track_slot_[t], tracks[t]);
+        }
+    });
+}
+
+void IMMBatchEngine::updateAll(std::vector<Track>& tracks,
+                               const std::vector<std::pair<uint32_t, RadarDetection>>& measurements) {
+    forChunks(measurements.size(), [this, &tracks, &measurements](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            const auto& [track_index, detection] = measurements[m];
+            const uint32_t slot = track_slot_[track_index];
+            updateSlot(slot, motion::measurementOf(detection));
+            combineSlot(slot, tracks[track_index]);
+            tracks[track_index].last_update = detection.timestamp;
+            tracks[track_index].valid_time = detection.timestamp;
+        }
+    });
+}
+
+void IMMBatchEngine::predict(Track& track, double dt) {
+    prepareScan(dt);
+    const uint32_t slot = slotFor(track);
+    predictSlot(slot);
+    combineSlot(slot, track);
+}
+
+motion::MeasMatrix IMMBatchEngine::innovationCovariance(const Track& track) const {
+    motion::MeasMatrix S = motion::ConstTrackCovarianceMap(&track.covariance[0][0]).topLeftCorner<3, 3>();
+    S.diagonal().array() += params_.models[CV].measurement_noise;
+    return S;
+}
+
+void IMMBatchEngine::update(Track& track, const RadarDetection& detection) {
+    const uint32_t slot = slotFor(track);
+    updateSlot(slot, motion::measurementOf(detection));
+    combineSlot(slot, track);
+    track.last_update = detection.timestamp;
+    track.valid_time = detection.timestamp;
+}
+
+Track IMMBatchEngine::initializeTrack(const RadarDetection& detection) const {
+    Track track;
+    track.position = detection.position;
+    track.velocity = detection.velocity;
+    track.last_update = detection.timestamp;
+    track.valid_time = detection.timestamp;
+    for (int i = 0; i < 3; ++i) {
+        track.covariance[i][i] = params_.initial_position_variance;
+        track.covariance[i + 3][i + 3] = params_.initial_velocity_variance;
+        track.covariance[i + 6][i + 6] = params_.initial_acceleration_variance;
+    }
+    return track;
+}
+
+void IMMBatchEngine::retainTracks(const std::vector<Track>& tracks) {
+    ++scan_;
+    for (const auto& track : tracks) {
+        auto it = slot_of_id_.find(track.track_id);
+        if (it != slot_of_id_.end()) {
+            last_seen_[it->second] = scan_;
+        }
+    }
+    releaseUnseen();
+}
+
+IMMBatchEngine::Snapshot IMMBatchEngine::snapshot(const Track& track) {
+    const uint32_t slot = slotFor(track);
+    Snapshot snapshot;
+    embedCV(slot, snapshot.x[CV], snapshot.P[CV]);
+    snapshot.x[CA] = ca_x_[slot];
+    snapshot.P[CA] = ca_P_[slot];
+    snapshot.x[CT] = ct_x_[slot];
+    snapshot.P[CT] = ct_P_[slot];
+    for (int j = 0; j < NUM_MODELS; ++j) {
+        snapshot.probability[j] = probability_[j][slot];
+    }
+    return snapshot;
+}
+
+void IMMBatchEngine::restore(const Track& track, const Snapshot& snapshot) {
+    const uint32_t slot = slotFor(track);
+    cv_x_[slot] = snapshot.x[CV].head<6>();
+    cv_P_[slot] = snapshot.P[CV].topLeftCorner<6, 6>();
+    ca_x_[slot] = snapshot.x[CA];
+    ca_P_[slot] = snapshot.P[CA];
+    ct_x_[slot] = snapshot.x[CT];
+    ct_P_[slot] = snapshot.P[CT];
+    for (int j = 0; j < NUM_MODELS; ++j) {
+        probability_[j][slot] = snapshot.probability[j];
+    }
+    active_[slot] = (1u << NUM_MODELS) - 1;
+}
+
+std::array<double, IMMBatchEngine::NUM_MODELS> IMMBatchEngine::getModeProbabilities(uint32_t track_id) const {
+    auto it = slot_of_id_.find(track_id);
+    if (it == slot_of_id_.end()) {
+        return {{params_.models[CV].initial_probability, params_.models[CA].initial_probability,
+                 params_.models[CT].initial_probability}};
+    }
+    return {{probability_[CV][it->second], probability_[CA][it->second], probability_[CT][it->second]}};
+}
+
+uint32_t IMMBatchEngine::slotFor(const Track& track) {
+    auto it = slot_of_id_.find(track.track_id);
+    if (it != slot_of_id_.end()) {
+        last_seen_[it->second] = scan_;
+        return it->second;
+    }
+
+    uint32_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(cv_x_.size());
+        cv_x_.emplace_back();
+        cv_P_.emplace_back();
+        ca_x_.emplace_back();
+        ca_P_.emplace_back();
+        ct_x_.emplace_back();
+        ct_P_.emplace_back();
+        for (auto& column : probability_) {
+            column.push_back(0.0);
+        }
+        active_.push_back(0);
+        last_seen_.push_back(0);
+    }
+
+    motion::StateVector x;
+    motion::StateMatrix P;
+    motion::loadTrackState(track, x, P);
+    cv_x_[slot] = x.head<6>();
+    cv_P_[slot] = P.topLeftCorner<6, 6>();
+    ca_x_[slot] = x;
+    ca_P_[slot] = P;
+    ct_x_[slot] = x;
+    ct_P_[slot] = P;
+    for (int j = 0; j < NUM_MODELS; ++j) {
+        probability_[j][slot] = params_.models[j].initial_probability;
+    }
+    active_[slot] = (1u << NUM_MODELS) - 1;
+    last_seen_[slot] = scan_;
+
+    slot_of_id_.emplace(track.track_id, slot);
+    return slot;
+}
+
+void IMMBatchEngine::releaseUnseen() {
+    for (auto it = slot_of_id_.begin(); it != slot_of_id_.end();) {
+        if (last_seen_[it->second] != scan_) {
+            free_slots_.push_back(it->second);
+            it = slot_of_id_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void IMMBatchEngine::prepareScan(double dt) {
+    if (dt == prepared_dt_) {
+        return;
+    }
+    prepared_dt_ = dt;
+
+    // F and Q of CV and CA depend only on dt; CT's F depends on the state
+    motion::StateVector unused = motion::StateVector::Zero();
+    motion::StateMatrix F, Q;
+    motion::ConstantVelocityModel::transition(unused, dt, F);
+    motion::ConstantVelocityModel::processNoise(dt, params_.models[CV].process_noise, Q);
+    F_cv_ = F.topLeftCorner<6, 6>();
+    Q_cv_ = Q.topLeftCorner<6, 6>();
+
+    motion::ConstantAccelerationModel::transition(unused, dt, F_ca_);
+    motion::ConstantAccelerationModel::processNoise(dt, params_.models[CA].process_noise, Q_ca_);
+    motion::CoordinatedTurnModel::processNoise(dt, params_.models[CT].process_noise, Q_ct_);
+}
+
+void IMMBatchEngine::embedCV(uint32_t slot, motion::StateVector& x, motion::StateMatrix& P) const {
+    x.head<6>() = cv_x_[slot];
+    x.tail<3>().setZero();
+    P.setZero();
+    P.topLeftCorner<6, 6>() = cv_P_[slot];
+    P.bottomRightCorner<3, 3>().diagonal().setConstant(params_.initial_acceleration_variance);
+}
+
+template<int Dim>
+void IMMBatchEngine::mixInto(const std::array<double, NUM_MODELS>& w, double w_total, int target,
+                             const motion::StateVector* const* src_x, const motion::StateMatrix* const* src_P,
+                             Eigen::Matrix<double, Dim, 1>& x0, Eigen::Matrix<double, Dim, Dim>& P0) {
+    if (w_total <= 0.0) {
+        x0 = src_x[target]->template head<Dim>();
+        P0 = src_P[target]->template topLeftCorner<Dim, Dim>();
+        return;
+    }
+
+    x0.setZero();
+    for (int i = 0; i < NUM_MODELS; ++i) {
+        if (w[i] > 0.0) {
+            x0.noalias() += (w[i] / w_total) * src_x[i]->template head<Dim>();
+        }
+    }
+    P0.setZero();
+    for (int i = 0; i < NUM_MODELS; ++i) {
+        if (w[i] > 0.0) {
+            const Eigen::Matrix<double, Dim, 1> dx = src_x[i]->template head<Dim>() - x0;
+            P0.noalias() += (w[i] / w_total) * src_P[i]->template topLeftCorner<Dim, Dim>();
+            P0.noalias() += (w[i] / w_total) * dx * dx.transpose();
+        }
+    }
+}
+
+void IMMBatchEngine::predictSlot(uint32_t slot) {
+    const double threshold = params_.mixing_threshold;
+    std::array<double, NUM_MODELS> mu{};
+    for (int i = 0; i < NUM_MODELS; ++i) {
+        mu[i] = probability_[i][slot];
+    }
+
+    // Predicted mode probabilities; dormant targets are not propagated
+    std::array<double, NUM_MODELS> c{};
+    double c_total = 0.0;
+    uint8_t active = 0;
+    for (int j = 0; j < NUM_MODELS; ++j) {
+        for (int i = 0; i < NUM_MODELS; ++i) {
+            c[j] += params_.transition[i][j] * mu[i];
+        }
+        if (c[j] >= threshold) {
+            active |= static_cast<uint8_t>(1u << j);
+            c_total += c[j];
+        } else {
+            c[j] = 0.0;
+        }
+    }
+
+    // Source states in the common 9-dimensional space (CV embedded)
+    motion::StateVector cv_x9;
+    motion::StateMatrix cv_P9;
+    embedCV(slot, cv_x9, cv_P9);
+    const motion::StateVector* src_x[NUM_MODELS] = {&cv_x9, &ca_x_[slot], &ct_x_[slot]};
+    const motion::StateMatrix* src_P[NUM_MODELS] = {&cv_P9, &ca_P_[slot], &ct_P_[slot]};
+
+    for (int j = 0; j < NUM_MODELS; ++j) {
+        if (!(active & (1u << j))) {
+            continue;
+        }
+
+        // Mixing weights, skipping sources below the threshold
+        std::array<double, NUM_MODELS> w{};
+        double w_total = 0.0;
+        for (int i = 0; i < NUM_MODELS; ++i) {
+            if (mu[i] >= threshold) {
+                w[i] = params_.transition[i][j] * mu[i];
+                w_total += w[i];
+            }
+        }
+
+        if (j == CV) {
+            // CV is mixed and propagated in its own 6-dimensional space
+            CVVector x0;
+            CVMatrix P0;
+            mixInto<6>(w, w_total, j, src_x, src_P, x0, P0);
+            cv_x_[slot].noalias() = F_cv_ * x0;
+            cv_P_[slot].noalias() = F_cv_ * P0 * F_cv_.transpose();
+            cv_P_[slot] += Q_cv_;
+            continue;
+        }
+
+        motion::StateVector x0;
+        motion::StateMatrix P0;
+        mixInto<motion::STATE_DIM>(w, w_total, j, src_x, src_P, x0, P0);
+        if (j == CA) {
+            ca_x_[slot].noalias() = F_ca_ * x0;
+            ca_P_[slot].noalias() = F_ca_ * P0 * F_ca_.transpose();
+            ca_P_[slot] += Q_ca_;
+        } else {
+            motion::StateMatrix F;
+            motion::CoordinatedTurnModel::transition(x0, prepared_dt_, F);
+            ct_x_[slot].noalias() = F * x0;
+            ct_P_[slot].noalias() = F * P0 * F.transpose();
+            ct_P_[slot] += Q_ct_;
+        }
+    }
+
+    for (int j = 0; j < NUM_MODELS; ++j) {
+        probability_[j][slot] = c_total > 0.0 ? c[j] / c_total : mu[j];
+    }
+    active_[slot] = active;
+}
+
+void IMMBatchEngine::updateSlot(uint32_t slot, const motion::MeasVector& z) {
+    const uint8_t active = active_[slot];
+    std::array<double, NUM_MODELS> log_likelihood{};
+    double max_log_likelihood = -std::numeric_limits<double>::infinity();
+
+    auto updateModel = [&](auto& x, auto& P, int j) {
+        motion::MeasMatrix S = P.template topLeftCorner<3, 3>();
+        S.diagonal().array() += params_.models[j].measurement_noise;
+        const Eigen::LLT<motion::MeasMatrix> llt(S);
+        if (llt.info() != Eigen::Success) {
+            log_likelihood[j] = -std::numeric_limits<double>::infinity();
+            return;
+        }
+        const motion::MeasVector y = z - x.template head<3>();
+
+        using Gain = Eigen::Matrix<double, std::decay_t<decltype(x)>::RowsAtCompileTime, 3>;
+        const Gain PHt = P.template leftCols<3>();
+        const Gain K = llt.solve(PHt.transpose()).transpose();
+        x.noalias() += K * y;
+        P.noalias() -= K * PHt.transpose();
+        P = 0.5 * (P + P.transpose()).eval();
+
+        const motion::MeasVector w = llt.matrixL().solve(y);
+        const double log_det = 2.0 * llt.matrixLLT().diagonal().array().log().sum();
+        log_likelihood[j] = -0.5 * (w.squaredNorm() + log_det + 3.0 * LOG_2PI);
+        max_log_likelihood = std::max(max_log_likelihood, log_likelihood[j]);
+    };
+
+    if (active & (1u << CV)) updateModel(cv_x_[slot], cv_P_[slot], CV);
+    if (active & (1u << CA)) updateModel(ca_x_[slot], ca_P_[slot], CA);
+    if (active & (1u << CT)) updateModel(ct_x_[slot], ct_P_[slot], CT);
+
+    // Mode probabilities, normalized in log space to avoid underflow far from the gate center
+    double total = 0.0;
+    std::array<double, NUM_MODELS> posterior{};
+    for (int j = 0; j < NUM_MODELS; ++j) {
+        if ((active & (1u << j)) && std::isfinite(log_likelihood[j])) {
+            posterior[j] = probability_[j][slot] * std::exp(log_likelihood[j] - max_log_likelihood);
+            total += posterior[j];
+        }
+    }
+    if (total > 0.0) {
+        for (int j = 0; j < NUM_MODELS; ++j) {
+            probability_[j][slot] = posterior[j] / total;
+        }
+    }
+}
+
+void IMMBatchEngine::combineSlot(uint32_t slot, Track& track) const {
+    const uint8_t active = active_[slot];
+    motion::StateVector cv_x9;
+    motion::StateMatrix cv_P9;
+    embedCV(slot, cv_x9, cv_P9);
+    const motion::StateVector* src_x[NUM_MODELS] = {&cv_x9, &ca_x_[slot], &ct_x_[slot]};
+    const motion::StateMatrix* src_P[NUM_MODELS] = {&cv_P9, &ca_P_[slot], &ct_P_[slot]};
+
+    motion::StateVector x = motion::StateVector::Zero();
+    for (int j = 0; j < NUM_MODELS; ++j) {
+        if (active & (1u << j)) {
+            x.noalias() += probability_[j][slot] * *src_x[j];
+        }
+    }
+    motion::StateMatrix P = motion::StateMatrix::Zero();
+    for (int j = 0; j < NUM_MODELS; ++j) {
+        if (active & (1u << j)) {
+            const motion::StateVector dx = *src_x[j] - x;
+            P.noalias() += probability_[j][slot] * (*src_P[j] + dx * dx.transpose());
+        }
+    }
+    motion::storeTrackState(x, P, track);
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,896 @@
+#include "tracking/ParticleFilter.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace radar_tracking {
+
+namespace {
+
+inline uint32_t mixBits(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Uniform float in [0, 1) from the top 24 bits
+ */
+inline float unitFloat(uint32_t bits) {
+    return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Fill an array with approximately standard normal draws over [begin, end)
+ *
+ * Each draw is the centred sum of the four bytes of one counter-based hash
+ * (Irwin-Hall, tails bounded at 3.46 sigma). The loop is integer-only and
+ * vectorizes, and each particle's draw depends only on (key, stream, index),
+ * so results do not depend on how particles are split across threads.
+ */
+void fillGaussian(uint32_t key, uint32_t stream, size_t begin, size_t end, float* out) {
+    constexpr float SCALE = 1.7320508075688772f / 256.0f;  // sqrt(12 / 4) per byte unit
+    const uint32_t stream_key = key + stream * 0x85ebca6bU;
+    for (size_t i = begin; i < end; ++i) {
+        const uint32_t bits = mixBits(stream_key + static_cast<uint32_t>(i) * 0x9E3779B9U);
+        const int sum = static_cast<int>((bits & 0xffu) + ((bits >> 8) & 0xffu) +
+                                         ((bits >> 16) & 0xffu) + (bits >> 24));
+        out[i] = static_cast<float>(sum - 510) * SCALE;
+    }
+}
+
+/**
+ * @brief exp(x) for x <= 0 without calls or branches (relative error below 4e-7)
+ *
+ * Returns 0 below -87, where the float result would be denormal.
+ */
+inline float expNonPositive(float x) {
+    const float clamped = x < -87.0f ? -87.0f : x;
+    // k = round(x / ln 2), r = x - k ln 2 split in two parts for accuracy
+    const float k = (clamped * 1.44269504f + 12582912.0f) - 12582912.0f;
+    const float r = (clamped - k * 0.693145752f) - k * 1.42860677e-6f;
+    const float p = 1.0f + r * (1.0f + r * (0.5f + r * (1.0f / 6.0f + r * (1.0f / 24.0f +
+                    r * (1.0f / 120.0f + r * (1.0f / 720.0f))))));
+    const int32_t bits = (static_cast<int32_t>(k) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return x < -87.0f ? 0.0f : p * scale;
+}
+
+/**
+ * @brief Nearly coordinated turn plus white acceleration for particles [begin, end)
+ *
+ * Series selects truncated series for the turn terms, valid while
+ * |omega dt| <= 0.5 (error below 1e-10); otherwise sin and cos are called.
+ */
+template<bool Series>
+void turnStep(float* __restrict px, float* __restrict py, float* __restrict pz,
+              float* __restrict vx, float* __restrict vy, float* __restrict vz, float* __restrict omega,
+              const float* __restrict nx, const float* __restrict ny, const float* __restrict nz,
+              const float* __restrict nw, size_t begin, size_t end,
+              float dt, float sigma_a, float sigma_w, float max_w) {
+    const float half_dt2 = 0.5f * dt * dt;
+    for (size_t i = begin; i < end; ++i) {
+        float w = omega[i] + sigma_w * nw[i];
+        w = w > max_w ? max_w : w;
+        w = w < -max_w ? -max_w : w;
+        const float wt = w * dt;
+
+        // s, c = sin(wt), cos(wt); sw, cw = sin(wt) / w, (1 - cos(wt)) / w
+        float s, c, sw, cw;
+        if constexpr (Series) {
+            const float x2 = wt * wt;
+            const float sinc = 1.0f - x2 / 6.0f * (1.0f - x2 / 20.0f * (1.0f - x2 / 42.0f * (1.0f - x2 / 72.0f)));
+            const float cosc = 1.0f - x2 / 12.0f * (1.0f - x2 / 30.0f * (1.0f - x2 / 56.0f));
+            s = wt * sinc;
+            c = 1.0f - 0.5f * x2 * cosc;
+            sw = dt * sinc;
+            cw = 0.5f * wt * dt * cosc;
+        } else {
+            s = std::sin(wt);
+            c = std::cos(wt);
+            const bool straight = std::fabs(wt) < 1e-4f;
+            const float w_safe = straight ? 1.0f : w;
+            sw = straight ? dt : s / w_safe;
+            cw = straight ? 0.5f * wt * dt : (1.0f - c) / w_safe;
+        }
+
+        const float ax = sigma_a * nx[i];
+        const float ay = sigma_a * ny[i];
+        const float az = sigma_a * nz[i];
+        const float vx0 = vx[i];
+        const float vy0 = vy[i];
+
+        px[i] += sw * vx0 - cw * vy0 + half_dt2 * ax;
+        py[i] += cw * vx0 + sw * vy0 + half_dt2 * ay;
+        pz[i] += dt * vz[i] + half_dt2 * az;
+        vx[i] = c * vx0 - s * vy0 + dt * ax;
+        vy[i] = s * vx0 + c * vy0 + dt * ay;
+        vz[i] += dt * az;
+        omega[i] = w;
+    }
+}
+
+/**
+ * @brief Gaussian position log-likelihood for particles [begin, end); returns the maximum
+ */
+float logLikelihood(const float* __restrict px, const float* __restrict py, const float* __restrict pz,
+                    float* __restrict out, size_t begin, size_t end,
+                    float zx, float zy, float zz, float scale) {
+    for (size_t i = begin; i < end; ++i) {
+        const float dx = zx - px[i];
+        const float dy = zy - py[i];
+        const float dz = zz - pz[i];
+        out[i] = -scale * (dx * dx + dy * dy + dz * dz);
+    }
+    float max_log = -std::numeric_limits<float>::infinity();
+    for (size_t i = begin; i < end; ++i) {
+        max_log = out[i] > max_log ? out[i] : max_log;
+    }
+    return max_log;
+}
+
+constexpr size_t LANES = 16;
+
+/**
+ * @brief Per-lane float partial sums of particle moments
+ *
+ * Lanes keep iterations independent, so the block loops vectorize without
+ * reassociating sums.
+ */
+struct LaneSums {
+    float weight[LANES];
+    float first[6][LANES];
+    float second[21][LANES];
+    float accel[2][LANES];
+    float turn[2][LANES];
+};
+
+/**
+ * @brief Accumulate particles [i, i + LANES); deviations from the pivot keep
+ * the float second moments accurate
+ */
+inline void accumulateBlock(const float* const state[6], const float* omega, const float* weight,
+                            size_t i, const std::array<float, 6>& pivot, LaneSums& sums) {
+    float d[6][LANES];
+    for (int a = 0; a < 6; ++a) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            d[a][lane] = state[a][i + lane] - pivot[a];
+        }
+    }
+    const float* w = weight + i;
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        sums.weight[lane] += w[lane];
+    }
+    int k = 0;
+    for (int a = 0; a < 6; ++a) {
+        float wd[LANES];
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            wd[lane] = w[lane] * d[a][lane];
+            sums.first[a][lane] += wd[lane];
+        }
+        for (int b = a; b < 6; ++b, ++k) {
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                sums.second[k][lane] += wd[lane] * d[b][lane];
+            }
+        }
+    }
+    const float* vx = state[ParticleArena::VX] + i;
+    const float* vy = state[ParticleArena::VY] + i;
+    const float* turn_rate = omega + i;
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        const float w_omega = w[lane] * turn_rate[lane];
+        sums.accel[0][lane] -= w_omega * vy[lane];
+        sums.accel[1][lane] += w_omega * vx[lane];
+        sums.turn[0][lane] += w_omega;
+        sums.turn[1][lane] += w_omega * turn_rate[lane];
+    }
+}
+
+inline int upperIndex(int a, int b) {
+    // Row-major index into the upper triangle of a 6x6 matrix (a <= b)
+    return a * 6 - a * (a - 1) / 2 + (b - a);
+}
+}
+
+// ParticleArena
+
+void ParticleArena::configure(size_t particles_per_block) {
+    particles_ = particles_per_block;
+    stride_ = (particles_per_block + 15) & ~size_t(15);
+    blocks_ = 0;
+    data_.clear();
+    free_blocks_.clear();
+}
+
+void ParticleArena::reserve(size_t blocks) {
+    data_.reserve(blocks * 2 * NUM_COMPONENTS * stride_);
+    free_blocks_.reserve(blocks);
+}
+
+size_t ParticleArena::acquire() {
+    if (!free_blocks_.empty()) {
+        const size_t block = free_blocks_.back();
+        free_blocks_.pop_back();
+        return block;
+    }
+    const size_t block = blocks_++;
+    data_.resize(blocks_ * 2 * NUM_COMPONENTS * stride_);
+    return block;
+}
+
+void ParticleArena::release(size_t block) {
+    free_blocks_.push_back(block);
+}
+
+// ParticleFilter
+
+void ParticleFilter::Config::loadFromYaml(const YAML::Node& node) {
+    auto particles = node["particles"];
+    if (particles) {
+        particles_per_track = particles["count_per_track"].as<size_t>(particles_per_track);
+        resample_threshold = particles["resample_threshold"].as<double>(resample_threshold);
+        regularization = particles["regularization"].as<double>(regularization);
+    }
+
+    auto motion = node["motion"];
+    if (motion) {
+        acceleration_noise = motion["acceleration_noise"].as<double>(acceleration_noise);
+        turn_rate_noise = motion["turn_rate_noise"].as<double>(turn_rate_noise);
+        max_turn_rate = motion["max_turn_rate"].as<double>(max_turn_rate);
+    }
+
+    if (node["measurement"]) {
+        measurement_variance = node["measurement"]["position_variance"].as<double>(measurement_variance);
+    }
+
+    auto init = node["initialization"];
+    if (init) {
+        initial_position_std = init["position_std"].as<double>(initial_position_std);
+        initial_velocity_std = init["velocity_std"].as<double>(initial_velocity_std);
+        initial_turn_rate_std = init["turn_rate_std"].as<double>(initial_turn_rate_std);
+    }
+
+    auto params = node["parameters"];
+    if (params) {
+        recenter_distance_m = params["recenter_distance_m"].as<double>(recenter_distance_m);
+        seed = params["seed"].as<uint32_t>(seed);
+    }
+
+    auto performance = node["performance"];
+    if (performance) {
+        chunk_size = performance["chunk_size"].as<size_t>(chunk_size);
+        parallel_min_tracks = performance["parallel_min_tracks"].as<size_t>(parallel_min_tracks);
+        split_min_particles = performance["split_min_particles"].as<size_t>(split_min_particles);
+        slice_size = performance["slice_size"].as<size_t>(slice_size);
+    }
+}
+
+bool ParticleFilter::Config::validate() const {
+    if (particles_per_track < 2) {
+        LOG_ERROR("Particle filter: count_per_track must be at least 2");
+        return false;
+    }
+    if (resample_threshold <= 0.0 || resample_threshold > 1.0) {
+        LOG_ERROR("Particle filter: resample_threshold must be in (0, 1]");
+        return false;
+    }
+    if (regularization < 0.0 || regularization >= 1.0) {
+        LOG_ERROR("Particle filter: regularization must be in [0, 1)");
+        return false;
+    }
+    if (measurement_variance <= 0.0 || acceleration_noise < 0.0 || turn_rate_noise < 0.0 || max_turn_rate <= 0.0) {
+        LOG_ERROR("Particle filter: noise parameters must be non-negative and measurement_variance positive");
+        return false;
+    }
+    if (recenter_distance_m <= 0.0) {
+        LOG_ERROR("Particle filter: recenter_distance_m must be positive");
+        return false;
+    }
+    return true;
+}
+
+void ParticleFilter::Moments::merge(const Moments& other) {
+    weight += other.weight;
+    for (size_t i = 0; i < first.size(); ++i) {
+        first[i] += other.first[i];
+    }
+    for (size_t i = 0; i < second.size(); ++i) {
+        second[i] += other.second[i];
+    }
+    accel[0] += other.accel[0];
+    accel[1] += other.accel[1];
+    turn[0] += other.turn[0];
+    turn[1] += other.turn[1];
+}
+
+ParticleFilter::ParticleFilter() {
+    arena_.configure(config_.particles_per_track);
+}
+
+ParticleFilter::ParticleFilter(const Config& config) : config_(config) {
+    arena_.configure(config_.particles_per_track);
+}
+
+void ParticleFilter::setConfig(const Config& config) {
+    config_ = config;
+    arena_.configure(config_.particles_per_track);
+    half_.clear();
+    epoch_.clear();
+    last_seen_.clear();
+    ess_.clear();
+    origin_.clear();
+    slot_of_id_.clear();
+}
+
+void ParticleFilter::reserve(size_t tracks) {
+    arena_.reserve(tracks);
+    half_.reserve(tracks);
+    epoch_.reserve(tracks);
+    last_seen_.reserve(tracks);
+    ess_.reserve(tracks);
+    origin_.reserve(tracks);
+}
+
+void ParticleFilter::predictAll(std::vector<Track>& tracks, double dt) {
+    ++scan_;
+
+    // Slot lookup (and arena growth) is serial; the per-slot work below touches disjoint blocks
+    track_slot_.resize(tracks.size());
+    for (size_t t = 0; t < tracks.size(); ++t) {
+        track_slot_[t] = slotFor(tracks[t]);
+    }
+    releaseUnseen();
+
+    const size_t slices = sliceCount();
+    if (slices > 1) {
+        // Large tracks: one track at a time, particles split over the pool
+        for (size_t t = 0; t < tracks.size(); ++t) {
+            predictSlot(track_slot_[t], dt, slices);
+            combineSlot(track_slot_[t], tracks[t], slices);
+        }
+        return;
+    }
+
+    forChunks(tracks.size(), [this, &tracks, dt](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            predictSlot(track_slot_[t], dt, 1);
+            combineSlot(track_slot_[t], tracks[t], 1);
+        }
+    });
+}
+
+void ParticleFilter::updateAll(std::vector<Track>& tracks,
+                               const std::vector<std::pair<uint32_t, RadarDetection>>& measurements) {
+    const size_t slices = sliceCount();
+    auto process = [this, &tracks, &measurements](size_t m, size_t slice_count) {
+        const auto& [track_index, detection] = measurements[m];
+        const uint32_t slot = track_slot_[track_index];
+        updateSlot(slot, motion::measurementOf(detection), slice_count);
+        combineSlot(slot, tracks[track_index], slice_count);
+        tracks[track_index].last_update = detection.timestamp;
+        tracks[track_index].valid_time = detection.timestamp;
+    };
+
+    if (slices > 1) {
+        for (size_t m = 0; m < measurements.size(); ++m) {
+            process(m, slices);
+        }
+        return;
+    }
+
+    forChunks(measurements.size(), [&process](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            process(m, 1);
+        }
+    });
+}
+
+void ParticleFilter::predict(Track& track, double dt) {
+    const uint32_t slot = slotFor(track);
+    const size_t slices = sliceCount();
+    predictSlot(slot, dt, slices);
+    combineSlot(slot, track, slices);
+}
+
+motion::MeasMatrix ParticleFilter::innovationCovariance(const Track& track) const {
+    motion::MeasMatrix S = motion::ConstTrackCovarianceMap(&track.covariance[0][0]).topLeftCorner<3, 3>();
+    S.diagonal().array() += config_.measurement_variance;
+    return S;
+}
+
+void ParticleFilter::update(Track& track, const RadarDetection& detection) {
+    const uint32_t slot = slotFor(track);
+    const size_t slices = sliceCount();
+    updateSlot(slot, motion::measurementOf(detection), slices);
+    combineSlot(slot, track, slices);
+    track.last_update = detection.timestamp;
+    track.valid_time = detection.timestamp;
+}
+
+Track ParticleFilter::initializeTrack(const RadarDetection& detection) const {
+    Track track;
+    track.position = detection.position;
+    track.velocity = detection.velocity;
+    track.last_update = detection.timestamp;
+    track.valid_time = detection.timestamp;
+    const double position_variance = config_.initial_position_std * config_.initial_position_std;
+    const double velocity_variance = config_.initial_velocity_std * config_.initial_velocity_std;
+    const double acceleration_variance = config_.acceleration_noise * config_.acceleration_noise;
+    for (int i = 0; i < 3; ++i) {
+        track.covariance[i][i] = position_variance;
+        track.covariance[i + 3][i + 3] = velocity_variance;
+        track.covariance[i + 6][i + 6] = acceleration_variance;
+    }
+    return track;
+}
+
+void ParticleFilter::retainTracks(const std::vector<Track>& tracks) {
+    ++scan_;
+    for (const auto& track : tracks) {
+        auto it = slot_of_id_.find(track.track_id);
+        if (it != slot_of_id_.end()) {
+            last_seen_[it->second] = scan_;
+        }
+    }
+    releaseUnseen();
+}
+
+double ParticleFilter::getEffectiveSampleSize(uint32_t track_id) const {
+    auto it = slot_of_id_.find(track_id);
+    return it == slot_of_id_.end() ? 0.0 : static_cast<double>(ess_[it->second]);
+}
+
+uint32_t ParticleFilter::slotFor(const Track& track) {
+    auto it = slot_of_id_.find(track.track_id);
+    if (it != slot_of_id_.end()) {
+        last_seen_[it->second] = scan_;
+        return it->second;
+    }
+
+    const auto slot = static_cast<uint32_t>(arena_.acquire());
+    if (slot >= half_.size()) {
+        half_.resize(slot + 1, 0);
+        epoch_.resize(slot + 1, 0);
+        last_seen_.resize(slot + 1, 0);
+        ess_.resize(slot + 1, 0.0f);
+        origin_.resize(slot + 1);
+    }
+    seedSlot(slot, track);
+    last_seen_[slot] = scan_;
+
+    slot_of_id_.emplace(track.track_id, slot);
+    return slot;
+}
+
+void ParticleFilter::seedSlot(uint32_t slot, const Track& track) {
+    const size_t n = arena_.particles();
+    half_[slot] = 0;
+    ++epoch_[slot];
+    origin_[slot] = {{track.position.x, track.position.y, track.position.z}};
+    ess_[slot] = static_cast<float>(n);
+
+    // Spread from the track covariance, falling back to the configured spread
+    auto spread = [&track](int i, double fallback) {
+        const double variance = track.covariance[i][i];
+        return static_cast<float>(variance > 0.0 ? std::sqrt(variance) : fallback);
+    };
+    const float mean[6] = {0.0f, 0.0f, 0.0f, static_cast<float>(track.velocity.x),
+                           static_cast<float>(track.velocity.y), static_cast<float>(track.velocity.z)};
+    float std_dev[6];
+    for (int i = 0; i < 3; ++i) {
+        std_dev[i] = spread(i, config_.initial_position_std);
+        std_dev[i + 3] = spread(i + 3, config_.initial_velocity_std);
+    }
+
+    const uint32_t key = mixBits(config_.seed ^ mixBits(slot * 0x9E3779B9u + epoch_[slot]));
+    float* state[ParticleArena::NUM_COMPONENTS];
+    for (int c = 0; c < ParticleArena::NUM_COMPONENTS; ++c) {
+        state[c] = arena_.data(slot, 0, c);
+    }
+    for (int c = 0; c <= ParticleArena::OMEGA; ++c) {
+        fillGaussian(key, static_cast<uint32_t>(c), 0, n, state[c]);
+    }
+
+    for (int c = 0; c < 6; ++c) {
+        float* values = state[c];
+        for (size_t i = 0; i < n; ++i) {
+            values[i] = mean[c] + std_dev[c] * values[i];
+        }
+    }
+    const float turn_std = static_cast<float>(config_.initial_turn_rate_std);
+    const float uniform = 1.0f / static_cast<float>(n);
+    float* omega = state[ParticleArena::OMEGA];
+    float* weight = state[ParticleArena::WEIGHT];
+    for (size_t i = 0; i < n; ++i) {
+        omega[i] *= turn_std;
+        weight[i] = uniform;
+    }
+}
+
+void ParticleFilter::releaseUnseen() {
+    for (auto it = slot_of_id_.begin(); it != slot_of_id_.end();) {
+        if (last_seen_[it->second] != scan_) {
+            arena_.release(it->second);
+            it = slot_of_id_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ParticleFilter::predictSlot(uint32_t slot, double dt, size_t slices) {
+    if (dt <= 0.0) {
+        return;
+    }
+    ++epoch_[slot];
+    const auto fdt = static_cast<float>(dt);
+    runSlices(slices, [this, slot, fdt, slices](size_t s) {
+        const auto [begin, end] = sliceRange(s, slices);
+        propagateRange(slot, fdt, begin, end);
+    });
+}
+
+void ParticleFilter::propagateRange(uint32_t slot, float dt, size_t begin, size_t end) {
+    const int active = half_[slot];
+    const int spare = 1 - active;
+    float* px = arena_.data(slot, active, ParticleArena::PX);
+    float* py = arena_.data(slot, active, ParticleArena::PY);
+    float* pz = arena_.data(slot, active, ParticleArena::PZ);
+    float* vx = arena_.data(slot, active, ParticleArena::VX);
+    float* vy = arena_.data(slot, active, ParticleArena::VY);
+    float* vz = arena_.data(slot, active, ParticleArena::VZ);
+    float* omega = arena_.data(slot, active, ParticleArena::OMEGA);
+
+    // The spare half is free until resampling and holds this step's noise
+    float* nx = arena_.data(slot, spare, ParticleArena::PX);
+    float* ny = arena_.data(slot, spare, ParticleArena::PY);
+    float* nz = arena_.data(slot, spare, ParticleArena::PZ);
+    float* nw = arena_.data(slot, spare, ParticleArena::OMEGA);
+    const uint32_t key = mixBits(config_.seed ^ mixBits(slot * 0x9E3779B9u + epoch_[slot]));
+    fillGaussian(key, 0, begin, end, nx);
+    fillGaussian(key, 1, begin, end, ny);
+    fillGaussian(key, 2, begin, end, nz);
+    fillGaussian(key, 3, begin, end, nw);
+
+    const auto sigma_a = static_cast<float>(config_.acceleration_noise);
+    const auto sigma_w = static_cast<float>(config_.turn_rate_noise) * std::sqrt(dt);
+    const auto max_w = static_cast<float>(config_.max_turn_rate);
+
+    // |omega dt| is bounded by max_turn_rate * dt, which decides whether the
+    // call-free series form (which vectorizes) is accurate enough
+    if (max_w * dt <= 0.5f) {
+        turnStep<true>(px, py, pz, vx, vy, vz, omega, nx, ny, nz, nw, begin, end, dt, sigma_a, sigma_w, max_w);
+    } else {
+        turnStep<false>(px, py, pz, vx, vy, vz, omega, nx, ny, nz, nw, begin, end, dt, sigma_a, sigma_w, max_w);
+    }
+}
+
+void ParticleFilter::updateSlot(uint32_t slot, const motion::MeasVector& z, size_t slices) {
+    const int active = half_[slot];
+    const int spare = 1 - active;
+    const auto& origin = origin_[slot];
+    const auto zx = static_cast<float>(z(0) - origin[0]);
+    const auto zy = static_cast<float>(z(1) - origin[1]);
+    const auto zz = static_cast<float>(z(2) - origin[2]);
+    const auto scale = static_cast<float>(0.5 / config_.measurement_variance);
+    float* weight = arena_.data(slot, active, ParticleArena::WEIGHT);
+    float* log_likelihood = arena_.data(slot, spare, ParticleArena::WEIGHT);
+
+    // Log-likelihood of the position measurement (into the spare half)
+    std::array<float, MAX_SLICES> slice_max;
+    runSlices(slices, [&](size_t s) {
+        const auto [begin, end] = sliceRange(s, slices);
+        slice_max[s] = logLikelihood(arena_.data(slot, active, ParticleArena::PX),
+                                     arena_.data(slot, active, ParticleArena::PY),
+                                     arena_.data(slot, active, ParticleArena::PZ),
+                                     log_likelihood, begin, end, zx, zy, zz, scale);
+    });
+    const float max_log = *std::max_element(slice_max.begin(), slice_max.begin() + slices);
+
+    // Reweight relative to the most likely particle; the sums give the
+    // normalizer and the effective sample size
+    std::array<double, MAX_SLICES> slice_weight;
+    std::array<double, MAX_SLICES> slice_square;
+    auto reweight = [&](bool reset) {
+        runSlices(slices, [&](size_t s) {
+            const auto [begin, end] = sliceRange(s, slices);
+            if (reset) {
+                for (size_t i = begin; i < end; ++i) {
+                    weight[i] = expNonPositive(log_likelihood[i] - max_log);
+                }
+            } else {
+                for (size_t i = begin; i < end; ++i) {
+                    weight[i] *= expNonPositive(log_likelihood[i] - max_log);
+                }
+            }
+            double sum = 0.0;
+            double square = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                sum += weight[i];
+                square += static_cast<double>(weight[i]) * weight[i];
+            }
+            slice_weight[s] = sum;
+            slice_square[s] = square;
+        });
+    };
+    double total = 0.0;
+    double total_square = 0.0;
+    auto accumulate = [&]() {
+        total = 0.0;
+        total_square = 0.0;
+        for (size_t s = 0; s < slices; ++s) {
+            total += slice_weight[s];
+            total_square += slice_square[s];
+        }
+    };
+
+    reweight(false);
+    accumulate();
+    if (!(total > 0.0) || !std::isfinite(total)) {
+        // Every prior weight underflowed against the likelihood: restart from it
+        reweight(true);
+        accumulate();
+    }
+
+    const auto inv_total = static_cast<float>(1.0 / total);
+    runSlices(slices, [&](size_t s) {
+        const auto [begin, end] = sliceRange(s, slices);
+        for (size_t i = begin; i < end; ++i) {
+            weight[i] *= inv_total;
+        }
+    });
+
+    const double ess = total * total / total_square;
+    ess_[slot] = static_cast<float>(ess);
+    if (ess < config_.resample_threshold * static_cast<double>(arena_.particles())) {
+        resampleSlot(slot, slice_weight, total, slices);
+    }
+}
+
+void ParticleFilter::resampleSlot(uint32_t slot, const std::array<double, MAX_SLICES>& slice_weight,
+                                  double total_weight, size_t slices) {
+    const size_t n = arena_.particles();
+    const double scale = static_cast<double>(n);
+    const int active = half_[slot];
+    const int spare = 1 - active;
+    const Moments moments = config_.regularization > 0.0 ? slotMoments(slot, slices) : Moments();
+    const uint32_t key = mixBits(config_.seed ^ mixBits(slot * 0x9E3779B9u + epoch_[slot]) ^ 0x5bd1e995U);
+    const double u0 = unitFloat(mixBits(key));
+
+    // Systematic resampling: output k takes the particle whose cumulative
+    // weight (in units of 1/N) first reaches k + u0. Slice boundaries in
+    // cumulative weight fix each slice's output range, so slices resample
+    // independently.
+    std::array<double, MAX_SLICES + 1> cumulative;
+    cumulative[0] = 0.0;
+    for (size_t s = 0; s < slices; ++s) {
+        cumulative[s + 1] = cumulative[s] + slice_weight[s] / total_weight * scale;
+    }
+    auto firstOutput = [&](double position) {
+        return static_cast<size_t>(std::min(scale, std::max(0.0, std::ceil(position - u0))));
+    };
+
+    const float uniform = 1.0f / static_cast<float>(n);
+    runSlices(slices, [&](size_t s) {
+        const auto [begin, end] = sliceRange(s, slices);
+        const size_t k_begin = s == 0 ? 0 : firstOutput(cumulative[s]);
+        const size_t k_end = s + 1 == slices ? n : firstOutput(cumulative[s + 1]);
+        if (begin == end || k_begin >= k_end) {
+            return;
+        }
+
+        const float* weight = arena_.data(slot, active, ParticleArena::WEIGHT);
+        const float* src[ParticleArena::OMEGA + 1];
+        float* dst[ParticleArena::OMEGA + 1];
+        for (int c = 0; c <= ParticleArena::OMEGA; ++c) {
+            src[c] = arena_.data(slot, active, c);
+            dst[c] = arena_.data(slot, spare, c);
+        }
+        float* dst_weight = arena_.data(slot, spare, ParticleArena::WEIGHT);
+
+        size_t i = begin;
+        double running = cumulative[s] + weight[i] * scale;
+        for (size_t k = k_begin; k < k_end; ++k) {
+            const double target = static_cast<double>(k) + u0;
+            while (running < target && i + 1 < end) {
+                ++i;
+                running += weight[i] * scale;
+            }
+            for (int c = 0; c <= ParticleArena::OMEGA; ++c) {
+                dst[c][k] = src[c][i];
+            }
+            dst_weight[k] = uniform;
+        }
+    });
+
+    half_[slot] = static_cast<uint8_t>(spare);
+    if (config_.regularization > 0.0) {
+        regularizeSlot(slot, moments, slices);
+    }
+}
+
+void ParticleFilter::regularizeSlot(uint32_t slot, const Moments& moments, size_t slices) {
+    // Liu-West shrinkage: x <- a x + (1 - a) mean + h sigma n with a = sqrt(1 - h^2)
+    const double h = config_.regularization;
+    const auto a = static_cast<float>(std::sqrt(1.0 - h * h));
+    const double inv_weight = 1.0 / moments.weight;
+    float shrink_mean[ParticleArena::OMEGA + 1];
+    float jitter[ParticleArena::OMEGA + 1];
+    for (int c = 0; c < 6; ++c) {
+        const double deviation = moments.first[c] * inv_weight;
+        const double variance = moments.second[upperIndex(c, c)] * inv_weight - deviation * deviation;
+        shrink_mean[c] = static_cast<float>((1.0 - a) * (moments.pivot[c] + deviation));
+        jitter[c] = static_cast<float>(h * std::sqrt(std::max(variance, 0.0)));
+    }
+    const double turn_mean = moments.turn[0] * inv_weight;
+    const double turn_variance = moments.turn[1] * inv_weight - turn_mean * turn_mean;
+    shrink_mean[ParticleArena::OMEGA] = static_cast<float>((1.0 - a) * turn_mean);
+    jitter[ParticleArena::OMEGA] = static_cast<float>(h * std::sqrt(std::max(turn_variance, 0.0)));
+
+    // The previous half is free again and holds the jitter draws
+    const int active = half_[slot];
+    const int spare = 1 - active;
+    const uint32_t key = mixBits(config_.seed ^ mixBits(slot * 0x9E3779B9u + epoch_[slot]) ^ 0x27d4eb2fU);
+    runSlices(slices, [&](size_t s) {
+        const auto [begin, end] = sliceRange(s, slices);
+        float* noise[ParticleArena::NUM_COMPONENTS];
+        for (int c = 0; c < ParticleArena::NUM_COMPONENTS; ++c) {
+            noise[c] = arena_.data(slot, spare, c);
+        }
+        for (int c = 0; c <= ParticleArena::OMEGA; ++c) {
+            fillGaussian(key, static_cast<uint32_t>(c), begin, end, noise[c]);
+        }
+        for (int c = 0; c <= ParticleArena::OMEGA; ++c) {
+            float* values = arena_.data(slot, active, c);
+            const float* draws = noise[c];
+            const float offset = shrink_mean[c];
+            const float sigma = jitter[c];
+            for (size_t i = begin; i < end; ++i) {
+                values[i] = a * values[i] + offset + sigma * draws[i];
+            }
+        }
+    });
+}
+
+ParticleFilter::Moments ParticleFilter::momentsRange(uint32_t slot, const std::array<float, 6>& pivot,
+                                                     size_t begin, size_t end) const {
+    const int active = half_[slot];
+    const float* state[6];
+    for (int c = 0; c < 6; ++c) {
+        state[c] = arena_.data(slot, active, c) + begin;
+    }
+    const float* omega = arena_.data(slot, active, ParticleArena::OMEGA) + begin;
+    const float* weight = arena_.data(slot, active, ParticleArena::WEIGHT) + begin;
+
+    LaneSums sums = {};
+    const size_t count = end - begin;
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        accumulateBlock(state, omega, weight, i, pivot, sums);
+    }
+    if (i < count) {
+        // Zero-weight padding completes the last block
+        float tail[ParticleArena::NUM_COMPONENTS][LANES] = {};
+        const float* tail_state[6];
+        for (int c = 0; c < 6; ++c) {
+            std::copy(state[c] + i, state[c] + count, tail[c]);
+            tail_state[c] = tail[c];
+        }
+        std::copy(omega + i, omega + count, tail[ParticleArena::OMEGA]);
+        std::copy(weight + i, weight + count, tail[ParticleArena::WEIGHT]);
+        accumulateBlock(tail_state, tail[ParticleArena::OMEGA], tail[ParticleArena::WEIGHT], 0, pivot, sums);
+    }
+
+    Moments m;
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        m.weight += sums.weight[lane];
+        for (int a = 0; a < 6; ++a) {
+            m.first[a] += sums.first[a][lane];
+        }
+        for (int k = 0; k < 21; ++k) {
+            m.second[k] += sums.second[k][lane];
+        }
+        for (int k = 0; k < 2; ++k) {
+            m.accel[k] += sums.accel[k][lane];
+            m.turn[k] += sums.turn[k][lane];
+        }
+    }
+    for (int a = 0; a < 6; ++a) {
+        m.pivot[a] = pivot[a];
+    }
+    return m;
+}
+
+ParticleFilter::Moments ParticleFilter::slotMoments(uint32_t slot, size_t slices) {
+    // Deviations are taken from the first particle, common to all slices
+    std::array<float, 6> pivot;
+    for (int c = 0; c < 6; ++c) {
+        pivot[c] = arena_.data(slot, half_[slot], c)[0];
+    }
+
+    std::array<Moments, MAX_SLICES> partial;
+    runSlices(slices, [&](size_t s) {
+        const auto [begin, end] = sliceRange(s, slices);
+        partial[s] = momentsRange(slot, pivot, begin, end);
+    });
+    Moments m = partial[0];
+    for (size_t s = 1; s < slices; ++s) {
+        m.merge(partial[s]);
+    }
+    return m;
+}
+
+void ParticleFilter::combineSlot(uint32_t slot, Track& track, size_t slices) {
+    const Moments m = slotMoments(slot, slices);
+
+    const double inv_weight = 1.0 / m.weight;
+    double deviation[6];
+    double mean[6];
+    for (int a = 0; a < 6; ++a) {
+        deviation[a] = m.first[a] * inv_weight;
+        mean[a] = m.pivot[a] + deviation[a];
+    }
+
+    auto& origin = origin_[slot];
+    track.position = Point3D(origin[0] + mean[0], origin[1] + mean[1], origin[2] + mean[2]);
+    track.velocity = Point3D(mean[3], mean[4], mean[5]);
+    track.acceleration = Point3D(m.accel[0] * inv_weight, m.accel[1] * inv_weight, 0.0);
+
+    for (auto& row : track.covariance) {
+        std::fill(std::begin(row), std::end(row), 0.0);
+    }
+    for (int a = 0; a < 6; ++a) {
+        for (int b = a; b < 6; ++b) {
+            const double cov = m.second[upperIndex(a, b)] * inv_weight - deviation[a] * deviation[b];
+            track.covariance[a][b] = cov;
+            track.covariance[b][a] = cov;
+        }
+    }
+    const double acceleration_variance = config_.acceleration_noise * config_.acceleration_noise;
+    for (int i = 6; i < 9; ++i) {
+        track.covariance[i][i] = acceleration_variance;
+    }
+
+    // Re-centre so that float positions keep their resolution
+    const double offset = std::sqrt(mean[0] * mean[0] + mean[1] * mean[1] + mean[2] * mean[2]);
+    if (offset > config_.recenter_distance_m) {
+        const int active = half_[slot];
+        const size_t n = arena_.particles();
+        for (int c = 0; c < 3; ++c) {
+            const auto shift = static_cast<float>(mean[c]);
+            float* values = arena_.data(slot, active, c);
+            for (size_t i = 0; i < n; ++i) {
+                values[i] -= shift;
+            }
+            origin[c] += shift;
+        }
+    }
+}
+
+size_t ParticleFilter::sliceCount() const {
+    const size_t n = arena_.particles();
+    if (!thread_pool_ || thread_pool_->getThreadCount() < 2 || n < config_.split_min_particles) {
+        return 1;
+    }
+    const size_t slice = std::max<size_t>(config_.slice_size, 16);
+    return std::min(MAX_SLICES, (n + slice - 1) / slice);
+}
+
+std::pair<size_t, size_t> ParticleFilter::sliceRange(size_t slice, size_t slices) const {
+    const size_t n = arena_.particles();
+    if (slices <= 1) {
+        return {0, n};
+    }
+    // Slice starts stay on 16-float boundaries
+    const size_t per_slice = ((n + slices - 1) / slices + 15) & ~size_t(15);
+    const size_t begin = std::min(n, slice * per_slice);
+    return {begin, std::min(n, begin + per_slice)};
+}
+
+}  // namespace radar_tracking
@@ -0,0 +1,184 @@
+#include "tracking/SquareRootKalmanFilter.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace radar_tracking {
+
+namespace {
+
+template<typename Kernel>
+void exportFactors(Kernel& kernel, const std::string& tag, const std::vector<Track>& tracks,
+                   CheckpointSection& section) {
+    section.template begin<typename Kernel::Snapshot>(tag);
+    for (const auto& track : tracks) {
+        section.append(track.track_id, kernel.snapshot(track));
+    }
+}
+
+template<typename Kernel>
+bool importFactors(Kernel& kernel, const std::string& tag, const std::vector<Track>& tracks,
+                   const CheckpointSection& section) {
+    // Elements follow tracks one to one
+    if (!section.template matches<typename Kernel::Snapshot>(tag) || section.count != tracks.size()) {
+        return false;
+    }
+    typename Kernel::Snapshot snapshot;
+    uint32_t track_id = 0;
+    for (uint32_t i = 0; i < section.count; ++i) {
+        section.read(i, track_id, snapshot);
+        if (track_id == tracks[i].track_id) {
+            kernel.restore(tracks[i], snapshot);
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+void SquareRootKalmanFilter::Config::loadFromYaml(const YAML::Node& node) {
+    if (node["model"]) {
+        motion_model = node["model"]["type"].as<std::string>(motion_model);
+    }
+
+    auto params = node["parameters"];
+    if (params) {
+        process_noise = params["process_noise"].as<double>(process_noise);
+        measurement_noise = params["measurement_noise"].as<double>(measurement_noise);
+        initial_uncertainty = params["initial_uncertainty"].as<double>(initial_uncertainty);
+    }
+
+    auto quality = node["track_quality"];
+    if (quality) {
+        confirmation_hits = quality["confirmation_hits"].as<uint32_t>(confirmation_hits);
+        max_consecutive_misses = quality["max_consecutive_misses"].as<uint32_t>(max_consecutive_misses);
+        max_position_std = quality["max_position_std"].as<double>(max_position_std);
+    }
+}
+
+bool SquareRootKalmanFilter::Config::validate() const {
+    if (motion_model != "CV" && motion_model != "CA") {
+        LOG_ERROR("SRKF: model type must be CV or CA, got " + motion_model);
+        return false;
+    }
+    if (process_noise < 0.0 || measurement_noise <= 0.0 || initial_uncertainty <= 0.0) {
+        LOG_ERROR("SRKF: process_noise must be non-negative, measurement_noise and initial_uncertainty positive");
+        return false;
+    }
+    if (confirmation_hits == 0 || max_consecutive_misses == 0 || max_position_std <= 0.0) {
+        LOG_ERROR("SRKF: track quality thresholds must be positive");
+        return false;
+    }
+    return true;
+}
+
+SquareRootKalmanCVKernel::Params SquareRootKalmanFilter::Config::kernelParams() const {
+    SquareRootKalmanCVKernel::Params params;
+    params.process_noise = process_noise;
+    params.measurement_noise = measurement_noise;
+    params.initial_uncertainty = initial_uncertainty;
+    return params;
+}
+
+SquareRootKalmanFilter::SquareRootKalmanFilter(const Config& config) {
+    setConfig(config);
+}
+
+void SquareRootKalmanFilter::setConfig(const Config& config) {
+    config_ = config;
+    constant_acceleration_ = config_.motion_model == "CA";
+
+    const auto params = config_.kernelParams();
+    cv_kernel_ = SquareRootKalmanCVKernel(params);
+    SquareRootKalmanCAKernel::Params ca_params;
+    ca_params.process_noise = params.process_noise;
+    ca_params.measurement_noise = params.measurement_noise;
+    ca_params.initial_uncertainty = params.initial_uncertainty;
+    ca_kernel_ = SquareRootKalmanCAKernel(ca_params);
+}
+
+bool SquareRootKalmanFilter::initialize(const std::string& config_file) {
+    try {
+        Config config;
+        config.loadFromYaml(YAML::LoadFile(config_file));
+        if (!config.validate()) {
+            LOG_ERROR("Invalid SRKF configuration");
+            return false;
+        }
+        setConfig(config);
+
+        LOG_INFO("Square-root Kalman filter initialized (" + config_.motion_model + " model, float32 factors)");
+        return true;
+
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to initialize SRKF: " + std::string(e.what()));
+        return false;
+    }
+}
+
+void SquareRootKalmanFilter::predict(Track& track, double dt) {
+    if (constant_acceleration_) {
+        ca_kernel_.predict(track, dt);
+    } else {
+        cv_kernel_.predict(track, dt);
+    }
+}
+
+void SquareRootKalmanFilter::update(Track& track, const RadarDetection& detection) {
+    if (constant_acceleration_) {
+        ca_kernel_.update(track, detection);
+    } else {
+        cv_kernel_.update(track, detection);
+    }
+}
+
+double SquareRootKalmanFilter::getInnovationCovariance(const Track& track, const RadarDetection& detection) {
+    return cv_kernel_.mahalanobisSquared(track, detection);
+}
+
+Track SquareRootKalmanFilter::initializeTrack(const RadarDetection& detection) {
+    return cv_kernel_.initializeTrack(detection);
+}
+
+double SquareRootKalmanFilter::calculateQualityScore(const Track& track) const {
+    const double observations = static_cast<double>(track.hit_count + track.consecutive_misses);
+    const double hit_ratio = observations > 0.0 ? track.hit_count / observations : 0.0;
+
+    // Mean position standard deviation relative to the deletion limit
+    const double position_variance = (track.covariance[0][0] + track.covariance[1][1] + track.covariance[2][2]) / 3.0;
+    const double spread = std::sqrt(std::max(position_variance, 0.0)) / config_.max_position_std;
+    return std::clamp(hit_ratio * (1.0 - spread), 0.0, 1.0);
+}
+
+bool SquareRootKalmanFilter::shouldConfirmTrack(const Track& track) const {
+    return track.hit_count >= config_.confirmation_hits;
+}
+
+bool SquareRootKalmanFilter::shouldDeleteTrack(const Track& track) const {
+    if (track.consecutive_misses >= config_.max_consecutive_misses) {
+        return true;
+    }
+    const double max_variance = config_.max_position_std * config_.max_position_std;
+    return track.covariance[0][0] > max_variance || track.covariance[1][1] > max_variance ||
+           track.covariance[2][2] > max_variance;
+}
+
+void SquareRootKalmanFilter::exportState(const std::vector<Track>& tracks, CheckpointSection& section) {
+    if (constant_acceleration_) {
+        exportFactors(ca_kernel_, "SRKF-CA", tracks, section);
+    } else {
+        exportFactors(cv_kernel_, "SRKF-CV", tracks, section);
+    }
+}
+
+bool SquareRootKalmanFilter::importState(const std::vector<Track>& tracks, const CheckpointSection& section) {
+    return constant_acceleration_ ? importFactors(ca_kernel_, "SRKF-CA", tracks, section)
+                                  : importFactors(cv_kernel_, "SRKF-CV", tracks, section);
+}
+
+void SquareRootKalmanFilter::retainTracks(const std::vector<Track>& tracks) {
+    cv_kernel_.retainTracks(tracks);
+    ca_kernel_.retainTracks(tracks);
+}
+
+}  // namespace radar_tracking
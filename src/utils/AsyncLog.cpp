@@ -0,0 +1,233 @@
+#include "utils/AsyncLog.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace radar_tracking {
+
+namespace {
+
+/**
+ * @brief Holds the calling thread's buffer and marks it orphaned on thread exit
+ */
+template<typename Buffer>
+struct ThreadBufferHolder {
+    std::shared_ptr<Buffer> buffer;
+
+    ~ThreadBufferHolder() {
+        if (buffer) {
+            buffer->orphaned.store(true, std::memory_order_release);
+        }
+    }
+};
+
+size_t roundUpPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+
+}  // namespace
+
+void AsyncLog::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    enabled = node["enabled"].as<bool>(enabled);
+    buffer_kb = node["buffer_kb"].as<size_t>(buffer_kb);
+    flush_interval_ms = node["flush_interval_ms"].as<uint32_t>(flush_interval_ms);
+}
+
+uint8_t* AsyncLog::Buffer::reserve(size_t size) {
+    const uint64_t current = head.load(std::memory_order_relaxed);
+    const uint64_t capacity = mask + 1;
+    const uint64_t offset = current & mask;
+    const uint64_t to_end = capacity - offset;
+    const uint64_t needed = size + (to_end < size ? to_end : 0);
+
+    if (current + needed - cached_tail > capacity) {
+        cached_tail = tail.load(std::memory_order_acquire);
+        if (current + needed - cached_tail > capacity) {
+            return nullptr;
+        }
+    }
+
+    if (to_end < size) {
+        // Records are contiguous: mark the rest of the ring as skipped
+        const uint32_t wrap = 0;
+        std::memcpy(data.data() + offset, &wrap, sizeof(wrap));
+        reserved_head = current + to_end + size;
+        return data.data();
+    }
+    reserved_head = current + size;
+    return data.data() + offset;
+}
+
+AsyncLog::~AsyncLog() {
+    stop();
+}
+
+bool AsyncLog::start(const Config& config, std::shared_ptr<spdlog::logger> sink) {
+    if (!sink) {
+        return false;
+    }
+    stop();
+
+    config_ = config;
+    sink_ = std::move(sink);
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex_);
+        stop_requested_ = false;
+    }
+    worker_ = std::thread(&AsyncLog::run, this);
+    running_.store(true, std::memory_order_release);
+    return true;
+}
+
+void AsyncLog::stop() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    running_.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex_);
+        stop_requested_ = true;
+    }
+    worker_cv_.notify_one();
+    worker_.join();
+    drain();
+    if (sink_) {
+        sink_->flush();
+    }
+}
+
+void AsyncLog::flush() {
+    drain();
+    if (sink_) {
+        sink_->flush();
+    }
+}
+
+AsyncLog::Stats AsyncLog::getStats() {
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(drain_mutex_);
+        stats.written = written_;
+    }
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    stats.dropped = retired_dropped_;
+    for (const auto& buffer : buffers_) {
+        stats.dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    stats.threads = buffers_.size();
+    return stats;
+}
+
+AsyncLog::Buffer* AsyncLog::threadBuffer() {
+    thread_local ThreadBufferHolder<Buffer> holder;
+    if (!holder.buffer) {
+        holder.buffer = getInstance().registerBuffer();
+    }
+    return holder.buffer.get();
+}
+
+std::shared_ptr<AsyncLog::Buffer> AsyncLog::registerBuffer() {
+    const size_t capacity = roundUpPowerOfTwo(std::max<size_t>(config_.buffer_kb, 1) * 1024);
+    auto buffer = std::make_shared<Buffer>(capacity);
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    buffers_.push_back(buffer);
+    return buffer;
+}
+
+void AsyncLog::run() {
+    std::unique_lock<std::mutex> lock(worker_mutex_);
+    while (!stop_requested_) {
+        worker_cv_.wait_for(lock, std::chrono::milliseconds(config_.flush_interval_ms),
+                            [this] { return stop_requested_; });
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+void AsyncLog::drain() {
+    std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        buffers = buffers_;
+    }
+
+    batch_.clear();
+    for (const auto& buffer : buffers) {
+        drainBuffer(*buffer);
+    }
+
+    // Buffers of exited threads are released once empty
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+            [this](const std::shared_ptr<Buffer>& buffer) {
+                const bool released = buffer->orphaned.load(std::memory_order_acquire) &&
+                    buffer->tail.load(std::memory_order_relaxed) == buffer->head.load(std::memory_order_acquire);
+                if (released) {
+                    retired_dropped_ += buffer->dropped.load(std::memory_order_relaxed);
+                }
+                return released;
+            }), buffers_.end());
+    }
+
+    if (batch_.empty() || !sink_) {
+        return;
+    }
+    std::stable_sort(batch_.begin(), batch_.end(),
+                     [](const Entry& a, const Entry& b) { return a.timestamp < b.timestamp; });
+    for (const auto& entry : batch_) {
+        const spdlog::log_clock::time_point time{spdlog::log_clock::duration(entry.timestamp)};
+        sink_->log(time, spdlog::source_loc{entry.site->file, entry.site->line, ""}, entry.site->level,
+                   spdlog::string_view_t(entry.message));
+    }
+    written_ += batch_.size();
+}
+
+void AsyncLog::drainBuffer(Buffer& buffer) {
+    uint64_t position = buffer.tail.load(std::memory_order_relaxed);
+    const uint64_t end = buffer.head.load(std::memory_order_acquire);
+    const uint64_t capacity = buffer.mask + 1;
+    fmt::memory_buffer text;
+
+    while (position < end) {
+        const uint64_t offset = position & buffer.mask;
+        const uint8_t* record = buffer.data.data() + offset;
+        uint32_t size;
+        std::memcpy(&size, record, sizeof(size));
+        if (size == 0) {
+            position += capacity - offset;
+            continue;
+        }
+
+        RecordHeader header;
+        std::memcpy(&header, record, sizeof(header));
+        text.clear();
+        try {
+            header.format_fn(header.format, record + sizeof(header), text);
+        } catch (const std::exception& e) {
+            text.clear();
+            fmt::format_to(std::back_inserter(text), "[bad log format '{}': {}]", header.format, e.what());
+        }
+        batch_.push_back(Entry{header.timestamp, header.site, fmt::to_string(text)});
+        position += size;
+    }
+    buffer.tail.store(position, std::memory_order_release);
+}
+
+void AsyncLog::logSynchronously(const Site& site, const std::string& message) {
+    if (auto* logger = Logger::systemLogger()) {
+        logger->log(spdlog::source_loc{site.file, site.line, ""}, site.level, message);
+    }
+}
+
+}  // namespace radar_tracking
@@ -5,13 +5,15 @@
 
 namespace radar_tracking {
 
-std::unique_ptr<ConfigManager> ConfigManager::instance_ = nullptr;
-
 bool ConfigManager::loadConfig(const std::string& config_file) {
     try {
         config_file_path_ = config_file;
-        config_ = YAML::LoadFile(config_file);
-        return validateConfig();
+        auto config = std::make_shared<const YAML::Node>(YAML::LoadFile(config_file));
+        if (!validateConfig(*config)) {
+            return false;
+        }
+        std::atomic_store(&config_, std::shared_ptr<const YAML::Node>(std::move(config)));
+        return true;
     } catch (const YAML::Exception& e) {
         std::cerr << "YAML error loading config file " << config_file << ": " << e.what() << std::endl;
         return false;
@@ -29,25 +31,29 @@ bool ConfigManager::reloadConfig() {
 }
 
 bool ConfigManager::validateConfig() const {
+    return validateConfig(*root());
+}
+
+bool ConfigManager::validateConfig(const YAML::Node& config) const {
     try {
         // Validate required sections exist
-        if (!config_["system"]) {
+        if (!config["system"]) {
             std::cerr << "Missing required 'system' configuration section" << std::endl;
             return false;
         }
         
-        if (!config_["algorithms"]) {
+        if (!config["algorithms"]) {
             std::cerr << "Missing required 'algorithms' configuration section" << std::endl;
             return false;
         }
         
-        if (!config_["communication"]) {
+        if (!config["communication"]) {
             std::cerr << "Missing required 'communication' configuration section" << std::endl;
             return false;
         }
         
         // Validate system section
-        auto system = config_["system"];
+        auto system = config["system"];
         if (!system["tracking_mode"] || !system["max_tracks"] || !system["update_rate_hz"]) {
             std::cerr << "Missing required fields in 'system' section" << std::endl;
             return false;
@@ -61,7 +67,7 @@ bool ConfigManager::validateConfig() const {
         }
         
         // Validate algorithms section
-        auto algorithms = config_["algorithms"];
+        auto algorithms = config["algorithms"];
         if (!algorithms["clustering"] || !algorithms["association"] || !algorithms["tracking"]) {
             std::cerr << "Missing required algorithm configurations" << std::endl;
             return false;
@@ -77,12 +83,12 @@ bool ConfigManager::validateConfig() const {
 }
 
 YAML::Node ConfigManager::getNode(const std::string& key) const {
-    return getValueFromPath(config_, key);
+    return getValueFromPath(*root(), key);
 }
 
 bool ConfigManager::hasKey(const std::string& key) const {
     try {
-        auto node = getValueFromPath(config_, key);
+        auto node = getValueFromPath(*root(), key);
         return node.IsDefined() && !node.IsNull();
     } catch (...) {
         return false;
@@ -0,0 +1,417 @@
+#include "utils/DataRecorder.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <boost/filesystem.hpp>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef ENABLE_LZ4
+    #include <lz4.h>
+#endif
+
+namespace radar_tracking {
+
+using namespace recording;
+
+namespace {
+
+template<typename T>
+void appendPod(std::vector<uint8_t>& buffer, const T& value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void beginFrame(std::vector<uint8_t>& buffer, RecordType type) {
+    FrameHeader header{};
+    header.magic = FRAME_MAGIC;
+    header.type = type;
+    header.timestamp_ns = toNanoseconds(std::chrono::high_resolution_clock::now());
+    buffer.clear();
+    appendPod(buffer, header);
+}
+
+}  // namespace
+
+void DataRecorder::Config::loadFromYaml(const YAML::Node& node) {
+    if (!node) {
+        return;
+    }
+    output_path = node["output_path"].as<std::string>(output_path);
+    file_prefix = node["file_prefix"].as<std::string>(file_prefix);
+    segment_size_mb = node["segment_size_mb"].as<size_t>(segment_size_mb);
+    queue_capacity = node["queue_capacity"].as<size_t>(queue_capacity);
+    index_interval_ms = node["index_interval_ms"].as<int>(index_interval_ms);
+    compression = node["compression"].as<std::string>(compression);
+    min_compress_bytes = node["min_compress_bytes"].as<size_t>(min_compress_bytes);
+    record_detections = node["record_detections"].as<bool>(record_detections);
+    record_clusters = node["record_clusters"].as<bool>(record_clusters);
+    record_tracks = node["record_tracks"].as<bool>(record_tracks);
+    record_stats = node["record_stats"].as<bool>(record_stats);
+    record_raw = node["record_raw"].as<bool>(record_raw);
+}
+
+bool DataRecorder::Config::validate() const {
+    if (segment_size_mb == 0) {
+        return false;
+    }
+    if (queue_capacity < 2 || (queue_capacity & (queue_capacity - 1)) != 0) {
+        return false;
+    }
+    if (index_interval_ms < 0) {
+        return false;
+    }
+    return compression == "none" || compression == "lz4";
+}
+
+DataRecorder::~DataRecorder() {
+    stop();
+}
+
+bool DataRecorder::initialize(const Config& config) {
+#ifdef _WIN32
+    (void)config;
+    LOG_ERROR("DataRecorder: memory-mapped segments are not supported on Windows");
+    return false;
+#else
+    if (!config.validate()) {
+        LOG_ERROR("DataRecorder: invalid configuration");
+        return false;
+    }
+#ifndef ENABLE_LZ4
+    if (config.compression == "lz4") {
+        LOG_WARN("DataRecorder: built without LZ4 support, recording uncompressed");
+    }
+#endif
+
+    config_ = config;
+    frame_queue_ = std::make_unique<LockFreeQueue<std::vector<uint8_t>>>(config_.queue_capacity);
+    free_buffers_ = std::make_unique<LockFreeQueue<std::vector<uint8_t>>>(config_.queue_capacity);
+
+    try {
+        boost::filesystem::create_directories(config_.output_path);
+    } catch (const std::exception& e) {
+        LOG_ERROR("DataRecorder: cannot create " + config_.output_path + ": " + e.what());
+        return false;
+    }
+
+    std::time_t now = std::time(nullptr);
+    std::ostringstream base;
+    base << config_.output_path;
+    if (!config_.output_path.empty() && config_.output_path.back() != '/') {
+        base << '/';
+    }
+    base << config_.file_prefix << '_' << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S");
+    session_base_ = base.str();
+
+    LOG_INFO("DataRecorder initialized, writing to " + session_base_ + "_*.rec");
+    return true;
+#endif
+}
+
+void DataRecorder::start() {
+    if (running_ || !frame_queue_) {
+        return;
+    }
+    running_ = true;
+    writer_thread_ = std::thread(&DataRecorder::writerLoop, this);
+}
+
+void DataRecorder::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+}
+
+bool DataRecorder::recordDetections(const std::vector<RadarDetection>& detections) {
+    if (!running_ || !config_.record_detections) {
+        return false;
+    }
+
+    auto buffer = acquireBuffer();
+    beginFrame(buffer, RecordType::DETECTIONS);
+    buffer.reserve(buffer.size() + sizeof(uint32_t) + detections.size() * sizeof(DetectionRecord));
+    appendPod(buffer, static_cast<uint32_t>(detections.size()));
+
+    for (const auto& detection : detections) {
+        appendPod(buffer, toRecord(detection));
+    }
+
+    return enqueueFrame(buffer);
+}
+
+bool DataRecorder::recordClusters(const std::vector<Cluster>& clusters) {
+    if (!running_ || !config_.record_clusters) {
+        return false;
+    }
+
+    auto buffer = acquireBuffer();
+    beginFrame(buffer, RecordType::CLUSTERS);
+    appendPod(buffer, static_cast<uint32_t>(clusters.size()));
+
+    for (const auto& cluster : clusters) {
+        appendPod(buffer, toRecord(cluster));
+        for (const auto& detection : cluster.detections) {
+            appendPod(buffer, detection.detection_id);
+        }
+    }
+
+    return enqueueFrame(buffer);
+}
+
+bool DataRecorder::recordTracks(const std::vector<Track>& tracks) {
+    if (!running_ || !config_.record_tracks) {
+        return false;
+    }
+
+    auto buffer = acquireBuffer();
+    beginFrame(buffer, RecordType::TRACKS);
+    buffer.reserve(buffer.size() + sizeof(uint32_t) + tracks.size() * sizeof(TrackRecord));
+    appendPod(buffer, static_cast<uint32_t>(tracks.size()));
+
+    for (const auto& track : tracks) {
+        appendPod(buffer, toRecord(track));
+    }
+
+    return enqueueFrame(buffer);
+}
+
+bool DataRecorder::recordStats(const SystemStats& stats) {
+    if (!running_ || !config_.record_stats) {
+        return false;
+    }
+
+    auto buffer = acquireBuffer();
+    beginFrame(buffer, RecordType::STATS);
+
+    appendPod(buffer, toRecord(stats));
+
+    return enqueueFrame(buffer);
+}
+
+bool DataRecorder::recordRaw(const std::vector<uint8_t>& data) {
+    if (!running_ || !config_.record_raw) {
+        return false;
+    }
+
+    auto buffer = acquireBuffer();
+    beginFrame(buffer, RecordType::RAW);
+    buffer.insert(buffer.end(), data.begin(), data.end());
+
+    return enqueueFrame(buffer);
+}
+
+DataRecorder::RecorderStats DataRecorder::getStats() const {
+    RecorderStats stats;
+    stats.frames_written = frames_written_;
+    stats.frames_dropped = frames_dropped_;
+    stats.bytes_written = bytes_written_;
+    stats.bytes_uncompressed = bytes_uncompressed_;
+    stats.segments_written = segments_written_;
+    stats.queue_depth = frame_queue_ ? frame_queue_->sizeApprox() : 0;
+    return stats;
+}
+
+std::vector<uint8_t> DataRecorder::acquireBuffer() {
+    std::vector<uint8_t> buffer;
+    free_buffers_->tryPop(buffer);
+    return buffer;
+}
+
+bool DataRecorder::enqueueFrame(std::vector<uint8_t>& buffer) {
+    auto* header = reinterpret_cast<FrameHeader*>(buffer.data());
+    header->raw_size = static_cast<uint32_t>(buffer.size() - sizeof(FrameHeader));
+    header->payload_size = header->raw_size;
+
+    if (!frame_queue_->tryPush(buffer)) {
+        frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void DataRecorder::writerLoop() {
+#ifndef _WIN32
+    LOG_INFO("DataRecorder writer thread started");
+
+    std::vector<uint8_t> buffer;
+    int idle_spins = 0;
+
+    while (true) {
+        if (frame_queue_->tryPop(buffer)) {
+            idle_spins = 0;
+            writeFrame(buffer);
+            buffer.clear();
+            free_buffers_->tryPush(buffer);
+            continue;
+        }
+
+        if (!running_) {
+            break;  // Queue drained after stop request
+        }
+
+        // Producers never signal the writer, so back off progressively
+        if (++idle_spins < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    closeSegment();
+    LOG_INFO("DataRecorder writer thread stopped, " + std::to_string(frames_written_.load()) +
+             " frames written, " + std::to_string(frames_dropped_.load()) + " dropped");
+#endif
+}
+
+void DataRecorder::writeFrame(std::vector<uint8_t>& buffer) {
+    auto* header = reinterpret_cast<FrameHeader*>(buffer.data());
+    const uint8_t* payload = buffer.data() + sizeof(FrameHeader);
+    size_t payload_size = header->raw_size;
+
+#ifdef ENABLE_LZ4
+    if (config_.compression == "lz4" && payload_size >= config_.min_compress_bytes) {
+        compress_buffer_.resize(LZ4_compressBound(static_cast<int>(payload_size)));
+        int compressed = LZ4_compress_default(
+            reinterpret_cast<const char*>(payload),
+            reinterpret_cast<char*>(compress_buffer_.data()),
+            static_cast<int>(payload_size),
+            static_cast<int>(compress_buffer_.size()));
+        if (compressed > 0 && static_cast<size_t>(compressed) < payload_size) {
+            header->flags |= FRAME_FLAG_LZ4;
+            payload = compress_buffer_.data();
+            payload_size = static_cast<size_t>(compressed);
+        }
+    }
+#endif
+    header->payload_size = static_cast<uint32_t>(payload_size);
+
+    size_t frame_size = sizeof(FrameHeader) + payload_size;
+    if (!segment_data_ || segment_offset_ + frame_size > segment_capacity_) {
+        closeSegment();
+        if (!openSegment(frame_size)) {
+            frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    int64_t interval_ns = static_cast<int64_t>(config_.index_interval_ms) * 1000000;
+    if (segment_index_entries_.empty() || header->timestamp_ns - last_index_ns_ >= interval_ns) {
+        segment_index_entries_.push_back({header->timestamp_ns, segment_offset_});
+        last_index_ns_ = header->timestamp_ns;
+    }
+
+    std::memcpy(segment_data_ + segment_offset_, header, sizeof(FrameHeader));
+    std::memcpy(segment_data_ + segment_offset_ + sizeof(FrameHeader), payload, payload_size);
+    segment_offset_ += frame_size;
+
+    frames_written_.fetch_add(1, std::memory_order_relaxed);
+    bytes_written_.fetch_add(frame_size, std::memory_order_relaxed);
+    bytes_uncompressed_.fetch_add(sizeof(FrameHeader) + header->raw_size, std::memory_order_relaxed);
+}
+
+bool DataRecorder::openSegment(size_t min_size) {
+#ifdef _WIN32
+    (void)min_size;
+    return false;
+#else
+    size_t capacity = std::max(config_.segment_size_mb * 1024 * 1024,
+                               min_size + sizeof(SegmentHeader));
+    std::string path = segmentPath(++segment_index_, ".rec");
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG_ERROR("DataRecorder: cannot create segment " + path + ": " + std::strerror(errno));
+        return false;
+    }
+
+    // Reserve the blocks up front so page faults never wait on allocation
+    int rc = ::posix_fallocate(fd, 0, static_cast<off_t>(capacity));
+    if (rc != 0 && ::ftruncate(fd, static_cast<off_t>(capacity)) != 0) {
+        LOG_ERROR("DataRecorder: cannot preallocate segment " + path);
+        ::close(fd);
+        return false;
+    }
+
+    void* data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        LOG_ERROR("DataRecorder: mmap failed for " + path + ": " + std::strerror(errno));
+        ::close(fd);
+        return false;
+    }
+    ::madvise(data, capacity, MADV_SEQUENTIAL);
+
+    segment_fd_ = fd;
+    segment_data_ = static_cast<uint8_t*>(data);
+    segment_capacity_ = capacity;
+    segment_index_entries_.clear();
+    last_index_ns_ = 0;
+
+    SegmentHeader header{};
+    header.magic = SEGMENT_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.segment_index = segment_index_;
+    header.created_ns = toNanoseconds(std::chrono::high_resolution_clock::now());
+    std::memcpy(segment_data_, &header, sizeof(header));
+    segment_offset_ = sizeof(header);
+
+    LOG_DEBUG("DataRecorder opened segment " + path);
+    return true;
+#endif
+}
+
+void DataRecorder::closeSegment() {
+#ifndef _WIN32
+    if (!segment_data_) {
+        return;
+    }
+
+    ::msync(segment_data_, segment_offset_, MS_ASYNC);
+    ::munmap(segment_data_, segment_capacity_);
+    if (::ftruncate(segment_fd_, static_cast<off_t>(segment_offset_)) != 0) {
+        LOG_WARN("DataRecorder: failed to trim segment " + segmentPath(segment_index_, ".rec"));
+    }
+    ::close(segment_fd_);
+
+    writeIndexFile();
+
+    segment_fd_ = -1;
+    segment_data_ = nullptr;
+    segment_capacity_ = 0;
+    segment_offset_ = 0;
+    segments_written_.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+void DataRecorder::writeIndexFile() const {
+    std::string path = segmentPath(segment_index_, ".idx");
+    std::ofstream index(path, std::ios::binary | std::ios::trunc);
+    if (!index) {
+        LOG_WARN("DataRecorder: cannot write index " + path);
+        return;
+    }
+    index.write(reinterpret_cast<const char*>(segment_index_entries_.data()),
+                static_cast<std::streamsize>(segment_index_entries_.size() * sizeof(IndexEntry)));
+}
+
+std::string DataRecorder::segmentPath(uint32_t index, const char* extension) const {
+    std::ostringstream path;
+    path << session_base_ << '_' << std::setw(6) << std::setfill('0') << index << extension;
+    return path.str();
+}
+
+}  // namespace radar_tracking
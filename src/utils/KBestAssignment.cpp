@@ -0,0 +1,135 @@
+#include "utils/KBestAssignment.hpp"
+#include <limits>
+#include <queue>
+
+namespace radar_tracking {
+
+double KBestAssignment::solve(const Eigen::MatrixXd& cost, std::vector<int>& row_to_col) {
+    const int n = static_cast<int>(cost.rows());
+    const int m = static_cast<int>(cost.cols());
+    row_to_col.assign(n, -1);
+    if (n == 0) {
+        return 0.0;
+    }
+    if (n > m) {
+        return FORBIDDEN;
+    }
+
+    // Shortest augmenting path with row/column potentials (1-based, column 0 is virtual)
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> u(n + 1, 0.0), v(m + 1, 0.0), min_slack(m + 1);
+    std::vector<int> col_owner(m + 1, 0), way(m + 1, 0);
+    std::vector<char> used(m + 1);
+
+    for (int i = 1; i <= n; ++i) {
+        col_owner[0] = i;
+        int j0 = 0;
+        std::fill(min_slack.begin(), min_slack.end(), inf);
+        std::fill(used.begin(), used.end(), 0);
+
+        do {
+            used[j0] = 1;
+            const int i0 = col_owner[j0];
+            double delta = inf;
+            int j1 = 0;
+            for (int j = 1; j <= m; ++j) {
+                if (used[j]) {
+                    continue;
+                }
+                const double reduced = cost(i0 - 1, j - 1) - u[i0] - v[j];
+                if (reduced < min_slack[j]) {
+                    min_slack[j] = reduced;
+                    way[j] = j0;
+                }
+                if (min_slack[j] < delta) {
+                    delta = min_slack[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= m; ++j) {
+                if (used[j]) {
+                    u[col_owner[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    min_slack[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (col_owner[j0] != 0);
+
+        do {
+            const int j1 = way[j0];
+            col_owner[j0] = col_owner[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    double total = 0.0;
+    for (int j = 1; j <= m; ++j) {
+        if (col_owner[j] != 0) {
+            row_to_col[col_owner[j] - 1] = j - 1;
+            total += cost(col_owner[j] - 1, j - 1);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        if (cost(i, row_to_col[i]) >= FORBIDDEN) {
+            return FORBIDDEN;
+        }
+    }
+    return total;
+}
+
+std::vector<KBestAssignment::Solution> KBestAssignment::murty(const Eigen::MatrixXd& cost, size_t k,
+                                                              std::chrono::steady_clock::time_point deadline) {
+    struct Node {
+        Eigen::MatrixXd cost;
+        Solution solution;
+        int fixed_rows;  ///< Rows [0, fixed_rows) are forced to their current column
+    };
+    auto worse = [](const Node& a, const Node& b) { return a.solution.cost > b.solution.cost; };
+    std::priority_queue<Node, std::vector<Node>, decltype(worse)> open(worse);
+
+    std::vector<Solution> solutions;
+    if (k == 0) {
+        return solutions;
+    }
+
+    Node root{cost, {}, 0};
+    root.solution.cost = solve(root.cost, root.solution.row_to_col);
+    if (!isFeasible(root.solution.cost)) {
+        return solutions;
+    }
+    open.push(std::move(root));
+
+    const int rows = static_cast<int>(cost.rows());
+    while (!open.empty() && solutions.size() < k) {
+        Node node = open.top();
+        open.pop();
+        solutions.push_back(node.solution);
+
+        if (solutions.size() >= k || std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+
+        // Partition the remaining solution space of this node (Murty 1968)
+        Eigen::MatrixXd constrained = node.cost;
+        const auto& assigned = node.solution.row_to_col;
+        for (int r = node.fixed_rows; r < rows; ++r) {
+            Node child{constrained, {}, r};
+            child.cost(r, assigned[r]) = FORBIDDEN;
+            child.solution.cost = solve(child.cost, child.solution.row_to_col);
+            if (isFeasible(child.solution.cost)) {
+                open.push(std::move(child));
+            }
+
+            // Force row r to its assigned column for the next partitions
+            const double keep = constrained(r, assigned[r]);
+            constrained.row(r).setConstant(FORBIDDEN);
+            constrained.col(assigned[r]).setConstant(FORBIDDEN);
+            constrained(r, assigned[r]) = keep;
+        }
+    }
+    return solutions;
+}
+
+}  // namespace radar_tracking
@@ -4,8 +4,6 @@
 
 namespace radar_tracking {
 
-std::unique_ptr<Logger> Logger::instance_ = nullptr;
-
 bool Logger::initialize(const std::string& config_file) {
     try {
         auto& config = ConfigManager::getInstance();
@@ -21,6 +19,7 @@ bool Logger::initialize(const std::string& config_file) {
         int max_files = config.get<int>("logging.max_files", 10);
         bool enable_data_logging = config.get<bool>("logging.enable_data_logging", true);
         std::string data_log_path = config.get<std::string>("logging.data_log_path", "logs/data/");
+        std::string data_format = config.get<std::string>("logging.data_format", "text");
         
         // Convert string log level to spdlog level
         spdlog::level::level_enum level = spdlog::level::info;
@@ -42,8 +41,8 @@ bool Logger::initialize(const std::string& config_file) {
         system_logger_->set_level(level);
         spdlog::register_logger(system_logger_);
         
-        // Create data logger if enabled
-        if (enable_data_logging) {
+        // Create text data logger if enabled; binary data goes through DataRecorder
+        if (enable_data_logging && data_format == "text") {
             auto data_file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
                 data_log_path + "data.log", max_file_size * 1024 * 1024, max_files);
             data_file_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] %v");
@@ -64,6 +63,16 @@ bool Logger::initialize(const std::string& config_file) {
         
         // Set default logger
         spdlog::set_default_logger(system_logger_);
+
+        system_raw_.store(system_logger_.get(), std::memory_order_release);
+        data_raw_.store(data_logger_.get(), std::memory_order_release);
+        perf_raw_.store(perf_logger_.get(), std::memory_order_release);
+
+        AsyncLog::Config async_config;
+        async_config.loadFromYaml(config.getNode("logging")["async"]);
+        if (async_config.enabled) {
+            AsyncLog::getInstance().start(async_config, system_logger_);
+        }
         
         initialized_ = true;
         return true;
@@ -0,0 +1,53 @@
+#include "utils/MemoryPool.hpp"
+#include <algorithm>
+
+namespace radar_tracking {
+
+MemoryPool::MemoryPool(size_t block_size, size_t blocks_per_chunk)
+    : blocks_per_chunk_(std::max<size_t>(blocks_per_chunk, 1)) {
+    // Every block must hold the free-list link and keep the next block aligned
+    const size_t alignment = alignof(std::max_align_t);
+    block_size_ = std::max(block_size, sizeof(FreeBlock));
+    block_size_ = (block_size_ + alignment - 1) / alignment * alignment;
+}
+
+void* MemoryPool::allocate() {
+    if (!free_list_) {
+        addChunk();
+    }
+    FreeBlock* block = free_list_;
+    free_list_ = block->next;
+    ++allocated_;
+    return block;
+}
+
+void MemoryPool::deallocate(void* block) {
+    if (!block) {
+        return;
+    }
+    auto* free_block = static_cast<FreeBlock*>(block);
+    free_block->next = free_list_;
+    free_list_ = free_block;
+    --allocated_;
+}
+
+void MemoryPool::reserve(size_t blocks) {
+    while (getCapacity() < blocks) {
+        addChunk();
+    }
+}
+
+void MemoryPool::addChunk() {
+    // new[] storage is aligned for any fundamental type
+    chunks_.emplace_back(new unsigned char[block_size_ * blocks_per_chunk_]);
+    unsigned char* base = chunks_.back().get();
+
+    // Link in reverse so blocks are handed out in address order
+    for (size_t i = blocks_per_chunk_; i-- > 0;) {
+        auto* block = reinterpret_cast<FreeBlock*>(base + i * block_size_);
+        block->next = free_list_;
+        free_list_ = block;
+    }
+}
+
+}  // namespace radar_tracking
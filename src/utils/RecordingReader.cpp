@@ -0,0 +1,363 @@
+#include "utils/RecordingReader.hpp"
+#include "utils/Logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+#include <boost/filesystem.hpp>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef ENABLE_LZ4
+    #include <lz4.h>
+#endif
+
+namespace radar_tracking {
+
+using namespace recording;
+
+namespace {
+
+template<typename T>
+bool readPod(const uint8_t*& cursor, const uint8_t* end, T& value) {
+    if (cursor + sizeof(T) > end) {
+        return false;
+    }
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+}  // namespace
+
+RecordingReader::~RecordingReader() {
+    close();
+}
+
+bool RecordingReader::open(const std::string& path) {
+    close();
+
+    // Accept either the session base or one of its segment files
+    std::string base = path;
+    static const std::regex segment_suffix("_[0-9]{6}\\.(rec|idx)$");
+    base = std::regex_replace(base, segment_suffix, "");
+
+    for (uint32_t index = 1;; ++index) {
+        std::ostringstream segment_path;
+        segment_path << base << '_' << std::setw(6) << std::setfill('0') << index << ".rec";
+        if (!boost::filesystem::exists(segment_path.str())) {
+            break;
+        }
+
+        Segment segment;
+        if (!mapSegment(segment_path.str(), segment)) {
+            close();
+            return false;
+        }
+        segments_.push_back(std::move(segment));
+    }
+
+    if (segments_.empty()) {
+        LOG_ERROR("RecordingReader: no segments found for " + base);
+        return false;
+    }
+
+    rewind();
+    LOG_INFO("RecordingReader opened " + base + " (" + std::to_string(segments_.size()) + " segments)");
+    return true;
+}
+
+void RecordingReader::close() {
+#ifndef _WIN32
+    for (auto& segment : segments_) {
+        if (segment.data) {
+            ::munmap(const_cast<uint8_t*>(segment.data), segment.size);
+        }
+        if (segment.fd >= 0) {
+            ::close(segment.fd);
+        }
+    }
+#endif
+    segments_.clear();
+    current_segment_ = 0;
+    current_offset_ = 0;
+}
+
+bool RecordingReader::next(FrameView& frame) {
+    while (current_segment_ < segments_.size()) {
+        size_t frame_size = 0;
+        if (readFrameAt(current_segment_, current_offset_, frame, frame_size)) {
+            current_offset_ += frame_size;
+            return true;
+        }
+        ++current_segment_;
+        current_offset_ = sizeof(SegmentHeader);
+    }
+    return false;
+}
+
+bool RecordingReader::seek(int64_t timestamp_ns) {
+    if (segments_.empty()) {
+        return false;
+    }
+
+    // Last segment starting at or before the target
+    auto seg_it = std::upper_bound(segments_.begin(), segments_.end(), timestamp_ns,
+        [](int64_t ts, const Segment& segment) { return ts < segment.first_ns; });
+    size_t seg = seg_it == segments_.begin() ? 0 : static_cast<size_t>(seg_it - segments_.begin()) - 1;
+
+    // Last index entry at or before the target, then scan forward
+    const auto& index = segments_[seg].index;
+    auto idx_it = std::upper_bound(index.begin(), index.end(), timestamp_ns,
+        [](int64_t ts, const IndexEntry& entry) { return ts < entry.timestamp_ns; });
+    current_segment_ = seg;
+    current_offset_ = idx_it == index.begin() ? sizeof(SegmentHeader) : std::prev(idx_it)->offset;
+
+    while (current_segment_ < segments_.size()) {
+        FrameView frame;
+        size_t frame_size = 0;
+        if (!readFrameAt(current_segment_, current_offset_, frame, frame_size)) {
+            ++current_segment_;
+            current_offset_ = sizeof(SegmentHeader);
+            continue;
+        }
+        if (frame.timestamp_ns >= timestamp_ns) {
+            return true;
+        }
+        current_offset_ += frame_size;
+    }
+    return false;
+}
+
+void RecordingReader::rewind() {
+    current_segment_ = 0;
+    current_offset_ = sizeof(SegmentHeader);
+}
+
+int64_t RecordingReader::getStartTime() const {
+    return segments_.empty() ? 0 : segments_.front().first_ns;
+}
+
+std::vector<RadarDetection> RecordingReader::decodeDetections(const FrameView& frame) {
+    std::vector<RadarDetection> detections;
+    const uint8_t* cursor = frame.payload;
+    const uint8_t* end = frame.payload + frame.size;
+
+    uint32_t count = 0;
+    if (frame.type != RecordType::DETECTIONS || !readPod(cursor, end, count)) {
+        return detections;
+    }
+
+    detections.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        DetectionRecord record;
+        if (!readPod(cursor, end, record)) {
+            break;
+        }
+        RadarDetection detection;
+        detection.position = Point3D(record.position[0], record.position[1], record.position[2]);
+        detection.velocity = Point3D(record.velocity[0], record.velocity[1], record.velocity[2]);
+        detection.range = record.range;
+        detection.azimuth = record.azimuth;
+        detection.elevation = record.elevation;
+        detection.snr = record.snr;
+        detection.rcs = record.rcs;
+        detection.timestamp = fromNanoseconds(record.timestamp_ns);
+        detection.detection_id = record.detection_id;
+        detection.beam_id = record.beam_id;
+        detections.push_back(detection);
+    }
+    return detections;
+}
+
+std::vector<Cluster> RecordingReader::decodeClusters(const FrameView& frame) {
+    std::vector<Cluster> clusters;
+    const uint8_t* cursor = frame.payload;
+    const uint8_t* end = frame.payload + frame.size;
+
+    uint32_t count = 0;
+    if (frame.type != RecordType::CLUSTERS || !readPod(cursor, end, count)) {
+        return clusters;
+    }
+
+    clusters.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        ClusterRecord record;
+        if (!readPod(cursor, end, record)) {
+            break;
+        }
+        Cluster cluster;
+        cluster.cluster_id = record.cluster_id;
+        cluster.centroid = Point3D(record.centroid[0], record.centroid[1], record.centroid[2]);
+        cluster.confidence = record.confidence;
+        cluster.density = record.density;
+
+        // Only detection ids are recorded; the detections frame holds the rest
+        cluster.detections.resize(record.detection_count);
+        for (auto& detection : cluster.detections) {
+            readPod(cursor, end, detection.detection_id);
+        }
+        clusters.push_back(std::move(cluster));
+    }
+    return clusters;
+}
+
+std::vector<Track> RecordingReader::decodeTracks(const FrameView& frame) {
+    std::vector<Track> tracks;
+    const uint8_t* cursor = frame.payload;
+    const uint8_t* end = frame.payload + frame.size;
+
+    uint32_t count = 0;
+    if (frame.type != RecordType::TRACKS || !readPod(cursor, end, count)) {
+        return tracks;
+    }
+
+    tracks.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        TrackRecord record;
+        if (!readPod(cursor, end, record)) {
+            break;
+        }
+        Track track;
+        track.track_id = record.track_id;
+        track.state = static_cast<TrackState>(record.state);
+        track.position = Point3D(record.position[0], record.position[1], record.position[2]);
+        track.velocity = Point3D(record.velocity[0], record.velocity[1], record.velocity[2]);
+        track.acceleration = Point3D(record.acceleration[0], record.acceleration[1], record.acceleration[2]);
+        std::memcpy(track.covariance, record.covariance, sizeof(track.covariance));
+        track.confidence = record.confidence;
+        track.quality_score = record.quality_score;
+        track.last_update = fromNanoseconds(record.last_update_ns);
+        track.valid_time = track.last_update;
+        track.consecutive_misses = record.consecutive_misses;
+        track.hit_count = record.hit_count;
+        tracks.push_back(std::move(track));
+    }
+    return tracks;
+}
+
+SystemStats RecordingReader::decodeStats(const FrameView& frame) {
+    SystemStats stats;
+    const uint8_t* cursor = frame.payload;
+    StatsRecord record;
+    if (frame.type != RecordType::STATS || !readPod(cursor, frame.payload + frame.size, record)) {
+        return stats;
+    }
+    stats.active_tracks = record.active_tracks;
+    stats.total_tracks_created = record.total_tracks_created;
+    stats.total_detections_processed = record.total_detections_processed;
+    stats.detections_per_second = record.detections_per_second;
+    stats.processing_latency_ms = record.processing_latency_ms;
+    stats.cpu_usage_percent = record.cpu_usage_percent;
+    stats.memory_usage_mb = record.memory_usage_mb;
+    stats.average_processing_rate = record.average_processing_rate;
+    stats.total_runtime_seconds = record.total_runtime_seconds;
+    return stats;
+}
+
+bool RecordingReader::mapSegment(const std::string& path, Segment& segment) const {
+#ifdef _WIN32
+    (void)path;
+    (void)segment;
+    LOG_ERROR("RecordingReader: memory-mapped segments are not supported on Windows");
+    return false;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("RecordingReader: cannot open " + path);
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SegmentHeader)) {
+        LOG_ERROR("RecordingReader: segment too small: " + path);
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        LOG_ERROR("RecordingReader: mmap failed for " + path);
+        ::close(fd);
+        return false;
+    }
+    ::madvise(data, size, MADV_SEQUENTIAL | MADV_WILLNEED);
+
+    SegmentHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != SEGMENT_MAGIC || header.version != FORMAT_VERSION) {
+        LOG_ERROR("RecordingReader: not a recording segment: " + path);
+        ::munmap(data, size);
+        ::close(fd);
+        return false;
+    }
+
+    segment.path = path;
+    segment.fd = fd;
+    segment.data = static_cast<const uint8_t*>(data);
+    segment.size = size;
+    segment.first_ns = header.created_ns;
+
+    std::string index_path = path.substr(0, path.size() - 4) + ".idx";
+    std::ifstream index_file(index_path, std::ios::binary);
+    IndexEntry entry;
+    while (index_file.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+        segment.index.push_back(entry);
+    }
+    if (!segment.index.empty()) {
+        segment.first_ns = segment.index.front().timestamp_ns;
+    }
+    return true;
+#endif
+}
+
+bool RecordingReader::readFrameAt(size_t segment, size_t offset, FrameView& frame, size_t& frame_size) {
+    const auto& seg = segments_[segment];
+    if (offset + sizeof(FrameHeader) > seg.size) {
+        return false;
+    }
+
+    FrameHeader header;
+    std::memcpy(&header, seg.data + offset, sizeof(header));
+    if (header.magic != FRAME_MAGIC || offset + sizeof(FrameHeader) + header.payload_size > seg.size) {
+        return false;  // End of written data or truncated frame
+    }
+
+    frame.type = header.type;
+    frame.timestamp_ns = header.timestamp_ns;
+    frame.payload = seg.data + offset + sizeof(FrameHeader);
+    frame.size = header.payload_size;
+    frame_size = sizeof(FrameHeader) + header.payload_size;
+
+    if (header.flags & FRAME_FLAG_LZ4) {
+#ifdef ENABLE_LZ4
+        decompress_buffer_.resize(header.raw_size);
+        int decoded = LZ4_decompress_safe(
+            reinterpret_cast<const char*>(frame.payload),
+            reinterpret_cast<char*>(decompress_buffer_.data()),
+            static_cast<int>(header.payload_size),
+            static_cast<int>(header.raw_size));
+        if (decoded != static_cast<int>(header.raw_size)) {
+            LOG_WARN("RecordingReader: corrupt compressed frame in " + seg.path);
+            frame.size = 0;
+            return true;
+        }
+        frame.payload = decompress_buffer_.data();
+        frame.size = header.raw_size;
+#else
+        LOG_WARN("RecordingReader: compressed frame skipped, built without LZ4 support");
+        frame.size = 0;
+#endif
+    }
+    return true;
+}
+
+}  // namespace radar_tracking
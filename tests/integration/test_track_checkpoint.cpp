@@ -0,0 +1,308 @@
+#include <gtest/gtest.h>
+#include "management/TrackCheckpointer.hpp"
+#include <boost/filesystem.hpp>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace radar_tracking;
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+/**
+ * One cluster per detection, so association is decided by the filters alone
+ */
+struct PointClusterer {
+    std::vector<Cluster> cluster(const std::vector<RadarDetection>& detections) {
+        std::vector<Cluster> clusters;
+        clusters.reserve(detections.size());
+        for (const auto& detection : detections) {
+            Cluster cluster;
+            cluster.centroid = detection.position;
+            cluster.detections.push_back(detection);
+            clusters.push_back(cluster);
+        }
+        return clusters;
+    }
+};
+
+template<typename Filter>
+using TestPipeline = StaticPipeline<PointClusterer, GNNPolicy, Filter>;
+
+constexpr int TARGETS = 50;
+constexpr double SCAN_PERIOD = 0.5;
+
+/**
+ * Noisy detections of TARGETS constant-velocity targets at one scan
+ */
+std::vector<RadarDetection> scanDetections(int scan, Clock::time_point start) {
+    std::mt19937 rng(scan);
+    std::normal_distribution<double> noise(0.0, 3.0);
+    std::vector<RadarDetection> detections;
+    for (int i = 0; i < TARGETS; ++i) {
+        RadarDetection detection;
+        detection.position = Point3D(300.0 * i + 100.0 * scan + noise(rng), 900.0 * (i % 7) + noise(rng), 1000.0);
+        detection.velocity = Point3D(200.0, 0.0, 0.0);
+        detection.timestamp = start + std::chrono::milliseconds(static_cast<int>(1000 * SCAN_PERIOD) * scan);
+        detections.push_back(detection);
+    }
+    return detections;
+}
+
+/**
+ * Run scans through a pipeline, starting a track on every unassigned cluster
+ */
+void runScans(ScanPipeline& pipeline, std::vector<Track>& tracks, uint32_t& next_id,
+              int first_scan, int last_scan, Clock::time_point start) {
+    for (int scan = first_scan; scan < last_scan; ++scan) {
+        const ScanResult result = pipeline.processScan(scanDetections(scan, start), tracks, SCAN_PERIOD);
+        for (uint32_t c : result.unassigned_clusters) {
+            Track track;
+            track.track_id = next_id++;
+            track.position = result.clusters[c].centroid;
+            track.velocity = Point3D(200.0, 0.0, 0.0);
+            for (int i = 0; i < 9; ++i) {
+                track.covariance[i][i] = i < 3 ? 100.0 : (i < 6 ? 400.0 : 10.0);
+            }
+            track.valid_time = track.last_update = result.clusters[c].detections.front().timestamp;
+            track.trajectory.push_back(track.position);
+            tracks.push_back(track);
+        }
+    }
+}
+
+void expectSameEstimates(const std::vector<Track>& expected, const std::vector<Track>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].track_id, actual[i].track_id);
+        EXPECT_EQ(std::memcmp(&expected[i].position, &actual[i].position, sizeof(Point3D)), 0)
+            << "track " << expected[i].track_id;
+        EXPECT_EQ(std::memcmp(&expected[i].velocity, &actual[i].velocity, sizeof(Point3D)), 0)
+            << "track " << expected[i].track_id;
+        EXPECT_EQ(std::memcmp(expected[i].covariance, actual[i].covariance, sizeof(expected[i].covariance)), 0)
+            << "track " << expected[i].track_id;
+    }
+}
+
+class TrackCheckpointTest : public ::testing::Test {
+protected:
+    TrackCheckpointer::Config config_;
+
+    void SetUp() override {
+        config_.enabled = true;
+        config_.directory = (boost::filesystem::temp_directory_path() /
+                             boost::filesystem::unique_path("radar_checkpoint_%%%%-%%%%-%%%%")).string();
+        config_.sync = false;
+    }
+
+    void TearDown() override {
+        boost::filesystem::remove_all(config_.directory);
+    }
+
+    /**
+     * Checkpoint a pipeline after 10 scans, warm-start a fresh one from the
+     * file and check that the next scan gives bit-identical estimates
+     */
+    template<typename Filter>
+    void expectWarmStartContinuesExactly(std::unique_ptr<TestPipeline<Filter>> (*make)()) {
+        const auto start = Clock::now();
+        auto primary = make();
+        std::vector<Track> tracks;
+        uint32_t next_id = 1;
+        runScans(*primary, tracks, next_id, 0, 10, start);
+        ASSERT_EQ(tracks.size(), static_cast<size_t>(TARGETS));
+
+        TrackManager manager;
+        {
+            TrackerCheckpoint state;
+            state.tracks = tracks;
+            state.next_track_id = next_id;
+            manager.importState(state);
+        }
+
+        TrackCheckpointer writer;
+        ASSERT_TRUE(writer.initialize(config_));
+        ASSERT_TRUE(writer.capture(manager, primary.get(), Clock::now()));
+        writer.shutdown();
+        ASSERT_EQ(writer.getStats().checkpoints_written, 1u);
+
+        TrackManager restored_manager;
+        auto restored = make();
+        TrackCheckpointer reader;
+        ASSERT_TRUE(reader.initialize(config_));
+        ASSERT_TRUE(reader.warmStart(restored_manager, restored.get()));
+        EXPECT_EQ(reader.getStats().restored_tracks, static_cast<uint64_t>(TARGETS));
+
+        TrackerCheckpoint restored_state;
+        restored_manager.exportState(restored_state);
+        EXPECT_EQ(restored_state.next_track_id, next_id);
+        std::vector<Track> restored_tracks = restored_state.tracks;
+
+        if constexpr (std::is_same<Filter, SquareRootKalmanCVKernel>::value) {
+            // Factors come from the checkpoint, not re-derived from Track::covariance
+            for (const auto& track : restored_tracks) {
+                const auto* expected = primary->getFilter().getFactor(track.track_id);
+                const auto* actual = restored->getFilter().getFactor(track.track_id);
+                ASSERT_NE(expected, nullptr);
+                ASSERT_NE(actual, nullptr);
+                EXPECT_TRUE(*expected == *actual) << "track " << track.track_id;
+            }
+        }
+
+        // Both pipelines see the tracks in the restored order
+        std::unordered_map<uint32_t, Track> by_id;
+        for (const auto& track : tracks) {
+            by_id[track.track_id] = track;
+        }
+        tracks.clear();
+        for (const auto& track : restored_tracks) {
+            tracks.push_back(by_id.at(track.track_id));
+        }
+        expectSameEstimates(tracks, restored_tracks);
+
+        uint32_t primary_next = next_id, restored_next = next_id;
+        runScans(*primary, tracks, primary_next, 10, 11, start);
+        runScans(*restored, restored_tracks, restored_next, 10, 11, start);
+        expectSameEstimates(tracks, restored_tracks);
+    }
+};
+
+template<typename Filter>
+std::unique_ptr<TestPipeline<Filter>> makePipeline() {
+    return std::make_unique<TestPipeline<Filter>>(PointClusterer{}, GNNPolicy{}, Filter{}, "checkpoint-test");
+}
+
+std::unique_ptr<TestPipeline<IMMKernel>> makeOOSMPipeline() {
+    auto pipeline = makePipeline<IMMKernel>();
+    LazyPredictionPlanner::Config lazy;
+    lazy.enabled = true;
+    pipeline->enableLazyPrediction(lazy, TrackSpatialIndex::Config());
+    OOSMConfig oosm;
+    oosm.enabled = true;
+    pipeline->enableOOSM(oosm);
+    return pipeline;
+}
+
+/**
+ * Flip one payload byte of a checkpoint file
+ */
+void corruptPayload(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, static_cast<long>(sizeof(checkpoint::FileHeader) + 100), SEEK_SET);
+    const int byte = std::fgetc(file);
+    std::fseek(file, static_cast<long>(sizeof(checkpoint::FileHeader) + 100), SEEK_SET);
+    std::fputc(byte ^ 0x55, file);
+    std::fclose(file);
+}
+
+}  // namespace
+
+TEST_F(TrackCheckpointTest, KalmanWarmStartContinuesBitForBit) {
+    expectWarmStartContinuesExactly<KalmanCVKernel>(&makePipeline<KalmanCVKernel>);
+}
+
+TEST_F(TrackCheckpointTest, IMMWarmStartRestoresModeStates) {
+    expectWarmStartContinuesExactly<IMMKernel>(&makePipeline<IMMKernel>);
+}
+
+TEST_F(TrackCheckpointTest, SquareRootKalmanWarmStartRestoresFactors) {
+    expectWarmStartContinuesExactly<SquareRootKalmanCVKernel>(&makePipeline<SquareRootKalmanCVKernel>);
+}
+
+TEST_F(TrackCheckpointTest, LazyIMMWithOOSMWarmStartContinuesBitForBit) {
+    expectWarmStartContinuesExactly<IMMKernel>(&makeOOSMPipeline);
+}
+
+TEST_F(TrackCheckpointTest, CorruptChecksumFallsBackToPrevious) {
+    TrackManager manager;
+    TrackerCheckpoint state;
+    state.tracks.resize(3);
+    for (uint32_t i = 0; i < state.tracks.size(); ++i) {
+        state.tracks[i].track_id = i + 1;
+        state.tracks[i].position = Point3D(100.0 * i, 0.0, 0.0);
+    }
+    state.next_track_id = 4;
+    manager.importState(state);
+
+    // The periodic checkpoint becomes checkpoint.prev once the final one lands
+    TrackCheckpointer writer;
+    ASSERT_TRUE(writer.initialize(config_));
+    ASSERT_TRUE(writer.capture(manager, nullptr, Clock::now()));
+    Track extra;
+    extra.track_id = 4;
+    state.tracks.push_back(extra);
+    state.next_track_id = 5;
+    manager.importState(state);
+    ASSERT_TRUE(writer.writeFinal(manager, nullptr));
+    ASSERT_EQ(writer.getStats().checkpoints_written, 2u);
+
+    TrackerCheckpoint loaded;
+    ASSERT_TRUE(TrackCheckpointer::load(config_.checkpointPath(), loaded));
+    EXPECT_EQ(loaded.tracks.size(), 4u);
+    EXPECT_TRUE(loaded.handover);
+
+    corruptPayload(config_.checkpointPath());
+    EXPECT_FALSE(TrackCheckpointer::load(config_.checkpointPath(), loaded));
+
+    TrackManager restored;
+    TrackCheckpointer reader;
+    ASSERT_TRUE(reader.initialize(config_));
+    ASSERT_TRUE(reader.warmStart(restored, nullptr));
+    EXPECT_EQ(reader.getStats().restored_tracks, 3u);
+    restored.exportState(loaded);
+    EXPECT_EQ(loaded.tracks.size(), 3u);
+    EXPECT_EQ(loaded.next_track_id, 4u);
+
+    // With both files corrupt the tracker cold-starts
+    corruptPayload(config_.previousPath());
+    TrackManager cold;
+    EXPECT_FALSE(reader.warmStart(cold, nullptr));
+}
+
+TEST(TrackCheckpointFormatTest, EncodeDecodeRoundTrip) {
+    TrackerCheckpoint checkpoint;
+    checkpoint.sequence = 7;
+    checkpoint.timestamp_ns = 123456789;
+    checkpoint.next_track_id = 42;
+    checkpoint.total_tracks_created = 41;
+    checkpoint.tracks.resize(2);
+    checkpoint.tracks[0].track_id = 3;
+    checkpoint.tracks[0].position = Point3D(1.5, -2.5, 3.5);
+    checkpoint.tracks[0].covariance[4][4] = 0.125;
+    checkpoint.tracks[0].trajectory = {Point3D(1.0, 2.0, 3.0), Point3D(4.0, 5.0, 6.0)};
+    checkpoint.tracks[1].track_id = 9;
+    checkpoint.tracks[1].hit_count = 11;
+    checkpoint.filter_state.begin<double>("filter");
+    checkpoint.filter_state.append(3, 0.25);
+    checkpoint.filter_state.append(9, -1.0);
+
+    std::vector<uint8_t> image;
+    TrackCheckpointer::encode(checkpoint, image);
+    TrackerCheckpoint decoded;
+    ASSERT_TRUE(TrackCheckpointer::decode(image.data(), image.size(), decoded));
+
+    EXPECT_EQ(decoded.sequence, 7u);
+    EXPECT_EQ(decoded.timestamp_ns, 123456789);
+    EXPECT_EQ(decoded.next_track_id, 42u);
+    EXPECT_EQ(decoded.total_tracks_created, 41u);
+    ASSERT_EQ(decoded.tracks.size(), 2u);
+    EXPECT_EQ(decoded.tracks[0].position.y, -2.5);
+    EXPECT_EQ(decoded.tracks[0].covariance[4][4], 0.125);
+    ASSERT_EQ(decoded.tracks[0].trajectory.size(), 2u);
+    EXPECT_EQ(decoded.tracks[0].trajectory[1].z, 6.0);
+    EXPECT_EQ(decoded.tracks[1].hit_count, 11u);
+    ASSERT_TRUE(decoded.filter_state.matches<double>("filter"));
+    uint32_t track_id = 0;
+    double value = 0.0;
+    decoded.filter_state.read(1, track_id, value);
+    EXPECT_EQ(track_id, 9u);
+    EXPECT_EQ(value, -1.0);
+
+    // Truncated images are rejected
+    EXPECT_FALSE(TrackCheckpointer::decode(image.data(), image.size() - 1, decoded));
+}
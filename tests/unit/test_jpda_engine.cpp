@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "processing/JPDAEngine.hpp"
+#include "utils/KBestAssignment.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace radar_tracking;
+
+namespace {
+
+Track makeTrack(double x) {
+    Track track;
+    track.position = Point3D(x, 0.0, 0.0);
+    return track;
+}
+
+Cluster makeCluster(double x) {
+    Cluster cluster;
+    cluster.centroid = Point3D(x, 0.0, 0.0);
+    return cluster;
+}
+
+/**
+ * Every (track, cluster) pair, sorted by track as compute() expects
+ */
+std::vector<std::pair<uint32_t, uint32_t>> allPairs(size_t tracks, size_t clusters) {
+    std::vector<std::pair<uint32_t, uint32_t>> candidates;
+    for (uint32_t t = 0; t < tracks; ++t) {
+        for (uint32_t c = 0; c < clusters; ++c) {
+            candidates.emplace_back(t, c);
+        }
+    }
+    return candidates;
+}
+
+/**
+ * Costs of every feasible assignment of rows to distinct columns, ascending
+ */
+std::vector<double> enumerateAssignmentCosts(const Eigen::MatrixXd& cost) {
+    const int rows = static_cast<int>(cost.rows());
+    const int cols = static_cast<int>(cost.cols());
+    std::vector<double> costs;
+    std::vector<char> used(cols, 0);
+
+    auto enumerate = [&](auto&& self, int row, double total) -> void {
+        if (row == rows) {
+            costs.push_back(total);
+            return;
+        }
+        for (int c = 0; c < cols; ++c) {
+            if (!used[c] && cost(row, c) < KBestAssignment::FORBIDDEN) {
+                used[c] = 1;
+                self(self, row + 1, total + cost(row, c));
+                used[c] = 0;
+            }
+        }
+    };
+    enumerate(enumerate, 0, 0.0);
+    std::sort(costs.begin(), costs.end());
+    return costs;
+}
+
+}  // namespace
+
+TEST(KBestAssignmentTest, MurtyMatchesBruteForceRanking) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> entry(0.0, 10.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        const int rows = 1 + trial % 4;
+        const int cols = rows + (trial / 4) % 3;
+        Eigen::MatrixXd cost(rows, cols);
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                cost(r, c) = unit(rng) < 0.25 ? KBestAssignment::FORBIDDEN : entry(rng);
+            }
+        }
+
+        const std::vector<double> expected = enumerateAssignmentCosts(cost);
+        const size_t k = 1 + trial % 12;
+        const auto solutions = KBestAssignment::murty(cost, k);
+        ASSERT_EQ(solutions.size(), std::min(k, expected.size())) << "trial " << trial;
+
+        for (size_t i = 0; i < solutions.size(); ++i) {
+            EXPECT_NEAR(solutions[i].cost, expected[i], 1e-9) << "trial " << trial << " rank " << i;
+
+            // Each solution is a valid assignment whose entries sum to its cost
+            ASSERT_EQ(solutions[i].row_to_col.size(), static_cast<size_t>(rows));
+            std::vector<char> used(cols, 0);
+            double total = 0.0;
+            for (int r = 0; r < rows; ++r) {
+                const int c = solutions[i].row_to_col[r];
+                ASSERT_GE(c, 0);
+                ASSERT_LT(c, cols);
+                EXPECT_FALSE(used[c]);
+                used[c] = 1;
+                EXPECT_LT(cost(r, c), KBestAssignment::FORBIDDEN);
+                total += cost(r, c);
+            }
+            EXPECT_NEAR(total, solutions[i].cost, 1e-9);
+        }
+    }
+}
+
+TEST(KBestAssignmentTest, InfeasibleMatrixHasNoSolutions) {
+    Eigen::MatrixXd cost = Eigen::MatrixXd::Constant(2, 3, KBestAssignment::FORBIDDEN);
+    cost(0, 1) = 1.0;
+    cost(1, 1) = 2.0;
+
+    std::vector<int> row_to_col;
+    EXPECT_FALSE(KBestAssignment::isFeasible(KBestAssignment::solve(cost, row_to_col)));
+    EXPECT_TRUE(KBestAssignment::murty(cost, 5).empty());
+}
+
+TEST(JPDAEngineTest, KBestMarginalsMatchExactOnSharedGate) {
+    // Two tracks 10 m apart; all three clusters fall inside both gates
+    GatingContext gating;
+    gating.buildTracks({makeTrack(0.0), makeTrack(10.0)}, 25.0, 9.21);
+    gating.setClusters({makeCluster(5.0), makeCluster(-3.0), makeCluster(13.0)});
+    const auto candidates = allPairs(2, 3);
+
+    JPDAEngine::Config exact_config;
+    exact_config.clutter_density = 1e-4;
+    JPDAEngine exact(exact_config);
+    const JPDAResult exact_result = exact.compute(gating, candidates);
+    ASSERT_EQ(exact_result.exact_clusters, 1u);
+    ASSERT_EQ(exact_result.marginals.size(), 6u);
+
+    // 13 joint events in total, so k = 64 ranks all of them
+    JPDAEngine::Config kbest_config = exact_config;
+    kbest_config.exact_max_tracks = 0;
+    JPDAEngine kbest(kbest_config);
+    const JPDAResult kbest_result = kbest.compute(gating, candidates);
+    ASSERT_EQ(kbest_result.kbest_clusters, 1u);
+    ASSERT_EQ(kbest_result.marginals.size(), exact_result.marginals.size());
+
+    EXPECT_EQ(exact_result.gate_clusters, 1u);
+    EXPECT_EQ(exact_result.largest_gate_cluster, 2u);
+    for (size_t i = 0; i < exact_result.marginals.size(); ++i) {
+        const auto& e = exact_result.marginals[i];
+        const auto& k = kbest_result.marginals[i];
+        EXPECT_EQ(e.track_index, k.track_index);
+        EXPECT_EQ(e.cluster_index, k.cluster_index);
+        EXPECT_GT(e.probability, 0.0);
+        EXPECT_NEAR(e.probability, k.probability, 1e-9) << "pair " << i;
+    }
+
+    for (size_t t = 0; t < 2; ++t) {
+        double total = exact_result.miss_probability[t];
+        for (const auto& marginal : exact_result.marginals) {
+            if (marginal.track_index == t) {
+                total += marginal.probability;
+            }
+        }
+        EXPECT_NEAR(total, 1.0, 1e-9);
+        EXPECT_NEAR(exact_result.miss_probability[t], kbest_result.miss_probability[t], 1e-9);
+    }
+
+    // The cluster on top of each track is its most likely origin
+    EXPECT_GT(exact_result.marginals[1].probability, exact_result.marginals[0].probability);
+    EXPECT_GT(exact_result.marginals[5].probability, exact_result.marginals[3].probability);
+}
+
+TEST(JPDAEngineTest, DisjointGatesSplitIntoSeparateClusters) {
+    // Tracks 0 and 1 share the cluster at 10; track 2 is alone; the cluster at 5000 gates nothing
+    GatingContext gating;
+    gating.buildTracks({makeTrack(0.0), makeTrack(20.0), makeTrack(1000.0)}, 25.0, 9.21);
+    gating.setClusters({makeCluster(10.0), makeCluster(1001.0), makeCluster(5000.0)});
+
+    JPDAEngine engine;
+    const JPDAResult result = engine.compute(gating, allPairs(3, 3));
+
+    EXPECT_EQ(result.gate_clusters, 2u);
+    EXPECT_EQ(result.largest_gate_cluster, 2u);
+    EXPECT_EQ(result.exact_clusters, 2u);
+    ASSERT_EQ(result.marginals.size(), 3u);
+    EXPECT_EQ(result.marginals[0].track_index, 0u);
+    EXPECT_EQ(result.marginals[0].cluster_index, 0u);
+    EXPECT_EQ(result.marginals[1].track_index, 1u);
+    EXPECT_EQ(result.marginals[1].cluster_index, 0u);
+    EXPECT_EQ(result.marginals[2].track_index, 2u);
+    EXPECT_EQ(result.marginals[2].cluster_index, 1u);
+
+    // A lone track and cluster reduce to w / (1 + w)
+    const double w = 0.9 * std::exp(gating.logLikelihood(2, gating.distanceSquared(2, 1))) /
+                     (1e-9 * (1.0 - 0.9 * 0.99));
+    EXPECT_NEAR(result.marginals[2].probability, w / (1.0 + w), 1e-9);
+    EXPECT_NEAR(result.miss_probability[2], 1.0 / (1.0 + w), 1e-9);
+}
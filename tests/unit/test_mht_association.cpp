@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "processing/MHTAssociation.hpp"
+#include <cmath>
+
+using namespace radar_tracking;
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr double LOG_2PI = 1.8378770664093453;
+
+Track makeTrack(uint32_t id, double x, double vx = 0.0) {
+    Track track;
+    track.track_id = id;
+    track.position = Point3D(x, 0.0, 0.0);
+    track.velocity = Point3D(vx, 0.0, 0.0);
+    return track;
+}
+
+Cluster makeCluster(double x) {
+    Cluster cluster;
+    cluster.centroid = Point3D(x, 0.0, 0.0);
+    return cluster;
+}
+
+Cluster makeCluster(double x, Clock::time_point time) {
+    Cluster cluster = makeCluster(x);
+    RadarDetection detection;
+    detection.position = cluster.centroid;
+    detection.timestamp = time;
+    cluster.detections.push_back(detection);
+    return cluster;
+}
+
+/**
+ * Innovation variance per axis of a fresh tree after one scan: the root
+ * takes P = R and velocity variance 100 R, predicted over dt = 1.
+ */
+double firstScanInnovationVariance(const MHTAssociation::Config& config) {
+    const double r = config.measurement_variance;
+    return r + 100.0 * r + 0.25 * config.process_noise + r;
+}
+
+}  // namespace
+
+TEST(MHTAssociationTest, PruneKeepsScoreQualifiedLeavesRankedAfterFailingLeaf) {
+    MHTAssociation::Config config;
+    config.k_best = 2;
+    config.n_scan = 3;
+    const double s = firstScanInnovationVariance(config);
+
+    // Detection-over-miss log ratio at zero distance; 12 makes every
+    // miss leaf fall more than prune_log_ratio (9.2) below its detection
+    const double target = 12.0;
+    const double log_clutter = std::log(config.detection_probability) - 1.5 * LOG_2PI -
+                               0.5 * 3.0 * std::log(s) - std::log(1.0 - config.detection_probability) - target;
+    config.clutter_density = std::exp(log_clutter);
+    MHTAssociation mht(config);
+
+    // Track A sits on cluster c. Track B gates c at d2 = 8 and its own cluster
+    // d at d2 = 2; A does not gate d (d2 = 18)
+    const double sigma = std::sqrt(s);
+    const double b = std::sqrt(8.0) * sigma;
+    const double d = b + std::sqrt(2.0) * sigma;
+    std::vector<Track> tracks = {makeTrack(1, 0.0), makeTrack(2, b)};
+    std::vector<Cluster> clusters = {makeCluster(0.0), makeCluster(d)};
+
+    // Global hypotheses: (A:c, B:d) and (A:c, B:miss) at 11 below. B's miss
+    // leaf gets a marginal of ~1e-5 and ranks before B:c (marginal 0), which
+    // fails the probability test but is only 3 below B's best score
+    const auto associations = mht.associate(tracks, clusters);
+    ASSERT_EQ(associations.size(), 2u);
+    EXPECT_EQ(associations[0], std::make_pair(0u, 0u));
+    EXPECT_EQ(associations[1], std::make_pair(1u, 1u));
+
+    // A keeps its selected leaf; B keeps B:d and B:c, drops B:miss
+    const auto stats = mht.getHypothesisStats();
+    EXPECT_EQ(stats.groups, 1u);
+    EXPECT_EQ(stats.leaves, 3u);
+}
+
+TEST(MHTAssociationTest, NScanPruningBoundsTreeDepth) {
+    MHTAssociation::Config config;
+    config.n_scan = 3;
+    MHTAssociation mht(config);
+
+    const auto start = Clock::now();
+    std::vector<Track> tracks = {makeTrack(1, 0.0, 100.0)};
+    size_t max_nodes = 0;
+    for (int scan = 1; scan <= 50; ++scan) {
+        const auto time = start + std::chrono::seconds(scan);
+        std::vector<Cluster> clusters = {makeCluster(100.0 * scan, time),
+                                         makeCluster(100.0 * scan + 60.0, time)};
+        const auto associations = mht.associate(tracks, clusters);
+        ASSERT_EQ(associations.size(), 1u);
+        EXPECT_EQ(associations[0].second, 0u);
+        max_nodes = std::max(max_nodes, mht.getHypothesisStats().nodes);
+    }
+
+    // Committed history collapses to one root: at most n_scan levels of
+    // branching below it, each capped at max_leaves_per_tree
+    EXPECT_LE(max_nodes, 1 + config.n_scan * config.max_leaves_per_tree);
+}
+
+TEST(MHTAssociationTest, EmptyScanAdvancesScanClock) {
+    MHTAssociation mht;
+
+    // The first scan predicts over scan_period_sec, so start one period back
+    const auto start = Clock::now();
+    std::vector<Track> tracks = {makeTrack(1, -100.0, 100.0)};
+    for (int scan = 0; scan <= 6; ++scan) {
+        const auto time = start + std::chrono::seconds(scan);
+        std::vector<Cluster> clusters;
+        if (scan % 3 != 2) {
+            clusters.push_back(makeCluster(100.0 * scan, time));
+        }
+        const auto associations = mht.associate(tracks, clusters);
+        if (!clusters.empty()) {
+            ASSERT_EQ(associations.size(), 1u) << "scan " << scan;
+        }
+    }
+
+    // Scan 6 comes one period after the empty scan 5, not two; predicting
+    // over the time already covered would overshoot the target by 100 m
+    Point3D position, velocity;
+    ASSERT_TRUE(mht.getSelectedState(1, position, velocity));
+    EXPECT_NEAR(position.x, 600.0, 5.0);
+    EXPECT_NEAR(velocity.x, 100.0, 5.0);
+}
+
+TEST(MHTAssociationTest, PrunedNodesAreReusedByThePool) {
+    MHTAssociation mht;
+
+    const auto start = Clock::now();
+    auto run = [&](uint32_t first_id, int first_scan, int scans) {
+        // 20 well separated targets at 100 m/s, each with a nearby false alarm
+        std::vector<Track> tracks;
+        for (uint32_t i = 0; i < 20; ++i) {
+            tracks.push_back(makeTrack(first_id + i, 10000.0 * i + 100.0 * (first_scan - 1), 100.0));
+        }
+        for (int scan = first_scan; scan < first_scan + scans; ++scan) {
+            const auto time = start + std::chrono::seconds(scan);
+            std::vector<Cluster> clusters;
+            for (uint32_t i = 0; i < 20; ++i) {
+                const double x = 10000.0 * i + 100.0 * scan;
+                clusters.push_back(makeCluster(x, time));
+                clusters.push_back(makeCluster(x + 50.0, time));
+            }
+            ASSERT_EQ(mht.associate(tracks, clusters).size(), tracks.size());
+        }
+    };
+
+    run(1, 1, 10);
+    const double warm_memory_mb = mht.getStats().memory_usage_mb;
+    const size_t warm_nodes = mht.getHypothesisStats().nodes;
+    ASSERT_GT(warm_memory_mb, 0.0);
+    ASSERT_GT(warm_nodes, 0u);
+
+    run(1, 11, 200);
+    EXPECT_EQ(mht.getStats().memory_usage_mb, warm_memory_mb);
+    EXPECT_LE(mht.getHypothesisStats().nodes, warm_nodes * 2);
+
+    // Deleted tracks return every node; their replacements reuse the blocks
+    mht.associate({}, {});
+    EXPECT_EQ(mht.getHypothesisStats().nodes, 0u);
+    run(100, 211, 50);
+    EXPECT_EQ(mht.getStats().memory_usage_mb, warm_memory_mb);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "tracking/FilterKernels.hpp"
+#include "tracking/OOSMHandler.hpp"
+
+using namespace radar_tracking;
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+RadarDetection makeDetection(double t, double x, double y, Clock::time_point start) {
+    RadarDetection detection;
+    detection.position = Point3D(x, y, 500.0);
+    detection.timestamp = start + std::chrono::microseconds(static_cast<int64_t>(t * 1e6));
+    return detection;
+}
+
+/**
+ * In-sequence step: predict to the measurement time, update, record
+ */
+void processInOrder(Track& track, const RadarDetection& measurement, KalmanCVKernel& filter,
+                    OOSMHandler<KalmanCVKernel>* oosm) {
+    const double dt = std::chrono::duration<double>(measurement.timestamp - track.valid_time).count();
+    filter.predict(track, dt);
+    track.valid_time = measurement.timestamp;
+    filter.update(track, measurement);
+    if (oosm) {
+        oosm->record(track, measurement, filter);
+    }
+}
+
+}  // namespace
+
+TEST(OOSMHandlerTest, RetrodictionMatchesInOrderKalman) {
+    const auto start = Clock::now();
+    KalmanCVKernel filter;
+    const std::vector<RadarDetection> measurements = {
+        makeDetection(0.5, 105.0, 48.0, start),
+        makeDetection(1.0, 196.0, 103.0, start),
+        makeDetection(1.3, 262.0, 131.0, start),
+        makeDetection(1.7, 338.0, 172.0, start),
+        makeDetection(2.0, 404.0, 198.0, start),
+    };
+
+    Track initial = filter.initializeTrack(makeDetection(0.0, 0.0, 0.0, start));
+    initial.track_id = 1;
+    initial.velocity = Point3D(200.0, 100.0, 0.0);
+
+    Track in_order = initial;
+    for (const auto& measurement : measurements) {
+        processInOrder(in_order, measurement, filter, nullptr);
+    }
+
+    // The measurement at 1.3 s arrives after the one at 2.0 s
+    OOSMHandler<KalmanCVKernel>::Config config;
+    config.enabled = true;
+    OOSMHandler<KalmanCVKernel> oosm(config);
+    Track late = initial;
+    for (size_t i : {0u, 1u, 3u, 4u}) {
+        processInOrder(late, measurements[i], filter, &oosm);
+    }
+    ASSERT_TRUE(oosm.isLate(late, measurements[2]));
+    ASSERT_TRUE(oosm.retrodict(late, measurements[2], filter));
+    EXPECT_EQ(oosm.getStats().retrodicted, 1u);
+    EXPECT_EQ(oosm.getStats().replayed_updates, 2u);
+
+    EXPECT_EQ(late.valid_time, in_order.valid_time);
+    EXPECT_EQ(late.last_update, in_order.last_update);
+    EXPECT_NEAR(late.position.x, in_order.position.x, 1e-9);
+    EXPECT_NEAR(late.position.y, in_order.position.y, 1e-9);
+    EXPECT_NEAR(late.velocity.x, in_order.velocity.x, 1e-9);
+    EXPECT_NEAR(late.velocity.y, in_order.velocity.y, 1e-9);
+    for (int i = 0; i < 9; ++i) {
+        for (int j = 0; j < 9; ++j) {
+            EXPECT_NEAR(late.covariance[i][j], in_order.covariance[i][j], 1e-9) << i << "," << j;
+        }
+    }
+}
+
+TEST(OOSMHandlerTest, MeasurementsBeforeTheWindowAreDropped) {
+    const auto start = Clock::now();
+    KalmanCVKernel filter;
+    OOSMHandler<KalmanCVKernel>::Config config;
+    config.enabled = true;
+    config.window = 2;
+    OOSMHandler<KalmanCVKernel> oosm(config);
+
+    Track track = filter.initializeTrack(makeDetection(0.0, 0.0, 0.0, start));
+    track.track_id = 1;
+    for (int k = 1; k <= 4; ++k) {
+        processInOrder(track, makeDetection(0.5 * k, 100.0 * k, 0.0, start), filter, &oosm);
+    }
+
+    // The window holds the updates at 1.5 s and 2.0 s
+    const Track before = track;
+    EXPECT_FALSE(oosm.retrodict(track, makeDetection(1.2, 240.0, 0.0, start), filter));
+    EXPECT_EQ(oosm.getStats().dropped, 1u);
+    EXPECT_EQ(track.position.x, before.position.x);
+    EXPECT_EQ(track.valid_time, before.valid_time);
+}
+
+TEST(OOSMHandlerTest, RetainTracksDropsWindowsWhenTrackCountIsUnchanged) {
+    const auto start = Clock::now();
+    KalmanCVKernel filter;
+    OOSMHandler<KalmanCVKernel>::Config config;
+    config.enabled = true;
+    OOSMHandler<KalmanCVKernel> oosm(config);
+
+    std::vector<Track> tracks;
+    for (uint32_t id = 1; id <= 3; ++id) {
+        Track track = filter.initializeTrack(makeDetection(0.0, 1000.0 * id, 0.0, start));
+        track.track_id = id;
+        processInOrder(track, makeDetection(0.5, 1000.0 * id, 0.0, start), filter, &oosm);
+        tracks.push_back(track);
+    }
+    ASSERT_EQ(oosm.getWindowCount(), 3u);
+
+    // Track 2 is deleted and track 4 created in the same scan; 4 has no window yet
+    tracks.erase(tracks.begin() + 1);
+    Track created = filter.initializeTrack(makeDetection(0.5, 9000.0, 0.0, start));
+    created.track_id = 4;
+    tracks.push_back(created);
+    oosm.retainTracks(tracks);
+    EXPECT_EQ(oosm.getWindowCount(), 2u);
+
+    tracks.clear();
+    oosm.retainTracks(tracks);
+    EXPECT_EQ(oosm.getWindowCount(), 0u);
+}
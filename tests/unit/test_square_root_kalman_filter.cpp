@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "tracking/FilterKernels.hpp"
+#include "tracking/SquareRootKalmanFilter.hpp"
+#include <random>
+
+using namespace radar_tracking;
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+RadarDetection makeDetection(const Point3D& position, Clock::time_point time) {
+    RadarDetection detection;
+    detection.position = position;
+    detection.timestamp = time;
+    return detection;
+}
+
+}  // namespace
+
+TEST(SquareRootKalmanFilterTest, FloatFactorsTrackDoubleKalmanOverLongRun) {
+    KalmanCVKernel::Params kalman_params;
+    SquareRootKalmanCVKernel::Params srkf_params;
+    srkf_params.process_noise = kalman_params.process_noise;
+    srkf_params.measurement_noise = kalman_params.measurement_noise;
+    srkf_params.initial_uncertainty = kalman_params.initial_uncertainty;
+    KalmanCVKernel kalman(kalman_params);
+    SquareRootKalmanCVKernel srkf(srkf_params);
+
+    const auto start = Clock::now();
+    Track reference = kalman.initializeTrack(makeDetection(Point3D(0.0, 0.0, 3000.0), start));
+    reference.track_id = 1;
+    reference.velocity = Point3D(150.0, -80.0, 0.0);
+    Track track = reference;
+
+    // 20 minutes at 10 Hz; the covariance converges while the mean keeps moving
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, std::sqrt(kalman_params.measurement_noise));
+    const double dt = 0.1;
+    double max_position_error = 0.0, max_velocity_error = 0.0, max_variance_error = 0.0;
+    for (int k = 1; k <= 12000; ++k) {
+        const double t = dt * k;
+        const auto time = start + std::chrono::microseconds(static_cast<int64_t>(t * 1e6));
+        const Point3D truth(150.0 * t, -80.0 * t + 200.0 * std::sin(0.01 * t), 3000.0);
+        const RadarDetection detection =
+            makeDetection(Point3D(truth.x + noise(rng), truth.y + noise(rng), truth.z + noise(rng)), time);
+
+        kalman.predict(reference, dt);
+        kalman.update(reference, detection);
+        srkf.predict(track, dt);
+        srkf.update(track, detection);
+
+        max_position_error = std::max(max_position_error, (track.position - reference.position).magnitude());
+        max_velocity_error = std::max(max_velocity_error, (track.velocity - reference.velocity).magnitude());
+        for (int i = 0; i < 6; ++i) {
+            const double relative = std::abs(track.covariance[i][i] - reference.covariance[i][i]) /
+                                    reference.covariance[i][i];
+            max_variance_error = std::max(max_variance_error, relative);
+        }
+    }
+
+    // float32 factors stay within millimetres of the double filter (about 3e-6 m here)
+    EXPECT_LT(max_position_error, 1e-3);
+    EXPECT_LT(max_velocity_error, 1e-3);
+    EXPECT_LT(max_variance_error, 1e-4);
+
+    // And the position/velocity covariance stays symmetric positive definite
+    const motion::StateMatrix P = motion::ConstTrackCovarianceMap(&track.covariance[0][0]);
+    const Eigen::Matrix<double, 6, 6> P_cv = P.topLeftCorner<6, 6>();
+    EXPECT_TRUE(P_cv.isApprox(P_cv.transpose()));
+    const Eigen::LLT<Eigen::Matrix<double, 6, 6>> llt(P_cv);
+    EXPECT_EQ(llt.info(), Eigen::Success);
+}
+
+TEST(SquareRootKalmanFilterTest, RetainTracksDropsFactorsWhenTrackCountIsUnchanged) {
+    SquareRootKalmanCVKernel srkf;
+    const auto start = Clock::now();
+
+    std::vector<Track> tracks;
+    for (uint32_t id = 1; id <= 3; ++id) {
+        Track track = srkf.initializeTrack(makeDetection(Point3D(1000.0 * id, 0.0, 0.0), start));
+        track.track_id = id;
+        srkf.predict(track, 0.5);
+        tracks.push_back(track);
+    }
+    ASSERT_NE(srkf.getFactor(2), nullptr);
+
+    // Track 2 is deleted and track 4 created in the same scan
+    tracks.erase(tracks.begin() + 1);
+    Track created = srkf.initializeTrack(makeDetection(Point3D(9000.0, 0.0, 0.0), start));
+    created.track_id = 4;
+    tracks.push_back(created);
+    srkf.retainTracks(tracks);
+
+    EXPECT_EQ(srkf.getFactor(2), nullptr);
+    EXPECT_NE(srkf.getFactor(1), nullptr);
+    EXPECT_NE(srkf.getFactor(3), nullptr);
+}
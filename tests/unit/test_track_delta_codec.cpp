@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include "output/TrackPublisher.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+using namespace radar_tracking;
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+Track makeTrack(uint32_t id, double x, double y) {
+    Track track;
+    track.track_id = id;
+    track.state = TrackState::CONFIRMED;
+    track.position = Point3D(x, y, 1000.0 + id);
+    track.velocity = Point3D(0.37 * id, -12.5, 0.04);
+    track.confidence = 0.8;
+    track.quality_score = 0.6;
+    for (int i = 0; i < 3; ++i) {
+        track.covariance[i][i] = 25.0 * (i + 1);
+    }
+    return track;
+}
+
+/**
+ * A receiver: decodes every frame it is handed and records whether it was a keyframe
+ */
+struct Receiver {
+    TrackDeltaDecoder decoder;
+    std::vector<bool> keyframes;
+    bool failed = false;
+
+    TrackPublisher::Sink sink() {
+        return [this](const TrackPublisher::Buffer& frame) {
+            track_delta::FrameHeader header;
+            std::memcpy(&header, frame->data(), sizeof(header));
+            keyframes.push_back((header.flags & track_delta::FRAME_FLAG_KEYFRAME) != 0);
+            failed |= !decoder.apply(frame->data(), frame->size());
+            return true;
+        };
+    }
+};
+
+/**
+ * The decoded picture equals the published tracks after quantization
+ */
+void expectDecodedEqualsQuantized(const Receiver& receiver, const std::vector<Track>& tracks,
+                                  const TrackPublisher::SubscriberConfig& config, uint64_t seq) {
+    ASSERT_FALSE(receiver.failed) << "frame " << seq;
+    EXPECT_EQ(receiver.decoder.getFrameSeq(), seq);
+
+    // The wire carries resolutions as float
+    const double p_res = static_cast<float>(config.position_resolution_m);
+    const double v_res = static_cast<float>(config.velocity_resolution_mps);
+    auto position = [&](double value) { return std::round(value / config.position_resolution_m) * p_res; };
+    auto velocity = [&](double value) { return std::round(value / config.velocity_resolution_mps) * v_res; };
+    auto unit = [](double value) { return std::lround(value * 255.0) / 255.0; };
+
+    std::map<uint32_t, const Track*> live;
+    for (const auto& track : tracks) {
+        if (track.state != TrackState::TERMINATED) {
+            live[track.track_id] = &track;
+        }
+    }
+    const auto& decoded = receiver.decoder.getTracks();
+    ASSERT_EQ(decoded.size(), live.size()) << "frame " << seq;
+    for (const auto& [id, track] : live) {
+        auto it = decoded.find(id);
+        ASSERT_NE(it, decoded.end()) << "track " << id << " frame " << seq;
+        const auto& d = it->second;
+        EXPECT_EQ(d.position.x, position(track->position.x)) << "track " << id << " frame " << seq;
+        EXPECT_EQ(d.position.y, position(track->position.y)) << "track " << id << " frame " << seq;
+        EXPECT_EQ(d.position.z, position(track->position.z)) << "track " << id << " frame " << seq;
+        EXPECT_EQ(d.velocity.x, velocity(track->velocity.x)) << "track " << id << " frame " << seq;
+        EXPECT_EQ(d.velocity.y, velocity(track->velocity.y)) << "track " << id << " frame " << seq;
+        EXPECT_EQ(d.velocity.z, velocity(track->velocity.z)) << "track " << id << " frame " << seq;
+        EXPECT_EQ(d.state, track->state) << "track " << id << " frame " << seq;
+        EXPECT_EQ(d.confidence, unit(track->confidence)) << "track " << id << " frame " << seq;
+        EXPECT_EQ(d.quality_score, unit(track->quality_score)) << "track " << id << " frame " << seq;
+        if (config.include_covariance) {
+            EXPECT_EQ(d.position_std.y, position(std::sqrt(track->covariance[1][1]))) << "track " << id;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(TrackDeltaCodecTest, DecodedPictureMatchesQuantizedInput) {
+    TrackPublisher::Config publisher_config;
+    publisher_config.removal_history_entries = 4;
+    TrackPublisher publisher(publisher_config);
+
+    // Baseline advances every frame
+    TrackPublisher::SubscriberConfig every_frame;
+    every_frame.name = "every_frame";
+    every_frame.update_rate_hz = 0.0;
+    every_frame.keyframe_interval_s = 1e6;
+    Receiver following;
+    ASSERT_NE(publisher.addSubscriber(every_frame, following.sink()), 0u);
+
+    // Acknowledges only frame 1, so later frames are deltas against an old baseline
+    TrackPublisher::SubscriberConfig lagging_config = every_frame;
+    lagging_config.name = "lagging";
+    lagging_config.acknowledged = true;
+    lagging_config.include_covariance = true;
+    lagging_config.position_resolution_m = 0.25;
+    Receiver lagging;
+    const uint32_t lagging_id = publisher.addSubscriber(lagging_config, lagging.sink());
+    ASSERT_NE(lagging_id, 0u);
+
+    const auto start = Clock::now();
+    std::vector<Track> tracks;
+    for (uint32_t id = 1; id <= 6; ++id) {
+        tracks.push_back(makeTrack(id, 1000.0 * id + 0.3, -500.0 * id));
+    }
+    uint64_t seq = 0;
+    auto publish = [&](int frame) {
+        seq = publisher.publish(tracks, start + std::chrono::milliseconds(100 * frame));
+        expectDecodedEqualsQuantized(following, tracks, every_frame, seq);
+        expectDecodedEqualsQuantized(lagging, tracks, lagging_config, seq);
+    };
+
+    // 1: keyframe
+    publish(1);
+    ASSERT_EQ(following.keyframes.size(), 1u);
+    EXPECT_TRUE(following.keyframes[0]);
+    EXPECT_TRUE(lagging.keyframes[0]);
+    publisher.acknowledge(lagging_id, seq);
+
+    // 2-3: deltas moving some tracks, changing status and covariance of others
+    tracks[0].position.x += 40.0;
+    tracks[1].velocity.y = 3.3;
+    tracks[2].confidence = 0.95;
+    tracks[3].covariance[1][1] = 400.0;
+    publish(2);
+    tracks[0].position.x += 40.0;
+    tracks[4].state = TrackState::COASTING;
+    publish(3);
+    EXPECT_FALSE(following.keyframes.back());
+    EXPECT_FALSE(lagging.keyframes.back());
+
+    // 4: removals, one by omission and one as TERMINATED
+    tracks.erase(tracks.begin() + 1);
+    tracks[1].state = TrackState::TERMINATED;
+    publish(4);
+
+    // 5: track 2 re-added under the same ID with other values; the lagging
+    // receiver's frame carries its removal and its full re-add together
+    Track readded = makeTrack(2, -7000.0, 123.4);
+    readded.state = TrackState::TENTATIVE;
+    readded.quality_score = 0.1;
+    tracks.push_back(readded);
+    publish(5);
+    EXPECT_FALSE(lagging.keyframes.back());
+
+    // 6-9: churn until the lagging baseline predates the removal history
+    // (track 3 is already gone, so the fifth removal only comes at frame 9)
+    for (int frame = 6; frame <= 9; ++frame) {
+        tracks.erase(tracks.begin());
+        tracks.push_back(makeTrack(static_cast<uint32_t>(100 + frame), 50.0 * frame, 0.0));
+        publish(frame);
+    }
+    EXPECT_FALSE(following.keyframes.back());
+    EXPECT_TRUE(lagging.keyframes.back());
+    EXPECT_EQ(std::count(following.keyframes.begin(), following.keyframes.end(), true), 1);
+    EXPECT_EQ(std::count(lagging.keyframes.begin(), lagging.keyframes.end(), true), 2);
+}
+
+TEST(TrackDeltaCodecTest, DeltaAheadOfReceiverIsRejected) {
+    TrackPublisher publisher;
+    TrackPublisher::SubscriberConfig config;
+    config.name = "capture";
+    config.update_rate_hz = 0.0;
+    std::vector<TrackPublisher::Buffer> frames;
+    ASSERT_NE(publisher.addSubscriber(config, [&](const TrackPublisher::Buffer& frame) {
+        frames.push_back(frame);
+        return true;
+    }), 0u);
+
+    std::vector<Track> tracks = {makeTrack(1, 0.0, 0.0)};
+    publisher.publish(tracks);
+    tracks[0].position.x = 10.0;
+    publisher.publish(tracks);
+    tracks[0].position.x = 20.0;
+    publisher.publish(tracks);
+    ASSERT_EQ(frames.size(), 3u);
+
+    // Frame 3 is built against frame 2, which this receiver never saw
+    TrackDeltaDecoder decoder;
+    EXPECT_FALSE(decoder.apply(frames[1]->data(), frames[1]->size()));
+    ASSERT_TRUE(decoder.apply(frames[0]->data(), frames[0]->size()));
+    EXPECT_FALSE(decoder.apply(frames[2]->data(), frames[2]->size()));
+    EXPECT_EQ(decoder.getFrameSeq(), 1u);
+    EXPECT_EQ(decoder.getTracks().at(1).position.x, 0.0);
+
+    // Truncated frames leave the state unchanged
+    EXPECT_FALSE(decoder.apply(frames[1]->data(), frames[1]->size() - 1));
+    ASSERT_TRUE(decoder.apply(frames[1]->data(), frames[1]->size()));
+    EXPECT_EQ(decoder.getTracks().at(1).position.x, 10.0);
+}
@@ -0,0 +1,102 @@
+#include "management/BeamScheduler.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+
+using namespace radar_tracking;
+
+namespace {
+
+using TimePoint = BeamScheduler::TimePoint;
+
+/**
+ * @brief Tracks spread over 5-100 km with post-update covariances
+ */
+std::vector<Track> makeTracks(size_t count, TimePoint now) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> range(5000.0, 100000.0);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-300.0, 300.0);
+    std::uniform_real_distribution<double> age(0.0, 2.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<Track> tracks(count);
+    for (size_t i = 0; i < count; ++i) {
+        Track& track = tracks[i];
+        track.track_id = static_cast<uint32_t>(i + 1);
+        const double r = range(rng);
+        const double az = angle(rng);
+        track.position = Point3D(r * std::cos(az), r * std::sin(az), 1000.0 + 9000.0 * unit(rng));
+        track.velocity = Point3D(speed(rng), speed(rng), 0.0);
+        track.state = unit(rng) < 0.1 ? TrackState::TENTATIVE : TrackState::CONFIRMED;
+        track.quality_score = unit(rng);
+        track.valid_time = now - std::chrono::duration_cast<TimePoint::duration>(std::chrono::duration<double>(age(rng)));
+        for (int k = 0; k < 3; ++k) {
+            track.covariance[k][k] = 400.0;
+            track.covariance[k + 3][k + 3] = 100.0;
+            track.covariance[k + 6][k + 6] = 10.0;
+            track.covariance[k][k + 3] = track.covariance[k + 3][k] = 50.0;
+        }
+    }
+    return tracks;
+}
+
+BeamScheduler::Config benchmarkConfig() {
+    BeamScheduler::Config config;
+    config.slot_ms = 10.0;
+    config.occupancy = 0.8;
+    return config;
+}
+
+}  // namespace
+
+/**
+ * @brief One timeline slot: fold in the updates from the previous slot's dwells, then schedule
+ */
+static void BM_ScheduleSlot(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    TimePoint slot_start{};
+    slot_start += std::chrono::hours(1);
+    auto tracks = makeTracks(count, slot_start);
+
+    BeamScheduler scheduler(benchmarkConfig());
+    scheduler.updateTracks(tracks);
+
+    const auto slot = std::chrono::duration_cast<TimePoint::duration>(std::chrono::milliseconds(10));
+    std::vector<BeamRequest> previous;
+    size_t requests = 0;
+    for (auto _ : state) {
+        for (const auto& request : previous) {
+            Track& track = tracks[request.track_id - 1];
+            track.valid_time = request.request_time;
+            scheduler.updateTrack(track);
+        }
+        previous = scheduler.scheduleSlot(slot_start);
+        benchmark::DoNotOptimize(BeamScheduler::encode(previous, slot_start));
+        requests += previous.size();
+        slot_start += slot;
+    }
+    state.counters["requests_per_slot"] = benchmark::Counter(static_cast<double>(requests) /
+                                                             static_cast<double>(state.iterations()));
+    state.counters["late"] = static_cast<double>(scheduler.getStats().late_requests);
+}
+BENCHMARK(BM_ScheduleSlot)->Arg(1000)->Arg(5000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Full refresh from the track list (e.g. after a TWS scan)
+ */
+static void BM_UpdateAllTracks(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    TimePoint now{};
+    now += std::chrono::hours(1);
+    auto tracks = makeTracks(count, now);
+
+    BeamScheduler scheduler(benchmarkConfig());
+    scheduler.updateTracks(tracks);
+    for (auto _ : state) {
+        scheduler.updateTracks(tracks);
+        benchmark::DoNotOptimize(scheduler.pendingCount());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+BENCHMARK(BM_UpdateAllTracks)->Arg(1000)->Arg(5000)->Arg(10000)->Unit(benchmark::kMicrosecond);
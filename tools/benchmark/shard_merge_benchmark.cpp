@@ -0,0 +1,84 @@
+#include "management/TrackMerger.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+using namespace radar_tracking;
+
+namespace {
+
+constexpr double SITE_HALF_WIDTH = 100000.0;
+constexpr double BOUNDARY_MARGIN = 1000.0;
+
+/**
+ * @brief Split the site into vertical strips, one per shard
+ */
+ShardRegion stripRegion(int shard, int shards) {
+    const double width = 2.0 * SITE_HALF_WIDTH / shards;
+    ShardRegion region;
+    region.bounded = true;
+    region.x_min = -SITE_HALF_WIDTH + shard * width;
+    region.x_max = region.x_min + width;
+    region.y_min = -SITE_HALF_WIDTH;
+    region.y_max = SITE_HALF_WIDTH;
+    return region;
+}
+
+/**
+ * @brief Uniform targets; those near a strip edge are reported by both neighbours
+ */
+void feedShards(TrackMerger& merger, int shards, size_t targets, TrackMerger::TimePoint now) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> coordinate(-SITE_HALF_WIDTH, SITE_HALF_WIDTH);
+    std::normal_distribution<double> noise(0.0, 5.0);
+    std::vector<std::vector<shard_wire::TrackRecord>> records(shards);
+
+    for (size_t i = 0; i < targets; ++i) {
+        Track track;
+        track.state = TrackState::CONFIRMED;
+        track.valid_time = now;
+        track.velocity = Point3D(150.0, 0.0, 0.0);
+        for (int axis = 0; axis < 3; ++axis) {
+            track.covariance[axis][axis] = 100.0;
+        }
+        const Point3D truth(coordinate(rng), coordinate(rng), 3000.0);
+        for (int shard = 0; shard < shards; ++shard) {
+            const double edge = stripRegion(shard, shards).edgeDistance(truth);
+            if (edge < -BOUNDARY_MARGIN) {
+                continue;
+            }
+            track.track_id = static_cast<uint32_t>(i + 1);
+            track.position = Point3D(truth.x + noise(rng), truth.y + noise(rng), truth.z);
+            const uint8_t flags = edge < 0.0 ? shard_wire::TRACK_FOREIGN
+                                : edge < BOUNDARY_MARGIN ? shard_wire::TRACK_BOUNDARY : 0;
+            records[shard].push_back(shard_wire::toRecord(track, Point3D(), flags));
+        }
+    }
+    for (int shard = 0; shard < shards; ++shard) {
+        merger.setRegion(shard, stripRegion(shard, shards));
+        merger.updateShard(shard, std::move(records[shard]), now);
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Merge cost for a fixed site picture split over a growing number of shards
+ */
+static void BM_MergeShards(benchmark::State& state) {
+    const int shards = static_cast<int>(state.range(0));
+    const size_t targets = static_cast<size_t>(state.range(1));
+    const auto now = std::chrono::high_resolution_clock::now();
+    TrackMerger merger;
+    feedShards(merger, shards, targets, now);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(merger.merge(now).size());
+    }
+    const auto& stats = merger.getStats();
+    state.counters["duplicates"] = static_cast<double>(stats.duplicates_removed) / stats.merges;
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * targets));
+}
+BENCHMARK(BM_MergeShards)
+    ->Args({1, 10000})->Args({2, 10000})->Args({4, 10000})->Args({8, 10000})->Args({16, 10000})
+    ->Args({4, 50000})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,112 @@
+#include "output/SharedMemoryOutputAdapter.hpp"
+#include "output/SharedMemoryReader.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace radar_tracking;
+
+namespace {
+
+const char* SEGMENT_NAME = "/radar_shm_benchmark";
+
+std::vector<Track> makeTracks(size_t count) {
+    std::vector<Track> tracks(count);
+    for (size_t i = 0; i < count; ++i) {
+        tracks[i].track_id = static_cast<uint32_t>(i + 1);
+        tracks[i].state = TrackState::CONFIRMED;
+        tracks[i].position = Point3D(1000.0 * i, 500.0, 3000.0);
+        tracks[i].velocity = Point3D(200.0, 0.0, 0.0);
+        tracks[i].last_update = std::chrono::high_resolution_clock::now();
+    }
+    return tracks;
+}
+
+SharedMemoryOutputAdapter::Config benchmarkConfig() {
+    SharedMemoryOutputAdapter::Config config;
+    config.segment_name = SEGMENT_NAME;
+    config.slot_count = 16;
+    config.slot_size_kb = 1024;
+    return config;
+}
+
+int64_t steadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+/**
+ * @brief Writer cost of one track frame
+ */
+static void BM_PublishTracks(benchmark::State& state) {
+    const auto tracks = makeTracks(static_cast<size_t>(state.range(0)));
+    SharedMemoryOutputAdapter adapter;
+    if (!adapter.initialize(benchmarkConfig())) {
+        state.SkipWithError("cannot create shared-memory segment");
+        return;
+    }
+    for (auto _ : state) {
+        adapter.publishTracks(tracks);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(adapter.getStats().bytes_published));
+}
+BENCHMARK(BM_PublishTracks)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Publish to copied-out frame on another thread, measured from the slot's publish stamp
+ *
+ * The writer publishes one frame and waits until the polling reader has
+ * taken it, so each iteration times one frame in isolation. On a machine
+ * with a single core the two threads share it and the figure includes a
+ * context switch.
+ */
+static void BM_PublishToReadLatency(benchmark::State& state) {
+    const auto tracks = makeTracks(static_cast<size_t>(state.range(0)));
+    SharedMemoryOutputAdapter adapter;
+    if (!adapter.initialize(benchmarkConfig())) {
+        state.SkipWithError("cannot create shared-memory segment");
+        return;
+    }
+
+    SharedMemoryReader reader;
+    if (!reader.open(SEGMENT_NAME, SharedMemoryReader::StartPosition::NEXT)) {
+        state.SkipWithError("cannot open shared-memory segment");
+        return;
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> consumed{0};
+    std::atomic<int64_t> latency_ns{0};
+    std::thread consumer([&]() {
+        SharedMemoryReader::Frame frame;
+        while (running.load(std::memory_order_acquire)) {
+            if (reader.poll(frame) == SharedMemoryReader::PollResult::FRAME) {
+                latency_ns.store(steadyNanoseconds() - frame.publish_ns, std::memory_order_relaxed);
+                consumed.fetch_add(1, std::memory_order_release);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t published = 0;
+    double total_ns = 0.0;
+    for (auto _ : state) {
+        adapter.publishTracks(tracks);
+        ++published;
+        while (consumed.load(std::memory_order_acquire) < published) {
+            std::this_thread::yield();
+        }
+        const double ns = static_cast<double>(latency_ns.load(std::memory_order_relaxed));
+        state.SetIterationTime(ns * 1e-9);
+        total_ns += ns;
+    }
+    running.store(false, std::memory_order_release);
+    consumer.join();
+    state.counters["latency_us"] = total_ns * 1e-3 / static_cast<double>(std::max<uint64_t>(published, 1));
+}
+BENCHMARK(BM_PublishToReadLatency)->Arg(10)->Arg(100)->Arg(1000)->UseManualTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,66 @@
+#include "processing/TrackFusionEngine.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+
+using namespace radar_tracking;
+
+namespace {
+
+constexpr double SITE_HALF_WIDTH = 100000.0;
+
+Track makeTrack(uint32_t id, const Point3D& position, double variance, TrackFusionEngine::TimePoint now) {
+    Track track;
+    track.track_id = id;
+    track.state = TrackState::CONFIRMED;
+    track.position = position;
+    track.velocity = Point3D(150.0, 0.0, 0.0);
+    for (int axis = 0; axis < 6; ++axis) {
+        track.covariance[axis][axis] = axis < 3 ? variance : 4.0;
+    }
+    track.valid_time = now;
+    track.last_update = now;
+    return track;
+}
+
+/**
+ * @brief Local picture plus a peer that sees every target, with independent noise
+ */
+void makePictures(size_t targets, TrackFusionEngine::TimePoint now,
+                  std::vector<Track>& local, std::vector<Track>& remote) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> coordinate(-SITE_HALF_WIDTH, SITE_HALF_WIDTH);
+    std::normal_distribution<double> noise(0.0, 5.0);
+    for (size_t i = 0; i < targets; ++i) {
+        const Point3D truth(coordinate(rng), coordinate(rng), 3000.0);
+        const uint32_t id = static_cast<uint32_t>(i + 1);
+        local.push_back(makeTrack(id, Point3D(truth.x + noise(rng), truth.y + noise(rng), truth.z), 100.0, now));
+        remote.push_back(makeTrack(id, Point3D(truth.x + noise(rng), truth.y + noise(rng), truth.z), 50.0, now));
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief One fusion cycle: a full remote picture ingested, gated, associated and fused
+ */
+static void BM_FuseRemotePicture(benchmark::State& state) {
+    const size_t targets = static_cast<size_t>(state.range(0));
+    TrackFusionEngine::Config config;
+    config.method = state.range(1) ? TrackFusionEngine::Method::INFORMATION
+                                   : TrackFusionEngine::Method::COVARIANCE_INTERSECTION;
+    TrackFusionEngine engine(config);
+    const auto now = std::chrono::high_resolution_clock::now();
+    std::vector<Track> local, remote;
+    makePictures(targets, now, local, remote);
+
+    for (auto _ : state) {
+        engine.ingest(1, remote);
+        benchmark::DoNotOptimize(engine.fuse(local, now).size());
+    }
+    const auto stats = engine.getStats();
+    state.counters["associated"] = static_cast<double>(stats.associations) / stats.fusions;
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * targets));
+}
+BENCHMARK(BM_FuseRemotePicture)
+    ->Args({1000, 0})->Args({10000, 0})->Args({10000, 1})->Args({50000, 1})
+    ->Unit(benchmark::kMillisecond);